@@ -314,6 +314,7 @@ public class HoudiniEngine : ModuleRules
                     "AssetTools",
                     "EditorStyle",
                     "EditorWidgets",
+                    "Json",
                     "LevelEditor",
                     "MainFrame",
                     "MeshPaint",
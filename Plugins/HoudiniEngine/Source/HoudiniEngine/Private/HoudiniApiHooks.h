@@ -0,0 +1,410 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "HoudiniApi.h"
+
+#include "CoreMinimal.h"
+
+// The HAPI functions that can be hooked: all the functions that go through the session.
+// The struct helpers (AttributeInfo_Init, ParmInfo_IsInt...) don't leave the process and aren't hooked.
+#define HOUDINI_API_HOOKED_CALLS(CALL) \
+	CALL(AddAttribute) \
+	CALL(AddGroup) \
+	CALL(BindCustomImplementation) \
+	CALL(CancelPDGCook) \
+	CALL(CheckForSpecificErrors) \
+	CALL(Cleanup) \
+	CALL(ClearConnectionError) \
+	CALL(CloseSession) \
+	CALL(CommitGeo) \
+	CALL(CommitWorkitems) \
+	CALL(ComposeChildNodeList) \
+	CALL(ComposeNodeCookResult) \
+	CALL(ComposeObjectList) \
+	CALL(ConnectNodeInput) \
+	CALL(ConvertMatrixToEuler) \
+	CALL(ConvertMatrixToQuat) \
+	CALL(ConvertTransform) \
+	CALL(ConvertTransformEulerToMatrix) \
+	CALL(ConvertTransformQuatToMatrix) \
+	CALL(CookNode) \
+	CALL(CookPDG) \
+	CALL(CreateCustomSession) \
+	CALL(CreateHeightFieldInput) \
+	CALL(CreateHeightfieldInputVolumeNode) \
+	CALL(CreateInProcessSession) \
+	CALL(CreateInputNode) \
+	CALL(CreateNode) \
+	CALL(CreateThriftNamedPipeSession) \
+	CALL(CreateThriftSocketSession) \
+	CALL(CreateWorkitem) \
+	CALL(DeleteAttribute) \
+	CALL(DeleteGroup) \
+	CALL(DeleteNode) \
+	CALL(DirtyPDGNode) \
+	CALL(DisconnectNodeInput) \
+	CALL(DisconnectNodeOutputsAt) \
+	CALL(ExtractImageToFile) \
+	CALL(ExtractImageToMemory) \
+	CALL(GetActiveCacheCount) \
+	CALL(GetActiveCacheNames) \
+	CALL(GetAssetDefinitionParmCounts) \
+	CALL(GetAssetDefinitionParmInfos) \
+	CALL(GetAssetDefinitionParmValues) \
+	CALL(GetAssetInfo) \
+	CALL(GetAttributeFloat64Data) \
+	CALL(GetAttributeFloatData) \
+	CALL(GetAttributeInfo) \
+	CALL(GetAttributeInt64Data) \
+	CALL(GetAttributeIntData) \
+	CALL(GetAttributeNames) \
+	CALL(GetAttributeStringData) \
+	CALL(GetAvailableAssetCount) \
+	CALL(GetAvailableAssets) \
+	CALL(GetBoxInfo) \
+	CALL(GetCacheProperty) \
+	CALL(GetComposedChildNodeList) \
+	CALL(GetComposedNodeCookResult) \
+	CALL(GetComposedObjectList) \
+	CALL(GetComposedObjectTransforms) \
+	CALL(GetConnectionError) \
+	CALL(GetConnectionErrorLength) \
+	CALL(GetCookingCurrentCount) \
+	CALL(GetCookingTotalCount) \
+	CALL(GetCurveCounts) \
+	CALL(GetCurveInfo) \
+	CALL(GetCurveKnots) \
+	CALL(GetCurveOrders) \
+	CALL(GetDisplayGeoInfo) \
+	CALL(GetEnvInt) \
+	CALL(GetFaceCounts) \
+	CALL(GetFirstVolumeTile) \
+	CALL(GetGeoInfo) \
+	CALL(GetGeoSize) \
+	CALL(GetGroupCountOnPackedInstancePart) \
+	CALL(GetGroupMembership) \
+	CALL(GetGroupMembershipOnPackedInstancePart) \
+	CALL(GetGroupNames) \
+	CALL(GetGroupNamesOnPackedInstancePart) \
+	CALL(GetHandleBindingInfo) \
+	CALL(GetHandleInfo) \
+	CALL(GetHeightFieldData) \
+	CALL(GetImageFilePath) \
+	CALL(GetImageInfo) \
+	CALL(GetImageMemoryBuffer) \
+	CALL(GetImagePlaneCount) \
+	CALL(GetImagePlanes) \
+	CALL(GetInstanceTransformsOnPart) \
+	CALL(GetInstancedObjectIds) \
+	CALL(GetInstancedPartIds) \
+	CALL(GetInstancerPartTransforms) \
+	CALL(GetManagerNodeId) \
+	CALL(GetMaterialInfo) \
+	CALL(GetMaterialNodeIdsOnFaces) \
+	CALL(GetNextVolumeTile) \
+	CALL(GetNodeInfo) \
+	CALL(GetNodeInputName) \
+	CALL(GetNodeOutputName) \
+	CALL(GetNodePath) \
+	CALL(GetNumWorkitems) \
+	CALL(GetObjectInfo) \
+	CALL(GetObjectTransform) \
+	CALL(GetPDGEvents) \
+	CALL(GetPDGGraphContextId) \
+	CALL(GetPDGGraphContexts) \
+	CALL(GetPDGState) \
+	CALL(GetParameters) \
+	CALL(GetParmChoiceLists) \
+	CALL(GetParmExpression) \
+	CALL(GetParmFile) \
+	CALL(GetParmFloatValue) \
+	CALL(GetParmFloatValues) \
+	CALL(GetParmIdFromName) \
+	CALL(GetParmInfo) \
+	CALL(GetParmInfoFromName) \
+	CALL(GetParmIntValue) \
+	CALL(GetParmIntValues) \
+	CALL(GetParmNodeValue) \
+	CALL(GetParmStringValue) \
+	CALL(GetParmStringValues) \
+	CALL(GetParmTagName) \
+	CALL(GetParmTagValue) \
+	CALL(GetParmWithTag) \
+	CALL(GetPartInfo) \
+	CALL(GetPreset) \
+	CALL(GetPresetBufLength) \
+	CALL(GetServerEnvInt) \
+	CALL(GetServerEnvString) \
+	CALL(GetServerEnvVarCount) \
+	CALL(GetServerEnvVarList) \
+	CALL(GetSessionEnvInt) \
+	CALL(GetSessionSyncInfo) \
+	CALL(GetSphereInfo) \
+	CALL(GetStatus) \
+	CALL(GetStatusString) \
+	CALL(GetStatusStringBufLength) \
+	CALL(GetString) \
+	CALL(GetStringBatch) \
+	CALL(GetStringBatchSize) \
+	CALL(GetStringBufLength) \
+	CALL(GetSupportedImageFileFormatCount) \
+	CALL(GetSupportedImageFileFormats) \
+	CALL(GetTime) \
+	CALL(GetTimelineOptions) \
+	CALL(GetTotalCookCount) \
+	CALL(GetUseHoudiniTime) \
+	CALL(GetVertexList) \
+	CALL(GetViewport) \
+	CALL(GetVolumeBounds) \
+	CALL(GetVolumeInfo) \
+	CALL(GetVolumeTileFloatData) \
+	CALL(GetVolumeTileIntData) \
+	CALL(GetVolumeVoxelFloatData) \
+	CALL(GetVolumeVoxelIntData) \
+	CALL(GetWorkitemDataLength) \
+	CALL(GetWorkitemFloatData) \
+	CALL(GetWorkitemInfo) \
+	CALL(GetWorkitemIntData) \
+	CALL(GetWorkitemResultInfo) \
+	CALL(GetWorkitemStringData) \
+	CALL(GetWorkitems) \
+	CALL(Initialize) \
+	CALL(InsertMultiparmInstance) \
+	CALL(Interrupt) \
+	CALL(IsInitialized) \
+	CALL(IsNodeValid) \
+	CALL(IsSessionValid) \
+	CALL(LoadAssetLibraryFromFile) \
+	CALL(LoadAssetLibraryFromMemory) \
+	CALL(LoadGeoFromFile) \
+	CALL(LoadGeoFromMemory) \
+	CALL(LoadHIPFile) \
+	CALL(LoadNodeFromFile) \
+	CALL(ParmHasExpression) \
+	CALL(ParmHasTag) \
+	CALL(PausePDGCook) \
+	CALL(PythonThreadInterpreterLock) \
+	CALL(QueryNodeInput) \
+	CALL(QueryNodeOutputConnectedCount) \
+	CALL(QueryNodeOutputConnectedNodes) \
+	CALL(RemoveCustomString) \
+	CALL(RemoveMultiparmInstance) \
+	CALL(RemoveParmExpression) \
+	CALL(RenameNode) \
+	CALL(RenderCOPToImage) \
+	CALL(RenderTextureToImage) \
+	CALL(ResetSimulation) \
+	CALL(RevertGeo) \
+	CALL(RevertParmToDefault) \
+	CALL(RevertParmToDefaults) \
+	CALL(SaveGeoToFile) \
+	CALL(SaveGeoToMemory) \
+	CALL(SaveHIPFile) \
+	CALL(SaveNodeToFile) \
+	CALL(SetAnimCurve) \
+	CALL(SetAttributeFloat64Data) \
+	CALL(SetAttributeFloatData) \
+	CALL(SetAttributeInt64Data) \
+	CALL(SetAttributeIntData) \
+	CALL(SetAttributeStringData) \
+	CALL(SetCacheProperty) \
+	CALL(SetCurveCounts) \
+	CALL(SetCurveInfo) \
+	CALL(SetCurveKnots) \
+	CALL(SetCurveOrders) \
+	CALL(SetCustomString) \
+	CALL(SetFaceCounts) \
+	CALL(SetGroupMembership) \
+	CALL(SetHeightFieldData) \
+	CALL(SetImageInfo) \
+	CALL(SetNodeDisplay) \
+	CALL(SetObjectTransform) \
+	CALL(SetParmExpression) \
+	CALL(SetParmFloatValue) \
+	CALL(SetParmFloatValues) \
+	CALL(SetParmIntValue) \
+	CALL(SetParmIntValues) \
+	CALL(SetParmNodeValue) \
+	CALL(SetParmStringValue) \
+	CALL(SetPartInfo) \
+	CALL(SetPreset) \
+	CALL(SetServerEnvInt) \
+	CALL(SetServerEnvString) \
+	CALL(SetSessionSync) \
+	CALL(SetSessionSyncInfo) \
+	CALL(SetTime) \
+	CALL(SetTimelineOptions) \
+	CALL(SetTransformAnimCurve) \
+	CALL(SetUseHoudiniTime) \
+	CALL(SetVertexList) \
+	CALL(SetViewport) \
+	CALL(SetVolumeInfo) \
+	CALL(SetVolumeTileFloatData) \
+	CALL(SetVolumeTileIntData) \
+	CALL(SetVolumeVoxelFloatData) \
+	CALL(SetVolumeVoxelIntData) \
+	CALL(SetWorkitemFloatData) \
+	CALL(SetWorkitemIntData) \
+	CALL(SetWorkitemStringData) \
+	CALL(StartThriftNamedPipeServer) \
+	CALL(StartThriftSocketServer)
+
+// FHoudiniApi is generated, so the HAPI calls are instrumented by replacing its function pointers
+// with hooks instead of modifying it. A hook type implements:
+//
+//	template<int32 Call, typename ReturnType, typename... ArgTypes>
+//	static ReturnType Invoke(ReturnType (*InOriginal)(ArgTypes...), ArgTypes... Args);
+//
+// where InOriginal is the function that was in place when the hook was installed.
+// Hooks can be stacked: a hook that is removed while another one has been installed over it stays in the chain,
+// so an inactive hook must keep forwarding its calls to InOriginal.
+// Hooks are installed and removed from the game thread while the schedulers and workers call through the
+// function pointers, so the pointers are written atomically, after the hook's Original has been set.
+// Original is never cleared: a call that already went through the hook keeps a valid function to forward to.
+namespace HoudiniApiHooks
+{
+	// Atomic accesses to a function pointer
+	template<typename FunctionType>
+	inline void
+	StoreFunction(FunctionType& OutFunction, FunctionType InFunction)
+	{
+		static_assert(sizeof(FunctionType) == sizeof(int64), "HAPI function pointers are expected to be 64 bit.");
+		FPlatformAtomics::AtomicStore(reinterpret_cast<volatile int64*>(&OutFunction), (int64)reinterpret_cast<UPTRINT>(InFunction));
+	}
+
+	template<typename FunctionType>
+	inline FunctionType
+	LoadFunction(const FunctionType& InFunction)
+	{
+		static_assert(sizeof(FunctionType) == sizeof(int64), "HAPI function pointers are expected to be 64 bit.");
+		return reinterpret_cast<FunctionType>((UPTRINT)FPlatformAtomics::AtomicRead(reinterpret_cast<volatile const int64*>(&InFunction)));
+	}
+
+	enum ECall
+	{
+#define HOUDINI_API_HOOK_ENUM(Name) Name,
+		HOUDINI_API_HOOKED_CALLS(HOUDINI_API_HOOK_ENUM)
+#undef HOUDINI_API_HOOK_ENUM
+		CallCount
+	};
+
+	inline const TCHAR*
+	GetCallName(const int32& InCall)
+	{
+		static const TCHAR* const CallNames[CallCount] =
+		{
+#define HOUDINI_API_HOOK_NAME(Name) TEXT(#Name),
+			HOUDINI_API_HOOKED_CALLS(HOUDINI_API_HOOK_NAME)
+#undef HOUDINI_API_HOOK_NAME
+		};
+
+		return (InCall >= 0 && InCall < CallCount) ? CallNames[InCall] : TEXT("");
+	}
+
+	inline int32
+	FindCall(const FString& InCallName)
+	{
+		for (int32 Idx = 0; Idx < CallCount; Idx++)
+		{
+			if (InCallName.Equals(GetCallName(Idx), ESearchCase::CaseSensitive))
+				return Idx;
+		}
+
+		return INDEX_NONE;
+	}
+
+	// The function installed in place of a HAPI function pointer
+	template<typename HookType, int32 Call, typename ReturnType, typename... ArgTypes>
+	struct THook
+	{
+		static ReturnType
+		Invoke(ArgTypes... Args)
+		{
+			return HookType::template Invoke<Call, ReturnType, ArgTypes...>(LoadFunction(Original), Args...);
+		}
+
+		// The function that was in place before the hook
+		static ReturnType (*Original)(ArgTypes...);
+
+		// Whether the hook is in the chain of this function pointer
+		static bool bInstalled;
+	};
+
+	template<typename HookType, int32 Call, typename ReturnType, typename... ArgTypes>
+	ReturnType (*THook<HookType, Call, ReturnType, ArgTypes...>::Original)(ArgTypes...) = nullptr;
+
+	template<typename HookType, int32 Call, typename ReturnType, typename... ArgTypes>
+	bool THook<HookType, Call, ReturnType, ArgTypes...>::bInstalled = false;
+
+	template<typename HookType, int32 Call, typename ReturnType, typename... ArgTypes>
+	void
+	Install(ReturnType (*&InOutFunction)(ArgTypes...))
+	{
+		typedef THook<HookType, Call, ReturnType, ArgTypes...> FHook;
+		if (FHook::bInstalled)
+			return;
+
+		StoreFunction(FHook::Original, LoadFunction(InOutFunction));
+		FHook::bInstalled = true;
+		StoreFunction(InOutFunction, &FHook::Invoke);
+	}
+
+	template<typename HookType, int32 Call, typename ReturnType, typename... ArgTypes>
+	void
+	Uninstall(ReturnType (*&InOutFunction)(ArgTypes...))
+	{
+		typedef THook<HookType, Call, ReturnType, ArgTypes...> FHook;
+		if (!FHook::bInstalled)
+			return;
+
+		// Another hook has been installed over ours, leave it in the chain
+		if (LoadFunction(InOutFunction) != &FHook::Invoke)
+			return;
+
+		StoreFunction(InOutFunction, LoadFunction(FHook::Original));
+		FHook::bInstalled = false;
+	}
+
+	template<typename HookType>
+	void
+	InstallAll()
+	{
+#define HOUDINI_API_HOOK_INSTALL(Name) Install<HookType, Name>(FHoudiniApi::Name);
+		HOUDINI_API_HOOKED_CALLS(HOUDINI_API_HOOK_INSTALL)
+#undef HOUDINI_API_HOOK_INSTALL
+	}
+
+	template<typename HookType>
+	void
+	UninstallAll()
+	{
+#define HOUDINI_API_HOOK_UNINSTALL(Name) Uninstall<HookType, Name>(FHoudiniApi::Name);
+		HOUDINI_API_HOOKED_CALLS(HOUDINI_API_HOOK_UNINSTALL)
+#undef HOUDINI_API_HOOK_UNINSTALL
+	}
+}
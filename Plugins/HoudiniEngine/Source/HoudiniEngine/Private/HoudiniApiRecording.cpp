@@ -0,0 +1,793 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniApiRecording.h"
+
+#include "HoudiniApiHooks.h"
+#include "HoudiniEnginePrivatePCH.h"
+
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+#include "Templates/UniquePtr.h"
+
+namespace HoudiniApiRecording
+{
+	// "HAPR"
+	static const uint32 FileMagic = 0x52504148;
+	static const int32 FileVersion = 1;
+
+	enum class EArgumentType : uint8
+	{
+		// Passed by value
+		Value,
+		// Pointer to data read by HAPI
+		Input,
+		// Null terminated string, and array of strings
+		String,
+		StringArray,
+		// Pointer to data written by HAPI
+		Output,
+		// Pointer we can't interpret
+		Opaque
+	};
+
+	struct FArgument
+	{
+		EArgumentType Type = EArgumentType::Opaque;
+
+		// Bytes of the arguments passed by value
+		int64 Value = 0;
+		int32 ValueSize = 0;
+
+		// Pointed data and size of a single element for the pointer arguments
+		const void* Pointer = nullptr;
+		int32 ElementSize = 0;
+
+		// Returns the value of an integer argument
+		int64 GetInteger() const
+		{
+			switch (ValueSize)
+			{
+				case 1: { int8 Integer; FMemory::Memcpy(&Integer, &Value, 1); return Integer; }
+				case 2: { int16 Integer; FMemory::Memcpy(&Integer, &Value, 2); return Integer; }
+				case 4: { int32 Integer; FMemory::Memcpy(&Integer, &Value, 4); return Integer; }
+				default: return Value;
+			}
+		}
+	};
+
+	template<typename ValueType>
+	static FArgument
+	MakeArgument(ValueType InValue)
+	{
+		static_assert(sizeof(ValueType) <= sizeof(int64), "Arguments passed by value must fit in 64 bits");
+
+		FArgument Argument;
+		Argument.Type = EArgumentType::Value;
+		Argument.ValueSize = sizeof(ValueType);
+		FMemory::Memcpy(&Argument.Value, &InValue, sizeof(ValueType));
+		return Argument;
+	}
+
+	template<typename ElementType>
+	static FArgument
+	MakeArgument(const ElementType* InPointer)
+	{
+		FArgument Argument;
+		Argument.Type = EArgumentType::Input;
+		Argument.Pointer = InPointer;
+		Argument.ElementSize = sizeof(ElementType);
+		return Argument;
+	}
+
+	template<typename ElementType>
+	static FArgument
+	MakeArgument(ElementType* InPointer)
+	{
+		FArgument Argument;
+		Argument.Type = EArgumentType::Output;
+		Argument.Pointer = InPointer;
+		Argument.ElementSize = sizeof(ElementType);
+		return Argument;
+	}
+
+	static FArgument
+	MakeArgument(const char* InString)
+	{
+		FArgument Argument;
+		Argument.Type = EArgumentType::String;
+		Argument.Pointer = InString;
+		Argument.ElementSize = 1;
+		return Argument;
+	}
+
+	static FArgument
+	MakeArgument(const char** InStrings)
+	{
+		FArgument Argument;
+		Argument.Type = EArgumentType::StringArray;
+		Argument.Pointer = InStrings;
+		Argument.ElementSize = sizeof(const char*);
+		return Argument;
+	}
+
+	static FArgument
+	MakeArgument(void* InPointer)
+	{
+		FArgument Argument;
+		Argument.Type = EArgumentType::Opaque;
+		Argument.Pointer = InPointer;
+		return Argument;
+	}
+
+	// Pointer arguments that point to more than one element.
+	// The element count is read from another argument (and multiplied by the tuple size of an attribute info),
+	// or is fixed for the matrices.
+	struct FArrayArgument
+	{
+		int32 Call;
+		int32 Argument;
+		int32 CountArgument;
+		int32 AttributeInfoArgument;
+		int32 FixedCount;
+	};
+
+	static const FArrayArgument ArrayArguments[] =
+	{
+		{ HoudiniApiHooks::GetActiveCacheNames, 1, 2, -1, 0 },
+		{ HoudiniApiHooks::GetAssetDefinitionParmInfos, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetAssetDefinitionParmValues, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetAssetDefinitionParmValues, 6, 8, -1, 0 },
+		{ HoudiniApiHooks::GetAssetDefinitionParmValues, 10, 12, -1, 0 },
+		{ HoudiniApiHooks::GetAssetDefinitionParmValues, 13, 15, -1, 0 },
+		{ HoudiniApiHooks::GetAttributeFloat64Data, 6, 8, 4, 0 },
+		{ HoudiniApiHooks::GetAttributeFloatData, 6, 8, 4, 0 },
+		{ HoudiniApiHooks::GetAttributeInt64Data, 6, 8, 4, 0 },
+		{ HoudiniApiHooks::GetAttributeIntData, 6, 8, 4, 0 },
+		{ HoudiniApiHooks::GetAttributeNames, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::GetAttributeStringData, 5, 7, 4, 0 },
+		{ HoudiniApiHooks::GetAvailableAssets, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetComposedChildNodeList, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetComposedNodeCookResult, 1, 2, -1, 0 },
+		{ HoudiniApiHooks::GetComposedObjectList, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetComposedObjectTransforms, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetConnectionError, 0, 1, -1, 0 },
+		{ HoudiniApiHooks::GetCurveCounts, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetCurveKnots, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetCurveOrders, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetFaceCounts, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetGroupMembership, 6, 8, -1, 0 },
+		{ HoudiniApiHooks::GetGroupMembershipOnPackedInstancePart, 6, 8, -1, 0 },
+		{ HoudiniApiHooks::GetGroupNames, 3, 4, -1, 0 },
+		{ HoudiniApiHooks::GetGroupNamesOnPackedInstancePart, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::GetHandleBindingInfo, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetHandleInfo, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetHeightFieldData, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetImageMemoryBuffer, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetImagePlanes, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetInstanceTransformsOnPart, 4, 6, -1, 0 },
+		{ HoudiniApiHooks::GetInstancedObjectIds, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetInstancedPartIds, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetInstancerPartTransforms, 4, 6, -1, 0 },
+		{ HoudiniApiHooks::GetMaterialNodeIdsOnFaces, 4, 6, -1, 0 },
+		{ HoudiniApiHooks::GetPDGEvents, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetPDGGraphContexts, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetPDGGraphContexts, 3, 4, -1, 0 },
+		{ HoudiniApiHooks::GetParameters, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetParmChoiceLists, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetParmFloatValues, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetParmIntValues, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::GetParmStringValues, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetPreset, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetServerEnvVarList, 1, 3, -1, 0 },
+		{ HoudiniApiHooks::GetStatusString, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetString, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::GetStringBatch, 1, 2, -1, 0 },
+		{ HoudiniApiHooks::GetStringBatchSize, 1, 2, -1, 0 },
+		{ HoudiniApiHooks::GetSupportedImageFileFormats, 1, 2, -1, 0 },
+		{ HoudiniApiHooks::GetVertexList, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::GetVolumeTileFloatData, 5, 6, -1, 0 },
+		{ HoudiniApiHooks::GetVolumeTileIntData, 5, 6, -1, 0 },
+		{ HoudiniApiHooks::GetVolumeVoxelFloatData, 6, 7, -1, 0 },
+		{ HoudiniApiHooks::GetVolumeVoxelIntData, 6, 7, -1, 0 },
+		{ HoudiniApiHooks::GetWorkitemFloatData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::GetWorkitemIntData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::GetWorkitemResultInfo, 3, 4, -1, 0 },
+		{ HoudiniApiHooks::GetWorkitemStringData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::GetWorkitems, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::QueryNodeOutputConnectedNodes, 5, 7, -1, 0 },
+		{ HoudiniApiHooks::SaveGeoToMemory, 2, 3, -1, 0 },
+		{ HoudiniApiHooks::SetAnimCurve, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::SetAttributeFloat64Data, 5, 7, 4, 0 },
+		{ HoudiniApiHooks::SetAttributeFloatData, 5, 7, 4, 0 },
+		{ HoudiniApiHooks::SetAttributeInt64Data, 5, 7, 4, 0 },
+		{ HoudiniApiHooks::SetAttributeIntData, 5, 7, 4, 0 },
+		{ HoudiniApiHooks::SetAttributeStringData, 5, 7, 4, 0 },
+		{ HoudiniApiHooks::SetCurveCounts, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::SetCurveKnots, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::SetCurveOrders, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::SetFaceCounts, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::SetGroupMembership, 5, 7, -1, 0 },
+		{ HoudiniApiHooks::SetHeightFieldData, 4, 6, -1, 0 },
+		{ HoudiniApiHooks::SetParmFloatValues, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::SetParmIntValues, 2, 4, -1, 0 },
+		{ HoudiniApiHooks::SetTransformAnimCurve, 3, 4, -1, 0 },
+		{ HoudiniApiHooks::SetVertexList, 3, 5, -1, 0 },
+		{ HoudiniApiHooks::SetVolumeTileFloatData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::SetVolumeTileIntData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::SetVolumeVoxelFloatData, 6, 7, -1, 0 },
+		{ HoudiniApiHooks::SetVolumeVoxelIntData, 6, 7, -1, 0 },
+		{ HoudiniApiHooks::SetWorkitemFloatData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::SetWorkitemIntData, 4, 5, -1, 0 },
+		{ HoudiniApiHooks::ConvertMatrixToEuler, 1, -1, -1, 16 },
+		{ HoudiniApiHooks::ConvertMatrixToQuat, 1, -1, -1, 16 },
+		{ HoudiniApiHooks::ConvertTransformEulerToMatrix, 2, -1, -1, 16 },
+		{ HoudiniApiHooks::ConvertTransformQuatToMatrix, 2, -1, -1, 16 },
+	};
+
+	// The array arguments, per call
+	static TArray<FArrayArgument> CallArrayArguments[HoudiniApiHooks::CallCount];
+
+	static void
+	InitializeArrayArguments()
+	{
+		if (CallArrayArguments[ArrayArguments[0].Call].Num() > 0)
+			return;
+
+		for (const FArrayArgument& ArrayArgument : ArrayArguments)
+			CallArrayArguments[ArrayArgument.Call].Add(ArrayArgument);
+	}
+
+	// Returns the number of elements pointed by an argument
+	static int64
+	GetElementCount(const int32& InCall, const int32& InArgument, const FArgument* InArguments)
+	{
+		for (const FArrayArgument& ArrayArgument : CallArrayArguments[InCall])
+		{
+			if (ArrayArgument.Argument != InArgument)
+				continue;
+
+			if (ArrayArgument.FixedCount > 0)
+				return ArrayArgument.FixedCount;
+
+			int64 Count = InArguments[ArrayArgument.CountArgument].GetInteger();
+			if (ArrayArgument.AttributeInfoArgument >= 0)
+			{
+				const HAPI_AttributeInfo* AttributeInfo = (const HAPI_AttributeInfo*)InArguments[ArrayArgument.AttributeInfoArgument].Pointer;
+				if (AttributeInfo)
+					Count *= FMath::Max(AttributeInfo->tupleSize, 1);
+			}
+
+			return FMath::Max<int64>(Count, 0);
+		}
+
+		return 1;
+	}
+
+	static int64
+	GetByteCount(const int32& InCall, const int32& InArgument, const FArgument* InArguments)
+	{
+		const FArgument& Argument = InArguments[InArgument];
+		if (!Argument.Pointer)
+			return 0;
+
+		return GetElementCount(InCall, InArgument, InArguments) * Argument.ElementSize;
+	}
+
+	// Hashes what the caller sends to HAPI: values, input buffers and strings.
+	// The session is hashed too, so calls made on different sessions of a pool don't get mixed.
+	static uint64
+	HashInputs(const int32& InCall, const FArgument* InArguments, const int32& InArgumentCount)
+	{
+		uint64 Hash = CityHash64((const char*)&InCall, sizeof(InCall));
+		for (int32 ArgumentIdx = 0; ArgumentIdx < InArgumentCount; ArgumentIdx++)
+		{
+			const FArgument& Argument = InArguments[ArgumentIdx];
+			switch (Argument.Type)
+			{
+				case EArgumentType::Value:
+					Hash = CityHash64WithSeed((const char*)&Argument.Value, Argument.ValueSize, Hash);
+					break;
+
+				case EArgumentType::Input:
+					if (Argument.Pointer)
+						Hash = CityHash64WithSeed((const char*)Argument.Pointer, (uint32)GetByteCount(InCall, ArgumentIdx, InArguments), Hash);
+					break;
+
+				case EArgumentType::String:
+					if (Argument.Pointer)
+						Hash = CityHash64WithSeed((const char*)Argument.Pointer, FCStringAnsi::Strlen((const char*)Argument.Pointer), Hash);
+					break;
+
+				case EArgumentType::StringArray:
+				{
+					const char** Strings = (const char**)Argument.Pointer;
+					const int64 StringCount = Strings ? GetElementCount(InCall, ArgumentIdx, InArguments) : 0;
+					for (int64 StringIdx = 0; StringIdx < StringCount; StringIdx++)
+					{
+						if (Strings[StringIdx])
+							Hash = CityHash64WithSeed(Strings[StringIdx], FCStringAnsi::Strlen(Strings[StringIdx]), Hash);
+					}
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		return Hash;
+	}
+
+	static FCriticalSection CriticalSection;
+
+	// Recording state
+	static bool bRecording = false;
+	static TUniquePtr<FArchive> RecordingWriter;
+	static int64 RecordedCallCount = 0;
+	static int64 RecordedByteCount = 0;
+
+	// Replay state
+	struct FRecordedCall
+	{
+		int32 Call = INDEX_NONE;
+		uint64 InputHash = 0;
+		int32 Result = HAPI_RESULT_FAILURE;
+		int32 FirstOutput = 0;
+		int32 OutputCount = 0;
+		bool bReplayed = false;
+	};
+
+	struct FRecordedOutput
+	{
+		int32 Argument = 0;
+		int32 Size = 0;
+		int64 Offset = 0;
+	};
+
+	// Recorded calls in recording order, and the next one to use
+	struct FReplayQueue
+	{
+		TArray<int32> RecordedCalls;
+		int32 Next = 0;
+	};
+
+	static bool bReplaying = false;
+	static TArray<FRecordedCall> RecordedCalls;
+	static TArray<FRecordedOutput> RecordedOutputs;
+	static TArray64<uint8> RecordedData;
+	static TMap<TPair<int32, uint64>, FReplayQueue> ReplayQueuesByInputs;
+	static FReplayQueue ReplayQueuesByCall[HoudiniApiHooks::CallCount];
+	static int64 ReplayedMatchedCount = 0;
+	static int64 ReplayedInOrderCount = 0;
+	static int64 ReplayedRepeatedCount = 0;
+	static int64 ReplayMissingCount = 0;
+
+	static void
+	RecordCall(const int32& InCall, const FArgument* InArguments, const int32& InArgumentCount, const HAPI_Result& InResult)
+	{
+		uint64 InputHash = HashInputs(InCall, InArguments, InArgumentCount);
+
+		uint8 OutputCount = 0;
+		for (int32 ArgumentIdx = 0; ArgumentIdx < InArgumentCount; ArgumentIdx++)
+		{
+			if (InArguments[ArgumentIdx].Type == EArgumentType::Output && InArguments[ArgumentIdx].Pointer)
+				OutputCount++;
+		}
+
+		FScopeLock ScopeLock(&CriticalSection);
+		if (!RecordingWriter)
+			return;
+
+		FArchive& Writer = *RecordingWriter;
+		uint16 Call = (uint16)InCall;
+		int32 Result = (int32)InResult;
+		Writer << Call << InputHash << Result << OutputCount;
+
+		for (int32 ArgumentIdx = 0; ArgumentIdx < InArgumentCount; ArgumentIdx++)
+		{
+			const FArgument& Argument = InArguments[ArgumentIdx];
+			if (Argument.Type != EArgumentType::Output || !Argument.Pointer)
+				continue;
+
+			uint8 ArgumentIndex = (uint8)ArgumentIdx;
+			int32 Size = (int32)FMath::Min<int64>(GetByteCount(InCall, ArgumentIdx, InArguments), MAX_int32);
+			Writer << ArgumentIndex << Size;
+			Writer.Serialize(const_cast<void*>(Argument.Pointer), Size);
+
+			RecordedByteCount += Size;
+		}
+
+		RecordedCallCount++;
+	}
+
+	// Returns the next recorded call of a queue that hasn't been replayed yet
+	static int32
+	PopNextRecordedCall(FReplayQueue& InQueue)
+	{
+		while (InQueue.Next < InQueue.RecordedCalls.Num())
+		{
+			const int32 RecordedCallIdx = InQueue.RecordedCalls[InQueue.Next++];
+			if (!RecordedCalls[RecordedCallIdx].bReplayed)
+				return RecordedCallIdx;
+		}
+
+		return INDEX_NONE;
+	}
+
+	static HAPI_Result
+	ReplayCall(const int32& InCall, const FArgument* InArguments, const int32& InArgumentCount)
+	{
+		const uint64 InputHash = HashInputs(InCall, InArguments, InArgumentCount);
+
+		FScopeLock ScopeLock(&CriticalSection);
+
+		// Use the same call with the same inputs first, then the same call in recording order
+		FReplayQueue* InputsQueue = ReplayQueuesByInputs.Find(TPair<int32, uint64>(InCall, InputHash));
+		FReplayQueue& CallQueue = ReplayQueuesByCall[InCall];
+		int32 RecordedCallIdx = InputsQueue ? PopNextRecordedCall(*InputsQueue) : INDEX_NONE;
+		if (RecordedCallIdx != INDEX_NONE)
+		{
+			ReplayedMatchedCount++;
+		}
+		else
+		{
+			RecordedCallIdx = PopNextRecordedCall(CallQueue);
+			if (RecordedCallIdx != INDEX_NONE)
+			{
+				ReplayedInOrderCount++;
+			}
+			else
+			{
+				// All the recorded responses have been used (cook status polls...), repeat the last one
+				if (InputsQueue && InputsQueue->RecordedCalls.Num() > 0)
+					RecordedCallIdx = InputsQueue->RecordedCalls.Last();
+				else if (CallQueue.RecordedCalls.Num() > 0)
+					RecordedCallIdx = CallQueue.RecordedCalls.Last();
+
+				if (RecordedCallIdx != INDEX_NONE)
+					ReplayedRepeatedCount++;
+			}
+		}
+
+		if (RecordedCallIdx == INDEX_NONE)
+		{
+			ReplayMissingCount++;
+			return HAPI_RESULT_FAILURE;
+		}
+
+		FRecordedCall& RecordedCall = RecordedCalls[RecordedCallIdx];
+		RecordedCall.bReplayed = true;
+
+		for (int32 OutputIdx = RecordedCall.FirstOutput; OutputIdx < RecordedCall.FirstOutput + RecordedCall.OutputCount; OutputIdx++)
+		{
+			const FRecordedOutput& RecordedOutput = RecordedOutputs[OutputIdx];
+			if (RecordedOutput.Argument >= InArgumentCount)
+				continue;
+
+			const FArgument& Argument = InArguments[RecordedOutput.Argument];
+			if (Argument.Type != EArgumentType::Output || !Argument.Pointer)
+				continue;
+
+			// Never write past the caller's buffer if it is smaller than the recorded one
+			const int64 Size = FMath::Min<int64>(RecordedOutput.Size, GetByteCount(InCall, RecordedOutput.Argument, InArguments));
+			FMemory::Memcpy(const_cast<void*>(Argument.Pointer), RecordedData.GetData() + RecordedOutput.Offset, Size);
+		}
+
+		return (HAPI_Result)RecordedCall.Result;
+	}
+
+	struct FRecordHook
+	{
+		template<int32 Call, typename ReturnType, typename... ArgTypes>
+		static ReturnType
+		Invoke(ReturnType (*InOriginal)(ArgTypes...), ArgTypes... Args)
+		{
+			static_assert(TIsSame<ReturnType, HAPI_Result>::Value, "Only the calls returning a HAPI_Result can be recorded");
+
+			if (!bRecording)
+				return InOriginal(Args...);
+
+			// Capture the arguments before the call, the last element avoids an empty array
+			const FArgument Arguments[] = { MakeArgument(Args)..., FArgument() };
+			const ReturnType Result = InOriginal(Args...);
+			RecordCall(Call, Arguments, sizeof...(ArgTypes), Result);
+			return Result;
+		}
+	};
+
+	struct FReplayHook
+	{
+		template<int32 Call, typename ReturnType, typename... ArgTypes>
+		static ReturnType
+		Invoke(ReturnType (*InOriginal)(ArgTypes...), ArgTypes... Args)
+		{
+			static_assert(TIsSame<ReturnType, HAPI_Result>::Value, "Only the calls returning a HAPI_Result can be replayed");
+
+			if (!bReplaying)
+				return InOriginal(Args...);
+
+			const FArgument Arguments[] = { MakeArgument(Args)..., FArgument() };
+			return ReplayCall(Call, Arguments, sizeof...(ArgTypes));
+		}
+	};
+
+	static bool
+	LoadRecording(const FString& InFilePath)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InFilePath));
+		if (!Reader)
+		{
+			HOUDINI_LOG_WARNING(TEXT("HAPI Recording: could not open %s."), *InFilePath);
+			return false;
+		}
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		int32 NameCount = 0;
+		*Reader << Magic << Version << NameCount;
+		if (Magic != FileMagic || Version != FileVersion || NameCount < 0 || NameCount > MAX_uint16)
+		{
+			HOUDINI_LOG_WARNING(TEXT("HAPI Recording: %s is not a valid recording."), *InFilePath);
+			return false;
+		}
+
+		// The recorded calls are stored by index, map them to this build's calls by name
+		TArray<int32> CallIndices;
+		for (int32 NameIdx = 0; NameIdx < NameCount; NameIdx++)
+		{
+			FString Name;
+			*Reader << Name;
+			CallIndices.Add(HoudiniApiHooks::FindCall(Name));
+		}
+
+		while (!Reader->AtEnd() && !Reader->IsError())
+		{
+			uint16 Call = 0;
+			uint64 InputHash = 0;
+			int32 Result = 0;
+			uint8 OutputCount = 0;
+			*Reader << Call << InputHash << Result << OutputCount;
+
+			FRecordedCall RecordedCall;
+			RecordedCall.Call = CallIndices.IsValidIndex(Call) ? CallIndices[Call] : INDEX_NONE;
+			RecordedCall.InputHash = InputHash;
+			RecordedCall.Result = Result;
+			RecordedCall.FirstOutput = RecordedOutputs.Num();
+			RecordedCall.OutputCount = OutputCount;
+
+			for (int32 OutputIdx = 0; OutputIdx < OutputCount; OutputIdx++)
+			{
+				uint8 Argument = 0;
+				int32 Size = 0;
+				*Reader << Argument << Size;
+				if (Reader->IsError() || Size < 0)
+					break;
+
+				FRecordedOutput RecordedOutput;
+				RecordedOutput.Argument = Argument;
+				RecordedOutput.Size = Size;
+				RecordedOutput.Offset = RecordedData.Num();
+				RecordedOutputs.Add(RecordedOutput);
+
+				RecordedData.AddUninitialized(Size);
+				Reader->Serialize(RecordedData.GetData() + RecordedOutput.Offset, Size);
+			}
+
+			if (Reader->IsError())
+			{
+				HOUDINI_LOG_WARNING(TEXT("HAPI Recording: %s is truncated, replaying the first %d calls."), *InFilePath, RecordedCalls.Num());
+				RecordedOutputs.SetNum(RecordedCall.FirstOutput);
+				break;
+			}
+
+			// Calls unknown to this build can't be replayed
+			if (RecordedCall.Call == INDEX_NONE)
+				continue;
+
+			const int32 RecordedCallIdx = RecordedCalls.Add(RecordedCall);
+			ReplayQueuesByInputs.FindOrAdd(TPair<int32, uint64>(RecordedCall.Call, InputHash)).RecordedCalls.Add(RecordedCallIdx);
+			ReplayQueuesByCall[RecordedCall.Call].RecordedCalls.Add(RecordedCallIdx);
+		}
+
+		return true;
+	}
+
+	static void
+	ResetReplay()
+	{
+		RecordedCalls.Empty();
+		RecordedOutputs.Empty();
+		RecordedData.Empty();
+		ReplayQueuesByInputs.Empty();
+		for (FReplayQueue& Queue : ReplayQueuesByCall)
+		{
+			Queue.RecordedCalls.Empty();
+			Queue.Next = 0;
+		}
+
+		ReplayedMatchedCount = 0;
+		ReplayedInOrderCount = 0;
+		ReplayedRepeatedCount = 0;
+		ReplayMissingCount = 0;
+	}
+}
+
+bool
+FHoudiniApiRecording::StartRecording(const FString& InFilePath)
+{
+	using namespace HoudiniApiRecording;
+
+	if (bRecording || bReplaying)
+	{
+		HOUDINI_LOG_WARNING(TEXT("HAPI Recording: already recording or replaying HAPI calls."));
+		return false;
+	}
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	RecordingWriter.Reset(IFileManager::Get().CreateFileWriter(*InFilePath));
+	if (!RecordingWriter)
+	{
+		HOUDINI_LOG_WARNING(TEXT("HAPI Recording: could not create %s."), *InFilePath);
+		return false;
+	}
+
+	InitializeArrayArguments();
+
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	int32 NameCount = HoudiniApiHooks::CallCount;
+	*RecordingWriter << Magic << Version << NameCount;
+	for (int32 CallIdx = 0; CallIdx < HoudiniApiHooks::CallCount; CallIdx++)
+	{
+		FString Name = HoudiniApiHooks::GetCallName(CallIdx);
+		*RecordingWriter << Name;
+	}
+
+	RecordedCallCount = 0;
+	RecordedByteCount = 0;
+
+	HoudiniApiHooks::InstallAll<FRecordHook>();
+	bRecording = true;
+
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI Recording: recording the HAPI calls to %s."), *InFilePath);
+	return true;
+}
+
+void
+FHoudiniApiRecording::StopRecording()
+{
+	using namespace HoudiniApiRecording;
+
+	if (!bRecording)
+		return;
+
+	bRecording = false;
+	HoudiniApiHooks::UninstallAll<FRecordHook>();
+
+	LogStats();
+
+	FScopeLock ScopeLock(&CriticalSection);
+	RecordingWriter->Close();
+	RecordingWriter.Reset();
+}
+
+bool
+FHoudiniApiRecording::StartReplay(const FString& InFilePath)
+{
+	using namespace HoudiniApiRecording;
+
+	if (bRecording || bReplaying)
+	{
+		HOUDINI_LOG_WARNING(TEXT("HAPI Recording: already recording or replaying HAPI calls."));
+		return false;
+	}
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	InitializeArrayArguments();
+
+	ResetReplay();
+	if (!LoadRecording(InFilePath))
+	{
+		ResetReplay();
+		return false;
+	}
+
+	HoudiniApiHooks::InstallAll<FReplayHook>();
+	bReplaying = true;
+
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI Recording: replaying %d HAPI calls (%lld bytes of outputs) from %s."),
+		RecordedCalls.Num(), RecordedData.Num(), *InFilePath);
+	return true;
+}
+
+void
+FHoudiniApiRecording::StopReplay()
+{
+	using namespace HoudiniApiRecording;
+
+	if (!bReplaying)
+		return;
+
+	bReplaying = false;
+	HoudiniApiHooks::UninstallAll<FReplayHook>();
+
+	LogStats();
+
+	FScopeLock ScopeLock(&CriticalSection);
+	ResetReplay();
+}
+
+bool
+FHoudiniApiRecording::IsRecording()
+{
+	return HoudiniApiRecording::bRecording;
+}
+
+bool
+FHoudiniApiRecording::IsReplaying()
+{
+	return HoudiniApiRecording::bReplaying;
+}
+
+FString
+FHoudiniApiRecording::GetDefaultFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HoudiniEngine"), TEXT("ApiRecording.hapirec"));
+}
+
+void
+FHoudiniApiRecording::LogStats()
+{
+	using namespace HoudiniApiRecording;
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	if (RecordingWriter)
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("HAPI Recording: %lld calls recorded, %lld bytes of outputs."),
+			RecordedCallCount, RecordedByteCount);
+	}
+
+	if (RecordedCalls.Num() > 0)
+	{
+		int32 UnusedCount = 0;
+		for (const FRecordedCall& RecordedCall : RecordedCalls)
+		{
+			if (!RecordedCall.bReplayed)
+				UnusedCount++;
+		}
+
+		HOUDINI_LOG_MESSAGE(
+			TEXT("HAPI Recording: %lld calls matched by inputs, %lld in order, %lld repeated, %lld missing from the recording, %d recorded calls not replayed."),
+			ReplayedMatchedCount, ReplayedInOrderCount, ReplayedRepeatedCount, ReplayMissingCount, UnusedCount);
+	}
+}
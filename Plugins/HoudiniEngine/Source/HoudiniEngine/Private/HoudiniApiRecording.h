@@ -0,0 +1,63 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Records the HAPI calls of a session to a binary file, and replays them without Houdini.
+//
+// While recording, every HAPI call is forwarded to libHAPI, and its result and the content of its output buffers
+// are appended to the file, along with a hash of its inputs.
+// While replaying, libHAPI isn't loaded: the HAPI calls are answered with the recorded responses,
+// matched by call and input hash, or in recording order for that call when the inputs differ (paths, uninitialized padding...).
+// Calls that outnumber their recording (cook status polling) get the last recorded response again.
+// This allows the translators to be run and profiled deterministically on machines without a Houdini install.
+struct HOUDINIENGINE_API FHoudiniApiRecording
+{
+public:
+
+	// Starts recording the HAPI calls to a file
+	static bool StartRecording(const FString& InFilePath);
+
+	// Stops recording and closes the file
+	static void StopRecording();
+
+	// Loads a recording and answers all the HAPI calls with it
+	static bool StartReplay(const FString& InFilePath);
+
+	// Stops answering the HAPI calls with the recording
+	static void StopReplay();
+
+	static bool IsRecording();
+	static bool IsReplaying();
+
+	// Returns Saved/HoudiniEngine/ApiRecording.hapirec
+	static FString GetDefaultFilePath();
+
+	// Logs the number of calls recorded, or how the replayed calls were matched
+	static void LogStats();
+};
@@ -0,0 +1,1130 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniApiSynthetic.h"
+
+#include "HoudiniApiHooks.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniAssetActor.h"
+#include "HoudiniAssetComponent.h"
+#include "HoudiniOutput.h"
+#include "HoudiniPackageParams.h"
+#include "HoudiniOutputTranslator.h"
+#include "HoudiniMeshTranslator.h"
+#include "HoudiniInstanceTranslator.h"
+#include "HoudiniLandscapeTranslator.h"
+
+#include "Containers/ArrayView.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTLS.h"
+
+FHoudiniSyntheticSceneSizes::FHoudiniSyntheticSceneSizes()
+	: MeshPartCount(1)
+	, TrianglesPerPart(1000000)
+	, InstanceCount(100000)
+	, HeightfieldSize(1024)
+{
+}
+
+namespace HoudiniApiSynthetic
+{
+	// String handles of the synthetic scene
+	enum EStringHandle : HAPI_StringHandle
+	{
+		String_Empty,
+		String_Asset,
+		String_MeshObject,
+		String_InstancerObject,
+		String_HeightfieldObject,
+		String_Position,
+		String_Normal,
+		String_UV,
+		String_InstanceOverride,
+		String_InstancedMesh,
+		String_Height,
+		String_LodGroup,
+		StringCount
+	};
+
+	static const char* const Strings[StringCount] =
+	{
+		"",
+		"synthetic_asset",
+		"mesh",
+		"instancer",
+		"heightfield",
+		HAPI_UNREAL_ATTRIB_POSITION,
+		HAPI_UNREAL_ATTRIB_NORMAL,
+		HAPI_UNREAL_ATTRIB_UV,
+		HAPI_UNREAL_ATTRIB_INSTANCE_OVERRIDE,
+		"/Engine/BasicShapes/Cube.Cube",
+		"height",
+		"lod0"
+	};
+
+	// Node ids of the synthetic scene: an OBJ asset with one object per output type, and their display SOPs
+	enum ENodeId : HAPI_NodeId
+	{
+		Node_Asset = 1,
+		Node_MeshObject,
+		Node_InstancerObject,
+		Node_HeightfieldObject,
+		Node_MeshGeo,
+		Node_InstancerGeo,
+		Node_HeightfieldGeo
+	};
+
+	static const int32 ObjectCount = 3;
+	static const HAPI_NodeId GeoToObjectOffset = Node_MeshGeo - Node_MeshObject;
+
+	struct FAttribute
+	{
+		EStringHandle Name;
+		HAPI_AttributeOwner Owner;
+		HAPI_StorageType Storage;
+		int32 TupleSize;
+	};
+
+	static const FAttribute MeshAttributes[] =
+	{
+		{ String_Position, HAPI_ATTROWNER_POINT, HAPI_STORAGETYPE_FLOAT, 3 },
+		{ String_Normal, HAPI_ATTROWNER_POINT, HAPI_STORAGETYPE_FLOAT, 3 },
+		{ String_UV, HAPI_ATTROWNER_VERTEX, HAPI_STORAGETYPE_FLOAT, 3 }
+	};
+
+	static const FAttribute InstancerAttributes[] =
+	{
+		{ String_Position, HAPI_ATTROWNER_POINT, HAPI_STORAGETYPE_FLOAT, 3 },
+		{ String_InstanceOverride, HAPI_ATTROWNER_DETAIL, HAPI_STORAGETYPE_STRING, 1 }
+	};
+
+	static const FAttribute HeightfieldAttributes[] =
+	{
+		{ String_Position, HAPI_ATTROWNER_POINT, HAPI_STORAGETYPE_FLOAT, 3 }
+	};
+
+	// Distance between the grid points and the instances, in Houdini units
+	static const float GridSpacing = 0.1f;
+	static const float InstanceSpacing = 2.0f;
+
+	static bool bActive = false;
+	static uint32 SyntheticThreadId = 0;
+	static FHoudiniSyntheticSceneSizes Sizes;
+
+	// Quads per row and rows of the grid of each mesh part
+	static int32 GridColumns = 1;
+	static int32 GridRows = 1;
+
+	// Strings requested by the last GetStringBatchSize
+	static thread_local TArray<HAPI_StringHandle> StringBatch;
+
+	static bool
+	IsObject(const HAPI_NodeId& InNodeId)
+	{
+		return InNodeId >= Node_MeshObject && InNodeId <= Node_HeightfieldObject;
+	}
+
+	static bool
+	IsGeo(const HAPI_NodeId& InNodeId)
+	{
+		return InNodeId >= Node_MeshGeo && InNodeId <= Node_HeightfieldGeo;
+	}
+
+	static int32
+	GetPartCount(const HAPI_NodeId& InGeoId)
+	{
+		switch (InGeoId)
+		{
+			case Node_MeshGeo: return Sizes.TrianglesPerPart > 0 ? Sizes.MeshPartCount : 0;
+			case Node_InstancerGeo: return Sizes.InstanceCount > 0 ? 1 : 0;
+			case Node_HeightfieldGeo: return Sizes.HeightfieldSize > 0 ? 1 : 0;
+			default: return 0;
+		}
+	}
+
+	static bool
+	FillPartInfo(const HAPI_NodeId& InGeoId, const HAPI_PartId& InPartId, HAPI_PartInfo& OutPartInfo)
+	{
+		if (InPartId < 0 || InPartId >= GetPartCount(InGeoId))
+			return false;
+
+		FMemory::Memzero(OutPartInfo);
+		OutPartInfo.id = InPartId;
+		OutPartInfo.hasChanged = 1;
+		switch (InGeoId)
+		{
+			case Node_MeshGeo:
+				OutPartInfo.nameSH = String_MeshObject;
+				OutPartInfo.type = HAPI_PARTTYPE_MESH;
+				OutPartInfo.faceCount = GridColumns * GridRows * 2;
+				OutPartInfo.vertexCount = OutPartInfo.faceCount * 3;
+				OutPartInfo.pointCount = (GridColumns + 1) * (GridRows + 1);
+				OutPartInfo.attributeCounts[HAPI_ATTROWNER_POINT] = 2;
+				OutPartInfo.attributeCounts[HAPI_ATTROWNER_VERTEX] = 1;
+				break;
+
+			case Node_InstancerGeo:
+				// Point cloud instancing a mesh via unreal_instance
+				OutPartInfo.nameSH = String_InstancerObject;
+				OutPartInfo.type = HAPI_PARTTYPE_MESH;
+				OutPartInfo.pointCount = Sizes.InstanceCount;
+				OutPartInfo.attributeCounts[HAPI_ATTROWNER_POINT] = 1;
+				OutPartInfo.attributeCounts[HAPI_ATTROWNER_DETAIL] = 1;
+				break;
+
+			case Node_HeightfieldGeo:
+				// Volumes are a single primitive
+				OutPartInfo.nameSH = String_Height;
+				OutPartInfo.type = HAPI_PARTTYPE_VOLUME;
+				OutPartInfo.faceCount = 1;
+				OutPartInfo.vertexCount = 1;
+				OutPartInfo.pointCount = 1;
+				OutPartInfo.attributeCounts[HAPI_ATTROWNER_POINT] = 1;
+				break;
+
+			default:
+				return false;
+		}
+
+		return true;
+	}
+
+	static TArrayView<const FAttribute>
+	GetAttributes(const HAPI_NodeId& InGeoId)
+	{
+		switch (InGeoId)
+		{
+			case Node_MeshGeo: return MakeArrayView(MeshAttributes);
+			case Node_InstancerGeo: return MakeArrayView(InstancerAttributes);
+			case Node_HeightfieldGeo: return MakeArrayView(HeightfieldAttributes);
+			default: return TArrayView<const FAttribute>();
+		}
+	}
+
+	static const FAttribute*
+	FindAttribute(const HAPI_NodeId& InGeoId, const char* InName, const HAPI_AttributeOwner& InOwner)
+	{
+		if (!InName)
+			return nullptr;
+
+		for (const FAttribute& Attribute : GetAttributes(InGeoId))
+		{
+			if (Attribute.Owner == InOwner && FCStringAnsi::Strcmp(Strings[Attribute.Name], InName) == 0)
+				return &Attribute;
+		}
+
+		return nullptr;
+	}
+
+	static int32
+	GetElementCount(const HAPI_PartInfo& InPartInfo, const HAPI_AttributeOwner& InOwner)
+	{
+		switch (InOwner)
+		{
+			case HAPI_ATTROWNER_POINT: return InPartInfo.pointCount;
+			case HAPI_ATTROWNER_VERTEX: return InPartInfo.vertexCount;
+			case HAPI_ATTROWNER_PRIM: return InPartInfo.faceCount;
+			case HAPI_ATTROWNER_DETAIL: return 1;
+			default: return 0;
+		}
+	}
+
+	// Point of a vertex of the grid, each quad is split in two triangles
+	static int32
+	GetGridVertexPoint(const int32& InVertexIndex)
+	{
+		const int32 FaceIndex = InVertexIndex / 3;
+		const int32 QuadIndex = FaceIndex / 2;
+		const int32 Point00 = (QuadIndex / GridColumns) * (GridColumns + 1) + (QuadIndex % GridColumns);
+		const int32 Point10 = Point00 + GridColumns + 1;
+
+		static const int32 Corners[2][3] = { { 0, 2, 3 }, { 0, 3, 1 } };
+		switch (Corners[FaceIndex % 2][InVertexIndex % 3])
+		{
+			case 0: return Point00;
+			case 1: return Point00 + 1;
+			case 2: return Point10;
+			default: return Point10 + 1;
+		}
+	}
+
+	static void
+	GetGridPoint(const HAPI_PartId& InPartId, const int32& InPointIndex, float* OutPosition, float* OutUV)
+	{
+		const int32 Column = InPointIndex % (GridColumns + 1);
+		const int32 Row = InPointIndex / (GridColumns + 1);
+
+		// Parts are laid side by side
+		const float PartOffset = InPartId * (GridColumns + 1) * GridSpacing;
+		OutPosition[0] = PartOffset + Column * GridSpacing;
+		OutPosition[1] = FMath::Sin(Column * 0.05f) * FMath::Cos(Row * 0.05f);
+		OutPosition[2] = Row * GridSpacing;
+
+		OutUV[0] = (float)Column / GridColumns;
+		OutUV[1] = (float)Row / GridRows;
+		OutUV[2] = 0.0f;
+	}
+
+	static void
+	GetInstancePosition(const int32& InInstanceIndex, float* OutPosition)
+	{
+		const int32 InstancesPerRow = FMath::Max(FMath::CeilToInt(FMath::Sqrt((float)Sizes.InstanceCount)), 1);
+		OutPosition[0] = (InInstanceIndex % InstancesPerRow) * InstanceSpacing;
+		OutPosition[1] = 0.0f;
+		OutPosition[2] = (InInstanceIndex / InstancesPerRow) * InstanceSpacing;
+	}
+
+	static void
+	GetFloatAttributeValue(
+		const HAPI_NodeId& InGeoId, const HAPI_PartId& InPartId, const FAttribute& InAttribute,
+		const int32& InIndex, float* OutValue)
+	{
+		float Position[3] = { 0.0f, 0.0f, 0.0f };
+		float UV[3] = { 0.0f, 0.0f, 0.0f };
+		if (InGeoId == Node_MeshGeo)
+		{
+			const int32 PointIndex = InAttribute.Owner == HAPI_ATTROWNER_VERTEX ? GetGridVertexPoint(InIndex) : InIndex;
+			GetGridPoint(InPartId, PointIndex, Position, UV);
+		}
+		else if (InGeoId == Node_InstancerGeo)
+		{
+			GetInstancePosition(InIndex, Position);
+		}
+
+		switch (InAttribute.Name)
+		{
+			case String_Position:
+				FMemory::Memcpy(OutValue, Position, sizeof(Position));
+				break;
+
+			case String_Normal:
+				OutValue[0] = 0.0f;
+				OutValue[1] = 1.0f;
+				OutValue[2] = 0.0f;
+				break;
+
+			case String_UV:
+				FMemory::Memcpy(OutValue, UV, sizeof(UV));
+				break;
+
+			default:
+				FMemory::Memzero(OutValue, InAttribute.TupleSize * sizeof(float));
+				break;
+		}
+	}
+
+	static void
+	FillNodeName(const HAPI_NodeId& InNodeId, HAPI_StringHandle& OutNameSH)
+	{
+		if (InNodeId == Node_Asset)
+			OutNameSH = String_Asset;
+		else if (IsObject(InNodeId))
+			OutNameSH = String_MeshObject + (InNodeId - Node_MeshObject);
+		else if (IsGeo(InNodeId))
+			OutNameSH = String_MeshObject + (InNodeId - Node_MeshGeo);
+		else
+			OutNameSH = String_Empty;
+	}
+
+	static void
+	FillObjectInfo(const HAPI_NodeId& InObjectId, HAPI_ObjectInfo& OutObjectInfo)
+	{
+		FMemory::Memzero(OutObjectInfo);
+		FillNodeName(InObjectId, OutObjectInfo.nameSH);
+		OutObjectInfo.hasTransformChanged = 1;
+		OutObjectInfo.haveGeosChanged = 1;
+		OutObjectInfo.isVisible = 1;
+		OutObjectInfo.geoCount = 1;
+		OutObjectInfo.nodeId = InObjectId;
+		OutObjectInfo.objectToInstanceId = -1;
+	}
+
+	static void
+	FillGeoInfo(const HAPI_NodeId& InGeoId, HAPI_GeoInfo& OutGeoInfo)
+	{
+		FMemory::Memzero(OutGeoInfo);
+		OutGeoInfo.type = HAPI_GEOTYPE_DEFAULT;
+		FillNodeName(InGeoId, OutGeoInfo.nameSH);
+		OutGeoInfo.nodeId = InGeoId;
+		OutGeoInfo.isDisplayGeo = 1;
+		OutGeoInfo.hasGeoChanged = 1;
+		OutGeoInfo.hasMaterialChanged = 1;
+		OutGeoInfo.partCount = GetPartCount(InGeoId);
+
+		// The mesh faces all belong to a single LOD group, so that the split groups are processed
+		OutGeoInfo.primitiveGroupCount = InGeoId == Node_MeshGeo ? 1 : 0;
+	}
+
+	static void
+	FillIdentityTransform(HAPI_Transform& OutTransform, const HAPI_RSTOrder& InRSTOrder)
+	{
+		FMemory::Memzero(OutTransform);
+		OutTransform.rotationQuaternion[3] = 1.0f;
+		OutTransform.scale[0] = 1.0f;
+		OutTransform.scale[1] = 1.0f;
+		OutTransform.scale[2] = 1.0f;
+		OutTransform.rstOrder = InRSTOrder;
+	}
+
+	//
+	// Synthetic implementations of the HAPI calls, with the exact HAPI signatures
+	//
+
+	static HAPI_Result
+	GetAssetInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_AssetInfo* OutAssetInfo)
+	{
+		if (InNodeId != Node_Asset || !OutAssetInfo)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FMemory::Memzero(*OutAssetInfo);
+		OutAssetInfo->nodeId = Node_Asset;
+		OutAssetInfo->objectNodeId = Node_Asset;
+		OutAssetInfo->hasEverCooked = 1;
+		OutAssetInfo->nameSH = String_Asset;
+		OutAssetInfo->labelSH = String_Asset;
+		OutAssetInfo->fullOpNameSH = String_Asset;
+		OutAssetInfo->objectCount = ObjectCount;
+		OutAssetInfo->geoOutputCount = 1;
+		OutAssetInfo->haveObjectsChanged = 1;
+		OutAssetInfo->haveMaterialsChanged = 1;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetNodeInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_NodeInfo* OutNodeInfo)
+	{
+		if (!OutNodeInfo || (InNodeId != Node_Asset && !IsObject(InNodeId) && !IsGeo(InNodeId)))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FMemory::Memzero(*OutNodeInfo);
+		OutNodeInfo->id = InNodeId;
+		FillNodeName(InNodeId, OutNodeInfo->nameSH);
+		OutNodeInfo->isValid = 1;
+		OutNodeInfo->totalCookCount = 1;
+		OutNodeInfo->uniqueHoudiniNodeId = InNodeId;
+		if (InNodeId == Node_Asset)
+		{
+			OutNodeInfo->parentId = -1;
+			OutNodeInfo->type = HAPI_NODETYPE_OBJ;
+			OutNodeInfo->childNodeCount = ObjectCount;
+		}
+		else if (IsObject(InNodeId))
+		{
+			OutNodeInfo->parentId = Node_Asset;
+			OutNodeInfo->type = HAPI_NODETYPE_OBJ;
+			OutNodeInfo->childNodeCount = 1;
+		}
+		else
+		{
+			OutNodeInfo->parentId = InNodeId - GeoToObjectOffset;
+			OutNodeInfo->type = HAPI_NODETYPE_SOP;
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	IsNodeValid(const HAPI_Session* InSession, HAPI_NodeId InNodeId, int InUniqueNodeId, HAPI_Bool* OutAnswer)
+	{
+		if (!OutAnswer)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		*OutAnswer = (InNodeId == Node_Asset || IsObject(InNodeId) || IsGeo(InNodeId)) ? 1 : 0;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetNodePath(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_NodeId InRelativeToNodeId, HAPI_StringHandle* OutPath)
+	{
+		if (!OutPath)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FillNodeName(InNodeId, *OutPath);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetObjectInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_ObjectInfo* OutObjectInfo)
+	{
+		if (!IsObject(InNodeId) || !OutObjectInfo)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FillObjectInfo(InNodeId, *OutObjectInfo);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	ComposeObjectList(const HAPI_Session* InSession, HAPI_NodeId InParentNodeId, const char* InCategories, int* OutObjectCount)
+	{
+		if (!OutObjectCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		*OutObjectCount = InParentNodeId == Node_Asset ? ObjectCount : 0;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetComposedObjectList(const HAPI_Session* InSession, HAPI_NodeId InParentNodeId, HAPI_ObjectInfo* OutObjectInfos, int InStart, int InLength)
+	{
+		if (InParentNodeId != Node_Asset || !OutObjectInfos || InStart < 0 || InStart + InLength > ObjectCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+			FillObjectInfo(Node_MeshObject + InStart + Idx, OutObjectInfos[Idx]);
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetComposedObjectTransforms(const HAPI_Session* InSession, HAPI_NodeId InParentNodeId, HAPI_RSTOrder InRSTOrder, HAPI_Transform* OutTransforms, int InStart, int InLength)
+	{
+		if (InParentNodeId != Node_Asset || !OutTransforms || InStart < 0 || InStart + InLength > ObjectCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+			FillIdentityTransform(OutTransforms[Idx], InRSTOrder);
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetDisplayGeoInfo(const HAPI_Session* InSession, HAPI_NodeId InObjectNodeId, HAPI_GeoInfo* OutGeoInfo)
+	{
+		if (!IsObject(InObjectNodeId) || !OutGeoInfo)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FillGeoInfo(InObjectNodeId + GeoToObjectOffset, *OutGeoInfo);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetGeoInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_GeoInfo* OutGeoInfo)
+	{
+		if (!IsGeo(InNodeId) || !OutGeoInfo)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FillGeoInfo(InNodeId, *OutGeoInfo);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	ComposeChildNodeList(const HAPI_Session* InSession, HAPI_NodeId InParentNodeId, HAPI_NodeTypeBits InNodeTypeFilter, HAPI_NodeFlagsBits InNodeFlagsFilter, HAPI_Bool bInRecursive, int* OutCount)
+	{
+		// No editable or templated nodes
+		if (!OutCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		*OutCount = 0;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetPartInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, HAPI_PartInfo* OutPartInfo)
+	{
+		if (!OutPartInfo || !FillPartInfo(InNodeId, InPartId, *OutPartInfo))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetAttributeInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, const char* InName, HAPI_AttributeOwner InOwner, HAPI_AttributeInfo* OutAttributeInfo)
+	{
+		HAPI_PartInfo PartInfo;
+		if (!OutAttributeInfo || !FillPartInfo(InNodeId, InPartId, PartInfo))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FMemory::Memzero(*OutAttributeInfo);
+		OutAttributeInfo->owner = InOwner;
+		OutAttributeInfo->originalOwner = InOwner;
+		OutAttributeInfo->storage = HAPI_STORAGETYPE_INVALID;
+
+		const FAttribute* Attribute = FindAttribute(InNodeId, InName, InOwner);
+		if (Attribute)
+		{
+			OutAttributeInfo->exists = 1;
+			OutAttributeInfo->storage = Attribute->Storage;
+			OutAttributeInfo->count = GetElementCount(PartInfo, InOwner);
+			OutAttributeInfo->tupleSize = Attribute->TupleSize;
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetAttributeNames(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, HAPI_AttributeOwner InOwner, HAPI_StringHandle* OutNames, int InCount)
+	{
+		if (!OutNames)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		int32 NameIdx = 0;
+		for (const FAttribute& Attribute : GetAttributes(InNodeId))
+		{
+			if (Attribute.Owner == InOwner && NameIdx < InCount)
+				OutNames[NameIdx++] = Attribute.Name;
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetAttributeFloatData(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, const char* InName, HAPI_AttributeInfo* InAttributeInfo, int InStride, float* OutData, int InStart, int InLength)
+	{
+		HAPI_PartInfo PartInfo;
+		if (!InAttributeInfo || !OutData || !FillPartInfo(InNodeId, InPartId, PartInfo))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		const FAttribute* Attribute = FindAttribute(InNodeId, InName, InAttributeInfo->owner);
+		if (!Attribute || Attribute->Storage != HAPI_STORAGETYPE_FLOAT)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		if (InStart < 0 || InStart + InLength > GetElementCount(PartInfo, Attribute->Owner))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		// The caller may ask for less components than the attribute has
+		const int32 TupleSize = FMath::Clamp(InAttributeInfo->tupleSize, 1, Attribute->TupleSize);
+		const int32 Stride = InStride > 0 ? InStride : TupleSize;
+		float Value[4];
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+		{
+			GetFloatAttributeValue(InNodeId, InPartId, *Attribute, InStart + Idx, Value);
+			FMemory::Memcpy(OutData + (int64)Idx * Stride, Value, TupleSize * sizeof(float));
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetAttributeStringData(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, const char* InName, HAPI_AttributeInfo* InAttributeInfo, HAPI_StringHandle* OutData, int InStart, int InLength)
+	{
+		HAPI_PartInfo PartInfo;
+		if (!InAttributeInfo || !OutData || !FillPartInfo(InNodeId, InPartId, PartInfo))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		const FAttribute* Attribute = FindAttribute(InNodeId, InName, InAttributeInfo->owner);
+		if (!Attribute || Attribute->Storage != HAPI_STORAGETYPE_STRING)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		if (InStart < 0 || InStart + InLength > GetElementCount(PartInfo, Attribute->Owner))
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		// unreal_instance is the only string attribute
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+			OutData[Idx] = String_InstancedMesh;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetVertexList(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, int* OutVertexList, int InStart, int InLength)
+	{
+		HAPI_PartInfo PartInfo;
+		if (!OutVertexList || !FillPartInfo(InNodeId, InPartId, PartInfo) || InStart < 0 || InStart + InLength > PartInfo.vertexCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+			OutVertexList[Idx] = InNodeId == Node_MeshGeo ? GetGridVertexPoint(InStart + Idx) : 0;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetFaceCounts(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, int* OutFaceCounts, int InStart, int InLength)
+	{
+		HAPI_PartInfo PartInfo;
+		if (!OutFaceCounts || !FillPartInfo(InNodeId, InPartId, PartInfo) || InStart < 0 || InStart + InLength > PartInfo.faceCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+			OutFaceCounts[Idx] = InNodeId == Node_MeshGeo ? 3 : 1;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetGroupNames(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_GroupType InGroupType, HAPI_StringHandle* OutGroupNames, int InGroupCount)
+	{
+		HAPI_GeoInfo GeoInfo;
+		FillGeoInfo(InNodeId, GeoInfo);
+		const int32 GroupCount = InGroupType == HAPI_GROUPTYPE_PRIM ? GeoInfo.primitiveGroupCount : GeoInfo.pointGroupCount;
+		if (!OutGroupNames || InGroupCount != GroupCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		for (int32 Idx = 0; Idx < InGroupCount; Idx++)
+			OutGroupNames[Idx] = String_LodGroup;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetGroupMembership(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, HAPI_GroupType InGroupType, const char* InGroupName, HAPI_Bool* OutAllEqual, int* OutMembership, int InStart, int InLength)
+	{
+		HAPI_PartInfo PartInfo;
+		if (InNodeId != Node_MeshGeo || InGroupType != HAPI_GROUPTYPE_PRIM || !InGroupName || !OutMembership
+			|| !FillPartInfo(InNodeId, InPartId, PartInfo) || InStart < 0 || InStart + InLength > PartInfo.faceCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		const int32 Membership = FCStringAnsi::Strcmp(InGroupName, Strings[String_LodGroup]) == 0 ? 1 : 0;
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+			OutMembership[Idx] = Membership;
+
+		if (OutAllEqual)
+			*OutAllEqual = 1;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetMaterialNodeIdsOnFaces(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, HAPI_Bool* OutAreAllTheSame, HAPI_NodeId* OutMaterialIds, int InStart, int InLength)
+	{
+		// No materials assigned
+		if (OutAreAllTheSame)
+			*OutAreAllTheSame = 1;
+
+		for (int32 Idx = 0; OutMaterialIds && Idx < InLength; Idx++)
+			OutMaterialIds[Idx] = -1;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetInstanceTransformsOnPart(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, HAPI_RSTOrder InRSTOrder, HAPI_Transform* OutTransforms, int InStart, int InLength)
+	{
+		if (InNodeId != Node_InstancerGeo || !OutTransforms || InStart < 0 || InStart + InLength > Sizes.InstanceCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+		{
+			HAPI_Transform& Transform = OutTransforms[Idx];
+			FillIdentityTransform(Transform, InRSTOrder);
+			GetInstancePosition(InStart + Idx, Transform.position);
+
+			// Vary the rotation around Y and the scale
+			const float Angle = (InStart + Idx) * 0.1f;
+			Transform.rotationQuaternion[1] = FMath::Sin(Angle * 0.5f);
+			Transform.rotationQuaternion[3] = FMath::Cos(Angle * 0.5f);
+			const float Scale = 0.5f + 0.05f * ((InStart + Idx) % 10);
+			Transform.scale[0] = Scale;
+			Transform.scale[1] = Scale;
+			Transform.scale[2] = Scale;
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetVolumeInfo(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, HAPI_VolumeInfo* OutVolumeInfo)
+	{
+		if (InNodeId != Node_HeightfieldGeo || InPartId != 0 || !OutVolumeInfo || Sizes.HeightfieldSize <= 0)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FMemory::Memzero(*OutVolumeInfo);
+		OutVolumeInfo->nameSH = String_Height;
+		OutVolumeInfo->type = HAPI_VOLUMETYPE_HOUDINI;
+		OutVolumeInfo->xLength = Sizes.HeightfieldSize;
+		OutVolumeInfo->yLength = Sizes.HeightfieldSize;
+		OutVolumeInfo->zLength = 1;
+		OutVolumeInfo->tupleSize = 1;
+		OutVolumeInfo->storage = HAPI_STORAGETYPE_FLOAT;
+		OutVolumeInfo->tileSize = 8;
+
+		// One unit per voxel, centered on the origin
+		FillIdentityTransform(OutVolumeInfo->transform, HAPI_SRT);
+		OutVolumeInfo->transform.scale[0] = Sizes.HeightfieldSize * 0.5f;
+		OutVolumeInfo->transform.scale[1] = Sizes.HeightfieldSize * 0.5f;
+		OutVolumeInfo->transform.scale[2] = 0.5f;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetVolumeBounds(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, float* OutXMin, float* OutYMin, float* OutZMin, float* OutXMax, float* OutYMax, float* OutZMax, float* OutXCenter, float* OutYCenter, float* OutZCenter)
+	{
+		if (InNodeId != Node_HeightfieldGeo || InPartId != 0)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		const float HalfSize = Sizes.HeightfieldSize * 0.5f;
+		float* const Values[9] = { OutXMin, OutYMin, OutZMin, OutXMax, OutYMax, OutZMax, OutXCenter, OutYCenter, OutZCenter };
+		const float Bounds[9] = { -HalfSize, -HalfSize, -0.5f, HalfSize, HalfSize, 0.5f, 0.0f, 0.0f, 0.0f };
+		for (int32 Idx = 0; Idx < 9; Idx++)
+		{
+			if (Values[Idx])
+				*Values[Idx] = Bounds[Idx];
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetHeightFieldData(const HAPI_Session* InSession, HAPI_NodeId InNodeId, HAPI_PartId InPartId, float* OutValues, int InStart, int InLength)
+	{
+		const int64 SampleCount = (int64)Sizes.HeightfieldSize * Sizes.HeightfieldSize;
+		if (InNodeId != Node_HeightfieldGeo || InPartId != 0 || !OutValues || InStart < 0 || InStart + (int64)InLength > SampleCount)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		// Rolling hills, up to 50 units high
+		for (int32 Idx = 0; Idx < InLength; Idx++)
+		{
+			const int32 X = (InStart + Idx) % Sizes.HeightfieldSize;
+			const int32 Y = (InStart + Idx) / Sizes.HeightfieldSize;
+			OutValues[Idx] = 25.0f + 25.0f * FMath::Sin(X * 0.01f) * FMath::Cos(Y * 0.013f);
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetStringBufLength(const HAPI_Session* InSession, HAPI_StringHandle InStringHandle, int* OutBufferLength)
+	{
+		if (InStringHandle < 0 || InStringHandle >= StringCount || !OutBufferLength)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		*OutBufferLength = FCStringAnsi::Strlen(Strings[InStringHandle]) + 1;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetString(const HAPI_Session* InSession, HAPI_StringHandle InStringHandle, char* OutString, int InLength)
+	{
+		if (InStringHandle < 0 || InStringHandle >= StringCount || !OutString || InLength <= 0)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		FCStringAnsi::Strncpy(OutString, Strings[InStringHandle], InLength);
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetStringBatchSize(const HAPI_Session* InSession, const int* InStringHandles, int InStringHandleCount, int* OutStringBufferSize)
+	{
+		if (!InStringHandles || !OutStringBufferSize)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		StringBatch.SetNumUninitialized(InStringHandleCount);
+		int32 BufferSize = 0;
+		for (int32 Idx = 0; Idx < InStringHandleCount; Idx++)
+		{
+			const HAPI_StringHandle StringHandle = InStringHandles[Idx] >= 0 && InStringHandles[Idx] < StringCount ? InStringHandles[Idx] : String_Empty;
+			StringBatch[Idx] = StringHandle;
+			BufferSize += FCStringAnsi::Strlen(Strings[StringHandle]) + 1;
+		}
+
+		*OutStringBufferSize = BufferSize;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetStringBatch(const HAPI_Session* InSession, char* OutBuffer, int InBufferLength)
+	{
+		if (!OutBuffer)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		// The strings are written one after the other, with their null terminator
+		int32 Offset = 0;
+		for (const HAPI_StringHandle& StringHandle : StringBatch)
+		{
+			const int32 Length = FCStringAnsi::Strlen(Strings[StringHandle]) + 1;
+			if (Offset + Length > InBufferLength)
+				return HAPI_RESULT_INVALID_ARGUMENT;
+
+			FMemory::Memcpy(OutBuffer + Offset, Strings[StringHandle], Length);
+			Offset += Length;
+		}
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetStatus(const HAPI_Session* InSession, HAPI_StatusType InStatusType, int* OutStatus)
+	{
+		if (!OutStatus)
+			return HAPI_RESULT_INVALID_ARGUMENT;
+
+		*OutStatus = InStatusType == HAPI_STATUS_COOK_STATE ? HAPI_STATE_READY : HAPI_RESULT_SUCCESS;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	static HAPI_Result
+	GetParmIdFromName(const HAPI_Session* InSession, HAPI_NodeId InNodeId, const char* InParmName, HAPI_ParmId* OutParmId)
+	{
+		// The synthetic nodes have no parameters
+		if (OutParmId)
+			*OutParmId = -1;
+
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	// Calls without a synthetic implementation fail, as their outputs are left unwritten
+	template<int32 Call>
+	struct TSyntheticCall
+	{
+		template<typename... ArgTypes>
+		static HAPI_Result
+		Invoke(ArgTypes... Args)
+		{
+			return HAPI_RESULT_FAILURE;
+		}
+	};
+
+	// The signature check ensures a mistyped implementation can't silently fall back to the default
+#define HOUDINI_API_SYNTHETIC_CALL(Name) \
+	static_assert(TIsSame<decltype(&Name), FHoudiniApi::Name##FuncPtr>::Value, "The synthetic " #Name " doesn't match the HAPI signature."); \
+	template<> \
+	struct TSyntheticCall<HoudiniApiHooks::Name> \
+	{ \
+		template<typename... ArgTypes> \
+		static HAPI_Result \
+		Invoke(ArgTypes... Args) \
+		{ \
+			return Name(Args...); \
+		} \
+	};
+
+	HOUDINI_API_SYNTHETIC_CALL(GetAssetInfo)
+	HOUDINI_API_SYNTHETIC_CALL(GetNodeInfo)
+	HOUDINI_API_SYNTHETIC_CALL(IsNodeValid)
+	HOUDINI_API_SYNTHETIC_CALL(GetNodePath)
+	HOUDINI_API_SYNTHETIC_CALL(GetObjectInfo)
+	HOUDINI_API_SYNTHETIC_CALL(ComposeObjectList)
+	HOUDINI_API_SYNTHETIC_CALL(GetComposedObjectList)
+	HOUDINI_API_SYNTHETIC_CALL(GetComposedObjectTransforms)
+	HOUDINI_API_SYNTHETIC_CALL(GetDisplayGeoInfo)
+	HOUDINI_API_SYNTHETIC_CALL(GetGeoInfo)
+	HOUDINI_API_SYNTHETIC_CALL(ComposeChildNodeList)
+	HOUDINI_API_SYNTHETIC_CALL(GetPartInfo)
+	HOUDINI_API_SYNTHETIC_CALL(GetAttributeInfo)
+	HOUDINI_API_SYNTHETIC_CALL(GetAttributeNames)
+	HOUDINI_API_SYNTHETIC_CALL(GetAttributeFloatData)
+	HOUDINI_API_SYNTHETIC_CALL(GetAttributeStringData)
+	HOUDINI_API_SYNTHETIC_CALL(GetVertexList)
+	HOUDINI_API_SYNTHETIC_CALL(GetFaceCounts)
+	HOUDINI_API_SYNTHETIC_CALL(GetGroupNames)
+	HOUDINI_API_SYNTHETIC_CALL(GetGroupMembership)
+	HOUDINI_API_SYNTHETIC_CALL(GetMaterialNodeIdsOnFaces)
+	HOUDINI_API_SYNTHETIC_CALL(GetInstanceTransformsOnPart)
+	HOUDINI_API_SYNTHETIC_CALL(GetVolumeInfo)
+	HOUDINI_API_SYNTHETIC_CALL(GetVolumeBounds)
+	HOUDINI_API_SYNTHETIC_CALL(GetHeightFieldData)
+	HOUDINI_API_SYNTHETIC_CALL(GetStringBufLength)
+	HOUDINI_API_SYNTHETIC_CALL(GetString)
+	HOUDINI_API_SYNTHETIC_CALL(GetStringBatchSize)
+	HOUDINI_API_SYNTHETIC_CALL(GetStringBatch)
+	HOUDINI_API_SYNTHETIC_CALL(GetStatus)
+	HOUDINI_API_SYNTHETIC_CALL(GetParmIdFromName)
+
+#undef HOUDINI_API_SYNTHETIC_CALL
+
+	struct FSyntheticHook
+	{
+		template<int32 Call, typename ReturnType, typename... ArgTypes>
+		static ReturnType
+		Invoke(ReturnType (*InOriginal)(ArgTypes...), ArgTypes... Args)
+		{
+			// Leave the calls made by the other threads to the real session
+			if (!bActive || FPlatformTLS::GetCurrentThreadId() != SyntheticThreadId)
+				return InOriginal(Args...);
+
+			return TSyntheticCall<Call>::Invoke(Args...);
+		}
+	};
+}
+
+bool
+FHoudiniApiSynthetic::Start(const FHoudiniSyntheticSceneSizes& InSizes)
+{
+	using namespace HoudiniApiSynthetic;
+
+	if (bActive)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Synthetic HAPI: a synthetic scene is already active."));
+		return false;
+	}
+
+	Sizes = InSizes;
+	Sizes.MeshPartCount = FMath::Max(Sizes.MeshPartCount, 0);
+	Sizes.TrianglesPerPart = FMath::Max(Sizes.TrianglesPerPart, 0);
+	Sizes.InstanceCount = FMath::Max(Sizes.InstanceCount, 0);
+	Sizes.HeightfieldSize = FMath::Max(Sizes.HeightfieldSize, 0);
+
+	// Lay the quads of each part on a square grid
+	const int32 QuadCount = FMath::Max(Sizes.TrianglesPerPart / 2, 1);
+	GridColumns = FMath::Max(FMath::CeilToInt(FMath::Sqrt((float)QuadCount)), 1);
+	GridRows = (QuadCount + GridColumns - 1) / GridColumns;
+
+	// The synthetic nodes reuse the ids of the session's nodes, don't mix their attributes
+	FHoudiniEngine::Get().GetAttributeCache().Empty();
+
+	SyntheticThreadId = FPlatformTLS::GetCurrentThreadId();
+	HoudiniApiHooks::InstallAll<FSyntheticHook>();
+	bActive = true;
+
+	HOUDINI_LOG_MESSAGE(
+		TEXT("Synthetic HAPI: %d mesh parts of %d triangles, %d instances, %dx%d heightfield."),
+		Sizes.MeshPartCount, GridColumns * GridRows * 2, Sizes.InstanceCount, Sizes.HeightfieldSize, Sizes.HeightfieldSize);
+	return true;
+}
+
+void
+FHoudiniApiSynthetic::Stop()
+{
+	using namespace HoudiniApiSynthetic;
+
+	if (!bActive)
+		return;
+
+	bActive = false;
+	HoudiniApiHooks::UninstallAll<FSyntheticHook>();
+	FHoudiniEngine::Get().GetAttributeCache().Empty();
+}
+
+bool
+FHoudiniApiSynthetic::IsActive()
+{
+	return HoudiniApiSynthetic::bActive;
+}
+
+HAPI_NodeId
+FHoudiniApiSynthetic::GetAssetId()
+{
+	return HoudiniApiSynthetic::Node_Asset;
+}
+
+bool
+FHoudiniApiSynthetic::RunBenchmark(const FHoudiniSyntheticSceneSizes& InSizes, UWorld* InWorld)
+{
+	if (!InWorld)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Synthetic HAPI: no world to run the benchmark in."));
+		return false;
+	}
+
+	// The outputs need a component to be created on
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags = RF_Transient;
+	AHoudiniAssetActor* HoudiniAssetActor = InWorld->SpawnActor<AHoudiniAssetActor>(SpawnParameters);
+	UHoudiniAssetComponent* HAC = HoudiniAssetActor ? HoudiniAssetActor->GetHoudiniAssetComponent() : nullptr;
+	if (!HAC)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Synthetic HAPI: could not spawn a Houdini Asset Actor for the benchmark."));
+		return false;
+	}
+
+	if (!Start(InSizes))
+	{
+		HoudiniAssetActor->Destroy();
+		return false;
+	}
+
+	// Same package params as a regular cook
+	FHoudiniPackageParams PackageParams;
+	PackageParams.PackageMode = FHoudiniPackageParams::GetDefaultStaticMeshesCookMode();
+	PackageParams.ReplaceMode = FHoudiniPackageParams::GetDefaultReplaceMode();
+	PackageParams.BakeFolder = FHoudiniEngineRuntime::Get().GetDefaultBakeFolder();
+	PackageParams.TempCookFolder = FHoudiniEngineRuntime::Get().GetDefaultTemporaryCookFolder();
+	PackageParams.OuterPackage = HAC->GetComponentLevel();
+	PackageParams.HoudiniAssetName = TEXT("SyntheticBenchmark");
+	PackageParams.HoudiniAssetActorName = HoudiniAssetActor->GetName();
+	PackageParams.ComponentGUID = HAC->GetComponentGUID();
+	PackageParams.ObjectName = FString();
+
+	double StartTime = FPlatformTime::Seconds();
+	TArray<UHoudiniOutput*> OldOutputs;
+	TArray<UHoudiniOutput*> NewOutputs;
+	const bool bSuccess = FHoudiniOutputTranslator::BuildAllOutputs(GetAssetId(), HAC, OldOutputs, NewOutputs, false);
+	const double BuildOutputsTime = FPlatformTime::Seconds() - StartTime;
+
+	// Run the translators as UpdateOutputs does, instancers last
+	double MeshTime = 0.0;
+	double InstancerTime = 0.0;
+	double LandscapeTime = 0.0;
+	TArray<TWeakObjectPtr<AActor>> UntrackedActors;
+	TArray<ALandscapeProxy*> InputLandscapes;
+	TArray<UPackage*> CreatedPackages;
+	TMap<FString, float> LandscapeLayerGlobalMinimums;
+	TMap<FString, float> LandscapeLayerGlobalMaximums;
+	for (UHoudiniOutput* CurOutput : NewOutputs)
+	{
+		if (!CurOutput)
+			continue;
+
+		StartTime = FPlatformTime::Seconds();
+		if (CurOutput->GetType() == EHoudiniOutputType::Mesh)
+		{
+			FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
+				CurOutput, PackageParams, HAC->StaticMeshMethod, HAC);
+			MeshTime += FPlatformTime::Seconds() - StartTime;
+		}
+		else if (CurOutput->GetType() == EHoudiniOutputType::Landscape)
+		{
+			FHoudiniLandscapeTranslator::CalcHeightfieldsArrayGlobalZMinZMax(
+				CurOutput->GetHoudiniGeoPartObjects(), LandscapeLayerGlobalMinimums, LandscapeLayerGlobalMaximums, false);
+			FHoudiniLandscapeTranslator::CreateLandscape(
+				CurOutput, UntrackedActors, InputLandscapes, InputLandscapes, HAC, TEXT("{hda_actor_name}_"), InWorld,
+				LandscapeLayerGlobalMinimums, LandscapeLayerGlobalMaximums, PackageParams, CreatedPackages);
+			LandscapeTime += FPlatformTime::Seconds() - StartTime;
+		}
+	}
+
+	for (UHoudiniOutput* CurOutput : NewOutputs)
+	{
+		if (!CurOutput || CurOutput->GetType() != EHoudiniOutputType::Instancer)
+			continue;
+
+		StartTime = FPlatformTime::Seconds();
+		FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(CurOutput, NewOutputs, HAC);
+		InstancerTime += FPlatformTime::Seconds() - StartTime;
+	}
+
+	Stop();
+
+	const FHoudiniSyntheticSceneSizes& Sizes = HoudiniApiSynthetic::Sizes;
+	const int64 TriangleCount = (int64)HoudiniApiSynthetic::GridColumns * HoudiniApiSynthetic::GridRows * 2 * Sizes.MeshPartCount;
+	const int64 SampleCount = (int64)Sizes.HeightfieldSize * Sizes.HeightfieldSize;
+	HOUDINI_LOG_MESSAGE(TEXT("Synthetic HAPI benchmark: BuildAllOutputs built %d outputs in %.3fs."), NewOutputs.Num(), BuildOutputsTime);
+	HOUDINI_LOG_MESSAGE(TEXT("Synthetic HAPI benchmark: Mesh %lld triangles in %.3fs (%.0f triangles/s)."),
+		TriangleCount, MeshTime, MeshTime > 0.0 ? TriangleCount / MeshTime : 0.0);
+	HOUDINI_LOG_MESSAGE(TEXT("Synthetic HAPI benchmark: Instancer %d instances in %.3fs (%.0f instances/s)."),
+		Sizes.InstanceCount, InstancerTime, InstancerTime > 0.0 ? Sizes.InstanceCount / InstancerTime : 0.0);
+	HOUDINI_LOG_MESSAGE(TEXT("Synthetic HAPI benchmark: Landscape %lld samples in %.3fs (%.0f samples/s)."),
+		SampleCount, LandscapeTime, LandscapeTime > 0.0 ? SampleCount / LandscapeTime : 0.0);
+
+	// Clean up the landscapes and the actor with the created components
+	for (UHoudiniOutput* CurOutput : NewOutputs)
+	{
+		if (CurOutput)
+			FHoudiniOutputTranslator::ClearOutput(CurOutput);
+	}
+
+	for (TWeakObjectPtr<AActor>& UntrackedActor : UntrackedActors)
+	{
+		if (UntrackedActor.IsValid())
+			UntrackedActor->Destroy();
+	}
+
+	HoudiniAssetActor->Destroy();
+
+	return bSuccess;
+}
@@ -0,0 +1,78 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "HAPI/HAPI_Common.h"
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+// Sizes of the synthetic scene
+struct HOUDINIENGINE_API FHoudiniSyntheticSceneSizes
+{
+public:
+
+	FHoudiniSyntheticSceneSizes();
+
+	// Number of grid mesh parts, and triangles in each of them
+	int32 MeshPartCount;
+	int32 TrianglesPerPart;
+
+	// Number of points of the attribute instancer
+	int32 InstanceCount;
+
+	// Resolution of the square heightfield, 0 for no heightfield
+	int32 HeightfieldSize;
+};
+
+// Answers the HAPI calls with a procedurally generated asset, to stress the output translators
+// at sizes that are impractical to cook in Houdini (tens of millions of triangles, millions of instances...).
+//
+// The synthetic asset has one object per output type: a mesh object with grid parts (P, N, uv),
+// a point cloud instancing a cube through unreal_instance, and a heightfield volume.
+// Only the calls made from the thread that started the synthetic scene are answered, so a live session
+// keeps working on the other threads. The calls the scene doesn't model succeed without writing their outputs.
+struct HOUDINIENGINE_API FHoudiniApiSynthetic
+{
+public:
+
+	// Starts answering the HAPI calls made on this thread with a synthetic scene
+	static bool Start(const FHoudiniSyntheticSceneSizes& InSizes);
+
+	// Stops answering the HAPI calls
+	static void Stop();
+
+	static bool IsActive();
+
+	// Node id of the synthetic asset, to pass to the output translators
+	static HAPI_NodeId GetAssetId();
+
+	// Builds the outputs of the synthetic scene, runs the mesh, instancer and landscape translators on them
+	// and logs their throughput. The created actors and components are destroyed afterwards.
+	static bool RunBenchmark(const FHoudiniSyntheticSceneSizes& InSizes, UWorld* InWorld);
+};
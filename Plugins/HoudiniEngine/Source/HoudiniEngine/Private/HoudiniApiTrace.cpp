@@ -0,0 +1,628 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniApiTrace.h"
+
+#include "HoudiniApiHooks.h"
+#include "HoudiniEngineOutputStats.h"
+#include "HoudiniEnginePrivatePCH.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Templates/Identity.h"
+
+DECLARE_STATS_GROUP(TEXT("HoudiniApi"), STATGROUP_HoudiniApi, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HAPI calls"), STAT_HoudiniApiCalls, STATGROUP_HoudiniApi);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HAPI payload (bytes)"), STAT_HoudiniApiPayloadBytes, STATGROUP_HoudiniApi);
+
+#if CPUPROFILERTRACE_ENABLED
+UE_TRACE_CHANNEL(HoudiniApiChannel);
+#endif
+
+namespace HoudiniApiTrace
+{
+	// The latency histograms have 4 buckets per octave, from 1us to 2^24us (~17s)
+	static const int32 BucketsPerOctave = 4;
+	static const int32 BucketCount = 24 * BucketsPerOctave + 1;
+
+	struct FCallStats
+	{
+		int64 Count;
+		int64 Cycles;
+		int64 MaxCycles;
+		int64 PayloadBytes;
+		int64 Buckets[BucketCount];
+	};
+
+	struct FScopeStats
+	{
+		int64 Count = 0;
+		uint64 Cycles = 0;
+		int64 CallCount = 0;
+		uint64 CallCycles = 0;
+		int64 PayloadBytes = 0;
+	};
+
+	static bool bTracing = false;
+	static bool bRecordingCookStats = false;
+
+	// Counters of each call, updated atomically as the calls can be made from any thread
+	static FCallStats CallStats[HoudiniApiHooks::CallCount];
+
+	// Dynamic stats / Insights events of each call, registered when tracing starts
+	static TStatId CallStatIds[HoudiniApiHooks::CallCount];
+	static uint32 CallTraceSpecIds[HoudiniApiHooks::CallCount];
+
+	// Counters of the scopes, per scope name
+	static TMap<FString, FScopeStats> ScopeStats;
+	static FCriticalSection ScopeStatsCriticalSection;
+
+	// Innermost scope on this thread
+	static thread_local FHoudiniApiTraceScope* CurrentScope = nullptr;
+
+	static int32
+	GetBucketIndex(const uint64& InCycles)
+	{
+		const double Microseconds = FPlatformTime::ToMilliseconds64(InCycles) * 1000.0;
+		if (Microseconds < 1.0)
+			return 0;
+
+		return FMath::Min(1 + FMath::FloorToInt(FMath::Log2(Microseconds) * BucketsPerOctave), BucketCount - 1);
+	}
+
+	// Returns (the upper bound of) the latency under which InPercentile of the calls completed, in microseconds
+	static double
+	GetPercentile(const FCallStats& InStats, const double& InPercentile)
+	{
+		const double MaxMicroseconds = FPlatformTime::ToMilliseconds64(InStats.MaxCycles) * 1000.0;
+		const int64 Target = FMath::Max<int64>(1, (int64)FMath::CeilToDouble(InStats.Count * InPercentile));
+
+		int64 Cumulated = 0;
+		for (int32 Idx = 0; Idx < BucketCount; Idx++)
+		{
+			Cumulated += InStats.Buckets[Idx];
+			if (Cumulated >= Target)
+				return FMath::Min<double>(FMath::Pow(2.0f, (float)Idx / BucketsPerOctave), MaxMicroseconds);
+		}
+
+		return MaxMicroseconds;
+	}
+
+	static void
+	RecordCall(const int32& InCall, const uint64& InCycles, const int64& InPayloadBytes)
+	{
+		FCallStats& Stats = CallStats[InCall];
+		FPlatformAtomics::InterlockedIncrement(&Stats.Count);
+		FPlatformAtomics::InterlockedAdd(&Stats.Cycles, (int64)InCycles);
+		FPlatformAtomics::InterlockedIncrement(&Stats.Buckets[GetBucketIndex(InCycles)]);
+		if (InPayloadBytes > 0)
+			FPlatformAtomics::InterlockedAdd(&Stats.PayloadBytes, InPayloadBytes);
+
+		int64 MaxCycles = Stats.MaxCycles;
+		while ((int64)InCycles > MaxCycles)
+		{
+			const int64 PreviousMaxCycles = FPlatformAtomics::InterlockedCompareExchange(&Stats.MaxCycles, (int64)InCycles, MaxCycles);
+			if (PreviousMaxCycles == MaxCycles)
+				break;
+
+			MaxCycles = PreviousMaxCycles;
+		}
+
+		INC_DWORD_STAT(STAT_HoudiniApiCalls);
+		INC_DWORD_STAT_BY(STAT_HoudiniApiPayloadBytes, InPayloadBytes);
+	}
+
+	// Times a call for the lifetime of the object
+	struct FCallScope
+	{
+		FCallScope(const int32& InCall, const int64& InPayloadBytes)
+			: Call(InCall)
+			, PayloadBytes(InPayloadBytes)
+			, CycleCounter(CallStatIds[InCall])
+		{
+#if CPUPROFILERTRACE_ENABLED
+			bTraceEvent = UE_TRACE_CHANNELEXPR_IS_ENABLED(HoudiniApiChannel);
+			if (bTraceEvent)
+				FCpuProfilerTrace::OutputBeginEvent(CallTraceSpecIds[InCall]);
+#endif
+			StartCycles = FPlatformTime::Cycles64();
+		}
+
+		~FCallScope()
+		{
+			const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+#if CPUPROFILERTRACE_ENABLED
+			if (bTraceEvent)
+				FCpuProfilerTrace::OutputEndEvent();
+#endif
+			RecordCall(Call, Cycles, PayloadBytes);
+
+			if (CurrentScope)
+				CurrentScope->AddCall(Cycles, PayloadBytes);
+		}
+
+		int32 Call;
+		int64 PayloadBytes;
+		uint64 StartCycles;
+		FScopeCycleCounter CycleCounter;
+#if CPUPROFILERTRACE_ENABLED
+		bool bTraceEvent;
+#endif
+	};
+
+	// Returns the size of the data transferred by a call, null if not relevant for that call
+	template<int32 Call, typename... ArgTypes>
+	struct TPayload
+	{
+		static int64 (*Function)(ArgTypes...);
+	};
+
+	template<int32 Call, typename... ArgTypes>
+	int64 (*TPayload<Call, ArgTypes...>::Function)(ArgTypes...) = nullptr;
+
+	template<int32 Call, typename ReturnType, typename... ArgTypes>
+	static void
+	SetPayload(ReturnType (*&InFunction)(ArgTypes...), typename TIdentity<int64 (*)(ArgTypes...)>::Type InPayload)
+	{
+		TPayload<Call, ArgTypes...>::Function = InPayload;
+	}
+
+	struct FTraceHook
+	{
+		template<int32 Call, typename ReturnType, typename... ArgTypes>
+		static ReturnType
+		Invoke(ReturnType (*InOriginal)(ArgTypes...), ArgTypes... Args)
+		{
+			if (!bTracing)
+				return InOriginal(Args...);
+
+			int64 (*Payload)(ArgTypes...) = TPayload<Call, ArgTypes...>::Function;
+			FCallScope CallScope(Call, Payload ? Payload(Args...) : 0);
+			return InOriginal(Args...);
+		}
+	};
+
+	//
+	// Payload of the transfer calls
+	//
+
+	template<typename ElementType>
+	static int64
+	GetAttributeDataPayload(
+		const HAPI_Session*, HAPI_NodeId, HAPI_PartId, const char*, HAPI_AttributeInfo* AttrInfo, int, ElementType*, int, int Length)
+	{
+		return AttrInfo ? (int64)Length * AttrInfo->tupleSize * sizeof(ElementType) : 0;
+	}
+
+	static int64
+	GetAttributeStringDataPayload(
+		const HAPI_Session*, HAPI_NodeId, HAPI_PartId, const char*, HAPI_AttributeInfo* AttrInfo, HAPI_StringHandle*, int, int Length)
+	{
+		return AttrInfo ? (int64)Length * AttrInfo->tupleSize * sizeof(HAPI_StringHandle) : 0;
+	}
+
+	template<typename ElementType>
+	static int64
+	SetAttributeDataPayload(
+		const HAPI_Session*, HAPI_NodeId, HAPI_PartId, const char*, const HAPI_AttributeInfo* AttrInfo, const ElementType*, int, int Length)
+	{
+		return AttrInfo ? (int64)Length * AttrInfo->tupleSize * sizeof(ElementType) : 0;
+	}
+
+	static int64
+	SetAttributeStringDataPayload(
+		const HAPI_Session*, HAPI_NodeId, HAPI_PartId, const char*, const HAPI_AttributeInfo* AttrInfo, const char** Data, int, int Length)
+	{
+		if (!AttrInfo || !Data)
+			return 0;
+
+		int64 Bytes = 0;
+		const int64 StringCount = (int64)Length * AttrInfo->tupleSize;
+		for (int64 Idx = 0; Idx < StringCount; Idx++)
+			Bytes += Data[Idx] ? FCStringAnsi::Strlen(Data[Idx]) + 1 : 0;
+
+		return Bytes;
+	}
+
+	template<typename ElementType>
+	static int64
+	PartArrayPayload(const HAPI_Session*, HAPI_NodeId, HAPI_PartId, ElementType*, int, int Length)
+	{
+		return (int64)Length * sizeof(ElementType);
+	}
+
+	static int64
+	PartTransformsPayload(const HAPI_Session*, HAPI_NodeId, HAPI_PartId, HAPI_RSTOrder, HAPI_Transform*, int, int Length)
+	{
+		return (int64)Length * sizeof(HAPI_Transform);
+	}
+
+	static int64
+	SetHeightFieldDataPayload(const HAPI_Session*, HAPI_NodeId, HAPI_PartId, const char*, const float*, int, int Length)
+	{
+		return (int64)Length * sizeof(float);
+	}
+
+	template<typename ElementType>
+	static int64
+	GetVolumeTileDataPayload(const HAPI_Session*, HAPI_NodeId, HAPI_PartId, ElementType, const HAPI_VolumeTileInfo*, ElementType*, int Length)
+	{
+		return (int64)Length * sizeof(ElementType);
+	}
+
+	template<typename ElementType>
+	static int64
+	SetVolumeTileDataPayload(const HAPI_Session*, HAPI_NodeId, HAPI_PartId, const HAPI_VolumeTileInfo*, const ElementType*, int Length)
+	{
+		return (int64)Length * sizeof(ElementType);
+	}
+
+	static int64
+	GetImageMemoryBufferPayload(const HAPI_Session*, HAPI_NodeId, char*, int Length)
+	{
+		return Length;
+	}
+
+	static int64
+	GetStringBatchPayload(const HAPI_Session*, char*, int Length)
+	{
+		return Length;
+	}
+
+	static void
+	RegisterPayloads()
+	{
+		static bool bRegistered = false;
+		if (bRegistered)
+			return;
+
+#define HOUDINI_API_TRACE_PAYLOAD(Name, Payload) SetPayload<HoudiniApiHooks::Name>(FHoudiniApi::Name, &Payload);
+		HOUDINI_API_TRACE_PAYLOAD(GetAttributeFloatData, GetAttributeDataPayload<float>)
+		HOUDINI_API_TRACE_PAYLOAD(GetAttributeFloat64Data, GetAttributeDataPayload<double>)
+		HOUDINI_API_TRACE_PAYLOAD(GetAttributeIntData, GetAttributeDataPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(GetAttributeInt64Data, GetAttributeDataPayload<HAPI_Int64>)
+		HOUDINI_API_TRACE_PAYLOAD(GetAttributeStringData, GetAttributeStringDataPayload)
+		HOUDINI_API_TRACE_PAYLOAD(SetAttributeFloatData, SetAttributeDataPayload<float>)
+		HOUDINI_API_TRACE_PAYLOAD(SetAttributeFloat64Data, SetAttributeDataPayload<double>)
+		HOUDINI_API_TRACE_PAYLOAD(SetAttributeIntData, SetAttributeDataPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(SetAttributeInt64Data, SetAttributeDataPayload<HAPI_Int64>)
+		HOUDINI_API_TRACE_PAYLOAD(SetAttributeStringData, SetAttributeStringDataPayload)
+		HOUDINI_API_TRACE_PAYLOAD(GetVertexList, PartArrayPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(SetVertexList, PartArrayPayload<const int>)
+		HOUDINI_API_TRACE_PAYLOAD(GetFaceCounts, PartArrayPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(SetFaceCounts, PartArrayPayload<const int>)
+		HOUDINI_API_TRACE_PAYLOAD(GetCurveCounts, PartArrayPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(SetCurveCounts, PartArrayPayload<const int>)
+		HOUDINI_API_TRACE_PAYLOAD(GetCurveOrders, PartArrayPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(SetCurveOrders, PartArrayPayload<const int>)
+		HOUDINI_API_TRACE_PAYLOAD(GetCurveKnots, PartArrayPayload<float>)
+		HOUDINI_API_TRACE_PAYLOAD(SetCurveKnots, PartArrayPayload<const float>)
+		HOUDINI_API_TRACE_PAYLOAD(GetHeightFieldData, PartArrayPayload<float>)
+		HOUDINI_API_TRACE_PAYLOAD(SetHeightFieldData, SetHeightFieldDataPayload)
+		HOUDINI_API_TRACE_PAYLOAD(GetInstancedPartIds, PartArrayPayload<HAPI_PartId>)
+		HOUDINI_API_TRACE_PAYLOAD(GetInstanceTransformsOnPart, PartTransformsPayload)
+		HOUDINI_API_TRACE_PAYLOAD(GetInstancerPartTransforms, PartTransformsPayload)
+		HOUDINI_API_TRACE_PAYLOAD(GetVolumeTileFloatData, GetVolumeTileDataPayload<float>)
+		HOUDINI_API_TRACE_PAYLOAD(GetVolumeTileIntData, GetVolumeTileDataPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(SetVolumeTileFloatData, SetVolumeTileDataPayload<float>)
+		HOUDINI_API_TRACE_PAYLOAD(SetVolumeTileIntData, SetVolumeTileDataPayload<int>)
+		HOUDINI_API_TRACE_PAYLOAD(GetImageMemoryBuffer, GetImageMemoryBufferPayload)
+		HOUDINI_API_TRACE_PAYLOAD(GetStringBatch, GetStringBatchPayload)
+#undef HOUDINI_API_TRACE_PAYLOAD
+
+		bRegistered = true;
+	}
+
+	// Feeds the cook stats bound to the calling thread: bytes transferred to/from the session,
+	// and the time spent waiting on HAPI while translating outputs, which is accounted as fetching geometry.
+	struct FCookStatsHook
+	{
+		template<int32 Call, typename ReturnType, typename... ArgTypes>
+		static ReturnType
+		Invoke(ReturnType (*InOriginal)(ArgTypes...), ArgTypes... Args)
+		{
+			if (!FHoudiniCookStatsScope::GetCurrent())
+				return InOriginal(Args...);
+
+			int64 (*Payload)(ArgTypes...) = TPayload<Call, ArgTypes...>::Function;
+			if (Payload)
+			{
+				// The setters send data to the session, everything else receives it
+				static const bool bSend = FCString::Strncmp(HoudiniApiHooks::GetCallName(Call), TEXT("Set"), 3) == 0;
+				const int64 Bytes = Payload(Args...);
+				FHoudiniCookStatsScope::NotifyBytesTransferred(bSend ? Bytes : 0, bSend ? 0 : Bytes);
+			}
+
+			EHoudiniCookPhase Phase;
+			if (!FHoudiniCookPhaseScope::GetCurrentPhase(Phase)
+				|| (Phase != EHoudiniCookPhase::TranslateMeshes && Phase != EHoudiniCookPhase::BuildStaticMeshes && Phase != EHoudiniCookPhase::CreateComponents))
+			{
+				return InOriginal(Args...);
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			ReturnType Result = InOriginal(Args...);
+			FHoudiniCookPhaseScope::ReattributeTime(EHoudiniCookPhase::FetchGeometry, FPlatformTime::Seconds() - StartTime);
+			return Result;
+		}
+	};
+}
+
+
+void
+FHoudiniApiTrace::Start()
+{
+	if (HoudiniApiTrace::bTracing)
+		return;
+
+	// Register the stats and Insights events of the calls
+	for (int32 Idx = 0; Idx < HoudiniApiHooks::CallCount; Idx++)
+	{
+		const FString EventName = FString(TEXT("HAPI_")) + HoudiniApiHooks::GetCallName(Idx);
+#if STATS
+		if (!HoudiniApiTrace::CallStatIds[Idx].IsValidStat())
+			HoudiniApiTrace::CallStatIds[Idx] = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_HoudiniApi>(EventName);
+#endif
+#if CPUPROFILERTRACE_ENABLED
+		if (HoudiniApiTrace::CallTraceSpecIds[Idx] == 0)
+			HoudiniApiTrace::CallTraceSpecIds[Idx] = FCpuProfilerTrace::OutputEventType(*EventName);
+#endif
+	}
+
+	HoudiniApiTrace::RegisterPayloads();
+
+	HoudiniApiHooks::InstallAll<HoudiniApiTrace::FTraceHook>();
+
+	HoudiniApiTrace::bTracing = true;
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI call tracing started."));
+}
+
+
+void
+FHoudiniApiTrace::Stop()
+{
+	if (!HoudiniApiTrace::bTracing)
+		return;
+
+	HoudiniApiHooks::UninstallAll<HoudiniApiTrace::FTraceHook>();
+
+	HoudiniApiTrace::bTracing = false;
+	HOUDINI_LOG_MESSAGE(TEXT("HAPI call tracing stopped."));
+}
+
+
+bool
+FHoudiniApiTrace::IsTracing()
+{
+	return HoudiniApiTrace::bTracing;
+}
+
+
+void
+FHoudiniApiTrace::StartCookStats()
+{
+	if (HoudiniApiTrace::bRecordingCookStats)
+		return;
+
+	HoudiniApiTrace::RegisterPayloads();
+	HoudiniApiHooks::InstallAll<HoudiniApiTrace::FCookStatsHook>();
+
+	HoudiniApiTrace::bRecordingCookStats = true;
+}
+
+
+void
+FHoudiniApiTrace::StopCookStats()
+{
+	if (!HoudiniApiTrace::bRecordingCookStats)
+		return;
+
+	HoudiniApiHooks::UninstallAll<HoudiniApiTrace::FCookStatsHook>();
+
+	HoudiniApiTrace::bRecordingCookStats = false;
+}
+
+
+bool
+FHoudiniApiTrace::IsRecordingCookStats()
+{
+	return HoudiniApiTrace::bRecordingCookStats;
+}
+
+
+void
+FHoudiniApiTrace::Reset()
+{
+	FMemory::Memzero(HoudiniApiTrace::CallStats);
+
+	FScopeLock ScopeLock(&HoudiniApiTrace::ScopeStatsCriticalSection);
+	HoudiniApiTrace::ScopeStats.Empty();
+}
+
+
+void
+FHoudiniApiTrace::LogStats(const int32& InMaxCallCount)
+{
+	using namespace HoudiniApiTrace;
+
+	TArray<int32> Calls;
+	int64 TotalCount = 0;
+	uint64 TotalCycles = 0;
+	int64 TotalPayloadBytes = 0;
+	for (int32 Idx = 0; Idx < HoudiniApiHooks::CallCount; Idx++)
+	{
+		if (CallStats[Idx].Count <= 0)
+			continue;
+
+		Calls.Add(Idx);
+		TotalCount += CallStats[Idx].Count;
+		TotalCycles += CallStats[Idx].Cycles;
+		TotalPayloadBytes += CallStats[Idx].PayloadBytes;
+	}
+
+	Calls.Sort([](const int32& A, const int32& B) { return CallStats[A].Cycles > CallStats[B].Cycles; });
+
+	HOUDINI_LOG_DISPLAY(
+		TEXT("HAPI calls%s: %lld calls, %.3f ms, %.2f MB transferred"),
+		bTracing ? TEXT("") : TEXT(" (not tracing)"),
+		TotalCount, FPlatformTime::ToMilliseconds64(TotalCycles), TotalPayloadBytes / (1024.0 * 1024.0));
+
+	for (int32 Idx = 0; Idx < Calls.Num() && Idx < InMaxCallCount; Idx++)
+	{
+		const FCallStats& Stats = CallStats[Calls[Idx]];
+		const double Milliseconds = FPlatformTime::ToMilliseconds64(Stats.Cycles);
+		HOUDINI_LOG_DISPLAY(
+			TEXT("    %-36s %8lld calls %10.3f ms - mean %.1f us, p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us - %.2f MB"),
+			HoudiniApiHooks::GetCallName(Calls[Idx]), Stats.Count, Milliseconds, Milliseconds * 1000.0 / Stats.Count,
+			GetPercentile(Stats, 0.5), GetPercentile(Stats, 0.9), GetPercentile(Stats, 0.99),
+			FPlatformTime::ToMilliseconds64(Stats.MaxCycles) * 1000.0, Stats.PayloadBytes / (1024.0 * 1024.0));
+	}
+
+	FScopeLock ScopeLock(&ScopeStatsCriticalSection);
+	TArray<FString> Scopes;
+	ScopeStats.GetKeys(Scopes);
+	Scopes.Sort([](const FString& A, const FString& B) { return ScopeStats[A].CallCycles > ScopeStats[B].CallCycles; });
+
+	for (const FString& Scope : Scopes)
+	{
+		const FScopeStats& Stats = ScopeStats[Scope];
+		const double Milliseconds = FPlatformTime::ToMilliseconds64(Stats.Cycles);
+		const double CallMilliseconds = FPlatformTime::ToMilliseconds64(Stats.CallCycles);
+		HOUDINI_LOG_DISPLAY(
+			TEXT("    %s: %lld times, %.3f ms - %.3f ms (%.1f%%) waiting on %lld HAPI calls - %.2f MB"),
+			*Scope, Stats.Count, Milliseconds, CallMilliseconds, Milliseconds > 0.0 ? CallMilliseconds * 100.0 / Milliseconds : 0.0,
+			Stats.CallCount, Stats.PayloadBytes / (1024.0 * 1024.0));
+	}
+}
+
+
+bool
+FHoudiniApiTrace::WriteCSV(const FString& InFilePath)
+{
+	using namespace HoudiniApiTrace;
+
+	// Calls and scopes share the columns: the time of a call is all spent in HAPI,
+	// and the latency percentiles are only available for the calls
+	FString CSV = TEXT("Type,Name,Count,TotalMs,HapiCalls,HapiMs,MeanUs,P50Us,P90Us,P99Us,MaxUs,PayloadBytes\n");
+	for (int32 Idx = 0; Idx < HoudiniApiHooks::CallCount; Idx++)
+	{
+		const FCallStats& Stats = CallStats[Idx];
+		if (Stats.Count <= 0)
+			continue;
+
+		const double Milliseconds = FPlatformTime::ToMilliseconds64(Stats.Cycles);
+		CSV += FString::Printf(
+			TEXT("Call,%s,%lld,%.3f,%lld,%.3f,%.1f,%.1f,%.1f,%.1f,%.1f,%lld\n"),
+			HoudiniApiHooks::GetCallName(Idx), Stats.Count, Milliseconds, Stats.Count, Milliseconds, Milliseconds * 1000.0 / Stats.Count,
+			GetPercentile(Stats, 0.5), GetPercentile(Stats, 0.9), GetPercentile(Stats, 0.99),
+			FPlatformTime::ToMilliseconds64(Stats.MaxCycles) * 1000.0, Stats.PayloadBytes);
+	}
+
+	{
+		FScopeLock ScopeLock(&ScopeStatsCriticalSection);
+		for (const auto& Pair : ScopeStats)
+		{
+			const FScopeStats& Stats = Pair.Value;
+			CSV += FString::Printf(
+				TEXT("Scope,%s,%lld,%.3f,%lld,%.3f,,,,,,%lld\n"),
+				*Pair.Key, Stats.Count, FPlatformTime::ToMilliseconds64(Stats.Cycles),
+				Stats.CallCount, FPlatformTime::ToMilliseconds64(Stats.CallCycles), Stats.PayloadBytes);
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(CSV, *InFilePath))
+	{
+		HOUDINI_LOG_WARNING(TEXT("Failed to write the HAPI call trace to %s"), *InFilePath);
+		return false;
+	}
+
+	HOUDINI_LOG_DISPLAY(TEXT("Wrote the HAPI call trace to %s"), *InFilePath);
+	return true;
+}
+
+
+FString
+FHoudiniApiTrace::GetDefaultCSVFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HoudiniEngine"), TEXT("ApiTrace.csv"));
+}
+
+
+FHoudiniApiTraceScope::FHoudiniApiTraceScope(const TCHAR* InName)
+	: Name(InName)
+	, Parent(nullptr)
+	, bActive(HoudiniApiTrace::bTracing)
+	, StartCycles(0)
+	, CallCount(0)
+	, CallCycles(0)
+	, PayloadBytes(0)
+{
+	if (!bActive)
+		return;
+
+	Parent = HoudiniApiTrace::CurrentScope;
+	HoudiniApiTrace::CurrentScope = this;
+	StartCycles = FPlatformTime::Cycles64();
+}
+
+
+FHoudiniApiTraceScope::~FHoudiniApiTraceScope()
+{
+	if (!bActive)
+		return;
+
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	HoudiniApiTrace::CurrentScope = Parent;
+
+	// The calls of a nested scope are also made in its parent
+	if (Parent)
+	{
+		Parent->CallCount += CallCount;
+		Parent->CallCycles += CallCycles;
+		Parent->PayloadBytes += PayloadBytes;
+	}
+
+	FScopeLock ScopeLock(&HoudiniApiTrace::ScopeStatsCriticalSection);
+	HoudiniApiTrace::FScopeStats& Stats = HoudiniApiTrace::ScopeStats.FindOrAdd(Name);
+	Stats.Count++;
+	Stats.Cycles += Cycles;
+	Stats.CallCount += CallCount;
+	Stats.CallCycles += CallCycles;
+	Stats.PayloadBytes += PayloadBytes;
+}
+
+
+void
+FHoudiniApiTraceScope::AddCall(const uint64& InCycles, const int64& InPayloadBytes)
+{
+	CallCount++;
+	CallCycles += InCycles;
+	PayloadBytes += InPayloadBytes;
+}
@@ -0,0 +1,99 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Opt-in instrumentation of the HAPI calls.
+// While tracing, every HAPI function pointer of FHoudiniApi is replaced by a wrapper that counts and times the call,
+// keeps a histogram of its latency and, for the geometry/attribute/image transfer calls, the size of the data transferred.
+// FHoudiniApi is generated, so the wrappers are installed over its function pointers instead of being added to it.
+// The calls are also reported in the HoudiniApi stats group ("stat HoudiniApi"),
+// and as CPU events in Unreal Insights when the HoudiniApi trace channel is enabled.
+struct HOUDINIENGINE_API FHoudiniApiTrace
+{
+public:
+
+	// Installs the wrappers over the current HAPI function pointers
+	static void Start();
+
+	// Restores the HAPI function pointers
+	static void Stop();
+
+	static bool IsTracing();
+
+	// Installs the wrappers that account the HAPI transfers in the cook stats of the HAC being processed.
+	// The HACs' cook stats are only recorded in between, the wrappers only do work inside an FHoudiniCookStatsScope.
+	static void StartCookStats();
+	static void StopCookStats();
+
+	static bool IsRecordingCookStats();
+
+	// Clears the counters recorded so far
+	static void Reset();
+
+	// Logs the calls with the highest cumulative time, and the time spent in HAPI by each traced scope
+	static void LogStats(const int32& InMaxCallCount);
+
+	// Writes the counters of all the calls and scopes to a CSV file
+	static bool WriteCSV(const FString& InFilePath);
+
+	// Default location of the CSV file
+	static FString GetDefaultCSVFilePath();
+};
+
+// Attributes the HAPI calls made on this thread during its lifetime to a named scope (usually a translator),
+// so the time spent waiting on HAPI can be compared to the total time spent in that scope.
+// Nested scopes also count toward their parent. Does nothing when not tracing.
+struct HOUDINIENGINE_API FHoudiniApiTraceScope
+{
+public:
+
+	FHoudiniApiTraceScope(const TCHAR* InName);
+	~FHoudiniApiTraceScope();
+
+	// Called by the HAPI call wrappers
+	void AddCall(const uint64& InCycles, const int64& InPayloadBytes);
+
+protected:
+
+	// Name of the scope, must be a literal
+	const TCHAR* Name;
+
+	// Enclosing scope on this thread
+	FHoudiniApiTraceScope* Parent;
+
+	// Whether we were tracing when the scope was entered
+	bool bActive;
+
+	uint64 StartCycles;
+
+	// HAPI calls made in this scope (and its nested scopes)
+	int64 CallCount;
+	uint64 CallCycles;
+	int64 PayloadBytes;
+};
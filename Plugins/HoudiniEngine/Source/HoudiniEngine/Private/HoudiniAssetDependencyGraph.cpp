@@ -0,0 +1,405 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniAssetDependencyGraph.h"
+
+#include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniAssetComponent.h"
+
+FHoudiniAssetDependencyGraph::FWaveNode::FWaveNode()
+	: Depth(0)
+	, bCookStarted(false)
+	, bSettled(false)
+{}
+
+FHoudiniAssetDependencyGraph::FHoudiniAssetDependencyGraph()
+	: GraphRevision(-1)
+	, WaveStartTime(0.0)
+	, LastWaveAssetCount(0)
+	, LastWaveCookCount(0)
+	, LastWaveDepth(0)
+	, LastWaveDuration(0.0)
+{}
+
+bool
+FHoudiniAssetDependencyGraph::IsWaitingToCook(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return false;
+
+	switch (HAC->GetAssetState())
+	{
+		case EHoudiniAssetState::PreInstantiation:
+		case EHoudiniAssetState::Instantiating:
+		case EHoudiniAssetState::PreCook:
+		case EHoudiniAssetState::NeedRebuild:
+			return true;
+
+		case EHoudiniAssetState::NeedInstantiation:
+		case EHoudiniAssetState::None:
+			return HAC->NeedUpdate();
+
+		default:
+			break;
+	}
+
+	return false;
+}
+
+void
+FHoudiniAssetDependencyGraph::Update()
+{
+	if (IsWaveActive())
+	{
+		RefreshWave();
+
+		for (const FWaveNode& CurrentNode : WaveNodes)
+		{
+			if (!CurrentNode.bSettled)
+				return;
+		}
+
+		FinishWave();
+	}
+
+	// Nothing to do until a HAC needs to cook
+	if (DirtyHACs.Num() <= 0)
+		return;
+
+	StartWave();
+}
+
+void
+FHoudiniAssetDependencyGraph::BuildGraph()
+{
+	Upstreams.Empty();
+	Downstreams.Empty();
+	GraphRevision = FHoudiniEngineRuntime::Get().GetRegistryRevision();
+
+	const int32 ComponentCount = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentCount();
+	for (int32 Idx = 0; Idx < ComponentCount; Idx++)
+	{
+		UHoudiniAssetComponent* CurrentHAC = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentAt(Idx);
+		if (!CurrentHAC || CurrentHAC->IsPendingKill())
+			continue;
+
+		UpdateAssetInputs(CurrentHAC);
+	}
+}
+
+void
+FHoudiniAssetDependencyGraph::UpdateAssetInputs(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return;
+
+	// Remove the previous edges
+	TArray<TWeakObjectPtr<UHoudiniAssetComponent>>& InputHACs = Upstreams.FindOrAdd(HAC);
+	for (auto& InputHAC : InputHACs)
+	{
+		if (TArray<TWeakObjectPtr<UHoudiniAssetComponent>>* DownstreamHACs = Downstreams.Find(InputHAC))
+			DownstreamHACs->Remove(HAC);
+	}
+	InputHACs.Empty();
+
+	TArray<UHoudiniAssetComponent*> CurrentInputHACs;
+	HAC->GetInputHoudiniAssets(CurrentInputHACs);
+	for (auto& InputHAC : CurrentInputHACs)
+	{
+		InputHACs.Add(InputHAC);
+		Downstreams.FindOrAdd(InputHAC).AddUnique(HAC);
+	}
+}
+
+void
+FHoudiniAssetDependencyGraph::GetUpstreamHACs(UHoudiniAssetComponent* HAC, TArray<UHoudiniAssetComponent*>& OutHACs) const
+{
+	OutHACs.Empty();
+	const TArray<TWeakObjectPtr<UHoudiniAssetComponent>>* InputHACs = Upstreams.Find(HAC);
+	if (!InputHACs)
+		return;
+
+	for (auto& InputHAC : *InputHACs)
+	{
+		if (InputHAC.IsValid() && !InputHAC->IsPendingKill())
+			OutHACs.Add(InputHAC.Get());
+	}
+}
+
+void
+FHoudiniAssetDependencyGraph::GetDownstreamHACs(UHoudiniAssetComponent* HAC, TArray<UHoudiniAssetComponent*>& OutHACs) const
+{
+	OutHACs.Empty();
+	const TArray<TWeakObjectPtr<UHoudiniAssetComponent>>* DownstreamHACs = Downstreams.Find(HAC);
+	if (!DownstreamHACs)
+		return;
+
+	for (auto& DownstreamHAC : *DownstreamHACs)
+	{
+		if (DownstreamHAC.IsValid() && !DownstreamHAC->IsPendingKill())
+			OutHACs.Add(DownstreamHAC.Get());
+	}
+}
+
+bool
+FHoudiniAssetDependencyGraph::StartWave()
+{
+	if (!FHoudiniEngineRuntime::IsInitialized())
+		return false;
+
+	// Only rebuild the graph if HACs have been registered or unregistered since
+	if (GraphRevision != FHoudiniEngineRuntime::Get().GetRegistryRevision())
+		BuildGraph();
+
+	// The HACs that are still waiting to cook
+	TArray<UHoudiniAssetComponent*> WaveHACs;
+	for (auto& DirtyHAC : DirtyHACs)
+	{
+		if (IsWaitingToCook(DirtyHAC.Get()))
+			WaveHACs.AddUnique(DirtyHAC.Get());
+	}
+	DirtyHACs.Empty();
+
+	if (WaveHACs.Num() <= 0)
+		return false;
+
+	// Add everything downstream of the HACs that will cook
+	bool bHasDependencies = false;
+	TArray<UHoudiniAssetComponent*> DownstreamHACs;
+	for (int32 Idx = 0; Idx < WaveHACs.Num(); Idx++)
+	{
+		GetDownstreamHACs(WaveHACs[Idx], DownstreamHACs);
+		if (DownstreamHACs.Num() <= 0)
+			continue;
+
+		bHasDependencies = true;
+		for (auto& DownstreamHAC : DownstreamHACs)
+			WaveHACs.AddUnique(DownstreamHAC);
+	}
+
+	// HACs without dependencies don't need to be ordered
+	if (!bHasDependencies)
+		return false;
+
+	// Topological sort (Kahn) of the wave
+	TMap<UHoudiniAssetComponent*, int32> PendingInputCount;
+	TArray<UHoudiniAssetComponent*> InputHACs;
+	for (auto& CurrentHAC : WaveHACs)
+	{
+		int32& InputCount = PendingInputCount.Add(CurrentHAC, 0);
+		GetUpstreamHACs(CurrentHAC, InputHACs);
+		for (auto& InputHAC : InputHACs)
+		{
+			if (WaveHACs.Contains(InputHAC))
+				InputCount++;
+		}
+	}
+
+	TArray<UHoudiniAssetComponent*> SortedHACs;
+	for (auto& CurrentHAC : WaveHACs)
+	{
+		if (PendingInputCount[CurrentHAC] == 0)
+			SortedHACs.Add(CurrentHAC);
+	}
+
+	for (int32 Idx = 0; Idx < SortedHACs.Num(); Idx++)
+	{
+		GetDownstreamHACs(SortedHACs[Idx], DownstreamHACs);
+		for (auto& DownstreamHAC : DownstreamHACs)
+		{
+			int32* InputCount = PendingInputCount.Find(DownstreamHAC);
+			if (InputCount && --(*InputCount) == 0)
+				SortedHACs.Add(DownstreamHAC);
+		}
+	}
+
+	if (SortedHACs.Num() != WaveHACs.Num())
+	{
+		// HACs in a cycle would wait for each other forever, leave them out of the wave
+		HOUDINI_LOG_WARNING(TEXT("Houdini Engine: %d Houdini Asset(s) have cyclic asset input dependencies, their cooks will not be ordered."),
+			WaveHACs.Num() - SortedHACs.Num());
+	}
+
+	// Create the wave's nodes
+	WaveNodes.SetNum(SortedHACs.Num());
+	WaveNodeIndices.Empty(SortedHACs.Num());
+	for (int32 Idx = 0; Idx < SortedHACs.Num(); Idx++)
+	{
+		WaveNodes[Idx].HAC = SortedHACs[Idx];
+		WaveNodeIndices.Add(SortedHACs[Idx], Idx);
+	}
+
+	for (int32 Idx = 0; Idx < SortedHACs.Num(); Idx++)
+	{
+		FWaveNode& CurrentNode = WaveNodes[Idx];
+		GetUpstreamHACs(SortedHACs[Idx], InputHACs);
+		for (auto& InputHAC : InputHACs)
+		{
+			const int32* InputIndex = WaveNodeIndices.Find(InputHAC);
+			if (!InputIndex)
+				continue;
+
+			// Inputs are always sorted before us
+			CurrentNode.Upstream.Add(*InputIndex);
+			CurrentNode.Depth = FMath::Max(CurrentNode.Depth, WaveNodes[*InputIndex].Depth + 1);
+		}
+	}
+
+	WaveStartTime = FPlatformTime::Seconds();
+
+	HOUDINI_LOG_MESSAGE(TEXT("Houdini Engine: starting a cook wave for %d Houdini Asset(s)."), WaveNodes.Num());
+
+	RefreshWave();
+
+	return true;
+}
+
+void
+FHoudiniAssetDependencyGraph::RefreshWave()
+{
+	for (FWaveNode& CurrentNode : WaveNodes)
+	{
+		UHoudiniAssetComponent* CurrentHAC = CurrentNode.HAC.Get();
+		if (!CurrentHAC || CurrentHAC->IsPendingKill() || !FHoudiniEngineRuntime::Get().IsComponentRegistered(CurrentHAC))
+		{
+			CurrentNode.bSettled = true;
+			continue;
+		}
+
+		const EHoudiniAssetState State = CurrentHAC->GetAssetState();
+		const bool bIdle = (State == EHoudiniAssetState::None || State == EHoudiniAssetState::NeedInstantiation);
+		if (CurrentNode.bCookStarted)
+		{
+			// Finished (or failed) its cook for this wave.
+			// Back in PreCook means it changed again and is waiting for the next wave.
+			CurrentNode.bSettled = bIdle || State == EHoudiniAssetState::PreCook;
+			continue;
+		}
+
+		// A HAC that didn't cook is settled once its inputs have settled
+		// and they didn't request a cook from it
+		bool bUpstreamSettled = true;
+		for (const int32& UpstreamIndex : CurrentNode.Upstream)
+		{
+			if (!WaveNodes[UpstreamIndex].bSettled)
+			{
+				bUpstreamSettled = false;
+				break;
+			}
+		}
+
+		CurrentNode.bSettled = bUpstreamSettled && bIdle && !IsWaitingToCook(CurrentHAC);
+	}
+}
+
+void
+FHoudiniAssetDependencyGraph::FinishWave()
+{
+	LastWaveAssetCount = WaveNodes.Num();
+	LastWaveCookCount = 0;
+	LastWaveDepth = 0;
+	for (const FWaveNode& CurrentNode : WaveNodes)
+	{
+		if (CurrentNode.bCookStarted)
+			LastWaveCookCount++;
+
+		LastWaveDepth = FMath::Max(LastWaveDepth, CurrentNode.Depth + 1);
+	}
+	LastWaveDuration = FPlatformTime::Seconds() - WaveStartTime;
+
+	HOUDINI_LOG_MESSAGE(
+		TEXT("Houdini Engine: cook wave finished in %.3f s - %d Houdini Asset(s), %d cooked, longest chain: %d."),
+		LastWaveDuration, LastWaveAssetCount, LastWaveCookCount, LastWaveDepth);
+
+	WaveNodes.Empty();
+	WaveNodeIndices.Empty();
+}
+
+void
+FHoudiniAssetDependencyGraph::OnAssetStateChanged(UHoudiniAssetComponent* HAC)
+{
+	// A HAC that needs to cook starts the next wave, its inputs might have changed
+	if (IsWaitingToCook(HAC))
+	{
+		DirtyHACs.AddUnique(HAC);
+		if (GraphRevision >= 0)
+			UpdateAssetInputs(HAC);
+	}
+
+	if (!IsWaveActive() || !WaveNodeIndices.Contains(HAC))
+		return;
+
+	RefreshWave();
+}
+
+bool
+FHoudiniAssetDependencyGraph::IsReadyToCook(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill() || !IsWaveActive())
+		return true;
+
+	const int32* NodeIndex = WaveNodeIndices.Find(HAC);
+	if (NodeIndex)
+	{
+		const FWaveNode& CurrentNode = WaveNodes[*NodeIndex];
+
+		// Only cook once per wave, further changes will be cooked by the next wave
+		if (CurrentNode.bCookStarted)
+			return false;
+
+		for (const int32& UpstreamIndex : CurrentNode.Upstream)
+		{
+			if (!WaveNodes[UpstreamIndex].bSettled)
+				return false;
+		}
+
+		return true;
+	}
+
+	// HACs outside of the wave still need to wait for the wave's HACs they depend on
+	TArray<UHoudiniAssetComponent*> InputHACs;
+	HAC->GetInputHoudiniAssets(InputHACs);
+	for (auto& InputHAC : InputHACs)
+	{
+		const int32* InputIndex = WaveNodeIndices.Find(InputHAC);
+		if (InputIndex && !WaveNodes[*InputIndex].bSettled)
+			return false;
+	}
+
+	return true;
+}
+
+void
+FHoudiniAssetDependencyGraph::OnCookStarted(UHoudiniAssetComponent* HAC)
+{
+	const int32* NodeIndex = WaveNodeIndices.Find(HAC);
+	if (!NodeIndex)
+		return;
+
+	WaveNodes[*NodeIndex].bCookStarted = true;
+	WaveNodes[*NodeIndex].bSettled = false;
+}
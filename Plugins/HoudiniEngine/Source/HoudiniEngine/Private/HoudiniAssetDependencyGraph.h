@@ -0,0 +1,145 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UHoudiniAssetComponent;
+
+// Orders the cooks of HACs connected via asset inputs.
+// The asset input graph of the registered HACs is built once, and rebuilt when HACs are registered or unregistered.
+// The input edges of a HAC are refreshed when it needs to cook, since its inputs might have changed.
+// When HACs need to cook, their dependencies (them and all the HACs downstream)
+// are sorted topologically: this is a cook "wave".
+// A HAC of the wave only starts cooking once all its input HACs from the wave have settled,
+// so each HAC cooks once per wave, and independent branches can cook at the same time.
+struct HOUDINIENGINE_API FHoudiniAssetDependencyGraph
+{
+public:
+
+	FHoudiniAssetDependencyGraph();
+
+	// Starts a new wave if HACs with dependencies started waiting to cook since the last one,
+	// or refreshes the current wave and finishes it when all its HACs have settled.
+	void Update();
+
+	// Records the HAC for the next wave if it is now waiting to cook,
+	// and refreshes the current wave after a HAC's state has changed
+	void OnAssetStateChanged(UHoudiniAssetComponent* HAC);
+
+	// Returns true if the HAC can start cooking:
+	// all its input HACs from the current wave have settled, and it hasn't cooked in this wave yet
+	bool IsReadyToCook(UHoudiniAssetComponent* HAC);
+
+	// Indicates that the HAC has started cooking for the current wave
+	void OnCookStarted(UHoudiniAssetComponent* HAC);
+
+	// Returns true if a wave is currently being cooked
+	bool IsWaveActive() const { return WaveNodes.Num() > 0; };
+
+	// Number of HACs in the last finished wave
+	int32 GetLastWaveAssetCount() const { return LastWaveAssetCount; };
+	// Number of HACs that cooked in the last finished wave
+	int32 GetLastWaveCookCount() const { return LastWaveCookCount; };
+	// Length of the longest dependency chain in the last finished wave
+	int32 GetLastWaveDepth() const { return LastWaveDepth; };
+	// Wall-clock duration of the last finished wave (in seconds)
+	double GetLastWaveDuration() const { return LastWaveDuration; };
+
+protected:
+
+	struct FWaveNode
+	{
+		FWaveNode();
+
+		TWeakObjectPtr<UHoudiniAssetComponent> HAC;
+
+		// Indices of the input HACs in the wave
+		TArray<int32> Upstream;
+
+		// Position in the longest dependency chain leading to this HAC
+		int32 Depth;
+
+		// The HAC has started cooking in this wave
+		bool bCookStarted;
+
+		// The HAC has nothing left to do in this wave
+		bool bSettled;
+	};
+
+	// Builds a wave from the HACs that started waiting to cook and all the HACs downstream
+	// Returns false if those HACs have no dependencies, in which case they don't need to be ordered
+	bool StartWave();
+
+	// Builds the asset input graph of all the registered HACs
+	void BuildGraph();
+
+	// Refreshes the input edges of a HAC in the graph
+	void UpdateAssetInputs(UHoudiniAssetComponent* HAC);
+
+	// Input HACs of a HAC, and HACs using it as an input
+	void GetUpstreamHACs(UHoudiniAssetComponent* HAC, TArray<UHoudiniAssetComponent*>& OutHACs) const;
+	void GetDownstreamHACs(UHoudiniAssetComponent* HAC, TArray<UHoudiniAssetComponent*>& OutHACs) const;
+
+	// Updates the settled state of the wave's HACs, in topological order
+	void RefreshWave();
+
+	// Logs the wave's report and clears it
+	void FinishWave();
+
+	// Returns true if the HAC is going to cook (or instantiate, then cook)
+	static bool IsWaitingToCook(UHoudiniAssetComponent* HAC);
+
+private:
+
+	// Input HACs of each registered HAC
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, TArray<TWeakObjectPtr<UHoudiniAssetComponent>>> Upstreams;
+
+	// HACs using each registered HAC as an input
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, TArray<TWeakObjectPtr<UHoudiniAssetComponent>>> Downstreams;
+
+	// Revision of the HAC registry the graph was built for, -1 if it hasn't been built
+	int32 GraphRevision;
+
+	// HACs that started waiting to cook since the last wave started
+	TArray<TWeakObjectPtr<UHoudiniAssetComponent>> DirtyHACs;
+
+	// HACs of the current wave, sorted topologically
+	TArray<FWaveNode> WaveNodes;
+
+	// Index of each HAC in WaveNodes
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, int32> WaveNodeIndices;
+
+	// Time at which the current wave started
+	double WaveStartTime;
+
+	int32 LastWaveAssetCount;
+	int32 LastWaveCookCount;
+	int32 LastWaveDepth;
+	double LastWaveDuration;
+};
@@ -0,0 +1,184 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniAssetLibraryCache.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniAsset.h"
+
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+
+FHoudiniAssetLibraryCache::FHoudiniAssetLibraryCache()
+{}
+
+uint64
+FHoudiniAssetLibraryCache::GetAssetLibraryHash(const UHoudiniAsset* HoudiniAsset, const FString& InLibraryPath)
+{
+	if (!HoudiniAsset || HoudiniAsset->IsPendingKill())
+		return 0;
+
+	// Libraries are loaded from their file when it exists, so editing the file invalidates the entry too
+	uint64 LibraryHash = HoudiniAsset->GetAssetBytesHash();
+	if (!InLibraryPath.IsEmpty())
+	{
+		LibraryHash = CityHash64WithSeed(
+			reinterpret_cast<const char *>(*InLibraryPath), InLibraryPath.Len() * sizeof(TCHAR), LibraryHash);
+
+		const int64 TimeStampTicks = IFileManager::Get().GetTimeStamp(*InLibraryPath).GetTicks();
+		LibraryHash = CityHash64WithSeed(
+			reinterpret_cast<const char *>(&TimeStampTicks), sizeof(TimeStampTicks), LibraryHash);
+	}
+
+	return LibraryHash;
+}
+
+EHoudiniAssetLibraryLoadState
+FHoudiniAssetLibraryCache::BeginLoad(const uint64& InLibraryHash, HAPI_AssetLibraryId& OutAssetLibraryId)
+{
+	const int32 SessionIndex = FHoudiniEngineRuntime::GetCurrentSessionIndex();
+	const TPair<int32, uint64> Key(SessionIndex, InLibraryHash);
+
+	FScopeLock ScopeLock(&CriticalSection);
+	const FLibraryEntry* Entry = Libraries.Find(Key);
+	if (Entry)
+	{
+		HitCount.Increment();
+		OutAssetLibraryId = Entry->AssetLibraryId;
+
+		HOUDINI_LOG_HELPER(Verbose, TEXT("Asset library cache hit for %s in session %d."), *Entry->LibraryPath, SessionIndex);
+		return EHoudiniAssetLibraryLoadState::Loaded;
+	}
+
+	// Don't wait for the other load, the caller decides whether to wait or not
+	if (PendingLoads.Contains(Key))
+		return EHoudiniAssetLibraryLoadState::Loading;
+
+	// We're the one loading this library
+	MissCount.Increment();
+	PendingLoads.Add(Key);
+	return EHoudiniAssetLibraryLoadState::MustLoad;
+}
+
+void
+FHoudiniAssetLibraryCache::EndLoad(const uint64& InLibraryHash, const FString& InLibraryPath, const HAPI_AssetLibraryId& InAssetLibraryId, const bool& bInLoaded)
+{
+	const int32 SessionIndex = FHoudiniEngineRuntime::GetCurrentSessionIndex();
+
+	FScopeLock ScopeLock(&CriticalSection);
+	if (bInLoaded)
+		Add(InLibraryHash, InLibraryPath, InAssetLibraryId);
+
+	PendingLoads.Remove(TPair<int32, uint64>(SessionIndex, InLibraryHash));
+}
+
+bool
+FHoudiniAssetLibraryCache::Contains(const int32& InSessionIndex, const uint64& InLibraryHash) const
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	return Libraries.Contains(TPair<int32, uint64>(InSessionIndex, InLibraryHash));
+}
+
+bool
+FHoudiniAssetLibraryCache::IsLoading(const int32& InSessionIndex, const uint64& InLibraryHash) const
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	return PendingLoads.Contains(TPair<int32, uint64>(InSessionIndex, InLibraryHash));
+}
+
+void
+FHoudiniAssetLibraryCache::Add(const uint64& InLibraryHash, const FString& InLibraryPath, const HAPI_AssetLibraryId& InAssetLibraryId)
+{
+	const int32 SessionIndex = FHoudiniEngineRuntime::GetCurrentSessionIndex();
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	// Loading a library overwrites the definitions previously loaded from the same path in that session
+	if (!InLibraryPath.IsEmpty())
+	{
+		for (auto It = Libraries.CreateIterator(); It; ++It)
+		{
+			if (It->Key.Key == SessionIndex && It->Key.Value != InLibraryHash && It->Value.LibraryPath.Equals(InLibraryPath))
+				It.RemoveCurrent();
+		}
+	}
+
+	FLibraryEntry& Entry = Libraries.Add(TPair<int32, uint64>(SessionIndex, InLibraryHash));
+	Entry.AssetLibraryId = InAssetLibraryId;
+	Entry.LibraryPath = InLibraryPath;
+}
+
+void
+FHoudiniAssetLibraryCache::Invalidate(const FString& InLibraryPath)
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	for (auto It = Libraries.CreateIterator(); It; ++It)
+	{
+		if (It->Value.LibraryPath.Equals(InLibraryPath))
+			It.RemoveCurrent();
+	}
+}
+
+void
+FHoudiniAssetLibraryCache::InvalidateSession(const int32& InSessionIndex)
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	for (auto It = Libraries.CreateIterator(); It; ++It)
+	{
+		if (It->Key.Key == InSessionIndex)
+			It.RemoveCurrent();
+	}
+}
+
+void
+FHoudiniAssetLibraryCache::Empty()
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	Libraries.Empty();
+}
+
+void
+FHoudiniAssetLibraryCache::LogStats() const
+{
+	const int32 Hits = HitCount.GetValue();
+	const int32 Misses = MissCount.GetValue();
+	const int32 Lookups = Hits + Misses;
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	HOUDINI_LOG_DISPLAY(
+		TEXT("Asset library cache: %d libraries loaded, %d hits, %d misses (%.1f%% hit rate)."),
+		Libraries.Num(), Hits, Misses, Lookups > 0 ? 100.0f * Hits / Lookups : 0.0f);
+
+	for (const auto& Pair : Libraries)
+	{
+		HOUDINI_LOG_DISPLAY(
+			TEXT("    Session %d: library %d, %s"),
+			Pair.Key.Key, Pair.Value.AssetLibraryId, *Pair.Value.LibraryPath);
+	}
+}
@@ -0,0 +1,117 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "HAPI/HAPI_Common.h"
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class UHoudiniAsset;
+
+enum class EHoudiniAssetLibraryLoadState : uint8
+{
+	// The library is already loaded in the session
+	Loaded,
+
+	// The caller has to load the library, then call EndLoad
+	MustLoad,
+
+	// Another thread is loading the library in the session
+	Loading
+};
+
+// Keeps track of the HDA libraries loaded in each session, keyed by the hash of their content.
+// Instantiating an asset whose library content has already been loaded in the session reuses that library
+// instead of sending the HDA to HAPI again, so HACs sharing an HDA only load it once per session.
+// HAPI cannot unload libraries: at most one library is kept per session and path,
+// loading new content for a path (after a reimport) replaces its previous entry.
+struct HOUDINIENGINE_API FHoudiniAssetLibraryCache
+{
+public:
+
+	FHoudiniAssetLibraryCache();
+
+	// Returns the key identifying the content of a Houdini Asset's library:
+	// the hash of its bytes, combined with the path and modification time of the library file it is loaded from
+	static uint64 GetAssetLibraryHash(const UHoudiniAsset* HoudiniAsset, const FString& InLibraryPath);
+
+	// Looks for a library with this content in the calling thread's session, and updates the hit/miss counters.
+	// Never blocks: if another thread is loading that library in the session (the preload task), returns Loading.
+	// If the library is loaded, its id is set in OutAssetLibraryId.
+	// If MustLoad is returned, the caller has to load the library and call EndLoad once done.
+	EHoudiniAssetLibraryLoadState BeginLoad(const uint64& InLibraryHash, HAPI_AssetLibraryId& OutAssetLibraryId);
+
+	// Ends a load started with BeginLoad, and registers the library if it has been loaded successfully.
+	void EndLoad(const uint64& InLibraryHash, const FString& InLibraryPath, const HAPI_AssetLibraryId& InAssetLibraryId, const bool& bInLoaded);
+
+	// Returns true if a library with this content has been loaded in the given session
+	bool Contains(const int32& InSessionIndex, const uint64& InLibraryHash) const;
+
+	// Returns true if a library with this content is being loaded in the given session
+	bool IsLoading(const int32& InSessionIndex, const uint64& InLibraryHash) const;
+
+	// Registers a library loaded in the calling thread's session
+	void Add(const uint64& InLibraryHash, const FString& InLibraryPath, const HAPI_AssetLibraryId& InAssetLibraryId);
+
+	// Forgets the libraries loaded from this path in all sessions (the asset has been reimported)
+	void Invalidate(const FString& InLibraryPath);
+
+	// Forgets the libraries loaded in a session (the session has been lost)
+	void InvalidateSession(const int32& InSessionIndex);
+
+	// Forgets all the libraries (the sessions have been stopped)
+	void Empty();
+
+	// Logs the content of the cache and its counters
+	void LogStats() const;
+
+	int32 GetHitCount() const { return HitCount.GetValue(); };
+	int32 GetMissCount() const { return MissCount.GetValue(); };
+
+private:
+
+	struct FLibraryEntry
+	{
+		HAPI_AssetLibraryId AssetLibraryId;
+		FString LibraryPath;
+	};
+
+	// Loaded libraries, per session index and content hash
+	TMap<TPair<int32, uint64>, FLibraryEntry> Libraries;
+
+	// Libraries currently being loaded, per session index and content hash
+	TSet<TPair<int32, uint64>> PendingLoads;
+
+	// Synchronization primitive for the libraries, as they are loaded by the schedulers and the game thread
+	mutable FCriticalSection CriticalSection;
+
+	// Number of lookups that found / didn't find a loaded library
+	FThreadSafeCounter HitCount;
+	FThreadSafeCounter MissCount;
+};
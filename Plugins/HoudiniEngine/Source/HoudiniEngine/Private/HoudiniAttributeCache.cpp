@@ -0,0 +1,552 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniAttributeCache.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniEngineString.h"
+#include "HoudiniEngineUtils.h"
+#include "HoudiniApi.h"
+#include "HoudiniRuntimeSettings.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Fetches an attribute's info, looking for it on all owners if InOwner is invalid
+	bool
+	FetchAttributeInfo(
+		const HAPI_NodeId& InGeoId, const HAPI_PartId& InPartId, const char * InAttribName,
+		const HAPI_AttributeOwner& InOwner, HAPI_AttributeInfo& OutAttributeInfo)
+	{
+		FHoudiniApi::AttributeInfo_Init(&OutAttributeInfo);
+		if (InOwner != HAPI_ATTROWNER_INVALID)
+		{
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
+				FHoudiniEngine::Get().GetSession(),
+				InGeoId, InPartId, InAttribName, InOwner, &OutAttributeInfo), false);
+
+			return true;
+		}
+
+		for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; ++OwnerIdx)
+		{
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
+				FHoudiniEngine::Get().GetSession(),
+				InGeoId, InPartId, InAttribName, (HAPI_AttributeOwner)OwnerIdx, &OutAttributeInfo), false);
+
+			if (OutAttributeInfo.exists)
+				break;
+		}
+
+		return true;
+	}
+
+	bool
+	FetchData(
+		const HAPI_NodeId& InGeoId, const HAPI_PartId& InPartId, const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo, TArray<float>& OutData)
+	{
+		// HAPI fills the whole buffer, no need to initialize it
+		OutData.SetNumUninitialized(InAttributeInfo.count * InAttributeInfo.tupleSize);
+		if (OutData.Num() <= 0)
+			return true;
+
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeFloatData(
+			FHoudiniEngine::Get().GetSession(),
+			InGeoId, InPartId, InAttribName,
+			&InAttributeInfo, -1, OutData.GetData(), 0, InAttributeInfo.count), false);
+
+		return true;
+	}
+
+	bool
+	FetchData(
+		const HAPI_NodeId& InGeoId, const HAPI_PartId& InPartId, const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo, TArray<int32>& OutData)
+	{
+		OutData.SetNumUninitialized(InAttributeInfo.count * InAttributeInfo.tupleSize);
+		if (OutData.Num() <= 0)
+			return true;
+
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeIntData(
+			FHoudiniEngine::Get().GetSession(),
+			InGeoId, InPartId, InAttribName,
+			&InAttributeInfo, -1, OutData.GetData(), 0, InAttributeInfo.count), false);
+
+		return true;
+	}
+
+	bool
+	FetchData(
+		const HAPI_NodeId& InGeoId, const HAPI_PartId& InPartId, const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo, FHoudiniStringTable& OutData)
+	{
+		TArray<HAPI_StringHandle> StringHandles;
+		StringHandles.Init(-1, InAttributeInfo.count * InAttributeInfo.tupleSize);
+		if (StringHandles.Num() > 0)
+		{
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeStringData(
+				FHoudiniEngine::Get().GetSession(),
+				InGeoId, InPartId, InAttribName, &InAttributeInfo,
+				StringHandles.GetData(), 0, InAttributeInfo.count), false);
+		}
+
+		return FHoudiniEngineString::SHArrayToStringTable(StringHandles, OutData);
+	}
+
+	int64
+	GetDataSize(const TArray<float>& InData) { return InData.Num() * sizeof(float); }
+
+	int64
+	GetDataSize(const TArray<int32>& InData) { return InData.Num() * sizeof(int32); }
+
+	int64
+	GetDataSize(const FHoudiniStringTable& InData) { return InData.GetAllocatedSize(); }
+}
+
+FHoudiniAttributeCache::FHoudiniAttributeCache()
+	: NumBytes(0)
+	, UseCounter(0)
+{}
+
+bool
+FHoudiniAttributeCache::PreparePart(const FPartKey& InKey)
+{
+	if (GetMaxBytes() <= 0)
+		return false;
+
+	const HAPI_NodeId& GeoId = InKey.Get<1>();
+	const HAPI_PartId& PartId = InKey.Get<2>();
+
+	const uint64 Epoch = GetValidationEpoch();
+	int32 CookCount = -1;
+	bool bNeedsValidation = true;
+	bool bNeedsNames = true;
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (const FPartEntry* Entry = Parts.Find(InKey))
+		{
+			CookCount = Entry->CookCount;
+			bNeedsValidation = Entry->ValidatedEpoch != Epoch;
+			bNeedsNames = !Entry->bHasNames;
+		}
+	}
+
+	if (bNeedsValidation)
+	{
+		// The geo's cook count changes each time its outputs do
+		HAPI_NodeInfo NodeInfo;
+		FHoudiniApi::NodeInfo_Init(&NodeInfo);
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetNodeInfo(
+			FHoudiniEngine::Get().GetSession(), GeoId, &NodeInfo), false);
+
+		FScopeLock ScopeLock(&CriticalSection);
+		FPartEntry* Entry = Parts.Find(InKey);
+		if (Entry && Entry->CookCount != NodeInfo.totalCookCount)
+		{
+			RemovePart(InKey);
+			Entry = nullptr;
+		}
+
+		if (!Entry)
+		{
+			Entry = &Parts.Add(InKey);
+			Entry->CookCount = NodeInfo.totalCookCount;
+		}
+
+		Entry->ValidatedEpoch = Epoch;
+		CookCount = Entry->CookCount;
+		bNeedsNames = !Entry->bHasNames;
+	}
+
+	if (!bNeedsNames)
+		return true;
+
+	// List the names of the part's attributes once, instead of probing each owner for each attribute
+	HAPI_PartInfo PartInfo;
+	FHoudiniApi::PartInfo_Init(&PartInfo);
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetPartInfo(
+		FHoudiniEngine::Get().GetSession(), GeoId, PartId, &PartInfo), false);
+
+	TArray<FString> OwnerNames[HAPI_ATTROWNER_MAX];
+	for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; ++OwnerIdx)
+	{
+		const int32 AttributeCount = PartInfo.attributeCounts[OwnerIdx];
+		if (AttributeCount <= 0)
+			continue;
+
+		TArray<HAPI_StringHandle> NameHandles;
+		NameHandles.SetNumZeroed(AttributeCount);
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeNames(
+			FHoudiniEngine::Get().GetSession(), GeoId, PartId, (HAPI_AttributeOwner)OwnerIdx,
+			NameHandles.GetData(), AttributeCount), false);
+
+		FHoudiniEngineString::SHArrayToFStringArray(NameHandles, OwnerNames[OwnerIdx]);
+	}
+
+	FScopeLock ScopeLock(&CriticalSection);
+	FPartEntry* Entry = Parts.Find(InKey);
+	if (!Entry || Entry->CookCount != CookCount)
+		return false;
+
+	if (!Entry->bHasNames)
+	{
+		for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; ++OwnerIdx)
+		{
+			for (const FString& Name : OwnerNames[OwnerIdx])
+				Entry->Names.Add(FAttributeKey(OwnerIdx, 0, Name));
+		}
+
+		Entry->bHasNames = true;
+	}
+
+	return true;
+}
+
+FHoudiniAttributeCache::FPartEntry*
+FHoudiniAttributeCache::FindPart(const FPartKey& InKey)
+{
+	FPartEntry* Entry = Parts.Find(InKey);
+	if (Entry)
+		Entry->LastUsed = ++UseCounter;
+
+	return Entry;
+}
+
+bool
+FHoudiniAttributeCache::GetAttributeInfo(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	const HAPI_AttributeOwner& InOwner,
+	HAPI_AttributeInfo& OutAttributeInfo)
+{
+	const FPartKey Key(FHoudiniEngineRuntime::GetCurrentSessionIndex(), InGeoId, InPartId);
+	if (!PreparePart(Key))
+		return FetchAttributeInfo(InGeoId, InPartId, InAttribName, InOwner, OutAttributeInfo);
+
+	const FString Name = UTF8_TO_TCHAR(InAttribName);
+	HAPI_AttributeOwner Owner = InOwner;
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		FPartEntry* Entry = FindPart(Key);
+		if (Entry && Entry->bHasNames)
+		{
+			// Find the owner of the attribute via the part's names, in the same order we would have probed them
+			if (Owner == HAPI_ATTROWNER_INVALID)
+			{
+				for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; ++OwnerIdx)
+				{
+					if (Entry->Names.Contains(FAttributeKey(OwnerIdx, 0, Name)))
+					{
+						Owner = (HAPI_AttributeOwner)OwnerIdx;
+						break;
+					}
+				}
+			}
+
+			if (Owner == HAPI_ATTROWNER_INVALID || !Entry->Names.Contains(FAttributeKey(Owner, 0, Name)))
+			{
+				// The attribute doesn't exist
+				HitCount.Increment();
+				FHoudiniApi::AttributeInfo_Init(&OutAttributeInfo);
+				OutAttributeInfo.exists = false;
+				return true;
+			}
+
+			if (const HAPI_AttributeInfo* FoundInfo = Entry->Infos.Find(FAttributeKey(Owner, 0, Name)))
+			{
+				HitCount.Increment();
+				OutAttributeInfo = *FoundInfo;
+				return true;
+			}
+		}
+	}
+
+	MissCount.Increment();
+	if (!FetchAttributeInfo(InGeoId, InPartId, InAttribName, Owner, OutAttributeInfo))
+		return false;
+
+	if (OutAttributeInfo.exists)
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (FPartEntry* Entry = FindPart(Key))
+			Entry->Infos.Add(FAttributeKey(OutAttributeInfo.owner, 0, Name), OutAttributeInfo);
+	}
+
+	return true;
+}
+
+template<typename DataType>
+bool
+FHoudiniAttributeCache::GetData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	TMap<FAttributeKey, TSharedPtr<const DataType, ESPMode::ThreadSafe>> FPartEntry::* InDataMap,
+	TSharedPtr<const DataType, ESPMode::ThreadSafe>& OutData)
+{
+	if (!InAttributeInfo.exists)
+		return false;
+
+	const FPartKey Key(FHoudiniEngineRuntime::GetCurrentSessionIndex(), InGeoId, InPartId);
+	const bool bCacheData = PreparePart(Key);
+	const FAttributeKey DataKey(InAttributeInfo.owner, InAttributeInfo.tupleSize, UTF8_TO_TCHAR(InAttribName));
+	if (bCacheData)
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		FPartEntry* Entry = FindPart(Key);
+		const TSharedPtr<const DataType, ESPMode::ThreadSafe>* FoundData = Entry ? (Entry->*InDataMap).Find(DataKey) : nullptr;
+		if (FoundData)
+		{
+			HitCount.Increment();
+			OutData = *FoundData;
+			return true;
+		}
+	}
+
+	MissCount.Increment();
+	TSharedRef<DataType, ESPMode::ThreadSafe> FetchedData = MakeShared<DataType, ESPMode::ThreadSafe>();
+	if (!FetchData(InGeoId, InPartId, InAttribName, InAttributeInfo, FetchedData.Get()))
+		return false;
+
+	OutData = FetchedData;
+	if (!bCacheData)
+		return true;
+
+	// Another thread might have fetched the same data in the meantime
+	FScopeLock ScopeLock(&CriticalSection);
+	FPartEntry* Entry = FindPart(Key);
+	if (Entry && !(Entry->*InDataMap).Contains(DataKey))
+	{
+		(Entry->*InDataMap).Add(DataKey, OutData);
+		OnDataAdded(Key, *Entry, GetDataSize(*OutData));
+	}
+
+	return true;
+}
+
+template<typename DataType>
+bool
+FHoudiniAttributeCache::CopyData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	TMap<FAttributeKey, TSharedPtr<const DataType, ESPMode::ThreadSafe>> FPartEntry::* InDataMap,
+	DataType& OutData)
+{
+	if (!InAttributeInfo.exists)
+		return false;
+
+	// Without the cache, fetch straight into the caller's buffer
+	if (GetMaxBytes() <= 0)
+		return FetchData(InGeoId, InPartId, InAttribName, InAttributeInfo, OutData);
+
+	TSharedPtr<const DataType, ESPMode::ThreadSafe> SharedData;
+	if (!GetData(InGeoId, InPartId, InAttribName, InAttributeInfo, InDataMap, SharedData))
+		return false;
+
+	OutData = *SharedData;
+	return true;
+}
+
+bool
+FHoudiniAttributeCache::GetFloatData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	TArray<float>& OutData)
+{
+	return CopyData(InGeoId, InPartId, InAttribName, InAttributeInfo, &FPartEntry::FloatData, OutData);
+}
+
+bool
+FHoudiniAttributeCache::GetIntData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	TArray<int32>& OutData)
+{
+	return CopyData(InGeoId, InPartId, InAttribName, InAttributeInfo, &FPartEntry::IntData, OutData);
+}
+
+bool
+FHoudiniAttributeCache::GetFloatData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	FHoudiniFloatAttributeView& OutView)
+{
+	FHoudiniFloatAttributeView::FDataPtr SharedData;
+	if (!GetData(InGeoId, InPartId, InAttribName, InAttributeInfo, &FPartEntry::FloatData, SharedData))
+		return false;
+
+	OutView = FHoudiniFloatAttributeView(SharedData);
+	return true;
+}
+
+bool
+FHoudiniAttributeCache::GetIntData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	FHoudiniIntAttributeView& OutView)
+{
+	FHoudiniIntAttributeView::FDataPtr SharedData;
+	if (!GetData(InGeoId, InPartId, InAttribName, InAttributeInfo, &FPartEntry::IntData, SharedData))
+		return false;
+
+	OutView = FHoudiniIntAttributeView(SharedData);
+	return true;
+}
+
+bool
+FHoudiniAttributeCache::GetStringData(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	TArray<FString>& OutData)
+{
+	TSharedPtr<const FHoudiniStringTable, ESPMode::ThreadSafe> StringTable;
+	if (!GetData(InGeoId, InPartId, InAttribName, InAttributeInfo, &FPartEntry::StringData, StringTable))
+		return false;
+
+	StringTable->ToFStringArray(OutData);
+	return true;
+}
+
+bool
+FHoudiniAttributeCache::GetStringTable(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	FHoudiniStringTable& OutStringTable)
+{
+	return CopyData(InGeoId, InPartId, InAttribName, InAttributeInfo, &FPartEntry::StringData, OutStringTable);
+}
+
+void
+FHoudiniAttributeCache::OnDataAdded(const FPartKey& InKey, FPartEntry& InEntry, const int64& InNumBytes)
+{
+	InEntry.NumBytes += InNumBytes;
+	NumBytes += InNumBytes;
+
+	const int64 MaxBytes = GetMaxBytes();
+	while (NumBytes > MaxBytes && Parts.Num() > 1)
+	{
+		// Evict the least recently used part, but never the one we've just added data to
+		const FPartKey* OldestKey = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const auto& Pair : Parts)
+		{
+			if (Pair.Value.LastUsed < OldestUse && Pair.Key != InKey)
+			{
+				OldestUse = Pair.Value.LastUsed;
+				OldestKey = &Pair.Key;
+			}
+		}
+
+		if (!OldestKey)
+			break;
+
+		RemovePart(FPartKey(*OldestKey));
+	}
+}
+
+void
+FHoudiniAttributeCache::RemovePart(const FPartKey& InKey)
+{
+	FPartEntry Entry;
+	if (Parts.RemoveAndCopyValue(InKey, Entry))
+		NumBytes -= Entry.NumBytes;
+}
+
+void
+FHoudiniAttributeCache::NotifyCooked()
+{
+	CookSerial.Increment();
+}
+
+uint64
+FHoudiniAttributeCache::GetValidationEpoch() const
+{
+	return ((uint64)GFrameCounter << 32) | (uint32)CookSerial.GetValue();
+}
+
+int64
+FHoudiniAttributeCache::GetMaxBytes()
+{
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	return HoudiniRuntimeSettings ? (int64)FMath::Max(HoudiniRuntimeSettings->AttributeCacheSizeMb, 0) * 1024 * 1024 : 0;
+}
+
+void
+FHoudiniAttributeCache::InvalidateSession(const int32& InSessionIndex)
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	for (auto It = Parts.CreateIterator(); It; ++It)
+	{
+		if (It->Key.Get<0>() == InSessionIndex)
+		{
+			NumBytes -= It->Value.NumBytes;
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void
+FHoudiniAttributeCache::Empty()
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	Parts.Empty();
+	NumBytes = 0;
+}
+
+void
+FHoudiniAttributeCache::LogStats() const
+{
+	const int32 Hits = HitCount.GetValue();
+	const int32 Misses = MissCount.GetValue();
+	const int32 Lookups = Hits + Misses;
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	HOUDINI_LOG_DISPLAY(
+		TEXT("Attribute cache: %d parts, %.2f MB of data (budget %.2f MB), %d hits, %d misses (%.1f%% hit rate)."),
+		Parts.Num(), NumBytes / (1024.0 * 1024.0), GetMaxBytes() / (1024.0 * 1024.0),
+		Hits, Misses, Lookups > 0 ? 100.0f * Hits / Lookups : 0.0f);
+}
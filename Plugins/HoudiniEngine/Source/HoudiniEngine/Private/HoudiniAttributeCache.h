@@ -0,0 +1,258 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "HAPI/HAPI_Common.h"
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
+
+#include "HoudiniEngineString.h"
+
+// Read-only view of an attribute's data, sharing the buffer kept by the attribute cache instead of copying it.
+// Offers the read accessors of the TArray it replaces, and converts to a TArrayView.
+template<typename DataType>
+struct THoudiniAttributeView
+{
+	typedef TSharedPtr<const TArray<DataType>, ESPMode::ThreadSafe> FDataPtr;
+
+	THoudiniAttributeView() {};
+	THoudiniAttributeView(const FDataPtr& InData) : Data(InData) {};
+
+	int32 Num() const { return Data.IsValid() ? Data->Num() : 0; };
+	bool IsValidIndex(const int32& InIndex) const { return Data.IsValid() && Data->IsValidIndex(InIndex); };
+	const DataType& operator[](const int32& InIndex) const { return (*Data)[InIndex]; };
+	const DataType* GetData() const { return Data.IsValid() ? Data->GetData() : nullptr; };
+
+	operator TArrayView<const DataType>() const { return TArrayView<const DataType>(GetData(), Num()); };
+
+	// Releases the view's buffer
+	void Empty() { Data.Reset(); };
+
+	private:
+
+		FDataPtr Data;
+};
+
+typedef THoudiniAttributeView<float> FHoudiniFloatAttributeView;
+typedef THoudiniAttributeView<int32> FHoudiniIntAttributeView;
+
+// Keeps the attributes fetched from HAPI for each part (GeoId, PartId) of the sessions.
+// The attribute names of a part are listed once, so looking for an attribute on all owners doesn't probe each of them,
+// and the infos and data of the attributes are memoized, so the translators fetching the same attributes several times
+// for a part only query them once. A part's entries are discarded as soon as its geo has been cooked again.
+// The cache's size is bounded by the AttributeCacheSizeMb setting, the least recently used parts are evicted first.
+struct HOUDINIENGINE_API FHoudiniAttributeCache
+{
+public:
+
+	FHoudiniAttributeCache();
+
+	// Gets the info of an attribute of a part of the calling thread's session.
+	// InOwner can be HAPI_ATTROWNER_INVALID to look for the attribute on all owners.
+	// Returns false if HAPI failed, OutAttributeInfo.exists is false if the attribute doesn't exist.
+	bool GetAttributeInfo(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		const HAPI_AttributeOwner& InOwner,
+		HAPI_AttributeInfo& OutAttributeInfo);
+
+	// Gets the data of an attribute, fetching it with the given info if it hasn't been already.
+	// The data matches the info's storage, a different tuple size can be requested via InAttributeInfo.
+	// The data is copied to the caller's buffer, or fetched directly into it if the cache is disabled.
+	bool GetFloatData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		TArray<float>& OutData);
+
+	bool GetIntData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		TArray<int32>& OutData);
+
+	bool GetStringData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		TArray<FString>& OutData);
+
+	// Same as above, but shares the cached buffer with the caller instead of copying it
+	bool GetFloatData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		FHoudiniFloatAttributeView& OutView);
+
+	bool GetIntData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		FHoudiniIntAttributeView& OutView);
+
+	// String attributes are kept as tables of their unique values
+	bool GetStringTable(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		FHoudiniStringTable& OutStringTable);
+
+	// Called whenever a node has been cooked: the parts are checked against their geo's cook count again on their next use
+	void NotifyCooked();
+
+	// Forgets the parts of a session (the session has been lost)
+	void InvalidateSession(const int32& InSessionIndex);
+
+	// Forgets all the parts (the sessions have been stopped)
+	void Empty();
+
+	// Logs the size of the cache and its counters
+	void LogStats() const;
+
+	int32 GetHitCount() const { return HitCount.GetValue(); };
+	int32 GetMissCount() const { return MissCount.GetValue(); };
+
+private:
+
+	// Session index, geo id and part id
+	typedef TTuple<int32, HAPI_NodeId, HAPI_PartId> FPartKey;
+
+	// Owner, tuple size and name of an attribute.
+	// Unlike FString's, the comparison and hash are case sensitive, as HAPI's attribute names are.
+	struct FAttributeKey
+	{
+		FAttributeKey(const int32& InOwner, const int32& InTupleSize, const FString& InName)
+			: Owner(InOwner), TupleSize(InTupleSize), Name(InName) {};
+
+		bool operator==(const FAttributeKey& Other) const
+		{
+			return Owner == Other.Owner && TupleSize == Other.TupleSize && Name.Equals(Other.Name, ESearchCase::CaseSensitive);
+		}
+
+		friend uint32 GetTypeHash(const FAttributeKey& InKey)
+		{
+			return HashCombine(HashCombine(::GetTypeHash(InKey.Owner), ::GetTypeHash(InKey.TupleSize)), FCrc::StrCrc32(*InKey.Name));
+		}
+
+		int32 Owner;
+		int32 TupleSize;
+		FString Name;
+	};
+
+	struct FPartEntry
+	{
+		// Cook count of the geo when the entry was created
+		int32 CookCount = -1;
+		// Validation epoch at which the cook count was last checked
+		uint64 ValidatedEpoch = 0;
+		// Used to evict the least recently used parts
+		uint64 LastUsed = 0;
+
+		// Names of the part's attributes, per owner (with a tuple size of 0)
+		bool bHasNames = false;
+		TSet<FAttributeKey> Names;
+
+		// Infos of the attributes, per owner and name (with a tuple size of 0)
+		TMap<FAttributeKey, HAPI_AttributeInfo> Infos;
+
+		// The buffers are shared with the views handed to the translators, evicting a part doesn't invalidate them
+		TMap<FAttributeKey, TSharedPtr<const TArray<float>, ESPMode::ThreadSafe>> FloatData;
+		TMap<FAttributeKey, TSharedPtr<const TArray<int32>, ESPMode::ThreadSafe>> IntData;
+		TMap<FAttributeKey, TSharedPtr<const FHoudiniStringTable, ESPMode::ThreadSafe>> StringData;
+
+		// Size of the data arrays
+		int64 NumBytes = 0;
+	};
+
+	// Gets the data of an attribute from one of the parts' data maps, fetching it if needed
+	template<typename DataType>
+	bool GetData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		TMap<FAttributeKey, TSharedPtr<const DataType, ESPMode::ThreadSafe>> FPartEntry::* InDataMap,
+		TSharedPtr<const DataType, ESPMode::ThreadSafe>& OutData);
+
+	// Copies the data of an attribute to the caller's buffer
+	template<typename DataType>
+	bool CopyData(
+		const HAPI_NodeId& InGeoId,
+		const HAPI_PartId& InPartId,
+		const char * InAttribName,
+		HAPI_AttributeInfo& InAttributeInfo,
+		TMap<FAttributeKey, TSharedPtr<const DataType, ESPMode::ThreadSafe>> FPartEntry::* InDataMap,
+		DataType& OutData);
+
+	// Makes sure the part's entry exists and is up to date with its geo's last cook, and lists its attribute names.
+	// HAPI is queried outside of the critical section. Returns false if the cache is disabled or HAPI failed.
+	bool PreparePart(const FPartKey& InKey);
+
+	// Returns the entry of a prepared part and marks it as used.
+	// Must be called with the critical section locked.
+	FPartEntry* FindPart(const FPartKey& InKey);
+
+	// Accounts for data added to an entry and evicts the least recently used parts if we're over budget.
+	// Must be called with the critical section locked.
+	void OnDataAdded(const FPartKey& InKey, FPartEntry& InEntry, const int64& InNumBytes);
+
+	// Forgets a part, must be called with the critical section locked
+	void RemovePart(const FPartKey& InKey);
+
+	// The parts are validated against their geo's cook count once per epoch,
+	// a new epoch starts on each frame and each cook
+	uint64 GetValidationEpoch() const;
+
+	// Returns the cache's budget in bytes, 0 if the cache is disabled
+	static int64 GetMaxBytes();
+
+	TMap<FPartKey, FPartEntry> Parts;
+
+	// Size of the data of all the parts
+	int64 NumBytes;
+
+	// Incremented on each part use, for the LRU eviction
+	uint64 UseCounter;
+
+	// Incremented on each cook
+	FThreadSafeCounter CookSerial;
+
+	// Synchronization primitive for the parts, as they are fetched by the game thread and worker threads
+	mutable FCriticalSection CriticalSection;
+
+	FThreadSafeCounter HitCount;
+	FThreadSafeCounter MissCount;
+};
@@ -0,0 +1,365 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "HoudiniCookCache.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniAsset.h"
+#include "HoudiniAssetActor.h"
+#include "HoudiniAssetComponent.h"
+#include "HoudiniParameter.h"
+#include "HoudiniInput.h"
+#include "HoudiniInputObject.h"
+#include "HoudiniOutput.h"
+
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Brush.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "LandscapeProxy.h"
+#include "Misc/PackageName.h"
+#include "Misc/SecureHash.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+// Limits the recursion through chained asset inputs
+static const int32 HoudiniCookCacheMaxInputDepth = 32;
+
+static void
+UpdateHashWithString(FSHA1& InOutHash, const FString& InString)
+{
+	InOutHash.UpdateWithString(*InString, InString.Len());
+	// Separator, so consecutive strings can't be confused
+	static const uint8 Separator = 0;
+	InOutHash.Update(&Separator, 1);
+}
+
+FHoudiniCookCache::FHoudiniCookCache()
+	: HitCount(0)
+	, MissCount(0)
+{}
+
+void
+FHoudiniCookCache::HashObjectProperties(FSHA1& InOutHash, const UObject* InObject, const UClass* InOwnerClass, const EPropertyFlags& InRequiredFlags)
+{
+	if (!InObject)
+		return;
+
+	// Flags indicating whether the parameter/input needs to be uploaded, they don't change its value
+	static const FName HasChangedName(TEXT("bHasChanged"));
+	static const FName NeedsToTriggerUpdateName(TEXT("bNeedsToTriggerUpdate"));
+
+	UpdateHashWithString(InOutHash, InObject->GetClass()->GetName());
+	for (TFieldIterator<FProperty> It(InObject->GetClass()); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (!Property)
+			continue;
+
+		// Transient properties only store HAPI ids and states
+		if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient))
+			continue;
+
+		if (InRequiredFlags != CPF_None && !Property->HasAllPropertyFlags(InRequiredFlags))
+			continue;
+
+		if (InOwnerClass && Property->GetOwnerClass() != InOwnerClass)
+			continue;
+
+		if (Property->GetFName() == HasChangedName || Property->GetFName() == NeedsToTriggerUpdateName)
+			continue;
+
+		FString Value;
+		Property->ExportTextItem(Value, Property->ContainerPtrToValuePtr<void>(InObject), nullptr, nullptr, PPF_None);
+
+		UpdateHashWithString(InOutHash, Property->GetName());
+		UpdateHashWithString(InOutHash, Value);
+	}
+}
+
+bool
+FHoudiniCookCache::HashInputObjectContent(FSHA1& InOutHash, const UObject* InObject, const int32& InDepth)
+{
+	if (!InObject)
+		return true;
+
+	UpdateHashWithString(InOutHash, InObject->GetPathName());
+
+	// Asset inputs: use the fingerprint of the upstream HAC
+	const UHoudiniAssetComponent* InputHAC = Cast<UHoudiniAssetComponent>(InObject);
+	if (!InputHAC && InObject->IsA<AHoudiniAssetActor>())
+		InputHAC = Cast<AHoudiniAssetActor>(InObject)->GetHoudiniAssetComponent();
+
+	if (InputHAC)
+	{
+		if (InDepth >= HoudiniCookCacheMaxInputDepth)
+			return false;
+
+		FString InputFingerprint;
+		if (!ComputeFingerprint(const_cast<UHoudiniAssetComponent*>(InputHAC), InDepth + 1, InputFingerprint))
+			return false;
+
+		UpdateHashWithString(InOutHash, InputFingerprint);
+		return true;
+	}
+
+	// The content of landscapes and brushes isn't stored in their input objects
+	if (InObject->IsA<ALandscapeProxy>() || InObject->IsA<ABrush>())
+		return false;
+
+	// Actors placed in a level: their components, with the meshes they reference
+	if (const AActor* Actor = Cast<AActor>(InObject))
+	{
+		TInlineComponentArray<UActorComponent*> Components;
+		Actor->GetComponents(Components);
+		for (const UActorComponent* Component : Components)
+		{
+			if (!HashInputObjectContent(InOutHash, Component, InDepth))
+				return false;
+		}
+
+		return true;
+	}
+
+	// Components placed in a level: their transform and saved properties (spline points, instances...), and the content of their mesh
+	if (const UActorComponent* Component = Cast<UActorComponent>(InObject))
+	{
+		HashObjectProperties(InOutHash, Component, nullptr, CPF_None);
+
+		if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+			UpdateHashWithString(InOutHash, SceneComponent->GetComponentTransform().ToString());
+
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component))
+		{
+			const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+			if (StaticMesh && !HashInputObjectContent(InOutHash, StaticMesh, InDepth))
+				return false;
+		}
+
+		return true;
+	}
+
+	// Other objects that aren't saved in their own package (transient meshes...) can't be hashed
+	if (!InObject->IsAsset())
+		return false;
+
+	// Assets: use their saved package, an unsaved asset can't be hashed
+	const UPackage* Package = InObject->GetOutermost();
+	if (!Package || Package->IsDirty())
+		return false;
+
+	FString PackageFilename;
+	if (!FPackageName::DoesPackageExist(Package->GetName(), nullptr, &PackageFilename))
+		return false;
+
+	const int64 FileSize = IFileManager::Get().FileSize(*PackageFilename);
+	const int64 TimeStamp = IFileManager::Get().GetTimeStamp(*PackageFilename).GetTicks();
+	InOutHash.Update(reinterpret_cast<const uint8*>(&FileSize), sizeof(FileSize));
+	InOutHash.Update(reinterpret_cast<const uint8*>(&TimeStamp), sizeof(TimeStamp));
+
+	return true;
+}
+
+bool
+FHoudiniCookCache::ComputeFingerprint(UHoudiniAssetComponent* HAC, FString& OutFingerprint)
+{
+	return ComputeFingerprint(HAC, 0, OutFingerprint);
+}
+
+bool
+FHoudiniCookCache::ComputeFingerprint(UHoudiniAssetComponent* HAC, const int32& InDepth, FString& OutFingerprint)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return false;
+
+	UHoudiniAsset* HoudiniAsset = HAC->GetHoudiniAsset();
+	if (!HoudiniAsset || HoudiniAsset->IsPendingKill() || HoudiniAsset->GetAssetBytesCount() <= 0)
+		return false;
+
+	// PDG cooks are handled by the PDG manager
+	if (HAC->GetPDGAssetLink())
+		return false;
+
+	FSHA1 Hash;
+
+	// HDA
+	const uint64 AssetBytesHash = HoudiniAsset->GetAssetBytesHash();
+	const uint32 AssetBytesCount = HoudiniAsset->GetAssetBytesCount();
+	UpdateHashWithString(Hash, HoudiniAsset->GetPathName());
+	Hash.Update(reinterpret_cast<const uint8*>(&AssetBytesHash), sizeof(AssetBytesHash));
+	Hash.Update(reinterpret_cast<const uint8*>(&AssetBytesCount), sizeof(AssetBytesCount));
+
+	// Cook and output settings, as displayed in the HAC's details
+	HashObjectProperties(Hash, HAC, UHoudiniAssetComponent::StaticClass(), CPF_Edit);
+	if (HAC->bCookOnTransformChange)
+		UpdateHashWithString(Hash, HAC->GetComponentTransform().ToString());
+
+	// Parameters
+	const int32 NumParameters = HAC->GetNumParameters();
+	for (int32 ParmIdx = 0; ParmIdx < NumParameters; ParmIdx++)
+	{
+		UHoudiniParameter* Parameter = HAC->GetParameterAt(ParmIdx);
+		if (!Parameter || Parameter->IsPendingKill())
+			continue;
+
+		HashObjectProperties(Hash, Parameter, nullptr, CPF_None);
+	}
+
+	// Inputs and the content of their objects
+	const int32 NumInputs = HAC->GetNumInputs();
+	for (int32 InputIdx = 0; InputIdx < NumInputs; InputIdx++)
+	{
+		UHoudiniInput* Input = HAC->GetInputAt(InputIdx);
+		if (!Input || Input->IsPendingKill())
+			continue;
+
+		HashObjectProperties(Hash, Input, nullptr, CPF_None);
+
+		const TArray<UHoudiniInputObject*>* InputObjects = Input->GetHoudiniInputObjectArray(Input->GetInputType());
+		if (!InputObjects)
+			continue;
+
+		for (const UHoudiniInputObject* InputObject : *InputObjects)
+		{
+			if (!InputObject || InputObject->IsPendingKill())
+				continue;
+
+			HashObjectProperties(Hash, InputObject, nullptr, CPF_None);
+
+			if (!HashInputObjectContent(Hash, InputObject->InputObject.Get(), InDepth))
+				return false;
+		}
+	}
+
+	Hash.Final();
+
+	uint8 Digest[FSHA1::DigestSize];
+	Hash.GetHash(Digest);
+	OutFingerprint = BytesToHex(Digest, FSHA1::DigestSize);
+
+	return true;
+}
+
+bool
+FHoudiniCookCache::GetOutputObjectPaths(UHoudiniAssetComponent* HAC, TArray<FString>& OutPaths)
+{
+	OutPaths.Empty();
+	if (!HAC)
+		return false;
+
+	const int32 NumOutputs = HAC->GetNumOutputs();
+	for (int32 OutputIdx = 0; OutputIdx < NumOutputs; OutputIdx++)
+	{
+		UHoudiniOutput* Output = HAC->GetOutputAt(OutputIdx);
+		if (!Output || Output->IsPendingKill())
+			return false;
+
+		for (auto& OutputObjectPair : Output->GetOutputObjects())
+		{
+			const FHoudiniOutputObject& OutputObject = OutputObjectPair.Value;
+			for (const UObject* Object : { OutputObject.OutputObject, OutputObject.OutputComponent, OutputObject.ProxyObject, OutputObject.ProxyComponent })
+			{
+				if (!Object)
+					continue;
+
+				if (Object->IsPendingKill())
+					return false;
+
+				OutPaths.Add(Object->GetPathName());
+			}
+		}
+	}
+
+	OutPaths.Sort();
+	return true;
+}
+
+void
+FHoudiniCookCache::Add(UHoudiniAssetComponent* HAC)
+{
+	TArray<FString> OutputPaths;
+	if (!GetOutputObjectPaths(HAC, OutputPaths) || OutputPaths.Num() <= 0)
+		return;
+
+	FString Fingerprint;
+	const bool bCacheable = ComputeFingerprint(HAC, Fingerprint);
+
+	// The previous cooks that produced these objects are not valid anymore
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		for (const FString& Path : It->Value)
+		{
+			if (OutputPaths.Contains(Path))
+			{
+				It.RemoveCurrent();
+				break;
+			}
+		}
+	}
+
+	if (bCacheable)
+		Entries.Add(Fingerprint, OutputPaths);
+}
+
+bool
+FHoudiniCookCache::Find(UHoudiniAssetComponent* HAC)
+{
+	FString Fingerprint;
+	const TArray<FString>* EntryPaths = nullptr;
+	if (ComputeFingerprint(HAC, Fingerprint))
+		EntryPaths = Entries.Find(Fingerprint);
+
+	TArray<FString> OutputPaths;
+	if (!EntryPaths || !GetOutputObjectPaths(HAC, OutputPaths) || OutputPaths.Num() <= 0 || OutputPaths != *EntryPaths)
+	{
+		MissCount++;
+		return false;
+	}
+
+	HitCount++;
+
+	HOUDINI_LOG_MESSAGE(
+		TEXT("%s: cook cache hit (%s), skipping the recook and keeping its %d output objects."),
+		*HAC->GetDisplayName(), *Fingerprint, OutputPaths.Num());
+
+	return true;
+}
+
+void
+FHoudiniCookCache::Empty()
+{
+	Entries.Empty();
+}
+
+void
+FHoudiniCookCache::LogStats() const
+{
+	const int32 Lookups = HitCount + MissCount;
+	HOUDINI_LOG_DISPLAY(
+		TEXT("Cook cache: %d entries, %d recooks skipped, %d misses (%.1f%% hit rate)."),
+		Entries.Num(), HitCount, MissCount, Lookups > 0 ? 100.0f * HitCount / Lookups : 0.0f);
+}
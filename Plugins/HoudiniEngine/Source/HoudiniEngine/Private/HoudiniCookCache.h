@@ -0,0 +1,93 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+
+class UObject;
+class UClass;
+class FSHA1;
+class UHoudiniAssetComponent;
+
+// Index of the cooks that produced the current outputs of the Houdini Asset Components, used to skip redundant recooks.
+// Each cook is identified by a fingerprint hashing the HDA's bytes, the HAC's cook settings,
+// every parameter value, the input settings and the content of the input objects: saved assets are identified by their package file,
+// actors and components placed in a level by their transforms, settings and meshes.
+// The index maps each fingerprint to the output objects it produced, and only lives as long as the editor session.
+// An entry is only valid while the HAC's outputs are still the ones it recorded: a new cook writing to the same
+// output objects replaces the previous entries referencing them, so there is at most one entry per set of outputs.
+struct HOUDINIENGINE_API FHoudiniCookCache
+{
+public:
+
+	FHoudiniCookCache();
+
+	// Computes the fingerprint of the next cook of the HAC
+	// Returns false if the HAC can't be cached (unsaved or unsupported inputs, PDG...)
+	static bool ComputeFingerprint(UHoudiniAssetComponent* HAC, FString& OutFingerprint);
+
+	// Records the fingerprint of the cook that just produced the HAC's outputs
+	void Add(UHoudiniAssetComponent* HAC);
+
+	// Returns true if the HAC's current outputs have been produced by a cook with the same fingerprint,
+	// in which case they can be kept as is and the cook skipped, and updates the hit/miss counters
+	bool Find(UHoudiniAssetComponent* HAC);
+
+	// Forgets all the entries
+	void Empty();
+
+	// Logs the cache's counters
+	void LogStats() const;
+
+	int32 GetHitCount() const { return HitCount; };
+	int32 GetMissCount() const { return MissCount; };
+
+protected:
+
+	// Adds the properties of an object to the hash
+	// If InOwnerClass is set, only the properties declared by that class are added
+	static void HashObjectProperties(FSHA1& InOutHash, const UObject* InObject, const UClass* InOwnerClass, const EPropertyFlags& InRequiredFlags);
+
+	// Computes the fingerprint of a HAC, InDepth is the number of asset inputs followed to reach it
+	static bool ComputeFingerprint(UHoudiniAssetComponent* HAC, const int32& InDepth, FString& OutFingerprint);
+
+	// Adds the content of an object referenced by an input to the hash
+	// Returns false if that content can't be hashed
+	static bool HashInputObjectContent(FSHA1& InOutHash, const UObject* InObject, const int32& InDepth);
+
+	// Path names of the HAC's current output objects and components, sorted
+	// Returns false if one of them is invalid
+	static bool GetOutputObjectPaths(UHoudiniAssetComponent* HAC, TArray<FString>& OutPaths);
+
+private:
+
+	// Output object paths, per fingerprint
+	TMap<FString, TArray<FString>> Entries;
+
+	int32 HitCount;
+	int32 MissCount;
+};
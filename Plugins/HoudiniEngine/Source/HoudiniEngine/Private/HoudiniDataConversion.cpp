@@ -0,0 +1,457 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniDataConversion.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+
+#include "Math/VectorRegister.h"
+#include "HAL/IConsoleManager.h"
+
+// Compares the conversion kernels with the equivalent scalar loops on random data.
+// Usage: HoudiniEngine.DataConversionBenchmark [TupleCount] [IterationCount]
+static FAutoConsoleCommand CCmdHoudiniEngineDataConversionBenchmark(
+	TEXT("HoudiniEngine.DataConversionBenchmark"),
+	TEXT("Measures the throughput of the HAPI data conversion kernels against scalar loops. Arguments: [TupleCount=1000000] [IterationCount=10]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 TupleCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000000;
+		const int32 IterationCount = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10;
+		FHoudiniDataConversion::RunBenchmark(TupleCount, IterationCount);
+	}));
+
+namespace
+{
+	// Loads the first three floats of a tuple, the last lane is undefined.
+	// A full vector is loaded when the buffer extends past the tuple, which is cheaper than assembling it.
+	FORCEINLINE VectorRegister
+	LoadFloat3(const float* InData, const bool& bCanLoadFloat4)
+	{
+		return bCanLoadFloat4 ? VectorLoad(InData) : VectorLoadFloat3(InData);
+	}
+
+	// Swaps the Y and Z of a tuple and scales it
+	FORCEINLINE void
+	ConvertTuple(TArrayView<const float> InData, const int32& InOffset, const VectorRegister& InScale, FVector& OutVector)
+	{
+		const VectorRegister Tuple = LoadFloat3(InData.GetData() + InOffset, InOffset + 4 <= InData.Num());
+		VectorStoreFloat3(VectorMultiply(VectorSwizzle(Tuple, 0, 2, 1, 3), InScale), &OutVector);
+	}
+
+	// Swaps the Y and Z of 4 contiguous xyz tuples held in 3 registers:
+	// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 becomes x0 z0 y0 x1 | z1 y1 x2 z2 | y2 x3 z3 y3
+	FORCEINLINE void
+	SwapYZ4(VectorRegister& A, VectorRegister& B, VectorRegister& C)
+	{
+		const VectorRegister X2Z2 = VectorShuffle(B, C, 2, 2, 0, 0);
+		const VectorRegister Y2X3 = VectorShuffle(B, C, 3, 3, 1, 1);
+
+		A = VectorSwizzle(A, 0, 2, 1, 3);
+		B = VectorShuffle(B, X2Z2, 1, 0, 0, 2);
+		C = VectorShuffle(Y2X3, C, 0, 2, 3, 2);
+	}
+
+	// InScale must have the same value in all its lanes
+	void
+	ConvertTuples(TArrayView<const float> InData, const int32& InTupleSize, FVector* OutVectors, const VectorRegister& InScale)
+	{
+		if (InTupleSize < 3)
+			return;
+
+		const int32 TupleCount = InData.Num() / InTupleSize;
+		if (TupleCount <= 0)
+			return;
+
+		int32 TupleIdx = 0;
+		if (InTupleSize == 3)
+		{
+			// Both buffers are contiguous xyz tuples, and the scale is the same for all lanes:
+			// 4 tuples are scaled as 3 registers, then only their Y and Z are swapped
+			const float* Data = InData.GetData();
+			float* OutData = &OutVectors[0].X;
+			for (; TupleIdx + 4 <= TupleCount; TupleIdx += 4)
+			{
+				const int32 Offset = TupleIdx * 3;
+				VectorRegister A = VectorMultiply(VectorLoad(Data + Offset), InScale);
+				VectorRegister B = VectorMultiply(VectorLoad(Data + Offset + 4), InScale);
+				VectorRegister C = VectorMultiply(VectorLoad(Data + Offset + 8), InScale);
+				SwapYZ4(A, B, C);
+				VectorStore(A, OutData + Offset);
+				VectorStore(B, OutData + Offset + 4);
+				VectorStore(C, OutData + Offset + 8);
+			}
+		}
+
+		for (; TupleIdx < TupleCount; TupleIdx++)
+			ConvertTuple(InData, TupleIdx * InTupleSize, InScale, OutVectors[TupleIdx]);
+	}
+
+	int32
+	ConvertTuples(
+		TArrayView<const float> InData, const int32& InTupleSize, TArrayView<const int32> InIndices,
+		FVector* OutVectors, const VectorRegister& InScale)
+	{
+		if (InTupleSize < 3)
+			return InIndices.Num();
+
+		const int32 TupleCount = InData.Num() / InTupleSize;
+		int32 SkippedCount = 0;
+		for (int32 Idx = 0; Idx < InIndices.Num(); Idx++)
+		{
+			const int32 TupleIdx = InIndices[Idx];
+			if (TupleIdx < 0 || TupleIdx >= TupleCount)
+			{
+				SkippedCount++;
+				continue;
+			}
+
+			ConvertTuple(InData, TupleIdx * InTupleSize, InScale, OutVectors[Idx]);
+		}
+
+		return SkippedCount;
+	}
+}
+
+void
+FHoudiniDataConversion::IntToFloat(const int32* InData, float* OutData, const int32& InNum)
+{
+	int32 Idx = 0;
+	for (; Idx + 4 <= InNum; Idx += 4)
+	{
+		// Loads and stores are unaligned, the buffers are only guaranteed to be aligned on their elements
+		const VectorRegisterInt IntValues = VectorIntLoad(InData + Idx);
+		VectorStore(VectorIntToFloat(IntValues), OutData + Idx);
+	}
+
+	for (; Idx < InNum; Idx++)
+		OutData[Idx] = (float)InData[Idx];
+}
+
+void
+FHoudiniDataConversion::FloatToInt(const float* InData, int32* OutData, const int32& InNum)
+{
+	int32 Idx = 0;
+	for (; Idx + 4 <= InNum; Idx += 4)
+	{
+		const VectorRegister FloatValues = VectorLoad(InData + Idx);
+		VectorIntStore(VectorFloatToInt(FloatValues), OutData + Idx);
+	}
+
+	for (; Idx < InNum; Idx++)
+		OutData[Idx] = (int32)InData[Idx];
+}
+
+void
+FHoudiniDataConversion::HoudiniToUnrealPositions(TArrayView<const float> InData, const int32& InTupleSize, FVector* OutPositions)
+{
+	ConvertTuples(InData, InTupleSize, OutPositions, VectorSetFloat1(HAPI_UNREAL_SCALE_FACTOR_POSITION));
+}
+
+int32
+FHoudiniDataConversion::HoudiniToUnrealPositions(
+	TArrayView<const float> InData, const int32& InTupleSize, TArrayView<const int32> InIndices, FVector* OutPositions)
+{
+	return ConvertTuples(InData, InTupleSize, InIndices, OutPositions, VectorSetFloat1(HAPI_UNREAL_SCALE_FACTOR_POSITION));
+}
+
+void
+FHoudiniDataConversion::HoudiniToUnrealVectors(TArrayView<const float> InData, const int32& InTupleSize, FVector* OutVectors)
+{
+	ConvertTuples(InData, InTupleSize, OutVectors, VectorOne());
+}
+
+int32
+FHoudiniDataConversion::HoudiniToUnrealVectors(
+	TArrayView<const float> InData, const int32& InTupleSize, TArrayView<const int32> InIndices, FVector* OutVectors)
+{
+	return ConvertTuples(InData, InTupleSize, InIndices, OutVectors, VectorOne());
+}
+
+void
+FHoudiniDataConversion::HoudiniToUnrealTransforms(const HAPI_Transform* InTransforms, FTransform* OutTransforms, const int32& InNum)
+{
+	const VectorRegister TranslationScale = VectorSetFloat1(HAPI_UNREAL_SCALE_FACTOR_TRANSLATION);
+	// Swapping Y and Z changes the handedness, which inverts the rotations
+	const VectorRegister RotationSign = MakeVectorRegister(1.0f, 1.0f, 1.0f, -1.0f);
+
+	for (int32 Idx = 0; Idx < InNum; Idx++)
+	{
+		const HAPI_Transform& HapiTransform = InTransforms[Idx];
+
+		FQuat Rotation;
+		FVector Translation;
+		if (HAPI_UNREAL_CONVERT_COORDINATE_SYSTEM)
+		{
+			// Swap Y/Z, invert W
+			VectorStore(
+				VectorMultiply(VectorSwizzle(VectorLoad(HapiTransform.rotationQuaternion), 0, 2, 1, 3), RotationSign),
+				&Rotation.X);
+
+			// Swap Y/Z and scale
+			VectorStoreFloat3(
+				VectorMultiply(VectorSwizzle(VectorLoadFloat3(HapiTransform.position), 0, 2, 1, 3), TranslationScale),
+				&Translation);
+		}
+		else
+		{
+			VectorStore(VectorLoad(HapiTransform.rotationQuaternion), &Rotation.X);
+			VectorStoreFloat3(VectorMultiply(VectorLoadFloat3(HapiTransform.position), TranslationScale), &Translation);
+		}
+
+		// The scale is kept as is in both cases
+		const FVector Scale3D(HapiTransform.scale[0], HapiTransform.scale[1], HapiTransform.scale[2]);
+
+		OutTransforms[Idx].SetComponents(Rotation, Translation, Scale3D);
+	}
+}
+
+void
+FHoudiniDataConversion::UnrealToHoudiniPositions(
+	const FVector* InPositions, const int32& InNum, float* OutData, const FVector& InScale)
+{
+	const VectorRegister PositionScale = VectorSetFloat1(HAPI_UNREAL_SCALE_FACTOR_POSITION);
+	const VectorRegister Scale = MakeVectorRegister(InScale.X, InScale.Y, InScale.Z, 1.0f);
+
+	// 4 positions are loaded as 3 registers, each with its own scale pattern
+	const VectorRegister ScaleA = MakeVectorRegister(InScale.X, InScale.Y, InScale.Z, InScale.X);
+	const VectorRegister ScaleB = MakeVectorRegister(InScale.Y, InScale.Z, InScale.X, InScale.Y);
+	const VectorRegister ScaleC = MakeVectorRegister(InScale.Z, InScale.X, InScale.Y, InScale.Z);
+	if (InNum <= 0)
+		return;
+
+	const float* InData = &InPositions[0].X;
+
+	int32 Idx = 0;
+	for (; Idx + 4 <= InNum; Idx += 4)
+	{
+		const int32 Offset = Idx * 3;
+		VectorRegister A = VectorMultiply(VectorDivide(VectorLoad(InData + Offset), PositionScale), ScaleA);
+		VectorRegister B = VectorMultiply(VectorDivide(VectorLoad(InData + Offset + 4), PositionScale), ScaleB);
+		VectorRegister C = VectorMultiply(VectorDivide(VectorLoad(InData + Offset + 8), PositionScale), ScaleC);
+		SwapYZ4(A, B, C);
+		VectorStore(A, OutData + Offset);
+		VectorStore(B, OutData + Offset + 4);
+		VectorStore(C, OutData + Offset + 8);
+	}
+
+	for (; Idx < InNum; Idx++)
+	{
+		// The positions are contiguous, a full vector can be loaded for all of them but the last
+		const VectorRegister Position = LoadFloat3(&InPositions[Idx].X, Idx + 1 < InNum);
+		const VectorRegister Converted = VectorMultiply(VectorDivide(Position, PositionScale), Scale);
+
+		// Swap Y/Z
+		VectorStoreFloat3(VectorSwizzle(Converted, 0, 2, 1, 3), OutData + Idx * 3);
+	}
+}
+
+void
+FHoudiniDataConversion::HoudiniToUnrealUVs(TArrayView<const float> InData, FVector2D* OutUVs)
+{
+	// V becomes 1 - V, 2 UVs per register
+	const VectorRegister FlipSign = MakeVectorRegister(1.0f, -1.0f, 1.0f, -1.0f);
+	const VectorRegister FlipOffset = MakeVectorRegister(0.0f, 1.0f, 0.0f, 1.0f);
+
+	const int32 UVCount = InData.Num() / 2;
+	if (UVCount <= 0)
+		return;
+
+	const float* Data = InData.GetData();
+	float* OutData = &OutUVs[0].X;
+
+	int32 Idx = 0;
+	for (; Idx + 2 <= UVCount; Idx += 2)
+		VectorStore(VectorMultiplyAdd(VectorLoad(Data + Idx * 2), FlipSign, FlipOffset), OutData + Idx * 2);
+
+	for (; Idx < UVCount; Idx++)
+		OutUVs[Idx] = FVector2D(Data[Idx * 2 + 0], 1.0f - Data[Idx * 2 + 1]);
+}
+
+void
+FHoudiniDataConversion::UnrealToHoudiniUVs(const FVector2D* InUVs, const int32& InNum, float* OutData)
+{
+	if (InNum <= 0)
+		return;
+
+	const VectorRegister FlipSign = MakeVectorRegister(1.0f, -1.0f, 1.0f, -1.0f);
+	const VectorRegister FlipOffset = MakeVectorRegister(0.0f, 1.0f, 0.0f, 1.0f);
+	const VectorRegister Zero = VectorZero();
+	const float* InData = &InUVs[0].X;
+
+	int32 Idx = 0;
+	for (; Idx + 4 <= InNum; Idx += 4)
+	{
+		// u0 v0 u1 v1 | u2 v2 u3 v3 becomes u0 v0 0 u1 | v1 0 u2 v2 | 0 u3 v3 0
+		const VectorRegister A = VectorMultiplyAdd(VectorLoad(InData + Idx * 2), FlipSign, FlipOffset);
+		const VectorRegister B = VectorMultiplyAdd(VectorLoad(InData + Idx * 2 + 4), FlipSign, FlipOffset);
+		const VectorRegister U1 = VectorShuffle(A, Zero, 2, 2, 0, 0);
+		const VectorRegister V1 = VectorShuffle(A, Zero, 3, 3, 0, 0);
+		const VectorRegister U3V3 = VectorShuffle(Zero, B, 0, 0, 2, 3);
+
+		float* Out = OutData + Idx * 3;
+		VectorStore(VectorShuffle(A, U1, 0, 1, 2, 0), Out);
+		VectorStore(VectorShuffle(V1, B, 0, 2, 0, 1), Out + 4);
+		VectorStore(VectorSwizzle(U3V3, 0, 2, 3, 0), Out + 8);
+	}
+
+	for (; Idx < InNum; Idx++)
+	{
+		OutData[Idx * 3 + 0] = InUVs[Idx].X;
+		OutData[Idx * 3 + 1] = 1.0f - InUVs[Idx].Y;
+		OutData[Idx * 3 + 2] = 0.0f;
+	}
+}
+
+void
+FHoudiniDataConversion::RunBenchmark(const int32& InTupleCount, const int32& InIterationCount)
+{
+	const int32 TupleCount = FMath::Clamp(InTupleCount, 1, 64 * 1024 * 1024);
+	const int32 IterationCount = FMath::Clamp(InIterationCount, 1, 1000);
+
+	FRandomStream RandomStream(TupleCount);
+	TArray<float> HoudiniData;
+	HoudiniData.SetNumUninitialized(TupleCount * 3);
+	for (float& Value : HoudiniData)
+		Value = RandomStream.FRandRange(-100.0f, 100.0f);
+
+	TArray<FVector> UnrealPositions;
+	UnrealPositions.SetNumUninitialized(TupleCount);
+	TArray<FVector> ReferencePositions;
+	ReferencePositions.SetNumUninitialized(TupleCount);
+	TArray<float> HoudiniOutData;
+	HoudiniOutData.SetNumUninitialized(TupleCount * 3);
+	TArray<float> ReferenceOutData;
+	ReferenceOutData.SetNumUninitialized(TupleCount * 3);
+	TArray<FVector2D> UnrealUVs;
+	UnrealUVs.SetNumUninitialized(TupleCount);
+	TArray<FVector2D> ReferenceUVs;
+	ReferenceUVs.SetNumUninitialized(TupleCount);
+
+	const FVector BuildScale(1.0f, 2.0f, 3.0f);
+	TArrayView<const float> HoudiniUVData(HoudiniData.GetData(), TupleCount * 2);
+
+	// Returns the average duration of an iteration, in ms
+	auto TimeIterations = [IterationCount](TFunctionRef<void()> Iteration)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Idx = 0; Idx < IterationCount; Idx++)
+			Iteration();
+
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / IterationCount;
+	};
+
+	auto MaxDifference = [](const float* A, const float* B, const int32& Num)
+	{
+		float MaxDiff = 0.0f;
+		for (int32 Idx = 0; Idx < Num; Idx++)
+			MaxDiff = FMath::Max(MaxDiff, FMath::Abs(A[Idx] - B[Idx]));
+
+		return MaxDiff;
+	};
+
+	auto LogResult = [TupleCount](const TCHAR* Name, const double& ScalarTime, const double& KernelTime, const float& MaxDiff)
+	{
+		HOUDINI_LOG_DISPLAY(
+			TEXT("Data conversion benchmark: %s - %d tuples - scalar %.3f ms, kernel %.3f ms (x%.2f) - max difference %g"),
+			Name, TupleCount, ScalarTime, KernelTime, KernelTime > 0.0 ? ScalarTime / KernelTime : 0.0, MaxDiff);
+	};
+
+	// Houdini to Unreal positions
+	{
+		const double ScalarTime = TimeIterations([&]()
+		{
+			for (int32 Idx = 0; Idx < TupleCount; Idx++)
+			{
+				ReferencePositions[Idx].X = HoudiniData[Idx * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+				ReferencePositions[Idx].Y = HoudiniData[Idx * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+				ReferencePositions[Idx].Z = HoudiniData[Idx * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+			}
+		});
+		const double KernelTime = TimeIterations([&]()
+		{
+			HoudiniToUnrealPositions(HoudiniData, 3, UnrealPositions.GetData());
+		});
+		LogResult(TEXT("HoudiniToUnrealPositions"), ScalarTime, KernelTime,
+			MaxDifference(&ReferencePositions[0].X, &UnrealPositions[0].X, TupleCount * 3));
+	}
+
+	// Unreal to Houdini positions
+	{
+		const double ScalarTime = TimeIterations([&]()
+		{
+			for (int32 Idx = 0; Idx < TupleCount; Idx++)
+			{
+				const FVector& Position = UnrealPositions[Idx];
+				ReferenceOutData[Idx * 3 + 0] = Position.X / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScale.X;
+				ReferenceOutData[Idx * 3 + 1] = Position.Z / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScale.Z;
+				ReferenceOutData[Idx * 3 + 2] = Position.Y / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScale.Y;
+			}
+		});
+		const double KernelTime = TimeIterations([&]()
+		{
+			UnrealToHoudiniPositions(UnrealPositions.GetData(), TupleCount, HoudiniOutData.GetData(), BuildScale);
+		});
+		LogResult(TEXT("UnrealToHoudiniPositions"), ScalarTime, KernelTime,
+			MaxDifference(ReferenceOutData.GetData(), HoudiniOutData.GetData(), TupleCount * 3));
+	}
+
+	// Houdini to Unreal UVs
+	{
+		const double ScalarTime = TimeIterations([&]()
+		{
+			for (int32 Idx = 0; Idx < TupleCount; Idx++)
+			{
+				ReferenceUVs[Idx].X = HoudiniUVData[Idx * 2 + 0];
+				ReferenceUVs[Idx].Y = 1.0f - HoudiniUVData[Idx * 2 + 1];
+			}
+		});
+		const double KernelTime = TimeIterations([&]()
+		{
+			HoudiniToUnrealUVs(HoudiniUVData, UnrealUVs.GetData());
+		});
+		LogResult(TEXT("HoudiniToUnrealUVs"), ScalarTime, KernelTime,
+			MaxDifference(&ReferenceUVs[0].X, &UnrealUVs[0].X, TupleCount * 2));
+	}
+
+	// Unreal to Houdini UVs
+	{
+		const double ScalarTime = TimeIterations([&]()
+		{
+			for (int32 Idx = 0; Idx < TupleCount; Idx++)
+			{
+				ReferenceOutData[Idx * 3 + 0] = UnrealUVs[Idx].X;
+				ReferenceOutData[Idx * 3 + 1] = 1.0f - UnrealUVs[Idx].Y;
+				ReferenceOutData[Idx * 3 + 2] = 0.0f;
+			}
+		});
+		const double KernelTime = TimeIterations([&]()
+		{
+			UnrealToHoudiniUVs(UnrealUVs.GetData(), TupleCount, HoudiniOutData.GetData());
+		});
+		LogResult(TEXT("UnrealToHoudiniUVs"), ScalarTime, KernelTime,
+			MaxDifference(ReferenceOutData.GetData(), HoudiniOutData.GetData(), TupleCount * 3));
+	}
+}
@@ -0,0 +1,79 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "HAPI/HAPI_Common.h"
+
+#include "CoreMinimal.h"
+
+// Conversion kernels for the data exchanged with HAPI, shared by the translators.
+// They use the engine's vector intrinsics (SSE or NEON, with the engine's scalar fallback on other platforms).
+// The coordinate system conversions swap Y and Z, and scale positions between Houdini's meters and Unreal's centimeters.
+// Contiguous xyz tuples are converted 4 at a time, loaded as 3 registers and deinterleaved with shuffles.
+struct HOUDINIENGINE_API FHoudiniDataConversion
+{
+public:
+
+	// Converts integers to floats
+	static void IntToFloat(const int32* InData, float* OutData, const int32& InNum);
+
+	// Converts floats to integers, truncating them towards zero like a cast
+	static void FloatToInt(const float* InData, int32* OutData, const int32& InNum);
+
+	// Converts Houdini positions to Unreal positions.
+	// InData holds tuples of InTupleSize (3 or more) floats, OutPositions must have room for all of them.
+	static void HoudiniToUnrealPositions(TArrayView<const float> InData, const int32& InTupleSize, FVector* OutPositions);
+
+	// Same as above, but only converts the tuples listed in InIndices, OutPositions must have room for each index.
+	// Out of range indices are skipped and their output left untouched. Returns the number of skipped indices.
+	static int32 HoudiniToUnrealPositions(
+		TArrayView<const float> InData, const int32& InTupleSize, TArrayView<const int32> InIndices, FVector* OutPositions);
+
+	// Same as above for directions (normals, tangents...), which aren't scaled
+	static void HoudiniToUnrealVectors(TArrayView<const float> InData, const int32& InTupleSize, FVector* OutVectors);
+
+	static int32 HoudiniToUnrealVectors(
+		TArrayView<const float> InData, const int32& InTupleSize, TArrayView<const int32> InIndices, FVector* OutVectors);
+
+	// Converts HAPI transforms to Unreal transforms
+	static void HoudiniToUnrealTransforms(const HAPI_Transform* InTransforms, FTransform* OutTransforms, const int32& InNum);
+
+	// Converts Unreal positions to Houdini positions, OutData receives 3 floats per position.
+	// InScale is applied to the Unreal positions (a mesh's build scale for example).
+	static void UnrealToHoudiniPositions(
+		const FVector* InPositions, const int32& InNum, float* OutData, const FVector& InScale = FVector::OneVector);
+
+	// Converts Houdini UVs to Unreal UVs by flipping V.
+	// InData holds pairs of floats, OutUVs must have room for all of them.
+	static void HoudiniToUnrealUVs(TArrayView<const float> InData, FVector2D* OutUVs);
+
+	// Converts Unreal UVs to Houdini UVs by flipping V, OutData receives 3 floats per UV (the last one being 0).
+	static void UnrealToHoudiniUVs(const FVector2D* InUVs, const int32& InNum, float* OutData);
+
+	// Compares the kernels with the equivalent scalar loops on random data, and logs their throughput.
+	static void RunBenchmark(const int32& InTupleCount, const int32& InIterationCount);
+};
@@ -30,7 +30,11 @@
 #include "HoudiniEnginePrivatePCH.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiRecording.h"
+#include "HoudiniApiSynthetic.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineRuntime.h"
 #include "HoudiniEngineRuntimeUtils.h"
 #include "HoudiniRuntimeSettings.h"
 #include "HoudiniEngineScheduler.h"
@@ -38,16 +42,23 @@
 #include "HoudiniEngineTask.h"
 #include "HoudiniEngineTaskInfo.h"
 #include "HoudiniAssetComponent.h"
+#include "HoudiniAsset.h"
 #include "HAPI/HAPI_Version.h"
 
 #include "Modules/ModuleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "Misc/ScopeLock.h"
+#include "Async/Async.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/Material.h"
 #include "ISettingsModule.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
 
 #if WITH_EDITOR
+	#include "Editor.h"
 	#include "Widgets/Notifications/SNotificationList.h"
 	#include "Framework/Notifications/NotificationManager.h"
 #endif
@@ -57,6 +68,172 @@
 IMPLEMENT_MODULE(FHoudiniEngine, HoudiniEngine)
 DEFINE_LOG_CATEGORY( LogHoudiniEngine );
 
+static FAutoConsoleCommand CCmdHoudiniEngineSchedulerStats(
+	TEXT("HoudiniEngine.SchedulerStats"),
+	TEXT("Logs the Houdini Engine scheduler's queue counters."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FHoudiniEngineSchedulerStats Stats;
+		if (!FHoudiniEngine::IsInitialized() || !FHoudiniEngine::Get().GetSchedulerStats(Stats))
+			return;
+
+		const double AverageWaitTime = Stats.ProcessedTaskCount > 0 ? Stats.TotalTaskWaitTime / Stats.ProcessedTaskCount : 0.0;
+		HOUDINI_LOG_DISPLAY(
+			TEXT("Scheduler: %d queued, %d processed, %d coalesced - wait time: last %.3f ms, avg %.3f ms, max %.3f ms"),
+			Stats.QueueDepth, Stats.ProcessedTaskCount, Stats.CoalescedTaskCount,
+			Stats.LastTaskWaitTime * 1000.0, AverageWaitTime * 1000.0, Stats.MaxTaskWaitTime * 1000.0);
+		HOUDINI_LOG_DISPLAY(
+			TEXT("Scheduler: %d cooks completed, %d cooks cancelled (outdated)"),
+			Stats.CompletedCookCount, Stats.CancelledCookCount);
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineAssetLibraryCacheStats(
+	TEXT("HoudiniEngine.AssetLibraryCacheStats"),
+	TEXT("Logs the HDA libraries loaded in the Houdini Engine sessions and the cache's hit/miss counters."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (!FHoudiniEngine::IsInitialized())
+			return;
+
+		FHoudiniEngine::Get().GetAssetLibraryCache().LogStats();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineCookCacheStats(
+	TEXT("HoudiniEngine.CookCacheStats"),
+	TEXT("Logs the Houdini Engine cook cache's hit rate and the number of recooks it skipped."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (!FHoudiniEngine::IsInitialized())
+			return;
+
+		FHoudiniEngine::Get().GetCookCache().LogStats();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineCookCacheClear(
+	TEXT("HoudiniEngine.CookCacheClear"),
+	TEXT("Forgets all the cooks recorded by the Houdini Engine cook cache."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (!FHoudiniEngine::IsInitialized())
+			return;
+
+		FHoudiniEngine::Get().GetCookCache().Empty();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineAttributeCacheStats(
+	TEXT("HoudiniEngine.AttributeCacheStats"),
+	TEXT("Logs the size of the Houdini Engine attribute cache and its hit/miss counters."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (!FHoudiniEngine::IsInitialized())
+			return;
+
+		FHoudiniEngine::Get().GetAttributeCache().LogStats();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineAttributeCacheClear(
+	TEXT("HoudiniEngine.AttributeCacheClear"),
+	TEXT("Forgets all the attributes kept by the Houdini Engine attribute cache."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (!FHoudiniEngine::IsInitialized())
+			return;
+
+		FHoudiniEngine::Get().GetAttributeCache().Empty();
+	}));
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineApiTrace(
+	TEXT("HoudiniEngine.ApiTrace"),
+	0,
+	TEXT("Traces the HAPI calls: counts, latency and transferred bytes per call, HoudiniApi stats group and Insights channel.\n")
+	TEXT("0: Disabled (default)\n")
+	TEXT("1: Enabled"));
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineCookStats(
+	TEXT("HoudiniEngine.CookStats"),
+	0,
+	TEXT("Records the time and data transferred by each phase of the HACs' cooks, shown in their details panel.\n")
+	TEXT("0: Disabled (default)\n")
+	TEXT("1: Enabled"));
+
+static FAutoConsoleCommand CCmdHoudiniEngineApiTraceStats(
+	TEXT("HoudiniEngine.ApiTraceStats"),
+	TEXT("Logs the traced HAPI calls with the highest cumulative time, and the time spent in HAPI per translator. Optional: number of calls to log (default 20)."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 MaxCallCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20;
+		FHoudiniApiTrace::LogStats(MaxCallCount);
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineApiTraceWriteCSV(
+	TEXT("HoudiniEngine.ApiTraceWriteCSV"),
+	TEXT("Writes the HAPI call trace counters to a CSV file. Optional: file path (default Saved/HoudiniEngine/ApiTrace.csv)."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FHoudiniApiTrace::WriteCSV(Args.Num() > 0 ? Args[0] : FHoudiniApiTrace::GetDefaultCSVFilePath());
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineApiTraceReset(
+	TEXT("HoudiniEngine.ApiTraceReset"),
+	TEXT("Clears the HAPI call trace counters."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FHoudiniApiTrace::Reset();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineApiRecordStart(
+	TEXT("HoudiniEngine.ApiRecordStart"),
+	TEXT("Records the HAPI calls so they can be replayed without Houdini with -HoudiniApiReplay=. Optional: file path (default Saved/HoudiniEngine/ApiRecording.hapirec)."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FHoudiniApiRecording::StartRecording(Args.Num() > 0 ? Args[0] : FHoudiniApiRecording::GetDefaultFilePath());
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineApiRecordStop(
+	TEXT("HoudiniEngine.ApiRecordStop"),
+	TEXT("Stops recording the HAPI calls."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FHoudiniApiRecording::StopRecording();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniEngineApiRecordingStats(
+	TEXT("HoudiniEngine.ApiRecordingStats"),
+	TEXT("Logs the number of HAPI calls recorded, or how the replayed calls matched the recording."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FHoudiniApiRecording::LogStats();
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CCmdHoudiniEngineSyntheticBenchmark(
+	TEXT("HoudiniEngine.SyntheticBenchmark"),
+	TEXT("Runs the output translators on a synthetic HAPI scene and logs their throughput. Optional: triangles per mesh part, instance count, heightfield size, mesh part count."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		FHoudiniSyntheticSceneSizes Sizes;
+		if (Args.Num() > 0)
+			Sizes.TrianglesPerPart = FCString::Atoi(*Args[0]);
+		if (Args.Num() > 1)
+			Sizes.InstanceCount = FCString::Atoi(*Args[1]);
+		if (Args.Num() > 2)
+			Sizes.HeightfieldSize = FCString::Atoi(*Args[2]);
+		if (Args.Num() > 3)
+			Sizes.MeshPartCount = FCString::Atoi(*Args[3]);
+
+		FHoudiniApiSynthetic::RunBenchmark(Sizes, World);
+	}));
+
+FHoudiniEngineScopedSession::FHoudiniEngineScopedSession(const int32& InSessionIndex)
+	: PreviousSessionIndex(FHoudiniEngineRuntime::GetCurrentSessionIndex())
+{
+	FHoudiniEngineRuntime::SetCurrentSessionIndex(InSessionIndex);
+}
+
+FHoudiniEngineScopedSession::~FHoudiniEngineScopedSession()
+{
+	FHoudiniEngineRuntime::SetCurrentSessionIndex(PreviousSessionIndex);
+}
+
 FHoudiniEngine *
 FHoudiniEngine::HoudiniEngineInstance = nullptr;
 
@@ -119,14 +296,29 @@ FHoudiniEngine::StartupModule()
 			LOCTEXT("RuntimeSettingsDescription", "Configure the HoudiniEngine plugin"),
 			GetMutableDefault< UHoudiniRuntimeSettings >());
 	}
+
+	// Preload the HDA libraries of the maps when they're opened
+	OnMapOpenedHandle = FEditorDelegates::OnMapOpened.AddRaw(this, &FHoudiniEngine::OnMapOpened);
 #endif
 
 	// Before starting the module, we need to locate and load HAPI library.
+	// When replaying a recording of the HAPI calls, the recording answers them and Houdini isn't needed.
+	FString HoudiniApiReplayFile;
+	if (FParse::Value(FCommandLine::Get(), TEXT("HoudiniApiReplay="), HoudiniApiReplayFile))
+	{
+		FHoudiniApiRecording::StartReplay(HoudiniApiReplayFile);
+	}
+	else
 	{
 		void * HAPILibraryHandle = FHoudiniEngineUtils::LoadLibHAPI(LibHAPILocation);
 		if ( HAPILibraryHandle )
 		{
 			FHoudiniApi::InitializeHAPI( HAPILibraryHandle );
+
+			// Record from startup so the session creation is part of the recording
+			FString HoudiniApiRecordFile;
+			if (FParse::Value(FCommandLine::Get(), TEXT("HoudiniApiRecord="), HoudiniApiRecordFile))
+				FHoudiniApiRecording::StartRecording(HoudiniApiRecordFile);
 		}
 		else
 		{
@@ -136,6 +328,33 @@ FHoudiniEngine::StartupModule()
 		}
 	}
 
+	if (FHoudiniApi::IsHAPIInitialized())
+	{
+		// Record the HACs' cook stats if requested, and whenever the cvar changes
+		if (CVarHoudiniEngineCookStats.GetValueOnAnyThread() != 0)
+			FHoudiniApiTrace::StartCookStats();
+
+		CVarHoudiniEngineCookStats->SetOnChangedCallback(FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* InVariable)
+		{
+			if (InVariable->GetInt() != 0)
+				FHoudiniApiTrace::StartCookStats();
+			else
+				FHoudiniApiTrace::StopCookStats();
+		}));
+
+		// Trace the HAPI calls if requested, and whenever the cvar changes
+		if (CVarHoudiniEngineApiTrace.GetValueOnAnyThread() != 0)
+			FHoudiniApiTrace::Start();
+
+		CVarHoudiniEngineApiTrace->SetOnChangedCallback(FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* InVariable)
+		{
+			if (InVariable->GetInt() != 0)
+				FHoudiniApiTrace::Start();
+			else
+				FHoudiniApiTrace::Stop();
+		}));
+	}
+
 	// Create static mesh Houdini logo.
 	HoudiniLogoStaticMesh = LoadObject<UStaticMesh>(
 		nullptr, HAPI_UNREAL_RESOURCE_HOUDINI_LOGO, nullptr, LOAD_None, nullptr);
@@ -259,12 +478,17 @@ FHoudiniEngine::ShutdownModule()
 	*/
 
 #if WITH_EDITOR
+	FEditorDelegates::OnMapOpened.Remove(OnMapOpenedHandle);
+
 	// Unregister settings.
 	ISettingsModule * SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
 	if (SettingsModule)
 		SettingsModule->UnregisterSettings("Project", "Plugins", "HoudiniEngine");
 #endif
 
+	// Stop the pooled sessions and their schedulers
+	StopSessionPool();
+
 	// Do scheduler and thread clean up.
 	if (HoudiniEngineScheduler)
 		HoudiniEngineScheduler->Stop();
@@ -301,51 +525,74 @@ FHoudiniEngine::ShutdownModule()
 		FHoudiniApi::CloseSession(GetSession());
 	}
 
+	FHoudiniApiTrace::Stop();
+	FHoudiniApiTrace::StopCookStats();
+	FHoudiniApiRecording::StopRecording();
+	FHoudiniApiRecording::StopReplay();
 	FHoudiniApi::FinalizeHAPI();
 
 	FHoudiniEngine::HoudiniEngineInstance = nullptr;
 }
 
-void
+FHoudiniEngineTaskHandlePtr
 FHoudiniEngine::AddTask(const FHoudiniEngineTask & InTask)
 {
-	if ( HoudiniEngineScheduler )
-		HoudiniEngineScheduler->AddTask(InTask);
+	FHoudiniEngineTask NewTask(InTask);
+	if (!NewTask.Handle.IsValid())
+		NewTask.Handle = MakeShared<FHoudiniEngineTaskHandle, ESPMode::ThreadSafe>(NewTask.HapiGUID, NewTask.TaskType);
 
-	FScopeLock ScopeLock(&CriticalSection);
-	FHoudiniEngineTaskInfo TaskInfo;
-	TaskInfo.TaskType = InTask.TaskType;
-	TaskInfo.TaskState = EHoudiniEngineTaskState::Working;
-
-	TaskInfos.Add(InTask.HapiGUID, TaskInfo);
-}
+	FHoudiniEngineTaskHandlePtr TaskHandle = NewTask.Handle;
 
-void
-FHoudiniEngine::AddTaskInfo(const FGuid& InHapiGUID, const FHoudiniEngineTaskInfo & InTaskInfo)
-{
-	FScopeLock ScopeLock(&CriticalSection);
-	TaskInfos.Add(InHapiGUID, InTaskInfo);
-}
+	// Tasks go to the scheduler of the session they target,
+	// the calling thread's session if none was specified
+	const int32 SessionIndex = NewTask.SessionIndex >= 0 ? NewTask.SessionIndex : FHoudiniEngineRuntime::GetCurrentSessionIndex();
+	if (SessionIndex > 0 && PooledSchedulers.IsValidIndex(SessionIndex - 1))
+	{
+		NewTask.SessionIndex = SessionIndex;
+		PooledSchedulers[SessionIndex - 1]->AddTask(MoveTemp(NewTask));
+	}
+	else if ( HoudiniEngineScheduler )
+	{
+		HoudiniEngineScheduler->AddTask(MoveTemp(NewTask));
+	}
+	else
+	{
+		// No scheduler to run the task
+		FHoudiniEngineTaskInfo TaskInfo(HAPI_RESULT_NOT_INITIALIZED, NewTask.AssetId, NewTask.TaskType, EHoudiniEngineTaskState::Aborted);
+		TaskInfo.StatusText = LOCTEXT("TaskAbortedNoScheduler", "Houdini Engine is not running.");
+		TaskHandle->SetTaskInfo(TaskInfo);
+	}
 
-void
-FHoudiniEngine::RemoveTaskInfo(const FGuid& InHapiGUID)
-{
-	FScopeLock ScopeLock(&CriticalSection);
-	TaskInfos.Remove(InHapiGUID);
+	return TaskHandle;
 }
 
 bool
-FHoudiniEngine::RetrieveTaskInfo(const FGuid& InHapiGUID, FHoudiniEngineTaskInfo & OutTaskInfo)
+FHoudiniEngine::GetSchedulerStats(FHoudiniEngineSchedulerStats& OutStats) const
 {
-	FScopeLock ScopeLock(&CriticalSection);
+	if (!HoudiniEngineScheduler)
+		return false;
 
-	if (TaskInfos.Contains(InHapiGUID))
+	HoudiniEngineScheduler->GetStats(OutStats);
+
+	// Accumulate the pooled schedulers' counters
+	for (FHoudiniEngineScheduler* PooledScheduler : PooledSchedulers)
 	{
-		OutTaskInfo = TaskInfos[InHapiGUID];
-		return true;
+		if (!PooledScheduler)
+			continue;
+
+		FHoudiniEngineSchedulerStats PooledStats;
+		PooledScheduler->GetStats(PooledStats);
+
+		OutStats.QueueDepth += PooledStats.QueueDepth;
+		OutStats.CoalescedTaskCount += PooledStats.CoalescedTaskCount;
+		OutStats.ProcessedTaskCount += PooledStats.ProcessedTaskCount;
+		OutStats.CompletedCookCount += PooledStats.CompletedCookCount;
+		OutStats.CancelledCookCount += PooledStats.CancelledCookCount;
+		OutStats.TotalTaskWaitTime += PooledStats.TotalTaskWaitTime;
+		OutStats.MaxTaskWaitTime = FMath::Max(OutStats.MaxTaskWaitTime, PooledStats.MaxTaskWaitTime);
 	}
 
-	return false;
+	return true;
 }
 
 /*
@@ -369,7 +616,32 @@ FHoudiniEngine::GetLibHAPILocation() const
 const HAPI_Session *
 FHoudiniEngine::GetSession() const
 {
-	return Session.type == HAPI_SESSION_MAX ? nullptr : &Session;
+	return GetSessionAt(FHoudiniEngineRuntime::GetCurrentSessionIndex());
+}
+
+const HAPI_Session *
+FHoudiniEngine::GetSessionAt(const int32& InSessionIndex) const
+{
+	if (InSessionIndex == 0)
+		return Session.type == HAPI_SESSION_MAX ? nullptr : &Session;
+
+	// Don't silently use the main session instead, the caller's nodes don't exist there
+	if (!PooledSessions.IsValidIndex(InSessionIndex - 1))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Invalid Houdini Engine session index %d (%d session(s) available)."), InSessionIndex, GetSessionCount());
+		return nullptr;
+	}
+
+	return PooledSessions[InSessionIndex - 1].type == HAPI_SESSION_MAX ? nullptr : &PooledSessions[InSessionIndex - 1];
+}
+
+bool
+FHoudiniEngine::IsSessionIndexValid(const int32& InSessionIndex) const
+{
+	if (InSessionIndex < 0 || InSessionIndex >= GetSessionCount())
+		return false;
+
+	return GetSessionAt(InSessionIndex) != nullptr;
 }
 
 HAPI_CookOptions
@@ -644,6 +916,34 @@ FHoudiniEngine::InitializeHAPISession()
 			TEXT("This could cause instabilities and crashes when using the Houdini Engine plugin"));
 	}
 
+	if (!InitializeHAPI(&Session))
+		return false;
+
+	if (bEnableSessionSync)
+	{
+		// Set the session sync infos if needed
+		UploadSessionSyncInfoToHoudini();
+
+		// Indicate that Session Sync is enabled
+		FString Notification = TEXT("Houdini Engine Session Sync enabled.");
+		FHoudiniEngineUtils::CreateSlateNotification(Notification);
+		HOUDINI_LOG_MESSAGE(TEXT("Houdini Engine Session Sync enabled."));		
+	}
+	else
+	{
+		// Start the additional sessions if needed
+		StartSessionPool();
+	}
+
+	// Load the HDA libraries used by the already opened level(s) before their first instantiation
+	PreloadAssetLibraries();
+
+	return true;
+}
+
+bool
+FHoudiniEngine::InitializeHAPI(const HAPI_Session* InSession)
+{
 	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
 
 	// Default CookOptions
@@ -651,7 +951,7 @@ FHoudiniEngine::InitializeHAPISession()
 
 	bool bUseCookingThread = true;
 	HAPI_Result Result = FHoudiniApi::Initialize(
-		&Session,
+		InSession,
 		&CookOptions,
 		bUseCookingThread,
 		HoudiniRuntimeSettings->CookingThreadStackSize,
@@ -680,29 +980,278 @@ FHoudiniEngine::InitializeHAPISession()
 	}
 
 	// Let HAPI know we are running inside UE4
-	FHoudiniApi::SetServerEnvString(&Session, HAPI_ENV_CLIENT_NAME, HAPI_UNREAL_CLIENT_NAME);
+	FHoudiniApi::SetServerEnvString(InSession, HAPI_ENV_CLIENT_NAME, HAPI_UNREAL_CLIENT_NAME);
+
+	return true;
+}
+
+void
+FHoudiniEngine::PreloadAssetLibraries(UWorld* InWorld)
+{
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+	if (!HoudiniRuntimeSettings || !HoudiniRuntimeSettings->bPreloadAssetLibraries)
+		return;
 
+	// The libraries are preloaded again once the session is started
+	if (!GetSession())
+		return;
+
+	// Gather the libraries used by the HACs of that world that are waiting for their instantiation,
+	// in the session each HAC will be instantiated in
+	TMap<TPair<int32, uint64>, FString> Libraries;
+	const int32 RegisteredCount = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentCount();
+	for (int32 Idx = 0; Idx < RegisteredCount; Idx++)
+	{
+		UHoudiniAssetComponent* HAC = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentAt(Idx);
+		if (!HAC || HAC->IsPendingKill() || HAC->GetAssetId() >= 0)
+			continue;
+
+		if (!HAC->GetWorld() || (InWorld && HAC->GetWorld() != InWorld))
+			continue;
+
+		UHoudiniAsset* HoudiniAsset = HAC->GetHoudiniAsset();
+		FString LibraryPath = FHoudiniEngineUtils::GetHoudiniAssetLibraryPath(HoudiniAsset);
+		if (LibraryPath.IsEmpty())
+			continue;
+
+		// Libraries without a source file are still loaded from memory on instantiation
+		if (!FPaths::FileExists(LibraryPath) && !(HoudiniAsset->IsExpandedHDA() && FPaths::DirectoryExists(LibraryPath)))
+			continue;
+
+		const int32 SessionIndex = HoudiniEngineManager ? HoudiniEngineManager->PreassignSessionForHoudiniAsset(HAC) : 0;
+		const uint64 LibraryHash = FHoudiniAssetLibraryCache::GetAssetLibraryHash(HoudiniAsset, LibraryPath);
+		Libraries.Add(TPair<int32, uint64>(SessionIndex, LibraryHash), LibraryPath);
+	}
+
+	// Each session loads its libraries on its own scheduler thread
+	int32 PreloadCount = 0;
+	for (const auto& Library : Libraries)
+	{
+		// No need to load the libraries that are already in the cache
+		if (AssetLibraryCache.Contains(Library.Key.Key, Library.Key.Value))
+			continue;
+
+		FHoudiniEngineTask Task(EHoudiniEngineTaskType::AssetLibraryLoad, FGuid::NewGuid());
+		Task.ActorName = FPaths::GetCleanFilename(Library.Value);
+		Task.AssetLibraryPath = Library.Value;
+		Task.AssetLibraryHash = Library.Key.Value;
+		Task.Priority = EHoudiniEngineTaskPriority::Low;
+		Task.SessionIndex = Library.Key.Key;
+		AddTask(Task);
+
+		PreloadCount++;
+	}
+
+	if (PreloadCount > 0)
+		HOUDINI_LOG_MESSAGE(TEXT("Preloading %d HDA libraries."), PreloadCount);
+}
+
+#if WITH_EDITOR
+void
+FHoudiniEngine::OnMapOpened(const FString& Filename, bool bAsTemplate)
+{
+	PreloadAssetLibraries(GEditor ? GEditor->GetEditorWorldContext().World() : nullptr);
+}
+#endif
+
+bool
+FHoudiniEngine::StartSessionPool()
+{
+	// Make sure the previous pool is gone
+	StopSessionPool();
+
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+	if (!HoudiniRuntimeSettings || HoudiniRuntimeSettings->SessionPoolSize <= 1)
+		return true;
+
+	// Pooled sessions require servers we start ourselves
 	if (bEnableSessionSync)
 	{
-		// Set the session sync infos if needed
-		UploadSessionSyncInfoToHoudini();
+		HOUDINI_LOG_MESSAGE(TEXT("The Houdini Engine session pool is disabled when using Session Sync, using a single session."));
+		return false;
+	}
 
-		// Indicate that Session Sync is enabled
-		FString Notification = TEXT("Houdini Engine Session Sync enabled.");
-		FHoudiniEngineUtils::CreateSlateNotification(Notification);
-		HOUDINI_LOG_MESSAGE(TEXT("Houdini Engine Session Sync enabled."));		
+	if (HoudiniRuntimeSettings->SessionType != EHoudiniRuntimeSettingsSessionType::HRSST_Socket
+		&& HoudiniRuntimeSettings->SessionType != EHoudiniRuntimeSettingsSessionType::HRSST_NamedPipe)
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("The Houdini Engine session pool requires a Socket or Named Pipe session type, using a single session."));
+		return false;
 	}
 
-	return true;
+	for (int32 PoolIdx = 1; PoolIdx < HoudiniRuntimeSettings->SessionPoolSize; PoolIdx++)
+	{
+		HAPI_Session PooledSession;
+		PooledSession.type = HAPI_SESSION_MAX;
+		PooledSession.id = -1;
+
+		// Each pooled session uses its own server.
+		// StartSession updates the session sync state and license type of the main session, restore them afterwards.
+		const bool bWasSessionSyncEnabled = bEnableSessionSync;
+		const HAPI_License MainLicenseType = LicenseType;
+
+		HAPI_Session* PooledSessionPtr = &PooledSession;
+		const bool bStarted = StartSession(
+			PooledSessionPtr,
+			true,
+			HoudiniRuntimeSettings->AutomaticServerTimeout,
+			HoudiniRuntimeSettings->SessionType,
+			FString::Printf(TEXT("%s_%d"), *HoudiniRuntimeSettings->ServerPipeName, PoolIdx),
+			HoudiniRuntimeSettings->ServerPort + PoolIdx,
+			HoudiniRuntimeSettings->ServerHost);
+
+		// StartSession considers any session it connected to without starting its server as a Session Sync one
+		const bool bConnectedToExistingServer = bStarted && bEnableSessionSync;
+		bEnableSessionSync = bWasSessionSyncEnabled;
+		LicenseType = MainLicenseType;
+
+		if (!bStarted)
+		{
+			HOUDINI_LOG_WARNING(TEXT("Failed to start pooled Houdini Engine session %d."), PoolIdx);
+			break;
+		}
+
+		// Don't cook in a Houdini session the user has opened on that port/pipe
+		if (bConnectedToExistingServer)
+		{
+			HOUDINI_LOG_WARNING(TEXT("Pooled Houdini Engine session %d connected to an existing server, it will not be used."), PoolIdx);
+			FHoudiniApi::CloseSession(PooledSessionPtr);
+			break;
+		}
+
+		if (!InitializeHAPI(PooledSessionPtr))
+		{
+			HOUDINI_LOG_WARNING(TEXT("Failed to initialize pooled Houdini Engine session %d."), PoolIdx);
+			FHoudiniApi::CloseSession(PooledSessionPtr);
+			break;
+		}
+
+		PooledSessions.Add(PooledSession);
+	}
+
+	// Each pooled session gets its own scheduler and thread
+	for (int32 PoolIdx = 0; PoolIdx < PooledSessions.Num(); PoolIdx++)
+	{
+		FHoudiniEngineScheduler* PooledScheduler = new FHoudiniEngineScheduler(PoolIdx + 1);
+		PooledSchedulers.Add(PooledScheduler);
+		PooledSchedulerThreads.Add(FRunnableThread::Create(
+			PooledScheduler, *FString::Printf(TEXT("HoudiniSchedulerThread_%d"), PoolIdx + 1), 0, TPri_Normal));
+	}
+
+	HOUDINI_LOG_MESSAGE(TEXT("Started %d additional Houdini Engine session(s)."), PooledSessions.Num());
+
+	return PooledSessions.Num() == (HoudiniRuntimeSettings->SessionPoolSize - 1);
+}
+
+void
+FHoudiniEngine::StopSessionPool()
+{
+	// Stop the schedulers first, so no task uses the sessions while we close them
+	for (FHoudiniEngineScheduler* PooledScheduler : PooledSchedulers)
+	{
+		if (PooledScheduler)
+			PooledScheduler->Stop();
+	}
+
+	for (FRunnableThread* PooledSchedulerThread : PooledSchedulerThreads)
+	{
+		if (!PooledSchedulerThread)
+			continue;
+
+		PooledSchedulerThread->WaitForCompletion();
+		delete PooledSchedulerThread;
+	}
+	PooledSchedulerThreads.Empty();
+
+	for (FHoudiniEngineScheduler* PooledScheduler : PooledSchedulers)
+	{
+		if (PooledScheduler)
+			delete PooledScheduler;
+	}
+	PooledSchedulers.Empty();
+
+	if (FHoudiniApi::IsHAPIInitialized())
+	{
+		for (HAPI_Session& PooledSession : PooledSessions)
+		{
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::IsSessionValid(&PooledSession))
+				continue;
+
+			FHoudiniApi::Cleanup(&PooledSession);
+			FHoudiniApi::CloseSession(&PooledSession);
+		}
+	}
+	PooledSessions.Empty();
 }
 
 
 void
-FHoudiniEngine::OnSessionLost()
+FHoudiniEngine::OnSessionLost(const HAPI_Session* InSession)
+{
+	if (!InSession)
+		return;
+
+	// Find which session has been lost, the pooled sessions are only added/removed while their schedulers are stopped
+	int32 SessionIndex = 0;
+	for (int32 PoolIdx = 0; PoolIdx < PooledSessions.Num(); PoolIdx++)
+	{
+		if (InSession == &PooledSessions[PoolIdx])
+		{
+			SessionIndex = PoolIdx + 1;
+			break;
+		}
+	}
+
+	if (SessionIndex == 0 && InSession != &Session)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Lost an unknown Houdini Engine session, ignoring it."));
+		return;
+	}
+
+	// The sessions are only modified on the game thread
+	const HAPI_SessionId LostSessionId = InSession->id;
+	if (!IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::GameThread, [SessionIndex, LostSessionId]()
+		{
+			FHoudiniEngine::Get().InvalidateLostSession(SessionIndex, LostSessionId);
+		});
+	}
+	else
+	{
+		InvalidateLostSession(SessionIndex, LostSessionId);
+	}
+}
+
+void
+FHoudiniEngine::InvalidateLostSession(const int32& InSessionIndex, const HAPI_SessionId& InSessionId)
 {
+	check(IsInGameThread());
+
+	// Losing a pooled session only invalidates that session,
+	// the assets using it will be moved to another session
+	if (InSessionIndex > 0)
+	{
+		// Ignore sessions that have already been invalidated, or restarted since
+		if (!PooledSessions.IsValidIndex(InSessionIndex - 1) || PooledSessions[InSessionIndex - 1].id != InSessionId)
+			return;
+
+		PooledSessions[InSessionIndex - 1].id = -1;
+		PooledSessions[InSessionIndex - 1].type = HAPI_SESSION_MAX;
+		AssetLibraryCache.InvalidateSession(InSessionIndex);
+		AttributeCache.InvalidateSession(InSessionIndex);
+
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine pooled session %d lost! This could be caused by a crash in HARS."), InSessionIndex);
+		return;
+	}
+
+	if (Session.id != InSessionId || Session.type == HAPI_SESSION_MAX)
+		return;
+
 	// Mark the session as invalid
 	Session.id = -1;
 	Session.type = HAPI_SESSION_MAX;
+	AssetLibraryCache.InvalidateSession(0);
+	AttributeCache.InvalidateSession(0);
 	bEnableSessionSync = false;
 	HoudiniEngineManager->StopHoudiniTicking();
 
@@ -734,6 +1283,12 @@ FHoudiniEngine::StopSession(HAPI_Session*& SessionPtr)
 		FHoudiniApi::CloseSession(SessionPtr);
 	}
 
+	StopSessionPool();
+
+	// The libraries loaded in the stopped sessions and their nodes are gone
+	AssetLibraryCache.Empty();
+	AttributeCache.Empty();
+
 	Session.id = -1;
 	Session.type = HAPI_SESSION_MAX;
 	bEnableSessionSync = false;
@@ -29,6 +29,9 @@
 #include "HAPI/HAPI_Common.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniEngineTaskInfo.h"
+#include "HoudiniAssetLibraryCache.h"
+#include "HoudiniAttributeCache.h"
+#include "HoudiniCookCache.h"
 #include "HoudiniRuntimeSettings.h"
 
 #include "Modules/ModuleInterface.h"
@@ -39,9 +42,21 @@ class FHoudiniEngineManager;
 class UHoudiniAssetComponent;
 class UStaticMesh;
 class UMaterial;
+class UWorld;
 
 struct FSlateDynamicImageBrush;
 
+// Routes the HAPI calls made on the current thread to the given session for the lifetime of this object.
+struct HOUDINIENGINE_API FHoudiniEngineScopedSession
+{
+	FHoudiniEngineScopedSession(const int32& InSessionIndex);
+	~FHoudiniEngineScopedSession();
+
+	private:
+		// Session index to restore when leaving the scope
+		int32 PreviousSessionIndex;
+};
+
 // Not using the IHoudiniEngine interface for now
 class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 {
@@ -61,8 +76,18 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		virtual const FString & GetLibHAPILocation() const;
 
 		// Session accessor
+		// Returns the session used by the calling thread (see FHoudiniEngineScopedSession)
 		virtual const HAPI_Session* GetSession() const;
 
+		// Returns the session with the given index, 0 being the main session
+		const HAPI_Session* GetSessionAt(const int32& InSessionIndex) const;
+
+		// Number of sessions that can be used to instantiate assets (main session + pooled sessions)
+		int32 GetSessionCount() const { return 1 + PooledSessions.Num(); };
+
+		// Returns true if the session with the given index exists and is usable
+		bool IsSessionIndexValid(const int32& InSessionIndex) const;
+
 		// Default cook options
 		static HAPI_CookOptions GetDefaultCookOptions();
 
@@ -103,8 +128,18 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		// Initialize HAPI
 		bool InitializeHAPISession();
 
-		// Indicate to the plugin that the session is now invalid (HAPI has likely crashed...)
-		void OnSessionLost();
+		// Starts loading, in the background, the HDA libraries of the HACs waiting for their instantiation in that world
+		// (in all worlds if null), each in the session the HAC will be instantiated in.
+		void PreloadAssetLibraries(UWorld* InWorld = nullptr);
+
+		// Starts the additional sessions and their schedulers, as set by SessionPoolSize in the settings
+		bool StartSessionPool();
+		// Stops the additional sessions and their schedulers
+		void StopSessionPool();
+
+		// Indicate to the plugin that the given session is now invalid (HAPI has likely crashed...)
+		// Can be called from any thread, the session is invalidated on the game thread.
+		void OnSessionLost(const HAPI_Session* InSession);
 
 		bool CreateTaskSlateNotification(
 			const FText& InText,
@@ -118,16 +153,23 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		void SetHapiNotificationStartedTime(const double& InTime) { HapiNotificationStarted = InTime; };
 
 		// Register task for execution.
-		virtual void AddTask(const FHoudiniEngineTask & InTask);
-		// Register task info.
-		virtual void AddTaskInfo(const FGuid& InHapiGUID, const FHoudiniEngineTaskInfo & InTaskInfo);
-		// Remove task info.
-		virtual void RemoveTaskInfo(const FGuid& InHapiGUID);
-		// Remove task info.
-		virtual bool RetrieveTaskInfo(const FGuid& InHapiGUID, FHoudiniEngineTaskInfo & OutTaskInfo);
+		// Returns the handle that will receive the task's progress and result.
+		virtual FHoudiniEngineTaskHandlePtr AddTask(const FHoudiniEngineTask & InTask);
 		// Register asset to the manager
 		//virtual void AddHoudiniAssetComponent(UHoudiniAssetComponent* HAC);
 
+		// Retrieves the scheduler's queue counters
+		bool GetSchedulerStats(struct FHoudiniEngineSchedulerStats& OutStats) const;
+
+		// Returns the HDA libraries loaded in the sessions
+		FHoudiniAssetLibraryCache& GetAssetLibraryCache() { return AssetLibraryCache; };
+
+		// Returns the fingerprints of the cooks that produced the HACs' current outputs
+		FHoudiniCookCache& GetCookCache() { return CookCache; };
+
+		// Returns the attributes fetched for the cooked parts
+		FHoudiniAttributeCache& GetAttributeCache() { return AttributeCache; };
+
 		// Indicates whether or not cooking is currently enabled
 		bool IsCookingEnabled() const;
 		// Sets whether or not cooking is currently enabled
@@ -191,6 +233,17 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 
 	private:
 
+		// Calls HAPI_Initialize on the given session using the plugin settings
+		bool InitializeHAPI(const HAPI_Session* InSession);
+
+		// Invalidates a lost session on the game thread, unless it has been invalidated or restarted since
+		void InvalidateLostSession(const int32& InSessionIndex, const HAPI_SessionId& InSessionId);
+
+#if WITH_EDITOR
+		// Preloads the HDA libraries of the map that has been opened
+		void OnMapOpened(const FString& Filename, bool bAsTemplate);
+#endif
+
 		// Singleton instance of Houdini Engine.
 		static FHoudiniEngine * HoudiniEngineInstance;
 
@@ -200,20 +253,32 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		// The Houdini Engine session. 
 		HAPI_Session Session;
 
+		// Additional sessions used to cook independent assets in parallel.
+		// Session index N uses PooledSessions[N - 1].
+		// Only modified on the game thread, and only resized while the pooled schedulers are stopped.
+		TArray<HAPI_Session> PooledSessions;
+
 		// The type of HE license used by the current session
 		HAPI_License LicenseType;
 
-		// Synchronization primitive.
-		FCriticalSection CriticalSection;
-		
-		// Map of task statuses.
-		TMap<FGuid, FHoudiniEngineTaskInfo> TaskInfos;
+		// HDA libraries loaded in the sessions, shared by the HACs using the same HDA.
+		FHoudiniAssetLibraryCache AssetLibraryCache;
+
+		// Fingerprints of the cooks that produced the HACs' current outputs.
+		FHoudiniCookCache CookCache;
+
+		// Attributes fetched for the cooked parts, shared by the translators.
+		FHoudiniAttributeCache AttributeCache;
 
 		// Thread used to execute the scheduler.
 		FRunnableThread * HoudiniEngineSchedulerThread;
 		// Scheduler used to schedule HAPI instantiation and cook tasks. 
 		FHoudiniEngineScheduler * HoudiniEngineScheduler;
 
+		// Threads and schedulers used for the pooled sessions, one per session.
+		TArray<FRunnableThread*> PooledSchedulerThreads;
+		TArray<FHoudiniEngineScheduler*> PooledSchedulers;
+
 		// Thread used to execute the manager.
 		FRunnableThread * HoudiniEngineManagerThread;
 		// Scheduler used to monitor and process Houdini Asset Components
@@ -272,5 +337,8 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		TWeakPtr<class SNotificationItem> NotificationPtr;
 		/** Used to delay notification updates for HAPI asynchronous work. **/
 		double HapiNotificationStarted;
+
+		// Handle of the map opened delegate, used to preload the HDA libraries.
+		FDelegateHandle OnMapOpenedHandle;
 #endif
 };
\ No newline at end of file
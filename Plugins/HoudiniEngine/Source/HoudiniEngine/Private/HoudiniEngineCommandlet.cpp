@@ -22,4 +22,396 @@
 * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
 * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
 * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
\ No newline at end of file
+*/
+#include "HoudiniEngineCommandlet.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniRuntimeSettings.h"
+#include "HoudiniAssetComponent.h"
+#include "HoudiniAsset.h"
+#include "HoudiniOutputTranslator.h"
+
+#include "Editor.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+UHoudiniEngineCommandlet::FHoudiniBatchCookAsset::FHoudiniBatchCookAsset()
+	: RefineDuration(0.0)
+	, TotalDuration(0.0)
+	, LastState(EHoudiniAssetState::None)
+	, LastStateTime(0.0)
+	, bStarted(false)
+	, bFinished(false)
+	, bSucceeded(false)
+{}
+
+UHoudiniEngineCommandlet::UHoudiniEngineCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, MapTimeout(3600.0)
+	, bNoSave(false)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32
+UHoudiniEngineCommandlet::Main(const FString& Params)
+{
+	FString MapsParam;
+	if (!FParse::Value(*Params, TEXT("Maps="), MapsParam, false) || MapsParam.IsEmpty())
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: no map to cook, use -Maps=/Game/Map1+/Game/Map2"));
+		return 1;
+	}
+
+	TArray<FString> MapNames;
+	MapsParam.ParseIntoArray(MapNames, TEXT("+"), true);
+
+	FString ReportFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Logs"), TEXT("HoudiniEngineBatchCook.json"));
+	FParse::Value(*Params, TEXT("Report="), ReportFile);
+
+	FParse::Value(*Params, TEXT("Timeout="), MapTimeout);
+	bNoSave = FParse::Param(*Params, TEXT("NoSave"));
+
+	if (!FHoudiniEngine::IsInitialized())
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: the Houdini Engine module is not initialized."));
+		return 1;
+	}
+
+	// Nothing can be displayed, and the pool size has to be set before the session starts
+	UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetMutableDefault<UHoudiniRuntimeSettings>();
+	HoudiniRuntimeSettings->bDisplaySlateCookingNotifications = false;
+	FParse::Value(*Params, TEXT("SessionPoolSize="), HoudiniRuntimeSettings->SessionPoolSize);
+
+	FHoudiniEngine::Get().SetFirstSessionCreated(true);
+	if (!FHoudiniEngine::Get().RestartSession())
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: couldn't start the Houdini Engine session."));
+		return 1;
+	}
+	FHoudiniEngine::Get().SetCookingEnabled(true);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<TSharedPtr<FJsonValue>> MapReports;
+	int32 FailedMapCount = 0;
+	for (const FString& MapName : MapNames)
+	{
+		TSharedPtr<FJsonObject> MapReport = MakeShared<FJsonObject>();
+		if (!ProcessMap(MapName, MapReport))
+			FailedMapCount++;
+
+		MapReports.Add(MakeShared<FJsonValueObject>(MapReport));
+	}
+
+	const double TotalDuration = FPlatformTime::Seconds() - StartTime;
+
+	FHoudiniEngine::Get().StopSession();
+
+	// Write the report
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("session_pool_size"), HoudiniRuntimeSettings->SessionPoolSize);
+	Report->SetNumberField(TEXT("total_seconds"), TotalDuration);
+	Report->SetNumberField(TEXT("failed_maps"), FailedMapCount);
+	Report->SetArrayField(TEXT("maps"), MapReports);
+
+	FString ReportString;
+	TSharedRef<TJsonWriter<>> ReportWriter = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(Report, ReportWriter);
+	if (!FFileHelper::SaveStringToFile(ReportString, *ReportFile))
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: couldn't write the report to %s"), *ReportFile);
+
+	HOUDINI_LOG_DISPLAY(
+		TEXT("Houdini Engine Commandlet: cooked %d map(s) in %.3f s, %d failed. Report written to %s"),
+		MapNames.Num(), TotalDuration, FailedMapCount, *ReportFile);
+
+	return FailedMapCount > 0 ? 1 : 0;
+}
+
+bool
+UHoudiniEngineCommandlet::ProcessMap(const FString& InMapName, TSharedPtr<FJsonObject>& OutMapReport)
+{
+	OutMapReport->SetStringField(TEXT("map"), InMapName);
+
+	// Load
+	double PhaseStartTime = FPlatformTime::Seconds();
+	UWorld* World = LoadWorld(InMapName);
+	OutMapReport->SetNumberField(TEXT("load_seconds"), FPlatformTime::Seconds() - PhaseStartTime);
+	if (!World)
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: couldn't load map %s"), *InMapName);
+		OutMapReport->SetStringField(TEXT("result"), TEXT("LoadFailed"));
+		return false;
+	}
+
+	// Rebuild all the HACs of the map, their outputs are directly created as UStaticMesh
+	TArray<FHoudiniBatchCookAsset> Assets;
+	for (TObjectIterator<UHoudiniAssetComponent> It; It; ++It)
+	{
+		UHoudiniAssetComponent* HAC = *It;
+		if (!HAC || HAC->IsPendingKill() || HAC->GetWorld() != World)
+			continue;
+
+		HAC->SetNoProxyMeshNextCookRequested(true);
+		HAC->MarkAsNeedRebuild();
+
+		FHoudiniBatchCookAsset& Asset = Assets.AddDefaulted_GetRef();
+		Asset.HAC = HAC;
+		Asset.Name = HAC->GetOwner() ? HAC->GetOwner()->GetName() : HAC->GetName();
+		Asset.HoudiniAssetName = HAC->GetHoudiniAsset() ? HAC->GetHoudiniAsset()->GetName() : FString();
+	}
+
+	HOUDINI_LOG_DISPLAY(TEXT("Houdini Engine Commandlet: cooking %d Houdini Asset(s) in %s"), Assets.Num(), *InMapName);
+
+	// Cook: tick until all the HACs are done, the independent ones are cooked concurrently
+	PhaseStartTime = FPlatformTime::Seconds();
+	double LastTickTime = PhaseStartTime;
+	for (FHoudiniBatchCookAsset& Asset : Assets)
+		Asset.LastStateTime = PhaseStartTime;
+
+	bool bTimedOut = false;
+	int32 RemainingCount = Assets.Num();
+	while (RemainingCount > 0)
+	{
+		Tick(LastTickTime);
+
+		RemainingCount = 0;
+		for (FHoudiniBatchCookAsset& Asset : Assets)
+		{
+			if (!UpdateAsset(Asset, LastTickTime))
+				RemainingCount++;
+		}
+
+		if (LastTickTime - PhaseStartTime > MapTimeout)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: timed out while cooking %s, %d Houdini Asset(s) remaining"), *InMapName, RemainingCount);
+			bTimedOut = true;
+			break;
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+	OutMapReport->SetNumberField(TEXT("cook_seconds"), FPlatformTime::Seconds() - PhaseStartTime);
+
+	// Refine the remaining proxy meshes to UStaticMesh
+	PhaseStartTime = FPlatformTime::Seconds();
+	for (FHoudiniBatchCookAsset& Asset : Assets)
+	{
+		UHoudiniAssetComponent* HAC = Asset.HAC.Get();
+		if (!Asset.bSucceeded || !HAC || HAC->IsPendingKill() || !HAC->HasAnyCurrentProxyOutput())
+			continue;
+
+		const double RefineStartTime = FPlatformTime::Seconds();
+		const bool bDestroyProxies = true;
+		FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(HAC, bDestroyProxies);
+		Asset.RefineDuration = FPlatformTime::Seconds() - RefineStartTime;
+		Asset.TotalDuration += Asset.RefineDuration;
+	}
+	OutMapReport->SetNumberField(TEXT("refine_seconds"), FPlatformTime::Seconds() - PhaseStartTime);
+
+	// Save
+	PhaseStartTime = FPlatformTime::Seconds();
+	const int32 SavedCount = bNoSave ? 0 : SavePackages();
+	OutMapReport->SetNumberField(TEXT("save_seconds"), FPlatformTime::Seconds() - PhaseStartTime);
+	OutMapReport->SetNumberField(TEXT("saved_packages"), SavedCount);
+
+	// Per HAC report
+	int32 FailedCount = 0;
+	TArray<TSharedPtr<FJsonValue>> AssetReports;
+	for (const FHoudiniBatchCookAsset& Asset : Assets)
+	{
+		if (!Asset.bSucceeded)
+			FailedCount++;
+
+		TSharedRef<FJsonObject> AssetReport = MakeShared<FJsonObject>();
+		AssetReport->SetStringField(TEXT("actor"), Asset.Name);
+		AssetReport->SetStringField(TEXT("houdini_asset"), Asset.HoudiniAssetName);
+		AssetReport->SetStringField(TEXT("result"), Asset.bSucceeded ? TEXT("Success") : (Asset.bFinished ? TEXT("Failed") : TEXT("TimedOut")));
+		AssetReport->SetNumberField(TEXT("total_seconds"), Asset.TotalDuration);
+		AssetReport->SetNumberField(TEXT("refine_seconds"), Asset.RefineDuration);
+
+		TSharedRef<FJsonObject> StateReport = MakeShared<FJsonObject>();
+		for (const auto& StateDuration : Asset.StateDurations)
+		{
+			FString StateName = UEnum::GetValueAsString(StateDuration.Key);
+			StateName.RemoveFromStart(TEXT("EHoudiniAssetState::"));
+			StateReport->SetNumberField(StateName, StateDuration.Value);
+		}
+		AssetReport->SetObjectField(TEXT("state_seconds"), StateReport);
+
+		AssetReports.Add(MakeShared<FJsonValueObject>(AssetReport));
+	}
+	OutMapReport->SetArrayField(TEXT("assets"), AssetReports);
+	OutMapReport->SetStringField(TEXT("result"), bTimedOut ? TEXT("TimedOut") : (FailedCount > 0 ? TEXT("Failed") : TEXT("Success")));
+
+	HOUDINI_LOG_DISPLAY(
+		TEXT("Houdini Engine Commandlet: %s done - %d Houdini Asset(s), %d failed, %d package(s) saved."),
+		*InMapName, Assets.Num(), FailedCount, SavedCount);
+
+	// Unload the map, its HACs' nodes will be deleted by the manager
+	World->ClearFlags(RF_Standalone);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	Tick(LastTickTime);
+
+	return !bTimedOut && FailedCount == 0;
+}
+
+UWorld*
+UHoudiniEngineCommandlet::LoadWorld(const FString& InMapName)
+{
+	FString MapPackageName;
+	if (!FPackageName::TryConvertFilenameToLongPackageName(InMapName, MapPackageName))
+		MapPackageName = InMapName;
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	if (!MapPackage)
+		return nullptr;
+
+	UWorld* World = UWorld::FindWorldInPackage(MapPackage);
+	if (!World)
+		return nullptr;
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+
+	if (!World->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValues;
+		InitValues.ShouldSimulatePhysics(false);
+		InitValues.EnableTraceCollision(false);
+		InitValues.CreateNavigation(false);
+		InitValues.CreateAISystem(false);
+		InitValues.AllowAudioPlayback(false);
+		World->InitWorld(InitValues);
+	}
+
+	World->LoadSecondaryLevels(true, nullptr);
+	World->UpdateWorldComponents(true, false);
+
+	return World;
+}
+
+void
+UHoudiniEngineCommandlet::Tick(double& InOutLastTickTime)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const float DeltaTime = (float)(CurrentTime - InOutLastTickTime);
+	InOutLastTickTime = CurrentTime;
+
+	// The engine doesn't tick in a commandlet, the manager's timer and the game thread tasks have to be ticked here
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	FTicker::GetCoreTicker().Tick(DeltaTime);
+	if (GEditor)
+		GEditor->GetTimerManager()->Tick(DeltaTime);
+}
+
+bool
+UHoudiniEngineCommandlet::UpdateAsset(FHoudiniBatchCookAsset& InOutAsset, const double& InTime)
+{
+	if (InOutAsset.bFinished)
+		return true;
+
+	UHoudiniAssetComponent* HAC = InOutAsset.HAC.Get();
+	if (!HAC || HAC->IsPendingKill())
+	{
+		InOutAsset.bFinished = true;
+		return true;
+	}
+
+	// Accumulate the time spent in the previous state
+	const EHoudiniAssetState State = HAC->GetAssetState();
+	InOutAsset.StateDurations.FindOrAdd(InOutAsset.LastState) += InTime - InOutAsset.LastStateTime;
+	InOutAsset.TotalDuration += InTime - InOutAsset.LastStateTime;
+	InOutAsset.LastStateTime = InTime;
+	InOutAsset.LastState = State;
+
+	// The manager sets the result of the HAC's state when an instantiation or a cook fails.
+	// Failed instantiations go back to NeedInstantiation and failed cooks to None, so check the result first.
+	const EHoudiniAssetStateResult ResultState = HAC->GetAssetStateResult();
+	if (InOutAsset.bStarted
+		&& (ResultState == EHoudiniAssetStateResult::FinishedWithError
+			|| ResultState == EHoudiniAssetStateResult::FinishedWithFatalError
+			|| ResultState == EHoudiniAssetStateResult::Aborted))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: failed to cook %s"), *HAC->GetPathName());
+		InOutAsset.bFinished = true;
+		return true;
+	}
+
+	// Outputs restored from the cook cache leave the HAC waiting for its next instantiation
+	if (InOutAsset.bStarted
+		&& State == EHoudiniAssetState::NeedInstantiation
+		&& ResultState == EHoudiniAssetStateResult::Success)
+	{
+		InOutAsset.bFinished = true;
+		InOutAsset.bSucceeded = true;
+		return true;
+	}
+
+	if (State != EHoudiniAssetState::None)
+	{
+		InOutAsset.bStarted = true;
+		return false;
+	}
+
+	// Back to the None state: the HAC has been rebuilt, cooked and its outputs processed
+	if (InOutAsset.bStarted)
+	{
+		InOutAsset.bFinished = true;
+		InOutAsset.bSucceeded = true;
+	}
+
+	return InOutAsset.bFinished;
+}
+
+int32
+UHoudiniEngineCommandlet::SavePackages()
+{
+	int32 SavedCount = 0;
+	for (TObjectIterator<UPackage> It; It; ++It)
+	{
+		UPackage* Package = *It;
+		if (!Package || Package->IsPendingKill() || !Package->IsDirty() || !Package->IsFullyLoaded())
+			continue;
+
+		if (Package == GetTransientPackage() || Package->HasAnyPackageFlags(PKG_CompiledIn))
+			continue;
+
+		// Maps are saved with their world as base, assets with their standalone objects
+		UWorld* World = UWorld::FindWorldInPackage(Package);
+		const FString Filename = FPackageName::LongPackageNameToFilename(
+			Package->GetName(),
+			World ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension());
+
+		const bool bSaved = UPackage::SavePackage(
+			Package, World, World ? RF_NoFlags : RF_Standalone, *Filename,
+			GError, nullptr, false, true, SAVE_NoError);
+
+		if (bSaved)
+		{
+			SavedCount++;
+			HOUDINI_LOG_MESSAGE(TEXT("Houdini Engine Commandlet: saved %s"), *Filename);
+		}
+		else
+		{
+			HOUDINI_LOG_ERROR(TEXT("Houdini Engine Commandlet: couldn't save %s"), *Filename);
+		}
+	}
+
+	return SavedCount;
+}
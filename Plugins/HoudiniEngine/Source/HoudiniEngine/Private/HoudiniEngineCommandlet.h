@@ -23,5 +23,83 @@
 * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
 * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
+#pragma once
 
-#pragma once
\ No newline at end of file
+#include "Commandlets/Commandlet.h"
+
+#include "HoudiniEngineCommandlet.generated.h"
+
+class UWorld;
+class UHoudiniAssetComponent;
+class FJsonObject;
+
+enum class EHoudiniAssetState : uint8;
+
+// Headless batch cook of the Houdini Asset Components of one or more maps.
+// For each map: loads it, rebuilds all its HACs, refines their proxy meshes to UStaticMesh,
+// saves the modified packages and unloads it. Independent HACs cook concurrently in the session pool.
+// Writes a JSON report with the timings of each map and of each HAC, per asset state.
+//
+// Usage:
+//   UE4Editor-Cmd <Project> -run=HoudiniEngine -Maps=/Game/Maps/A+/Game/Maps/B
+//       [-Report=<File.json>] [-SessionPoolSize=<N>] [-Timeout=<Seconds per map>] [-NoSave]
+UCLASS()
+class HOUDINIENGINE_API UHoudiniEngineCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	public:
+
+		virtual int32 Main(const FString& Params) override;
+
+	protected:
+
+		// Timings of a HAC during the batch cook
+		struct FHoudiniBatchCookAsset
+		{
+			FHoudiniBatchCookAsset();
+
+			TWeakObjectPtr<UHoudiniAssetComponent> HAC;
+			FString Name;
+			FString HoudiniAssetName;
+
+			// Time spent in each asset state, sampled every update of the cook loop (in seconds)
+			TMap<EHoudiniAssetState, double> StateDurations;
+			// Time spent refining the proxy meshes (in seconds)
+			double RefineDuration;
+			// Time between the start of the cook and the end of the refinement (in seconds)
+			double TotalDuration;
+
+			EHoudiniAssetState LastState;
+			double LastStateTime;
+			// The HAC has left its initial state
+			bool bStarted;
+			bool bFinished;
+			bool bSucceeded;
+		};
+
+		// Loads, cooks, refines and saves a map, fills its report
+		// Returns false if the map couldn't be loaded or one of its HACs failed to cook
+		bool ProcessMap(const FString& InMapName, TSharedPtr<FJsonObject>& OutMapReport);
+
+		// Loads and initializes a map's world
+		static UWorld* LoadWorld(const FString& InMapName);
+
+		// Ticks the Houdini Engine manager and the game thread tasks
+		static void Tick(double& InOutLastTickTime);
+
+		// Updates the timings of a HAC, returns true if it has finished cooking
+		static bool UpdateAsset(FHoudiniBatchCookAsset& InOutAsset, const double& InTime);
+
+		// Saves the dirty packages: the map and the HACs' outputs
+		// Returns the number of packages saved
+		static int32 SavePackages();
+
+	private:
+
+		// Maximum time allowed to cook a map (in seconds)
+		double MapTimeout;
+
+		// Skip saving the packages
+		bool bNoSave;
+};
@@ -31,11 +31,15 @@
 #include "HoudiniEngineRuntime.h"
 #include "HoudiniAsset.h"
 #include "HoudiniAssetComponent.h"
+#include "HoudiniParameter.h"
+#include "HoudiniInput.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineOutputStats.h"
 #include "HoudiniParameterTranslator.h"
 #include "HoudiniPDGManager.h"
 #include "HoudiniInputTranslator.h"
 #include "HoudiniOutputTranslator.h"
+#include "HoudiniMeshTranslator.h"
 #include "HoudiniHandletranslator.h"
 #include "HoudiniSplineTranslator.h"
 
@@ -54,7 +58,10 @@ FHoudiniEngineManager::TickTimerDelay = 0.05f;
 FHoudiniEngineManager::FHoudiniEngineManager()
 	: CurrentIndex(0)
 	, ComponentCount(0)
+	, LastTickProcessedCount(0)
+	, LastTickAdvancedCount(0)
 	, bMustStopTicking(false)
+	, TaskUpdates(MakeShared<FHoudiniEngineTaskUpdateQueue, ESPMode::ThreadSafe>())
 	, SyncedHoudiniViewportPivotPosition(FVector::ZeroVector)
 	, SyncedHoudiniViewportQuat(FQuat::Identity)
 	, SyncedHoudiniViewportOffset(0.0f)
@@ -67,7 +74,12 @@ FHoudiniEngineManager::FHoudiniEngineManager()
 
 FHoudiniEngineManager::~FHoudiniEngineManager()
 {
-
+	// The workers must be done with the session before it is closed
+	for (auto& Pair : PendingMeshPrefetches)
+	{
+		if (Pair.Value.IsValid())
+			Pair.Value->Wait();
+	}
 }
 
 void 
@@ -119,39 +131,60 @@ FHoudiniEngineManager::Tick()
 		return;
 	}
 
-	// Process the current component if possible
-	while (true)
+	// Process as many components as our time budget allows
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	const double TickBudget = HoudiniRuntimeSettings ? HoudiniRuntimeSettings->ProcessingTickBudgetMs / 1000.0 : 0.0;
+	const double TickStartTime = FPlatformTime::Seconds();
+
+	LastTickProcessedCount = 0;
+	LastTickAdvancedCount = 0;
+
+	if (FHoudiniEngineRuntime::IsInitialized())
 	{
-		UHoudiniAssetComponent * CurrentComponent = nullptr;
-		if (FHoudiniEngineRuntime::IsInitialized())
-		{
-			FHoudiniEngineRuntime::Get().CleanUpRegisteredHoudiniComponents();
+		FHoudiniEngineRuntime::Get().CleanUpRegisteredHoudiniComponents();
 
-			//FScopeLock ScopeLock(&CriticalSection);
-			ComponentCount = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentCount();
+		//FScopeLock ScopeLock(&CriticalSection);
+		ComponentCount = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentCount();
 
-			// No work to be done
-			if (ComponentCount <= 0)
-				break;
+		// Start, update or finish the current cook wave
+		DependencyGraph.Update();
 
-			// Wrap around if needed
-			if (CurrentIndex >= ComponentCount)
-				CurrentIndex = 0;
+		// Handle the progress and results reported by the schedulers
+		ProcessTaskUpdates(TickStartTime, TickBudget);
+	}
+	else
+	{
+		ComponentCount = 0;
+	}
 
-			CurrentComponent = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentAt(CurrentIndex);
-			CurrentIndex++;
-		}
+	// Visit each component at most once per tick
+	for (uint32 VisitedCount = 0; VisitedCount < ComponentCount; VisitedCount++)
+	{
+		// Stop when we run out of time, but always process at least one component
+		if (VisitedCount > 0 && (FPlatformTime::Seconds() - TickStartTime) >= TickBudget)
+			break;
+
+		// Ticking might have been stopped by the previous component (failed session...)
+		if (!TimerDelegateProcess.IsBound() || bMustStopTicking)
+			break;
+
+		// Wrap around if needed
+		if (CurrentIndex >= ComponentCount)
+			CurrentIndex = 0;
+
+		UHoudiniAssetComponent * CurrentComponent = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentAt(CurrentIndex);
+		CurrentIndex++;
 
 		if (!CurrentComponent || !CurrentComponent->IsValidLowLevelFast())
 		{
 			// Invalid component, do not process
-			break;
+			continue;
 		}
 		else if (CurrentComponent->IsPendingKill()
 			|| CurrentComponent->GetAssetState() == EHoudiniAssetState::Deleting)
 		{
 			// Component being deleted, do not process
-			break;
+			continue;
 		}
 
 		// See if we should start the default "first" session
@@ -193,8 +226,23 @@ FHoudiniEngineManager::Tick()
 
 		// Process the component
 		// try to catch (apache::thrift::transport::TTransportException * e) for session loss?
+		const EHoudiniAssetState PreviousState = CurrentComponent->GetAssetState();
 		ProcessComponent(CurrentComponent);
-		break;
+
+		LastTickProcessedCount++;
+		if (CurrentComponent->GetAssetState() != PreviousState)
+		{
+			LastTickAdvancedCount++;
+			DependencyGraph.OnAssetStateChanged(CurrentComponent);
+		}
+	}
+
+	if (LastTickAdvancedCount > 0)
+	{
+		HOUDINI_LOG_HELPER(Verbose,
+			TEXT("Houdini Engine Manager tick: %d/%d components processed, %d advanced in %.3f ms."),
+			LastTickProcessedCount, ComponentCount, LastTickAdvancedCount,
+			(FPlatformTime::Seconds() - TickStartTime) * 1000.0);
 	}
 
 	// Handle Asset delete
@@ -204,13 +252,27 @@ FHoudiniEngineManager::Tick()
 		for (int32 DeleteIdx = PendingDeleteCount - 1; DeleteIdx >= 0; DeleteIdx--)
 		{
 			HAPI_NodeId NodeIdToDelete = (HAPI_NodeId)FHoudiniEngineRuntime::Get().GetNodeIdsPendingDeleteAt(DeleteIdx);
+
+			// The node has to be deleted in the session it was created in
+			int32 SessionIndex = FHoudiniEngineRuntime::Get().GetNodeIdsPendingDeleteSessionIndexAt(DeleteIdx);
+			bool bShouldDeleteParent = FHoudiniEngineRuntime::Get().IsParentNodePendingDelete(NodeIdToDelete, SessionIndex);
+			if (SessionIndex > 0 && !FHoudiniEngine::Get().IsSessionIndexValid(SessionIndex))
+			{
+				// That session is gone, and so is the node
+				FHoudiniEngineRuntime::Get().RemoveNodeIdPendingDeleteAt(DeleteIdx);
+				if (bShouldDeleteParent)
+					FHoudiniEngineRuntime::Get().RemoveParentNodePendingDelete(NodeIdToDelete, SessionIndex);
+				continue;
+			}
+
+			FHoudiniEngineScopedSession ScopedSession(SessionIndex);
+
 			FGuid HapiDeletionGUID;
-			bool bShouldDeleteParent = FHoudiniEngineRuntime::Get().IsParentNodePendingDelete(NodeIdToDelete);
 			if (StartTaskAssetDelete(NodeIdToDelete, HapiDeletionGUID, bShouldDeleteParent))
 			{
 				FHoudiniEngineRuntime::Get().RemoveNodeIdPendingDeleteAt(DeleteIdx);
 				if (bShouldDeleteParent)
-					FHoudiniEngineRuntime::Get().RemoveParentNodePendingDelete(NodeIdToDelete);
+					FHoudiniEngineRuntime::Get().RemoveParentNodePendingDelete(NodeIdToDelete, SessionIndex);
 			}
 		}
 	}
@@ -249,6 +311,31 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 	if (!HAC->GetHoudiniAsset())
 		return;
 
+	if (HAC->GetAssetState() == EHoudiniAssetState::PreInstantiation)
+	{
+		// Pick the session the HAC will be instantiated in
+		HAC->SessionIndex = GetSessionIndexForHoudiniAsset(HAC);
+	}
+	else if (HAC->GetSessionIndex() > 0 && !FHoudiniEngine::Get().IsSessionIndexValid(HAC->GetSessionIndex()))
+	{
+		// The HAC's pooled session has been lost or stopped
+		if (HAC->GetAssetId() >= 0 || HAC->GetHapiGUID().IsValid())
+		{
+			// Instantiate it again in another session
+			HOUDINI_LOG_WARNING(TEXT("%s: Houdini Engine session %d is not available anymore, the asset will be instantiated again."),
+				*HAC->GetDisplayName(), HAC->GetSessionIndex());
+			ReleaseSessionForHoudiniAsset(HAC);
+			HAC->SessionIndex = GetSessionIndexForHoudiniAsset(HAC);
+		}
+		else
+		{
+			HAC->SessionIndex = 0;
+		}
+	}
+
+	// All the HAPI calls made while processing this HAC go to its session
+	FHoudiniEngineScopedSession ScopedSession(HAC->GetSessionIndex());
+
 	// If cooking is paused, stay in the current state until cooking's resumed
 	if (!FHoudiniEngine::Get().IsCookingEnabled())
 	{
@@ -290,59 +377,94 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 			if (HAC->NeedsToWaitForInputHoudiniAssets())
 				break;
 
-			FGuid TaskGuid;
+			// Wait for the preload task if it's loading our library in our session
 			UHoudiniAsset* HoudiniAsset = HAC->GetHoudiniAsset();
-			if (StartTaskAssetInstantiation(HoudiniAsset, HAC->GetDisplayName(), TaskGuid))
+			const uint64 AssetLibraryHash = FHoudiniAssetLibraryCache::GetAssetLibraryHash(
+				HoudiniAsset, FHoudiniEngineUtils::GetHoudiniAssetLibraryPath(HoudiniAsset));
+			if (FHoudiniEngine::Get().GetAssetLibraryCache().IsLoading(HAC->GetSessionIndex(), AssetLibraryHash))
+				break;
+
+			PreassignedSessionIndices.Remove(HAC);
+
+			FGuid TaskGuid;
+			FHoudiniEngineTaskHandlePtr TaskHandle;
+			if (StartTaskAssetInstantiation(HoudiniAsset, HAC->GetDisplayName(), TaskGuid, TaskHandle, GetTaskPriorityForHoudiniAsset(HAC)))
 			{
 				// Update the HAC's state
 				HAC->AssetState = EHoudiniAssetState::Instantiating;
-				//HAC->AssetStateResult = EHoudiniAssetStateResult::None;
+				HAC->AssetStateResult = EHoudiniAssetStateResult::Working;
 
 				// Update the Task GUID
 				HAC->HapiGUID = TaskGuid;
+
+				// The task's result will be handled by ProcessTaskUpdates
+				WatchTask(HAC, TaskHandle);
 			}
 			else
 			{
 				// If we couldnt instantiate the asset
 				// Change the state to NeedInstantiating
 				HAC->AssetState = EHoudiniAssetState::NeedInstantiation;
-				//HAC->AssetStateResult = EHoudiniAssetStateResult::None;
+				HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithError;
 			}
 			break;
 		}
 
 		case EHoudiniAssetState::Instantiating:
-		{			
-			EHoudiniAssetState NewState = EHoudiniAssetState::Instantiating;
-			if (UpdateInstantiating(HAC, NewState))
+		{
+			// The instantiation task's result is handled by ProcessTaskUpdates
+			if (!HAC->GetHapiGUID().IsValid())
 			{
-				// We need to update the HAC's state
-				HAC->AssetState = NewState;
+				// Couldnt get a valid task
+				HOUDINI_LOG_ERROR(TEXT("    %s Failed to instantiate - invalid task"), *HAC->GetDisplayName());
+				HAC->AssetState = EHoudiniAssetState::NeedInstantiation;
+				HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithError;
 			}
 			break;
 		}
 
 		case EHoudiniAssetState::PreCook:
 		{
+			// Wait for our input HoudiniAssets from the current cook wave to settle
+			if (!DependencyGraph.IsReadyToCook(HAC))
+				break;
+
 			// Only proceed forward if we don't need to wait for our input
 			// HoudiniAssets to finish cooking/instantiating
 			if (HAC->NeedsToWaitForInputHoudiniAssets())
 				break;
 
+			// Our input HoudiniAssets have to be in the same session as us
+			if (UpdateSessionAffinity(HAC))
+				break;
+
+			DependencyGraph.OnCookStarted(HAC);
+
+			// The HAC's current outputs might already be the result of this cook (ie, a parameter was changed and reverted).
+			// This has to be checked before PreCook, which clears the loaded and duplicated flags.
+			const bool bCookRedundant = IsCookRedundant(HAC);
+
 			// Update all the HAPI nodes, parameters, inputs etc...
 			PreCook(HAC);
 
 			// Create a Cooking task only if necessary
 			bool bCookStarted = false;
-			if (IsCookingEnabledForHoudiniAsset(HAC))
+			if (!bCookRedundant && IsCookingEnabledForHoudiniAsset(HAC))
 			{
 				FGuid TaskGUID = HAC->GetHapiGUID();
-				if ( StartTaskAssetCooking(HAC->GetAssetId(), HAC->GetDisplayName(), TaskGUID) )
+				FHoudiniEngineTaskHandlePtr TaskHandle;
+				if ( StartTaskAssetCooking(HAC->GetAssetId(), HAC->GetDisplayName(), TaskGUID, TaskHandle, GetTaskPriorityForHoudiniAsset(HAC)) )
 				{
 					// Updates the HAC's state
 					HAC->AssetState = EHoudiniAssetState::Cooking;
+					HAC->AssetStateResult = EHoudiniAssetStateResult::Working;
 					HAC->HapiGUID = TaskGUID;
 					bCookStarted = true;
+
+					// The task's result will be handled by ProcessTaskUpdates
+					WatchTask(HAC, TaskHandle);
+					CookTaskHandles.Add(TaskGUID, TaskHandle);
+					CookStartTimes.Add(TaskGUID, FPlatformTime::Seconds());
 				}
 			}
 			
@@ -359,12 +481,25 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 
 		case EHoudiniAssetState::Cooking:
 		{
-			EHoudiniAssetState NewState = EHoudiniAssetState::Cooking;
-			bool state = UpdateCooking(HAC, NewState);
-			if (state)
+			// The cooking task's result is handled by ProcessTaskUpdates
+			if (!HAC->GetHapiGUID().IsValid())
+			{
+				// Couldnt get a valid task
+				HOUDINI_LOG_ERROR(TEXT("    %s Failed to cook - invalid task"), *HAC->GetDisplayName());
+				HAC->AssetState = EHoudiniAssetState::None;
+				HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithError;
+			}
+			else if (HAC->NeedUpdate())
 			{
-				// We need to update the HAC's state
-				HAC->AssetState = NewState;
+				// Parameters or inputs changed during the cook, its result is outdated:
+				// have it interrupted so we can start the new cook right away
+				const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+				FHoudiniEngineTaskHandlePtr* TaskHandle = CookTaskHandles.Find(HAC->GetHapiGUID());
+				if (HoudiniRuntimeSettings && HoudiniRuntimeSettings->bInterruptOutdatedCooks
+					&& TaskHandle && TaskHandle->IsValid() && !(*TaskHandle)->IsCancelRequested())
+				{
+					(*TaskHandle)->Cancel();
+				}
 			}
 			break;
 		}
@@ -454,7 +589,9 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 
 
 bool 
-FHoudiniEngineManager::StartTaskAssetInstantiation(UHoudiniAsset* HoudiniAsset, const FString& DisplayName, FGuid& OutTaskGUID)
+FHoudiniEngineManager::StartTaskAssetInstantiation(
+	UHoudiniAsset* HoudiniAsset, const FString& DisplayName, FGuid& OutTaskGUID, FHoudiniEngineTaskHandlePtr& OutTaskHandle,
+	const EHoudiniEngineTaskPriority& Priority)
 {
 	// Make sure we have a valid session before attempting anything
 	if (!FHoudiniEngine::Get().GetSession())
@@ -513,15 +650,16 @@ FHoudiniEngineManager::StartTaskAssetInstantiation(UHoudiniAsset* HoudiniAsset,
 	//Task.bLoadedComponent = bLocalLoadedComponent;
 	Task.AssetLibraryId = AssetLibraryId;
 	Task.AssetHapiName = PickedAssetName;
+	Task.Priority = Priority;
 
 	// Add the task to the stack
-	FHoudiniEngine::Get().AddTask(Task);
+	OutTaskHandle = FHoudiniEngine::Get().AddTask(Task);
 
 	return true;
 }
 
 bool 
-FHoudiniEngineManager::UpdateInstantiating(UHoudiniAssetComponent* HAC, EHoudiniAssetState& NewState )
+FHoudiniEngineManager::UpdateInstantiating(UHoudiniAssetComponent* HAC, const FHoudiniEngineTaskInfo& TaskInfo, EHoudiniAssetState& NewState)
 {
 	check(HAC);
 
@@ -532,14 +670,12 @@ FHoudiniEngineManager::UpdateInstantiating(UHoudiniAssetComponent* HAC, EHoudini
 	// Get the HAC display name for the logs
 	FString DisplayName = HAC->GetDisplayName();
 
-	// Get the current task's progress
-	FHoudiniEngineTaskInfo TaskInfo;	
-	if ( !UpdateTaskStatus(HAC->HapiGUID, TaskInfo) 
-		|| TaskInfo.TaskType != EHoudiniEngineTaskType::AssetInstantiation)
+	if (TaskInfo.TaskType != EHoudiniEngineTaskType::AssetInstantiation)
 	{
 		// Couldnt get a valid task info
 		HOUDINI_LOG_ERROR(TEXT("    %s Failed to instantiate - invalid task"), *DisplayName);
 		NewState = EHoudiniAssetState::NeedInstantiation;
+		HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithError;
 		bUpdateState = true;
 		return bUpdateState;
 	}
@@ -556,6 +692,7 @@ FHoudiniEngineManager::UpdateInstantiating(UHoudiniAssetComponent* HAC, EHoudini
 		}
 
 		case EHoudiniEngineTaskState::Aborted:
+		case EHoudiniEngineTaskState::Cancelled:
 		case EHoudiniEngineTaskState::FinishedWithError:
 		case EHoudiniEngineTaskState::FinishedWithFatalError:
 		{
@@ -614,6 +751,14 @@ FHoudiniEngineManager::UpdateInstantiating(UHoudiniAssetComponent* HAC, EHoudini
 		// See if this Asset is a PDG Asset
 		PDGManager.InitializePDGAssetLink(HAC);
 
+		// PDG asset links are updated in the main session, move the asset there if needed
+		if (HAC->GetPDGAssetLink() && HAC->GetSessionIndex() != GetSessionIndexForHoudiniAsset(HAC))
+		{
+			ReleaseSessionForHoudiniAsset(HAC);
+			NewState = HAC->GetAssetState();
+			return true;
+		}
+
 		// Update the HAC's state
 		NewState = EHoudiniAssetState::PreCook;
 		return true;
@@ -667,14 +812,18 @@ FHoudiniEngineManager::UpdateInstantiating(UHoudiniAssetComponent* HAC, EHoudini
 
 		// Update the HAC's state
 		HAC->AssetState = EHoudiniAssetState::NeedInstantiation;
-		//HAC->AssetStateResult = EHoudiniAssetStateResult::Success;
+		HAC->AssetStateResult = TaskInfo.TaskState == EHoudiniEngineTaskState::Aborted
+			? EHoudiniAssetStateResult::Aborted
+			: EHoudiniAssetStateResult::FinishedWithError;
 
 		return true;
 	}
 }
 
 bool
-FHoudiniEngineManager::StartTaskAssetCooking(const HAPI_NodeId& AssetId, const FString& DisplayName, FGuid& OutTaskGUID)
+FHoudiniEngineManager::StartTaskAssetCooking(
+	const HAPI_NodeId& AssetId, const FString& DisplayName, FGuid& OutTaskGUID, FHoudiniEngineTaskHandlePtr& OutTaskHandle,
+	const EHoudiniEngineTaskPriority& Priority)
 {
 	// Make sure we have a valid session before attempting anything
 	if (!FHoudiniEngine::Get().GetSession())
@@ -695,13 +844,14 @@ FHoudiniEngineManager::StartTaskAssetCooking(const HAPI_NodeId& AssetId, const F
 	FHoudiniEngineTask Task(EHoudiniEngineTaskType::AssetCooking, OutTaskGUID);
 	Task.ActorName = DisplayName;
 	Task.AssetId = AssetId;
-	FHoudiniEngine::Get().AddTask(Task);
+	Task.Priority = Priority;
+	OutTaskHandle = FHoudiniEngine::Get().AddTask(Task);
 
 	return true;
 }
 
 bool
-FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetState& NewState)
+FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, const FHoudiniEngineTaskInfo& TaskInfo, EHoudiniAssetState& NewState)
 {
 	check(HAC);
 
@@ -712,14 +862,12 @@ FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetS
 	// Get the HAC display name for the logs
 	FString DisplayName = HAC->GetDisplayName();
 
-	// Get the current task's progress
-	FHoudiniEngineTaskInfo TaskInfo;
-	if (!UpdateTaskStatus(HAC->HapiGUID, TaskInfo)
-		|| TaskInfo.TaskType != EHoudiniEngineTaskType::AssetCooking)
+	if (TaskInfo.TaskType != EHoudiniEngineTaskType::AssetCooking)
 	{
 		// Couldnt get a valid task info
 		HOUDINI_LOG_ERROR(TEXT("    %s Failed to cook - invalid task"), *DisplayName);
 		NewState = EHoudiniAssetState::None;
+		HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithError;
 		bUpdateState = true;
 		return bUpdateState;
 	}
@@ -753,6 +901,15 @@ FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetS
 		}
 		break;
 
+		case EHoudiniEngineTaskState::Cancelled:
+		{
+			// The cook was interrupted because its result was outdated:
+			// discard it and go back to PreCook to upload the changes and cook again
+			HOUDINI_LOG_MESSAGE(TEXT("   %s Cooking cancelled - a newer cook is needed."), *DisplayName);
+			NewState = EHoudiniAssetState::PreCook;
+			return true;
+		}
+
 		case EHoudiniEngineTaskState::None:
 		case EHoudiniEngineTaskState::Working:
 		{
@@ -777,6 +934,12 @@ FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetS
 	{
 		// Cook failed, skip output processing
 		NewState = EHoudiniAssetState::None;
+		if (TaskInfo.TaskState == EHoudiniEngineTaskState::Aborted)
+			HAC->AssetStateResult = EHoudiniAssetStateResult::Aborted;
+		else if (TaskInfo.TaskState == EHoudiniEngineTaskState::FinishedWithFatalError)
+			HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithFatalError;
+		else
+			HAC->AssetStateResult = EHoudiniAssetStateResult::FinishedWithError;
 	}
 
 	return true;
@@ -810,11 +973,21 @@ FHoudiniEngineManager::PreCook(UHoudiniAssetComponent* HAC)
 		// TODO: Restore parameter preset data
 	}
 
+	// Stats of the previous cook are replaced by this one's
+	HAC->CookStats = FHoudiniCookStats();
+	FHoudiniCookStatsScope CookStatsScope(HAC);
+
 	// Try to upload changed parameters
-	FHoudiniParameterTranslator::UploadChangedParameters(HAC);
+	{
+		FHoudiniCookPhaseScope PhaseScope(EHoudiniCookPhase::UploadParameters);
+		FHoudiniParameterTranslator::UploadChangedParameters(HAC);
+	}
 
 	// Try to upload changed inputs
-	FHoudiniInputTranslator::UploadChangedInputs(HAC);
+	{
+		FHoudiniCookPhaseScope PhaseScope(EHoudiniCookPhase::UploadInputs);
+		FHoudiniInputTranslator::UploadChangedInputs(HAC);
+	}
 
 	// Try to upload changed editable nodes
 	FHoudiniOutputTranslator::UploadChangedEditableOutput(HAC, false);
@@ -852,7 +1025,6 @@ FHoudiniEngineManager::PostCook(UHoudiniAssetComponent* HAC, const bool& bSucces
 		HAC->SetAssetCookCount(HAC->GetAssetCookCount()+1);
 	*/
 
-	bool bNeedsToTriggerViewportUpdate = false;
 	if (bCookSuccess)
 	{
 		FHoudiniEngine::Get().CreateTaskSlateNotification(FText::FromString("Processing outputs..."));
@@ -864,47 +1036,40 @@ FHoudiniEngineManager::PostCook(UHoudiniAssetComponent* HAC, const bool& bSucces
 
 		FHoudiniInputTranslator::UpdateInputs(HAC);
 
-		bool bHasHoudiniStaticMeshOutput = false;
-		bool ForceUpdate = HAC->HasRebuildBeenRequested() || HAC->HasRecookBeenRequested();
-		FHoudiniOutputTranslator::UpdateOutputs(HAC, ForceUpdate, bHasHoudiniStaticMeshOutput);
-		HAC->SetNoProxyMeshNextCookRequested(false);
-
-		// Handles have to be updated after parameters
-		FHoudiniHandleTranslator::UpdateHandles(HAC);  
-
-		// Clear the HasBeenLoaded flag
-		if (HAC->HasBeenLoaded())
 		{
-			HAC->SetHasBeenLoaded(false);
+			FHoudiniCookStatsScope CookStatsScope(HAC);
+			FHoudiniOutputTranslator::BuildOutputs(HAC);
 		}
 
-		// Clear the HasBeenDuplicated flag
-		if (HAC->HasBeenDuplicated())
+		// Fetch the mesh parts on worker threads: the outputs will be created by UpdateProcess once they're done
+		TSharedPtr<FHoudiniMeshPrefetch> MeshPrefetch;
+		const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+		if (HoudiniRuntimeSettings && HoudiniRuntimeSettings->bFetchOutputsAsync)
 		{
-			HAC->SetHasBeenDuplicated(false);
+			// The splits' geometry can also be assembled by the worker if they'll be turned into mesh descriptions
+			const bool bAssembleSplits = HAC->StaticMeshMethod == EHoudiniStaticMeshMethod::FMeshDescription
+				&& !(HAC->IsProxyStaticMeshEnabled() && !HAC->HasNoProxyMeshNextCookBeenRequested());
+			MeshPrefetch = FHoudiniMeshPrefetch::Start(HAC->Outputs, HAC->GetSessionIndex(), bAssembleSplits);
 		}
 
-		// TODO: Need to update rendering information.
-		// UpdateRenderingInformation();
-		HAC->UpdateBounds();
-
-		FHoudiniEngine::Get().FinishTaskSlateNotification(FText::FromString("Finished processing outputs"));
+		if (MeshPrefetch.IsValid() && MeshPrefetch->GetPartCount() > 0)
+		{
+			// Forget about the HACs that were destroyed while their parts were being fetched
+			for (auto It = PendingMeshPrefetches.CreateIterator(); It; ++It)
+			{
+				if (!It.Key().IsValid())
+					It.RemoveCurrent();
+			}
 
-		// Trigger a details panel update
-		FHoudiniEngineUtils::UpdateEditorProperties(HAC, true);
+			PendingMeshPrefetches.Add(HAC, MeshPrefetch);
 
-		// If any outputs have HoudiniStaticMeshes, and if timer based refinement is enabled on the HAC,
-		// set the RefineMeshesTimer and ensure BuildStaticMeshesForAllHoudiniStaticMeshes is bound to
-		// the RefineMeshesTimerFired delegate of the HAC
-		if (bHasHoudiniStaticMeshOutput && HAC->IsProxyStaticMeshRefinementByTimerEnabled())
+			FString Notification = FString::Printf(TEXT("Fetching %d mesh parts..."), MeshPrefetch->GetPartCount());
+			FHoudiniEngine::Get().UpdateTaskSlateNotification(FText::FromString(Notification));
+		}
+		else
 		{
-			if (!HAC->GetOnRefineMeshesTimerDelegate().IsBoundToObject(this))
-				HAC->GetOnRefineMeshesTimerDelegate().AddRaw(this, &FHoudiniEngineManager::BuildStaticMeshesForAllHoudiniStaticMeshes);
-			HAC->SetRefineMeshesTimer();
+			StartCreatingOutputs(HAC, nullptr);
 		}
-
-		if (bHasHoudiniStaticMeshOutput)
-			bNeedsToTriggerViewportUpdate = true;
 	}
 	else
 	{
@@ -925,13 +1090,6 @@ FHoudiniEngineManager::PostCook(UHoudiniAssetComponent* HAC, const bool& bSucces
 	// Notify the PDG manager that the HDA is done cooking
 	FHoudiniPDGManager::NotifyAssetCooked(HAC->PDGAssetLink, bSuccess);
 
-	if (bNeedsToTriggerViewportUpdate && GEditor)
-	{
-		// We need to manually update the vieport with HoudiniMeshProxies
-		// if not, modification made in H with the two way debugger wont be visible in Unreal until the vieports gets focus
-		GEditor->RedrawAllViewports(false);
-	}
-
 	// Clear the rebuild/recook flags
 	HAC->SetRecookRequested(false);
 	HAC->SetRebuildRequested(false);
@@ -939,6 +1097,25 @@ FHoudiniEngineManager::PostCook(UHoudiniAssetComponent* HAC, const bool& bSucces
 	return bCookSuccess;
 }
 
+bool
+FHoudiniEngineManager::IsCookRedundant(UHoudiniAssetComponent* HAC)
+{
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	if (!HoudiniRuntimeSettings || !HoudiniRuntimeSettings->bEnableCookCache)
+		return false;
+
+	// Only skip the recooks of live nodes whose outputs have been translated in this session.
+	// Loaded, duplicated and rebuilt HACs still need their parameters, inputs and outputs to be updated by a cook.
+	if (HAC->GetAssetId() < 0 || HAC->HasBeenLoaded() || HAC->HasBeenDuplicated() || HAC->HasRebuildBeenRequested())
+		return false;
+
+	// Explicit recooks always cook, proxies need the cooked data to be refined
+	if (HAC->HasRecookBeenRequested() || HAC->HasNoProxyMeshNextCookBeenRequested())
+		return false;
+
+	return FHoudiniEngine::Get().GetCookCache().Find(HAC);
+}
+
 bool
 FHoudiniEngineManager::StartTaskAssetProcess(UHoudiniAssetComponent* HAC)
 {
@@ -950,11 +1127,119 @@ FHoudiniEngineManager::StartTaskAssetProcess(UHoudiniAssetComponent* HAC)
 bool
 FHoudiniEngineManager::UpdateProcess(UHoudiniAssetComponent* HAC)
 {
+	TSharedPtr<FHoudiniMeshPrefetch> MeshPrefetch;
+	if (PendingMeshPrefetches.RemoveAndCopyValue(HAC, MeshPrefetch))
+	{
+		// Keep waiting until the worker threads are done with the mesh parts
+		if (MeshPrefetch.IsValid() && !MeshPrefetch->IsComplete())
+		{
+			PendingMeshPrefetches.Add(HAC, MeshPrefetch);
+			return false;
+		}
+
+		// The workers' time and transfers are part of the HAC's cook
+		if (MeshPrefetch.IsValid())
+		{
+			FHoudiniCookStatsScope CookStatsScope(HAC);
+			FHoudiniCookStatsScope::AddStats(MeshPrefetch->GetCookStats());
+		}
+
+		StartCreatingOutputs(HAC, MeshPrefetch);
+	}
+
+	TSharedPtr<FHoudiniOutputBuilder> OutputBuilder;
+	if (PendingOutputBuilders.RemoveAndCopyValue(HAC, OutputBuilder) && OutputBuilder.IsValid())
+	{
+		const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+		const double Budget = HoudiniRuntimeSettings ? HoudiniRuntimeSettings->OutputCreationTickBudgetMs / 1000.0 : 0.0;
+
+		FHoudiniCookStatsScope CookStatsScope(HAC);
+
+		// Create as many outputs as the budget allows, the remaining ones will be created on the next ticks
+		if (!OutputBuilder->Step(Budget))
+		{
+			PendingOutputBuilders.Add(HAC, OutputBuilder);
+			return false;
+		}
+
+		OutputBuilder->Finish();
+
+		if (FinishCreatingOutputs(HAC, OutputBuilder->HasHoudiniStaticMeshOutput()) && GEditor)
+		{
+			// We need to manually update the vieport with HoudiniMeshProxies
+			// if not, modification made in H with the two way debugger wont be visible in Unreal until the vieports gets focus
+			GEditor->RedrawAllViewports(false);
+		}
+	}
+
 	HAC->AssetState = EHoudiniAssetState::None;
+	HAC->AssetStateResult = EHoudiniAssetStateResult::Success;
 
 	return true;
 }
 
+void
+FHoudiniEngineManager::StartCreatingOutputs(UHoudiniAssetComponent* HAC, const TSharedPtr<FHoudiniMeshPrefetch>& InMeshPrefetch)
+{
+	// Forget about the HACs that were destroyed while their outputs were being created
+	for (auto It = PendingOutputBuilders.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+			It.RemoveCurrent();
+	}
+
+	TSharedPtr<FHoudiniOutputBuilder> OutputBuilder = MakeShared<FHoudiniOutputBuilder>(HAC, InMeshPrefetch);
+	if (OutputBuilder->Begin())
+		PendingOutputBuilders.Add(HAC, OutputBuilder);
+}
+
+bool
+FHoudiniEngineManager::FinishCreatingOutputs(UHoudiniAssetComponent* HAC, const bool& bHasHoudiniStaticMeshOutput)
+{
+	HAC->SetNoProxyMeshNextCookRequested(false);
+
+	// Record the fingerprint of the cook that produced these outputs
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	if (HoudiniRuntimeSettings && HoudiniRuntimeSettings->bEnableCookCache)
+		FHoudiniEngine::Get().GetCookCache().Add(HAC);
+
+	// Handles have to be updated after parameters
+	FHoudiniHandleTranslator::UpdateHandles(HAC);  
+
+	// Clear the HasBeenLoaded flag
+	if (HAC->HasBeenLoaded())
+	{
+		HAC->SetHasBeenLoaded(false);
+	}
+
+	// Clear the HasBeenDuplicated flag
+	if (HAC->HasBeenDuplicated())
+	{
+		HAC->SetHasBeenDuplicated(false);
+	}
+
+	// TODO: Need to update rendering information.
+	// UpdateRenderingInformation();
+	HAC->UpdateBounds();
+
+	FHoudiniEngine::Get().FinishTaskSlateNotification(FText::FromString("Finished processing outputs"));
+
+	// Trigger a details panel update
+	FHoudiniEngineUtils::UpdateEditorProperties(HAC, true);
+
+	// If any outputs have HoudiniStaticMeshes, and if timer based refinement is enabled on the HAC,
+	// set the RefineMeshesTimer and ensure BuildStaticMeshesForAllHoudiniStaticMeshes is bound to
+	// the RefineMeshesTimerFired delegate of the HAC
+	if (bHasHoudiniStaticMeshOutput && HAC->IsProxyStaticMeshRefinementByTimerEnabled())
+	{
+		if (!HAC->GetOnRefineMeshesTimerDelegate().IsBoundToObject(this))
+			HAC->GetOnRefineMeshesTimerDelegate().AddRaw(this, &FHoudiniEngineManager::BuildStaticMeshesForAllHoudiniStaticMeshes);
+		HAC->SetRefineMeshesTimer();
+	}
+
+	return bHasHoudiniStaticMeshOutput;
+}
+
 bool
 FHoudiniEngineManager::StartTaskAssetRebuild(const HAPI_NodeId& InAssetId, FGuid& OutTaskGUID)
 {
@@ -1018,54 +1303,44 @@ FHoudiniEngineManager::StartTaskAssetDelete(const HAPI_NodeId& InNodeId, FGuid&
 }
 
 bool
-FHoudiniEngineManager::UpdateTaskStatus(FGuid& OutTaskGUID, FHoudiniEngineTaskInfo& OutTaskInfo)
+FHoudiniEngineManager::UpdateTaskStatus(FGuid& OutTaskGUID, const FHoudiniEngineTaskInfo& InTaskInfo)
 {
-	if (!OutTaskGUID.IsValid())
-		return false;
-	
-	if (!FHoudiniEngine::Get().RetrieveTaskInfo(OutTaskGUID, OutTaskInfo))
-	{
-		// Task information does not exist
-		OutTaskGUID.Invalidate();
-		return false;
-	}
-
 	// Check whether we want to display Slate cooking and instantiation notifications.
 	bool bDisplaySlateCookingNotifications = false;
 	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
 	if (HoudiniRuntimeSettings)
 		bDisplaySlateCookingNotifications = HoudiniRuntimeSettings->bDisplaySlateCookingNotifications;
 
-	if (EHoudiniEngineTaskState::None != OutTaskInfo.TaskState && bDisplaySlateCookingNotifications)
+	if (EHoudiniEngineTaskState::None != InTaskInfo.TaskState && bDisplaySlateCookingNotifications)
 	{
-		FHoudiniEngine::Get().CreateTaskSlateNotification(OutTaskInfo.StatusText);
+		FHoudiniEngine::Get().CreateTaskSlateNotification(InTaskInfo.StatusText);
 	}
 
-	switch (OutTaskInfo.TaskState)
+	switch (InTaskInfo.TaskState)
 	{
 		case EHoudiniEngineTaskState::Aborted:
+		case EHoudiniEngineTaskState::Cancelled:
 		case EHoudiniEngineTaskState::Success:
 		case EHoudiniEngineTaskState::FinishedWithError:
 		case EHoudiniEngineTaskState::FinishedWithFatalError:
 		{
 			// If the current task is finished
-			// Terminate the slate notification if they exist and delete/invalidate the task
+			// Terminate the slate notification if they exist and invalidate the task
 			if (bDisplaySlateCookingNotifications)
 			{
-				FHoudiniEngine::Get().FinishTaskSlateNotification(OutTaskInfo.StatusText);
+				FHoudiniEngine::Get().FinishTaskSlateNotification(InTaskInfo.StatusText);
 			}
 
-			FHoudiniEngine::Get().RemoveTaskInfo(OutTaskGUID);
 			OutTaskGUID.Invalidate();
+			return true;
 		}
-		break;
 
 		case EHoudiniEngineTaskState::Working:
 		{
 			// The current task is still running, simply update the current notification
 			if (bDisplaySlateCookingNotifications)
 			{
-				FHoudiniEngine::Get().UpdateTaskSlateNotification(OutTaskInfo.StatusText);
+				FHoudiniEngine::Get().UpdateTaskSlateNotification(InTaskInfo.StatusText);
 			}
 		}
 		break;
@@ -1077,7 +1352,291 @@ FHoudiniEngineManager::UpdateTaskStatus(FGuid& OutTaskGUID, FHoudiniEngineTaskIn
 		}
 	}
 
-	return true;
+	return false;
+}
+
+void
+FHoudiniEngineManager::WatchTask(UHoudiniAssetComponent* HAC, const FHoudiniEngineTaskHandlePtr& TaskHandle)
+{
+	if (!HAC || !TaskHandle.IsValid())
+		return;
+
+	TWeakObjectPtr<UHoudiniAssetComponent> WeakHAC(HAC);
+	TWeakPtr<FHoudiniEngineTaskUpdateQueue, ESPMode::ThreadSafe> WeakTaskUpdates(TaskUpdates);
+	const FGuid HapiGUID = TaskHandle->GetHapiGUID();
+
+	// Called on the scheduler thread, just queue the infos for the next tick
+	auto PushTaskUpdate = [WeakHAC, WeakTaskUpdates, HapiGUID](const FHoudiniEngineTaskInfo& InTaskInfo)
+	{
+		TSharedPtr<FHoudiniEngineTaskUpdateQueue, ESPMode::ThreadSafe> Updates = WeakTaskUpdates.Pin();
+		if (!Updates.IsValid())
+			return;
+
+		FHoudiniEngineTaskUpdate Update;
+		Update.HAC = WeakHAC;
+		Update.HapiGUID = HapiGUID;
+		Update.TaskInfo = InTaskInfo;
+		Updates->Enqueue(MoveTemp(Update));
+	};
+
+	TaskHandle->OnProgress(PushTaskUpdate);
+	TaskHandle->Then(PushTaskUpdate);
+}
+
+void
+FHoudiniEngineManager::ProcessTaskUpdates(const double& TickStartTime, const double& TickBudget)
+{
+	// Keep the results until cooking is resumed
+	if (!FHoudiniEngine::Get().IsCookingEnabled())
+		return;
+
+	// Handling a result can be costly (PostCook), so we stop when we run out of time,
+	// but always handle at least one result
+	int32 ResultCount = 0;
+	FHoudiniEngineTaskUpdate Update;
+	while ((ResultCount == 0 || (FPlatformTime::Seconds() - TickStartTime) < TickBudget) && TaskUpdates->Dequeue(Update))
+	{
+		// The cook task won't need to be interrupted anymore
+		double CookStartTime = -1.0;
+		if (Update.TaskInfo.TaskState != EHoudiniEngineTaskState::Working && Update.TaskInfo.TaskState != EHoudiniEngineTaskState::None)
+		{
+			CookTaskHandles.Remove(Update.HapiGUID);
+			CookStartTimes.RemoveAndCopyValue(Update.HapiGUID, CookStartTime);
+		}
+
+		UHoudiniAssetComponent* HAC = Update.HAC.Get();
+		if (!HAC || HAC->IsPendingKill())
+			continue;
+
+		// Ignore the updates of tasks the HAC isn't waiting for anymore
+		if (!HAC->HapiGUID.IsValid() || HAC->HapiGUID != Update.HapiGUID)
+			continue;
+
+		// The cook runs asynchronously, so its phase is the wall time between the task's start and its result
+		if (CookStartTime >= 0.0)
+		{
+			FHoudiniCookStatsScope CookStatsScope(HAC);
+			FHoudiniCookStatsScope::AddPhaseTime(EHoudiniCookPhase::Cook, FPlatformTime::Seconds() - CookStartTime);
+		}
+
+		if (!UpdateTaskStatus(HAC->HapiGUID, Update.TaskInfo))
+			continue;
+
+		ResultCount++;
+
+		// All the HAPI calls made while handling the result go to the HAC's session
+		FHoudiniEngineScopedSession ScopedSession(HAC->GetSessionIndex());
+
+		const EHoudiniAssetState PreviousState = HAC->GetAssetState();
+		EHoudiniAssetState NewState = PreviousState;
+		bool bUpdateState = false;
+		if (PreviousState == EHoudiniAssetState::Instantiating)
+			bUpdateState = UpdateInstantiating(HAC, Update.TaskInfo, NewState);
+		else if (PreviousState == EHoudiniAssetState::Cooking)
+			bUpdateState = UpdateCooking(HAC, Update.TaskInfo, NewState);
+
+		if (bUpdateState)
+		{
+			// We need to update the HAC's state
+			HAC->AssetState = NewState;
+		}
+
+		if (HAC->GetAssetState() != PreviousState)
+		{
+			LastTickAdvancedCount++;
+			DependencyGraph.OnAssetStateChanged(HAC);
+		}
+	}
+}
+
+int32
+FHoudiniEngineManager::GetSessionIndexForHoudiniAsset(UHoudiniAssetComponent* HAC)
+{
+	const int32 SessionCount = FHoudiniEngine::Get().GetSessionCount();
+	if (!HAC || HAC->IsPendingKill() || SessionCount <= 1)
+		return 0;
+
+	// HACs connected via asset inputs must share the same session:
+	// follow our input HDAs first, then the HDAs we are an input of
+	int32 SessionIndex = GetInputHoudiniAssetsSessionIndex(HAC);
+	if (FHoudiniEngine::Get().IsSessionIndexValid(SessionIndex))
+		return SessionIndex;
+
+	for (auto& DownstreamHAC : HAC->DownstreamHoudiniAssets)
+	{
+		if (!DownstreamHAC || DownstreamHAC->IsPendingKill())
+			continue;
+
+		SessionIndex = GetInputHoudiniAssetsSessionIndex(DownstreamHAC, HAC);
+		if (SessionIndex < 0 && DownstreamHAC->GetAssetId() >= 0)
+			SessionIndex = DownstreamHAC->GetSessionIndex();
+		else if (SessionIndex < 0 && PreassignedSessionIndices.Contains(DownstreamHAC))
+			SessionIndex = PreassignedSessionIndices[DownstreamHAC];
+
+		if (FHoudiniEngine::Get().IsSessionIndexValid(SessionIndex))
+			return SessionIndex;
+	}
+
+	// PDG asset links are only updated in the main session
+	if (HAC->GetPDGAssetLink())
+		return 0;
+
+	// Keep the session the HAC's library has been preloaded in
+	const int32* PreassignedSessionIndex = PreassignedSessionIndices.Find(HAC);
+	if (PreassignedSessionIndex && FHoudiniEngine::Get().IsSessionIndexValid(*PreassignedSessionIndex))
+		return *PreassignedSessionIndex;
+
+	// Use the session with the least instantiated HACs
+	TArray<int32> SessionLoads;
+	SessionLoads.SetNumZeroed(SessionCount);
+	for (int32 SessionIdx = 0; SessionIdx < SessionCount; SessionIdx++)
+	{
+		if (!FHoudiniEngine::Get().IsSessionIndexValid(SessionIdx))
+			SessionLoads[SessionIdx] = MAX_int32;
+	}
+
+	const int32 RegisteredCount = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentCount();
+	for (int32 Idx = 0; Idx < RegisteredCount; Idx++)
+	{
+		UHoudiniAssetComponent* CurrentHAC = FHoudiniEngineRuntime::Get().GetRegisteredHoudiniComponentAt(Idx);
+		if (!CurrentHAC || CurrentHAC == HAC || CurrentHAC->IsPendingKill())
+			continue;
+
+		// HACs waiting for their instantiation count in the session they've been preassigned to
+		int32 CurrentSessionIndex = CurrentHAC->GetSessionIndex();
+		if (CurrentHAC->GetAssetId() < 0 && CurrentHAC->GetAssetState() != EHoudiniAssetState::Instantiating)
+		{
+			const int32* CurrentPreassignedSessionIndex = PreassignedSessionIndices.Find(CurrentHAC);
+			if (!CurrentPreassignedSessionIndex)
+				continue;
+
+			CurrentSessionIndex = *CurrentPreassignedSessionIndex;
+		}
+
+		if (SessionLoads.IsValidIndex(CurrentSessionIndex) && SessionLoads[CurrentSessionIndex] < MAX_int32)
+			SessionLoads[CurrentSessionIndex]++;
+	}
+
+	int32 BestSessionIndex = 0;
+	for (int32 SessionIdx = 1; SessionIdx < SessionCount; SessionIdx++)
+	{
+		if (SessionLoads[SessionIdx] < SessionLoads[BestSessionIndex])
+			BestSessionIndex = SessionIdx;
+	}
+
+	return BestSessionIndex;
+}
+
+int32
+FHoudiniEngineManager::PreassignSessionForHoudiniAsset(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return 0;
+
+	// Forget the HACs that have been destroyed before their instantiation
+	for (auto It = PreassignedSessionIndices.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+			It.RemoveCurrent();
+	}
+
+	const int32 SessionIndex = GetSessionIndexForHoudiniAsset(HAC);
+	PreassignedSessionIndices.Add(HAC, SessionIndex);
+
+	return SessionIndex;
+}
+
+int32
+FHoudiniEngineManager::GetInputHoudiniAssetsSessionIndex(UHoudiniAssetComponent* HAC, UHoudiniAssetComponent* IgnoredHAC)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return -1;
+
+	TArray<UHoudiniAssetComponent*> InputHACs;
+	HAC->GetInputHoudiniAssets(InputHACs);
+	for (auto& InputHAC : InputHACs)
+	{
+		if (InputHAC == IgnoredHAC)
+			continue;
+
+		if (InputHAC->GetAssetId() >= 0)
+			return InputHAC->GetSessionIndex();
+
+		// Input HDAs waiting for their instantiation will use the session they've been preassigned to
+		const int32* PreassignedSessionIndex = PreassignedSessionIndices.Find(InputHAC);
+		if (PreassignedSessionIndex)
+			return *PreassignedSessionIndex;
+	}
+
+	return -1;
+}
+
+bool
+FHoudiniEngineManager::UpdateSessionAffinity(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill() || FHoudiniEngine::Get().GetSessionCount() <= 1)
+		return false;
+
+	const int32 InputSessionIndex = GetInputHoudiniAssetsSessionIndex(HAC);
+	if (InputSessionIndex < 0)
+		return false;
+
+	// Input HDAs that are not in the same session as the first one have to move there
+	bool bMoved = false;
+	TArray<UHoudiniAssetComponent*> InputHACs;
+	HAC->GetInputHoudiniAssets(InputHACs);
+	for (auto& InputHAC : InputHACs)
+	{
+		if (InputHAC->GetAssetId() < 0 || InputHAC->GetSessionIndex() == InputSessionIndex)
+			continue;
+
+		HOUDINI_LOG_MESSAGE(TEXT("%s: moving input asset %s to Houdini Engine session %d."),
+			*HAC->GetDisplayName(), *InputHAC->GetDisplayName(), InputSessionIndex);
+		ReleaseSessionForHoudiniAsset(InputHAC);
+		bMoved = true;
+	}
+
+	// Wait for the inputs to be instantiated in their new session before moving ourself
+	if (bMoved)
+		return true;
+
+	if (HAC->GetSessionIndex() != InputSessionIndex)
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("%s: moving to Houdini Engine session %d to join its input assets."),
+			*HAC->GetDisplayName(), InputSessionIndex);
+		ReleaseSessionForHoudiniAsset(HAC);
+		return true;
+	}
+
+	return false;
+}
+
+void
+FHoudiniEngineManager::ReleaseSessionForHoudiniAsset(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return;
+
+	// Clean up the nodes we created in our current session
+	if (FHoudiniEngine::Get().IsSessionIndexValid(HAC->GetSessionIndex()))
+	{
+		FHoudiniEngineScopedSession ScopedSession(HAC->GetSessionIndex());
+		for (auto& CurrentInput : HAC->Inputs)
+		{
+			if (!CurrentInput || CurrentInput->IsPendingKill())
+				continue;
+
+			FHoudiniInputTranslator::DestroyInputNodes(CurrentInput, CurrentInput->GetInputType());
+		}
+	}
+
+	// Invalid sessions are ignored when deleting nodes
+	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(HAC->GetAssetId(), true, HAC->GetSessionIndex());
+
+	// Instantiate again right away, the new session will be picked when doing so
+	HAC->HapiGUID.Invalidate();
+	HAC->MarkAsNeedInstantiation();
+	HAC->AssetState = EHoudiniAssetState::PreInstantiation;
 }
 
 bool
@@ -1100,6 +1659,31 @@ FHoudiniEngineManager::IsCookingEnabledForHoudiniAsset(UHoudiniAssetComponent* H
 	return false;
 }
 
+EHoudiniEngineTaskPriority
+FHoudiniEngineManager::GetTaskPriorityForHoudiniAsset(UHoudiniAssetComponent* HAC)
+{
+	if (!HAC || HAC->IsPendingKill())
+		return EHoudiniEngineTaskPriority::Normal;
+
+	AActor* Owner = HAC->GetOwner();
+
+#if WITH_EDITOR
+	// Selected assets are the ones the user is currently editing
+	if (Owner && Owner->IsSelected())
+		return EHoudiniEngineTaskPriority::High;
+#endif
+
+	// Assets visible in a viewport
+	if (Owner && Owner->WasRecentlyRendered(1.0f))
+		return EHoudiniEngineTaskPriority::High;
+
+	// Recook/Rebuild All on assets that are neither selected nor visible
+	if (HAC->HasRecookBeenRequested() || HAC->HasRebuildBeenRequested())
+		return EHoudiniEngineTaskPriority::Low;
+
+	return EHoudiniEngineTaskPriority::Normal;
+}
+
 void 
 FHoudiniEngineManager::BuildStaticMeshesForAllHoudiniStaticMeshes(UHoudiniAssetComponent* HAC)
 {
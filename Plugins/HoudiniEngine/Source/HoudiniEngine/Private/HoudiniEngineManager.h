@@ -34,12 +34,18 @@
 //#include "Misc/SingleThreadRunnable.h"
 
 #include "HoudiniPDGManager.h"
+#include "HoudiniAssetDependencyGraph.h"
+#include "HoudiniEngineTask.h"
+#include "HoudiniEngineTaskInfo.h"
+
+#include "Containers/Queue.h"
 
 class UHoudiniAsset;
 class UHoudiniAssetComponent;
 
-struct FHoudiniEngineTaskInfo;
 struct FGuid;
+struct FHoudiniMeshPrefetch;
+struct FHoudiniOutputBuilder;
 
 enum class EHoudiniAssetState : uint8;
 
@@ -61,27 +67,46 @@ public:
 	// This is fired by the OnRefinedMeshesTimerDelegate on a HAC
 	void BuildStaticMeshesForAllHoudiniStaticMeshes(UHoudiniAssetComponent* HAC);
 
+	// Number of components processed during the last tick
+	int32 GetLastTickProcessedCount() const { return LastTickProcessedCount; };
+	// Number of components whose state changed during the last tick
+	int32 GetLastTickAdvancedCount() const { return LastTickAdvancedCount; };
+
+	// Graph ordering the cooks of HACs connected via asset inputs
+	const FHoudiniAssetDependencyGraph& GetDependencyGraph() const { return DependencyGraph; };
+
 protected:
 
-	// Updates a given task's status
-	// Returns true if the given task's status was properly found
-	bool UpdateTaskStatus(FGuid& OutTaskGUID, FHoudiniEngineTaskInfo& OutTaskInfo);
+	// Updates the slate notifications with a task's new infos,
+	// and invalidates the task's GUID if the task has finished
+	// Returns true if the task has finished
+	bool UpdateTaskStatus(FGuid& OutTaskGUID, const FHoudiniEngineTaskInfo& InTaskInfo);
+
+	// Forwards the progress and result of a HAC's task to the manager's task updates
+	void WatchTask(UHoudiniAssetComponent* HAC, const FHoudiniEngineTaskHandlePtr& TaskHandle);
+
+	// Handles the task updates reported by the schedulers since the last tick
+	void ProcessTaskUpdates(const double& TickStartTime, const double& TickBudget);
 
 	// Start a task to instantiate the given HoudiniAsset
 	// Return true if the task was successfully created
-	bool StartTaskAssetInstantiation(UHoudiniAsset* HoudiniAsset, const FString& DisplayName, FGuid& OutTaskGUID);
+	bool StartTaskAssetInstantiation(
+		UHoudiniAsset* HoudiniAsset, const FString& DisplayName, FGuid& OutTaskGUID, FHoudiniEngineTaskHandlePtr& OutTaskHandle,
+		const EHoudiniEngineTaskPriority& Priority = EHoudiniEngineTaskPriority::Normal);
 
-	// Updates progress of the instantiation task
+	// Handles the result of the instantiation task
 	// Returns true if a state change should be made
-	bool UpdateInstantiating(UHoudiniAssetComponent* HAC, EHoudiniAssetState& NewState);
+	bool UpdateInstantiating(UHoudiniAssetComponent* HAC, const FHoudiniEngineTaskInfo& TaskInfo, EHoudiniAssetState& NewState);
 
 	// Start a task to instantiate the Houdini Asset with the given node Id
 	// Returns true if the task was successfully created
-	bool StartTaskAssetCooking(const HAPI_NodeId& AssetId, const FString& DisplayName, FGuid& OutTaskGUID);
+	bool StartTaskAssetCooking(
+		const HAPI_NodeId& AssetId, const FString& DisplayName, FGuid& OutTaskGUID, FHoudiniEngineTaskHandlePtr& OutTaskHandle,
+		const EHoudiniEngineTaskPriority& Priority = EHoudiniEngineTaskPriority::Normal);
 
-	// Updates progress of the cooking task
+	// Handles the result of the cooking task
 	// Returns true if a state change should be made
-	bool UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetState& NewState);
+	bool UpdateCooking(UHoudiniAssetComponent* HAC, const FHoudiniEngineTaskInfo& TaskInfo, EHoudiniAssetState& NewState);
 
 	// Called to update all houdini nodes/params/inputs before a cook has started
 	bool PreCook(UHoudiniAssetComponent* HAC);
@@ -89,10 +114,22 @@ protected:
 	// Called after a cook has finished 
 	bool PostCook(UHoudiniAssetComponent* HAC, const bool& bSuccess, const HAPI_NodeId& TaskAssetId);
 
+	// Returns true if the HAC's node is live and its current outputs have been produced by a cook with the same fingerprint,
+	// in which case the parameters and inputs are uploaded, but the cook and the output translation are skipped
+	bool IsCookRedundant(UHoudiniAssetComponent* HAC);
+
 	bool StartTaskAssetProcess(UHoudiniAssetComponent* HAC);
 
 	bool UpdateProcess(UHoudiniAssetComponent* HAC);
 
+	// Starts creating the outputs of a HAC once its cook has been processed, using the prefetched mesh parts if any.
+	// The outputs are then created over multiple ticks by UpdateProcess.
+	void StartCreatingOutputs(UHoudiniAssetComponent* HAC, const TSharedPtr<FHoudiniMeshPrefetch>& InMeshPrefetch);
+
+	// Updates the HAC once all its outputs have been created (cook cache, handles, details...)
+	// Returns true if HoudiniStaticMeshes were created and the viewports need to be redrawn.
+	bool FinishCreatingOutputs(UHoudiniAssetComponent* HAC, const bool& bHasHoudiniStaticMeshOutput);
+
 	// Starts a rebuild task (delete then re instantiate)
 	// The NodeID should be invalidated after a successful call
 	bool StartTaskAssetRebuild(const HAPI_NodeId& InAssetId, FGuid& OutTaskGUID);
@@ -103,6 +140,30 @@ protected:
 
 	bool IsCookingEnabledForHoudiniAsset(UHoudiniAssetComponent* HAC);
 
+	// Returns the scheduler priority to use for this HAC's tasks:
+	// selected or visible HACs first, background bulk recooks/rebuilds last
+	EHoudiniEngineTaskPriority GetTaskPriorityForHoudiniAsset(UHoudiniAssetComponent* HAC);
+
+	// Returns the index of the session the HAC should be instantiated in:
+	// the session of the HACs it's connected to via asset inputs, or the least busy session
+	int32 GetSessionIndexForHoudiniAsset(UHoudiniAssetComponent* HAC);
+
+	// Picks the session a HAC waiting for its instantiation will use, so its library can be preloaded there.
+	// The HAC keeps that session when it's instantiated, unless it's no longer valid.
+	int32 PreassignSessionForHoudiniAsset(UHoudiniAssetComponent* HAC);
+
+	// Returns the session used by the first instantiated input HDA of this HAC (ignoring IgnoredHAC)
+	// Returns -1 if the HAC doesn't have any instantiated input HDA
+	int32 GetInputHoudiniAssetsSessionIndex(UHoudiniAssetComponent* HAC, UHoudiniAssetComponent* IgnoredHAC = nullptr);
+
+	// Makes sure the HAC and its input HDAs are all in the same session,
+	// Returns true if some HACs had to be moved to another session
+	bool UpdateSessionAffinity(UHoudiniAssetComponent* HAC);
+
+	// Deletes the HAC's nodes from its current session and marks it for instantiation,
+	// the HAC will then be instantiated in the session returned by GetSessionIndexForHoudiniAsset
+	void ReleaseSessionForHoudiniAsset(UHoudiniAssetComponent* HAC);
+
 	// Syncs the houdini viewport to Unreal's viewport
 	// Returns true if the Houdini viewport has been modified
 	bool SyncHoudiniViewportToUnreal();
@@ -113,6 +174,16 @@ protected:
 
 private:
 
+	// Task infos reported for a HAC's task
+	struct FHoudiniEngineTaskUpdate
+	{
+		TWeakObjectPtr<UHoudiniAssetComponent> HAC;
+		FGuid HapiGUID;
+		FHoudiniEngineTaskInfo TaskInfo;
+	};
+
+	typedef TQueue<FHoudiniEngineTaskUpdate, EQueueMode::Mpsc> FHoudiniEngineTaskUpdateQueue;
+
 	// Delay between each update of the manager
 	static const float TickTimerDelay;
 
@@ -128,6 +199,12 @@ private:
 	// Current number of components in the array
 	uint32 ComponentCount;
 
+	// Number of components processed during the last tick
+	int32 LastTickProcessedCount;
+
+	// Number of components whose state changed during the last tick
+	int32 LastTickAdvancedCount;
+
 	// Stopping flag. 
 	// Indicates that we should stop ticking asap
 	bool bMustStopTicking;
@@ -135,6 +212,28 @@ private:
 	// The PDG Manager, handles all registered PDG Asset Links
 	FHoudiniPDGManager PDGManager;
 
+	// Orders the cooks of HACs connected via asset inputs
+	FHoudiniAssetDependencyGraph DependencyGraph;
+
+	// Handles of the running cook tasks, used to interrupt outdated cooks.
+	TMap<FGuid, FHoudiniEngineTaskHandlePtr> CookTaskHandles;
+
+	// Start time of the running cook tasks, for the HACs' cook stats.
+	TMap<FGuid, double> CookStartTimes;
+
+	// Mesh parts of the cooked HACs being fetched on worker threads, their outputs are created once it's done.
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, TSharedPtr<FHoudiniMeshPrefetch>> PendingMeshPrefetches;
+
+	// Outputs of the cooked HACs being created over multiple ticks.
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, TSharedPtr<FHoudiniOutputBuilder>> PendingOutputBuilders;
+
+	// Sessions picked for HACs before their instantiation, when preloading their libraries.
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, int32> PreassignedSessionIndices;
+
+	// Task updates pushed by the task handles' callbacks on the scheduler threads.
+	// Shared so callbacks outliving the manager can detect it's gone.
+	TSharedRef<FHoudiniEngineTaskUpdateQueue, ESPMode::ThreadSafe> TaskUpdates;
+
 	// For ViewportSync: The camera transform that Hapi and Unreal currently agree with.
 	FVector SyncedHoudiniViewportPivotPosition;
 	FQuat SyncedHoudiniViewportQuat;
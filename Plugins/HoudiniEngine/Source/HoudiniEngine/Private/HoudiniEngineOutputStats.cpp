@@ -1,6 +1,21 @@
 ﻿
 #include "HoudiniEngineOutputStats.h"
 
+#include "HoudiniAssetComponent.h"
+#include "HoudiniApiTrace.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+// Stats the calling thread records into: a HAC's stats, or a worker's own stats
+static thread_local FHoudiniCookStats* HoudiniCurrentCookStats = nullptr;
+// HAC's stats the calling thread's records end up in, propagated to the worker tasks
+static thread_local FHoudiniCookStats* HoudiniSharedCookStats = nullptr;
+static thread_local FHoudiniCookPhaseScope* HoudiniCurrentCookPhase = nullptr;
+
+// Guards the stats shared by the game thread and the workers
+static FCriticalSection HoudiniCookStatsLock;
+
 FHoudiniEngineOutputStats::FHoudiniEngineOutputStats()
 	: NumPackagesCreated(0)
 	, NumPackagesUpdated(0)
@@ -32,4 +47,158 @@ void FHoudiniEngineOutputStats::NotifyObjectsReplaced(const FString& ObjectTypeN
 {
 	const int32 Count = OutputObjectsReplaced.FindOrAdd(ObjectTypeName, 0);
 	OutputObjectsReplaced[ObjectTypeName] = Count + NumReplaced;
-}
\ No newline at end of file
+}
+
+FHoudiniCookStatsScope::FHoudiniCookStatsScope(UHoudiniAssetComponent* InHAC)
+	: PreviousStats(HoudiniCurrentCookStats)
+	, PreviousSharedStats(HoudiniSharedCookStats)
+{
+	HoudiniCurrentCookStats = InHAC && FHoudiniApiTrace::IsRecordingCookStats() ? &InHAC->CookStats : nullptr;
+	HoudiniSharedCookStats = HoudiniCurrentCookStats;
+}
+
+FHoudiniCookStatsScope::~FHoudiniCookStatsScope()
+{
+	HoudiniCurrentCookStats = PreviousStats;
+	HoudiniSharedCookStats = PreviousSharedStats;
+}
+
+FHoudiniCookStats* FHoudiniCookStatsScope::GetCurrent()
+{
+	return HoudiniCurrentCookStats;
+}
+
+void FHoudiniCookStatsScope::NotifyBytesTransferred(int64 NumSent, int64 NumReceived)
+{
+	if (!HoudiniCurrentCookStats)
+		return;
+
+	FScopeLock Lock(&HoudiniCookStatsLock);
+	HoudiniCurrentCookStats->BytesSent += NumSent;
+	HoudiniCurrentCookStats->BytesReceived += NumReceived;
+
+	if (HoudiniCurrentCookPhase)
+		HoudiniCurrentCookStats->GetPhase(HoudiniCurrentCookPhase->Phase).PayloadBytes += NumSent + NumReceived;
+}
+
+void FHoudiniCookStatsScope::AddPhaseTime(const EHoudiniCookPhase& InPhase, double InSeconds)
+{
+	if (!HoudiniCurrentCookStats)
+		return;
+
+	FScopeLock Lock(&HoudiniCookStatsLock);
+	HoudiniCurrentCookStats->GetPhase(InPhase).Seconds += (float)InSeconds;
+	HoudiniCurrentCookStats->TotalSeconds += (float)InSeconds;
+}
+
+void FHoudiniCookStatsScope::AddStats(const FHoudiniCookStats& InStats)
+{
+	if (!HoudiniCurrentCookStats)
+		return;
+
+	FScopeLock Lock(&HoudiniCookStatsLock);
+	HoudiniCurrentCookStats->Accumulate(InStats);
+}
+
+FHoudiniCookPhaseScope::FHoudiniCookPhaseScope(const EHoudiniCookPhase& InPhase)
+	: Phase(InPhase)
+	, Parent(HoudiniCurrentCookPhase)
+	, StartTime(FPlatformTime::Seconds())
+	, ChildSeconds(0.0)
+{
+	// Without stats to fill, the scope does nothing
+	if (!HoudiniCurrentCookStats)
+		return;
+
+	HoudiniCurrentCookPhase = this;
+}
+
+FHoudiniCookPhaseScope::~FHoudiniCookPhaseScope()
+{
+	if (HoudiniCurrentCookPhase != this)
+		return;
+
+	HoudiniCurrentCookPhase = Parent;
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	if (Parent)
+		Parent->ChildSeconds += Elapsed;
+
+	if (!HoudiniCurrentCookStats)
+		return;
+
+	const double Exclusive = FMath::Max(Elapsed - ChildSeconds, 0.0);
+
+	FScopeLock Lock(&HoudiniCookStatsLock);
+	HoudiniCurrentCookStats->GetPhase(Phase).Seconds += (float)Exclusive;
+	HoudiniCurrentCookStats->TotalSeconds += (float)Exclusive;
+}
+
+bool FHoudiniCookPhaseScope::GetCurrentPhase(EHoudiniCookPhase& OutPhase)
+{
+	if (!HoudiniCurrentCookPhase)
+		return false;
+
+	OutPhase = HoudiniCurrentCookPhase->Phase;
+	return true;
+}
+
+void FHoudiniCookPhaseScope::ReattributeTime(const EHoudiniCookPhase& InPhase, double InSeconds)
+{
+	if (!HoudiniCurrentCookPhase || !HoudiniCurrentCookStats || HoudiniCurrentCookPhase->Phase == InPhase)
+		return;
+
+	// Counted as a child so it is removed from the current phase
+	HoudiniCurrentCookPhase->ChildSeconds += InSeconds;
+
+	FScopeLock Lock(&HoudiniCookStatsLock);
+	HoudiniCurrentCookStats->GetPhase(InPhase).Seconds += (float)InSeconds;
+	HoudiniCurrentCookStats->TotalSeconds += (float)InSeconds;
+}
+
+FHoudiniCookStatsContext::FHoudiniCookStatsContext()
+	: Stats(nullptr)
+	, Phase(EHoudiniCookPhase::Count)
+	, bHasPhase(false)
+{ }
+
+FHoudiniCookStatsContext::FHoudiniCookStatsContext(FHoudiniCookStats* InStats, const EHoudiniCookPhase& InPhase)
+	: Stats(InStats)
+	, Phase(InPhase)
+	, bHasPhase(true)
+{ }
+
+FHoudiniCookStatsContext FHoudiniCookStatsContext::Capture()
+{
+	FHoudiniCookStatsContext Context;
+	Context.Stats = HoudiniSharedCookStats;
+	Context.bHasPhase = FHoudiniCookPhaseScope::GetCurrentPhase(Context.Phase);
+	return Context;
+}
+
+FHoudiniCookStatsWorkerScope::FHoudiniCookStatsWorkerScope(const FHoudiniCookStatsContext& InContext)
+	: SharedStats(InContext.Stats)
+	, PreviousStats(HoudiniCurrentCookStats)
+	, PreviousSharedStats(HoudiniSharedCookStats)
+{
+	HoudiniCurrentCookStats = SharedStats ? &WorkerStats : nullptr;
+	HoudiniSharedCookStats = SharedStats;
+
+	if (SharedStats && InContext.bHasPhase)
+		PhaseScope.Emplace(InContext.Phase);
+}
+
+FHoudiniCookStatsWorkerScope::~FHoudiniCookStatsWorkerScope()
+{
+	// Close the phase first so its time is part of the worker's stats
+	PhaseScope.Reset();
+
+	HoudiniCurrentCookStats = PreviousStats;
+	HoudiniSharedCookStats = PreviousSharedStats;
+
+	if (!SharedStats)
+		return;
+
+	FScopeLock Lock(&HoudiniCookStatsLock);
+	SharedStats->Accumulate(WorkerStats);
+}
@@ -28,6 +28,11 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Class.h"
+#include "Misc/Optional.h"
+
+#include "HoudiniCookStats.h"
+
+class UHoudiniAssetComponent;
 
 struct HOUDINIENGINE_API FHoudiniEngineOutputStats
 {
@@ -69,3 +74,80 @@ struct HOUDINIENGINE_API FHoudiniEngineOutputStats
 		NotifyObjectsReplaced( UEnum::GetValueAsString(EnumValue), NumReplaced );
 	}
 };
+
+// Binds the cook stats of a HAC to the calling thread for the lifetime of the scope.
+// Phase scopes and HAPI transfers on this thread are accumulated into them.
+// Does nothing unless the cook stats are being recorded (HoudiniEngine.CookStats).
+struct HOUDINIENGINE_API FHoudiniCookStatsScope
+{
+	FHoudiniCookStatsScope(UHoudiniAssetComponent* InHAC);
+	~FHoudiniCookStatsScope();
+
+	// Stats bound to the calling thread, null outside of a scope
+	static FHoudiniCookStats* GetCurrent();
+
+	// Accounts payload bytes sent to / received from the session, in the stats and in the current phase
+	static void NotifyBytesTransferred(int64 NumSent, int64 NumReceived);
+
+	// Adds time to a phase of the stats bound to the calling thread
+	static void AddPhaseTime(const EHoudiniCookPhase& InPhase, double InSeconds);
+
+	// Adds stats recorded elsewhere to the stats bound to the calling thread
+	static void AddStats(const FHoudiniCookStats& InStats);
+
+private:
+	FHoudiniCookStats* PreviousStats;
+	FHoudiniCookStats* PreviousSharedStats;
+};
+
+// Times a cook phase. Nested phases are exclusive: a child's time isn't counted in its parent.
+struct HOUDINIENGINE_API FHoudiniCookPhaseScope
+{
+	FHoudiniCookPhaseScope(const EHoudiniCookPhase& InPhase);
+	~FHoudiniCookPhaseScope();
+
+	// Phase of the innermost scope on the calling thread
+	static bool GetCurrentPhase(EHoudiniCookPhase& OutPhase);
+
+	// Moves time spent in the innermost scope to another phase
+	static void ReattributeTime(const EHoudiniCookPhase& InPhase, double InSeconds);
+
+private:
+	EHoudiniCookPhase Phase;
+	FHoudiniCookPhaseScope* Parent;
+
+	double StartTime;
+	double ChildSeconds;
+};
+
+// Cook stats and phase of a thread, captured to be bound to the worker tasks it starts.
+struct HOUDINIENGINE_API FHoudiniCookStatsContext
+{
+	FHoudiniCookStatsContext();
+	FHoudiniCookStatsContext(FHoudiniCookStats* InStats, const EHoudiniCookPhase& InPhase);
+
+	// Captures the stats and the current phase of the calling thread
+	static FHoudiniCookStatsContext Capture();
+
+	FHoudiniCookStats* Stats;
+	EHoudiniCookPhase Phase;
+	bool bHasPhase;
+};
+
+// Binds a captured context to a worker thread for the lifetime of the scope, within the captured phase.
+// The worker records into its own stats, which are added to the captured ones when the scope closes:
+// the time of the workers is cumulated in their phase.
+struct HOUDINIENGINE_API FHoudiniCookStatsWorkerScope
+{
+	FHoudiniCookStatsWorkerScope(const FHoudiniCookStatsContext& InContext);
+	~FHoudiniCookStatsWorkerScope();
+
+private:
+	FHoudiniCookStats* SharedStats;
+	FHoudiniCookStats WorkerStats;
+
+	FHoudiniCookStats* PreviousStats;
+	FHoudiniCookStats* PreviousSharedStats;
+
+	TOptional<FHoudiniCookPhaseScope> PhaseScope;
+};
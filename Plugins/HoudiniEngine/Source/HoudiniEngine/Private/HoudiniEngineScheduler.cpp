@@ -30,41 +30,238 @@
 #include "HoudiniEngineString.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngine.h"
-
-const uint32
-FHoudiniEngineScheduler::InitialTaskSize = 256u;
+#include "HoudiniRuntimeSettings.h"
+
+#include "HAL/Event.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/Async.h"
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineSchedulerLegacyPolling(
+	TEXT("HoudiniEngine.SchedulerLegacyPolling"),
+	0,
+	TEXT("If enabled, the scheduler polls the cook state at a fixed interval instead of using an adaptive wait.\n")
+	TEXT("0: Adaptive wait (spin, exponential back-off, then block until the cook state watcher sees the end of the cook)\n")
+	TEXT("1: Fixed interval polling\n")
+);
+
+// Adds tasks to a scheduler from several producer threads while the calling thread
+// retrieves and completes them, and logs the resulting throughput.
+// Usage: HoudiniEngine.SchedulerQueueBenchmark [TaskCount] [ProducerCount] [NodeCount]
+static FAutoConsoleCommand CCmdHoudiniEngineSchedulerQueueBenchmark(
+	TEXT("HoudiniEngine.SchedulerQueueBenchmark"),
+	TEXT("Stress tests the scheduler's task queue. Arguments: [TaskCount=200000] [ProducerCount=4] [NodeCount=0 (one node per task)]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 TaskCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200000;
+		const int32 ProducerCount = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 4;
+		const int32 NodeCount = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 0;
+		FHoudiniEngineScheduler::RunQueueBenchmark(TaskCount, ProducerCount, NodeCount);
+	}));
+
+// Compares the latency of the legacy and adaptive cook state waits on simulated cooks.
+// Usage: HoudiniEngine.SchedulerCookLatencyBenchmark [CookCount] [CookTimeMs]
+static FAutoConsoleCommand CCmdHoudiniEngineSchedulerCookLatencyBenchmark(
+	TEXT("HoudiniEngine.SchedulerCookLatencyBenchmark"),
+	TEXT("Measures the delay between the end of simulated cooks and their detection by the scheduler. Arguments: [CookCount=20] [CookTimeMs=2]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 CookCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20;
+		const float CookTimeMs = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 2.0f;
+		FHoudiniEngineScheduler::RunCookLatencyBenchmark(CookCount, CookTimeMs / 1000.0f);
+	}));
 
 const float
 FHoudiniEngineScheduler::UpdateFrequency = 0.1f;
 
-FHoudiniEngineScheduler::FHoudiniEngineScheduler()
-	: Tasks(nullptr)
-	, PositionWrite(0u)
-	, PositionRead(0u)
-	, bStopping(false)
+const int32
+FHoudiniEngineScheduler::CookStateSpinCount = 16;
+
+const float
+FHoudiniEngineScheduler::CookStateMinWait = 0.0005f;
+
+const float
+FHoudiniEngineScheduler::CookStateBlockingWait = 0.008f;
+
+const float
+FHoudiniEngineCookStateWatcher::MinPollInterval = 0.002f;
+
+const float
+FHoudiniEngineCookStateWatcher::MaxPollInterval = 0.1f;
+
+FHoudiniEngineSchedulerStats::FHoudiniEngineSchedulerStats()
+	: QueueDepth(0)
+	, CoalescedTaskCount(0)
+	, ProcessedTaskCount(0)
+	, CompletedCookCount(0)
+	, CancelledCookCount(0)
+	, LastTaskWaitTime(0.0)
+	, MaxTaskWaitTime(0.0)
+	, TotalTaskWaitTime(0.0)
+{}
+
+FHoudiniEngineCookStateWatcher::FHoudiniEngineCookStateWatcher(
+	const int32& InSessionIndex,
+	TFunction<HAPI_Result(int32&)> InCookStateQuery,
+	FEvent* InCookOverEvent)
+	: SessionIndex(InSessionIndex)
+	, CookStateQuery(MoveTemp(InCookStateQuery))
+	, CookOverEvent(InCookOverEvent)
+	, WakeEvent(nullptr)
+	, bArmed(0)
+	, bStopping(0)
+	, PollInterval(MinPollInterval)
+	, LastCookState(HAPI_STATE_STARTING_COOK)
+	, LastResult(HAPI_RESULT_SUCCESS)
+	, PollCount(0)
 {
-	//  Make sure size is power of two.
-	TaskCount = FPlatformMath::RoundUpToPowerOfTwo(FHoudiniEngineScheduler::InitialTaskSize);
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
 
-	if (TaskCount)
+FHoudiniEngineCookStateWatcher::~FHoudiniEngineCookStateWatcher()
+{
+	if (WakeEvent)
 	{
-		// Allocate buffer to store all tasks.
-		Tasks = static_cast<FHoudiniEngineTask *>(FMemory::Malloc(TaskCount * sizeof(FHoudiniEngineTask)));
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+}
+
+uint32
+FHoudiniEngineCookStateWatcher::Run()
+{
+	// Poll the session of the scheduler we're watching for
+	FHoudiniEngineScopedSession ScopedSession(SessionIndex);
 
-		if (Tasks)
+	while (bStopping.GetValue() == 0)
+	{
+		if (bArmed.GetValue() == 0)
 		{
-			// Zero memory.
-			FMemory::Memset(Tasks, 0x0, TaskCount * sizeof(FHoudiniEngineTask));
+			WakeEvent->Wait();
+			continue;
 		}
+
+		float WaitTime = MaxPollInterval;
+		{
+			FScopeLock Lock(&QueryLock);
+
+			// We might have been disarmed since, Disarm is then waiting for the lock
+			if (bArmed.GetValue() == 0)
+				continue;
+
+			LastCookState = HAPI_STATE_STARTING_COOK;
+			LastResult = CookStateQuery(LastCookState);
+			PollCount++;
+
+			// On failure, let the scheduler poll the session itself
+			if (LastResult != HAPI_RESULT_SUCCESS || IsCookOver(LastCookState))
+			{
+				bArmed.Reset();
+				if (CookOverEvent)
+					CookOverEvent->Trigger();
+
+				continue;
+			}
+
+			WaitTime = PollInterval;
+			PollInterval = FMath::Min(PollInterval * 2.0f, MaxPollInterval);
+		}
+
+		// Arm and Stop wake us up early
+		WakeEvent->Wait(FTimespan::FromSeconds(WaitTime));
 	}
+
+	return 0;
+}
+
+void
+FHoudiniEngineCookStateWatcher::Stop()
+{
+	bStopping.Set(1);
+	if (WakeEvent)
+		WakeEvent->Trigger();
+}
+
+void
+FHoudiniEngineCookStateWatcher::Arm()
+{
+	{
+		FScopeLock Lock(&QueryLock);
+		PollCount = 0;
+		bArmed.Set(1);
+	}
+
+	if (WakeEvent)
+		WakeEvent->Trigger();
+}
+
+void
+FHoudiniEngineCookStateWatcher::Disarm()
+{
+	bArmed.Reset();
+
+	// Wait for the poll in progress, no other will start
+	FScopeLock Lock(&QueryLock);
+}
+
+void
+FHoudiniEngineCookStateWatcher::ResetBackoff()
+{
+	FScopeLock Lock(&QueryLock);
+	PollInterval = MinPollInterval;
+}
+
+bool
+FHoudiniEngineCookStateWatcher::GetLastCookState(int32& OutCookState, HAPI_Result& OutResult, int32& OutPollCount)
+{
+	FScopeLock Lock(&QueryLock);
+	OutCookState = LastCookState;
+	OutResult = LastResult;
+	OutPollCount = PollCount;
+	return PollCount > 0;
+}
+
+bool
+FHoudiniEngineCookStateWatcher::IsCookOver(const int32& InCookState)
+{
+	return InCookState == HAPI_STATE_READY
+		|| InCookState == HAPI_STATE_READY_WITH_FATAL_ERRORS
+		|| InCookState == HAPI_STATE_READY_WITH_COOK_ERRORS;
+}
+
+FHoudiniEngineScheduler::FHoudiniEngineScheduler(const int32& InSessionIndex)
+	: TaskEvent(nullptr)
+	, CookStateWatcher(nullptr)
+	, CookStateWatcherThread(nullptr)
+	, NewTaskCount(0)
+	, SessionIndex(InSessionIndex)
+	, bStopping(false)
+{
+	TaskEvent = FPlatformProcess::GetSynchEventFromPool(false);
 }
 
 FHoudiniEngineScheduler::~FHoudiniEngineScheduler()
 {
-	if (TaskCount)
+	StopCookStateWatcher();
+
+	// Complete the tasks that will never be processed so nobody waits on them
+	FHoudiniEngineTask Task;
+	while (NewTasks.Dequeue(Task))
+		AbortTask(Task);
+
+	for (TArray<FHoudiniEngineTask>& PendingList : PendingTasks)
 	{
-		FMemory::Free(Tasks);
-		Tasks = nullptr;
+		for (const FHoudiniEngineTask& PendingTask : PendingList)
+			AbortTask(PendingTask);
+
+		PendingList.Empty();
+	}
+
+	if (TaskEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(TaskEvent);
+		TaskEvent = nullptr;
 	}
 }
 
@@ -187,66 +384,130 @@ FHoudiniEngineScheduler::TaskInstantiateAsset(const FHoudiniEngineTask & Task)
 
 	//TaskInfo.bLoadedComponent = Task.bLoadedComponent;
 	TaskDescription(TaskInfo, Task.ActorName, TEXT("Started Instantiation"));
-	FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, TaskInfo);
+	SetTaskInfo(Task, TaskInfo);
+
+	// We need to wait until instantiation is finished.
+	const double StartTime = FPlatformTime::Seconds();
+	int32 PollCount = 0;
+	const int32 Status = WaitForCookCompletion(
+		CVarHoudiniEngineSchedulerLegacyPolling.GetValueOnAnyThread() != 0,
+		[&]()
+		{
+			static const double NotificationUpdateFrequency = 0.5;
+			if ((FPlatformTime::Seconds() - LastUpdateTime) >= NotificationUpdateFrequency)
+			{
+				// Reset update time.
+				LastUpdateTime = FPlatformTime::Seconds();
+				const FString& CookStateMessage = FHoudiniEngineUtils::GetCookState();
+
+				AddResponseMessageTaskInfo(
+					HAPI_RESULT_SUCCESS,
+					EHoudiniEngineTaskType::AssetInstantiation,
+					EHoudiniEngineTaskState::Working,
+					AssetId, Task, CookStateMessage);
+			}
+		},
+		Result, PollCount);
 
-	// We need to spin until instantiation is finished.
-	while (true)
+	if (Status == HAPI_STATE_READY)
 	{
-		int Status = HAPI_STATE_STARTING_COOK;
-		HOUDINI_CHECK_ERROR_GET(&Result, FHoudiniApi::GetStatus(
-			FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &Status));
+		// Cooking has been successful.
+		AddResponseMessageTaskInfo(
+			HAPI_RESULT_SUCCESS, 
+			EHoudiniEngineTaskType::AssetInstantiation,
+			EHoudiniEngineTaskState::Success, AssetId, Task,
+			TEXT("Finished Instantiation."));
 
-		if (Status == HAPI_STATE_READY)
-		{
-			// Cooking has been successful.
-			AddResponseMessageTaskInfo(
-				HAPI_RESULT_SUCCESS, 
-				EHoudiniEngineTaskType::AssetInstantiation,
-				EHoudiniEngineTaskState::Success, AssetId, Task,
-				TEXT("Finished Instantiation."));
-
-			break;
-		}
-		else if (Status == HAPI_STATE_READY_WITH_FATAL_ERRORS || Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
-		{
-			// There was an error while instantiating.
-			FString CookResultString = FHoudiniEngineUtils::GetCookResult();
-			int32 CookResult = static_cast<int32>(HAPI_RESULT_SUCCESS);
-			FHoudiniApi::GetStatus(FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_RESULT, &CookResult);
-
-			EHoudiniEngineTaskState TaskStateResult = EHoudiniEngineTaskState::FinishedWithFatalError;
-			if (Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
-				TaskStateResult = EHoudiniEngineTaskState::FinishedWithError;
-
-			AddResponseMessageTaskInfo(
-				static_cast<HAPI_Result>(CookResult), 
-				EHoudiniEngineTaskType::AssetInstantiation,	
-				TaskStateResult,
-				AssetId, Task,
-				FString::Printf(TEXT("Finished Instantiation with Errors: %s"), *CookResultString));
-
-			break;
-		}
+		HOUDINI_LOG_HELPER(Verbose,
+			TEXT("HAPI Asynchronous Instantiation Finished for %s in %.3f ms (%d polls)"),
+			*Task.ActorName, (FPlatformTime::Seconds() - StartTime) * 1000.0, PollCount);
+	}
+	else
+	{
+		// There was an error while instantiating.
+		FString CookResultString = FHoudiniEngineUtils::GetCookResult();
+		int32 CookResult = static_cast<int32>(HAPI_RESULT_SUCCESS);
+		FHoudiniApi::GetStatus(FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_RESULT, &CookResult);
 
-		static const double NotificationUpdateFrequency = 0.5;
-		if ((FPlatformTime::Seconds() - LastUpdateTime) >= NotificationUpdateFrequency)
-		{
-			// Reset update time.
-			LastUpdateTime = FPlatformTime::Seconds();
-			const FString& CookStateMessage = FHoudiniEngineUtils::GetCookState();
-
-			AddResponseMessageTaskInfo(
-				HAPI_RESULT_SUCCESS,
-				EHoudiniEngineTaskType::AssetInstantiation,
-				EHoudiniEngineTaskState::Working,
-				AssetId, Task, CookStateMessage);
-		}
+		EHoudiniEngineTaskState TaskStateResult = EHoudiniEngineTaskState::FinishedWithFatalError;
+		if (Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
+			TaskStateResult = EHoudiniEngineTaskState::FinishedWithError;
 
-		// We want to yield.
-		FPlatformProcess::Sleep(UpdateFrequency);
+		AddResponseMessageTaskInfo(
+			static_cast<HAPI_Result>(CookResult), 
+			EHoudiniEngineTaskType::AssetInstantiation,	
+			TaskStateResult,
+			AssetId, Task,
+			FString::Printf(TEXT("Finished Instantiation with Errors: %s"), *CookResultString));
 	}
 }
 
+void
+FHoudiniEngineScheduler::TaskLoadAssetLibrary(const FHoudiniEngineTask & Task)
+{
+	if (!FHoudiniEngineUtils::IsInitialized())
+	{
+		AddResponseMessageTaskInfo(
+			HAPI_RESULT_NOT_INITIALIZED,
+			EHoudiniEngineTaskType::AssetLibraryLoad,
+			EHoudiniEngineTaskState::FinishedWithFatalError,
+			-1, Task, TEXT("HAPI is not initialized."));
+
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// An instantiation might have loaded this library already, or be loading it
+	FHoudiniAssetLibraryCache& AssetLibraryCache = FHoudiniEngine::Get().GetAssetLibraryCache();
+	HAPI_AssetLibraryId AssetLibraryId = -1;
+	const EHoudiniAssetLibraryLoadState LoadState = AssetLibraryCache.BeginLoad(Task.AssetLibraryHash, AssetLibraryId);
+	if (LoadState != EHoudiniAssetLibraryLoadState::MustLoad)
+	{
+		AddResponseMessageTaskInfo(
+			HAPI_RESULT_SUCCESS,
+			EHoudiniEngineTaskType::AssetLibraryLoad,
+			EHoudiniEngineTaskState::Success,
+			-1, Task, LoadState == EHoudiniAssetLibraryLoadState::Loaded ? TEXT("Library Already Loaded") : TEXT("Library Being Loaded"));
+
+		return;
+	}
+
+	std::string LibraryPathPlain;
+	FHoudiniEngineUtils::ConvertUnrealString(Task.AssetLibraryPath, LibraryPathPlain);
+
+	HAPI_Result Result = FHoudiniApi::LoadAssetLibraryFromFile(
+		FHoudiniEngine::Get().GetSession(), LibraryPathPlain.c_str(), true, &AssetLibraryId);
+	if (Result != HAPI_RESULT_SUCCESS)
+	{
+		AssetLibraryCache.EndLoad(Task.AssetLibraryHash, Task.AssetLibraryPath, -1, false);
+
+		// The library will be loaded again on instantiation
+		HOUDINI_LOG_WARNING(
+			TEXT("HAPI Asynchronous Library Preload failed for %s: %s"),
+			*Task.AssetLibraryPath, *FHoudiniEngineUtils::GetErrorDescription());
+
+		AddResponseTaskInfo(
+			Result, EHoudiniEngineTaskType::AssetLibraryLoad,
+			EHoudiniEngineTaskState::FinishedWithError, -1, Task);
+
+		return;
+	}
+
+	// The instantiations using this library will reuse it
+	AssetLibraryCache.EndLoad(Task.AssetLibraryHash, Task.AssetLibraryPath, AssetLibraryId, true);
+
+	HOUDINI_LOG_HELPER(Verbose,
+		TEXT("HAPI Asynchronous Library Preload Finished for %s in %.3f ms"),
+		*Task.ActorName, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	AddResponseMessageTaskInfo(
+		HAPI_RESULT_SUCCESS,
+		EHoudiniEngineTaskType::AssetLibraryLoad,
+		EHoudiniEngineTaskState::Success,
+		-1, Task, TEXT("Finished Loading Library"));
+}
+
 void
 FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 {
@@ -288,6 +549,14 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 		return;
 	}
 
+	// No need to start a cook whose result is already outdated
+	if (IsCookOutdated(Task))
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("HAPI Asynchronous Cooking Skipped for %s: outdated cook."), *Task.ActorName);
+		CancelCook(Task, TEXT("Cooking Cancelled"));
+		return;
+	}
+
 	// Default CookOptions
 	HAPI_CookOptions CookOptions = FHoudiniEngine::GetDefaultCookOptions();
 	Result = FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), AssetId, &CookOptions);
@@ -301,6 +570,8 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 		return;
 	}
 
+	FHoudiniEngine::Get().GetAttributeCache().NotifyCooked();
+
 	// Add processing notification.
 	AddResponseMessageTaskInfo(
 		HAPI_RESULT_SUCCESS, 
@@ -311,59 +582,218 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 	// Initialize last update time.
 	double LastUpdateTime = FPlatformTime::Seconds();
 
-	// We need to spin until cooking is finished.
-	while (true)
+	// We need to wait until cooking is finished.
+	const double StartTime = LastUpdateTime;
+	int32 PollCount = 0;
+	bool bInterrupted = false;
+	const int32 Status = WaitForCookCompletion(
+		CVarHoudiniEngineSchedulerLegacyPolling.GetValueOnAnyThread() != 0,
+		[&]()
+		{
+			// Latest wins: interrupt the cook as soon as its result is outdated
+			if (!bInterrupted && IsCookOutdated(Task))
+			{
+				HOUDINI_LOG_MESSAGE(
+					TEXT("HAPI Asynchronous Cooking Interrupted for %s after %.3f ms: outdated cook."),
+					*Task.ActorName, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+				FHoudiniApi::Interrupt(FHoudiniEngine::Get().GetSession());
+				bInterrupted = true;
+			}
+
+			static const double NotificationUpdateFrequency = 0.5;
+			if (FPlatformTime::Seconds() - LastUpdateTime >= NotificationUpdateFrequency)
+			{
+				// Reset update time.
+				LastUpdateTime = FPlatformTime::Seconds();
+
+				// Retrieve status string.
+				const FString & CookStateMessage = FHoudiniEngineUtils::GetCookState();
+
+				AddResponseMessageTaskInfo(
+					HAPI_RESULT_SUCCESS,
+					EHoudiniEngineTaskType::AssetCooking,
+					EHoudiniEngineTaskState::Working,
+					AssetId, Task, CookStateMessage);
+			}
+		},
+		Result, PollCount);
+
+	if (bInterrupted)
 	{
-		int32 Status = HAPI_STATE_STARTING_COOK;
-		HOUDINI_CHECK_ERROR_GET( &Result, FHoudiniApi::GetStatus(
-			FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &Status));
+		// Discard the result of the interrupted cook, even if it managed to finish
+		CancelCook(Task, TEXT("Cooking Cancelled"));
+		return;
+	}
 
-		if (Status == HAPI_STATE_READY)
-		{
-			// Cooking has been successful.
-			AddResponseMessageTaskInfo(
-				HAPI_RESULT_SUCCESS, 
-				EHoudiniEngineTaskType::AssetCooking,
-				EHoudiniEngineTaskState::Success,
-				AssetId, Task, TEXT("Finished Cooking"));
-
-			break;
-		}
-		else if (Status == HAPI_STATE_READY_WITH_FATAL_ERRORS || Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
-		{
-			EHoudiniEngineTaskState TaskResult = EHoudiniEngineTaskState::FinishedWithFatalError;
-			if (Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
-				TaskResult = EHoudiniEngineTaskState::FinishedWithError;
-
-			// There was an error while instantiating.
-			AddResponseMessageTaskInfo(
-				HAPI_RESULT_SUCCESS,
-				EHoudiniEngineTaskType::AssetCooking,
-				TaskResult,
-				AssetId, Task,
-				TEXT("Finished Cooking with Errors"));
-
-			break;
-		}
+	{
+		FScopeLock StatsLock(&StatsCriticalSection);
+		Stats.CompletedCookCount++;
+	}
 
-		static const double NotificationUpdateFrequency = 0.5;
-		if (FPlatformTime::Seconds() - LastUpdateTime >= NotificationUpdateFrequency)
-		{
-			// Reset update time.
-			LastUpdateTime = FPlatformTime::Seconds();
+	if (Status == HAPI_STATE_READY)
+	{
+		// Cooking has been successful.
+		AddResponseMessageTaskInfo(
+			HAPI_RESULT_SUCCESS, 
+			EHoudiniEngineTaskType::AssetCooking,
+			EHoudiniEngineTaskState::Success,
+			AssetId, Task, TEXT("Finished Cooking"));
 
-			// Retrieve status string.
-			const FString & CookStateMessage = FHoudiniEngineUtils::GetCookState();
+		HOUDINI_LOG_HELPER(Verbose,
+			TEXT("HAPI Asynchronous Cooking Finished for %s in %.3f ms (%d polls)"),
+			*Task.ActorName, (FPlatformTime::Seconds() - StartTime) * 1000.0, PollCount);
+	}
+	else
+	{
+		EHoudiniEngineTaskState TaskResult = EHoudiniEngineTaskState::FinishedWithFatalError;
+		if (Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
+			TaskResult = EHoudiniEngineTaskState::FinishedWithError;
 
-			AddResponseMessageTaskInfo(
-				HAPI_RESULT_SUCCESS,
-				EHoudiniEngineTaskType::AssetCooking,
-				EHoudiniEngineTaskState::Working,
-				AssetId, Task, CookStateMessage);
+		// There was an error while instantiating.
+		AddResponseMessageTaskInfo(
+			HAPI_RESULT_SUCCESS,
+			EHoudiniEngineTaskType::AssetCooking,
+			TaskResult,
+			AssetId, Task,
+			TEXT("Finished Cooking with Errors"));
+	}
+}
+
+HAPI_Result
+FHoudiniEngineScheduler::QueryCookState(int32& OutCookState)
+{
+	if (CookStateStub)
+		return CookStateStub(OutCookState);
+
+	return FHoudiniApi::GetStatus(FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &OutCookState);
+}
+
+int32
+FHoudiniEngineScheduler::WaitForCookCompletion(
+	const bool& bInLegacyPolling,
+	TFunctionRef<void()> InOnPoll,
+	HAPI_Result& OutResult,
+	int32& OutPollCount)
+{
+	OutPollCount = 0;
+	if (CookStateWatcher)
+		CookStateWatcher->ResetBackoff();
+
+	int32 Status = HAPI_STATE_STARTING_COOK;
+	bool bCookStateWatched = false;
+	for (int32 WaitCount = 0; true; WaitCount++)
+	{
+		// Don't poll again if the watcher just did it for us
+		if (!bCookStateWatched)
+		{
+			Status = HAPI_STATE_STARTING_COOK;
+			HOUDINI_CHECK_ERROR_GET(&OutResult, QueryCookState(Status));
+			OutPollCount++;
 		}
 
+		if (FHoudiniEngineCookStateWatcher::IsCookOver(Status))
+			return Status;
+
+		InOnPoll();
+
 		// We want to yield.
+		bCookStateWatched = WaitForCookStateUpdate(WaitCount, bInLegacyPolling, Status, OutPollCount);
+	}
+}
+
+bool
+FHoudiniEngineScheduler::WaitForCookStateUpdate(
+	const int32& WaitCount,
+	const bool& bInLegacyPolling,
+	int32& OutCookState,
+	int32& InOutPollCount)
+{
+	if (bInLegacyPolling)
+	{
 		FPlatformProcess::Sleep(UpdateFrequency);
+		return false;
+	}
+
+	// Cheap cooks usually finish within a few polls, only give up our time slice
+	if (WaitCount < CookStateSpinCount)
+	{
+		FPlatformProcess::YieldThread();
+		return false;
+	}
+
+	// Then back off exponentially
+	const int32 BackoffStep = FMath::Min(WaitCount - CookStateSpinCount, 16);
+	const float WaitTime = FMath::Min(CookStateMinWait * (float)(1 << BackoffStep), UpdateFrequency);
+	if (!TaskEvent)
+	{
+		FPlatformProcess::Sleep(WaitTime);
+		return false;
+	}
+
+	if (WaitTime < CookStateBlockingWait || !CookStateWatcher)
+	{
+		// Wait on the task event so we can react to newly queued tasks
+		TaskEvent->Wait(FTimespan::FromSeconds(WaitTime));
+		return false;
+	}
+
+	// Long cook: block until the watcher sees its end, or a task is added.
+	// We still wake up at the regular update frequency to send the cook state notifications.
+	// The watcher is the only one polling the session until it is disarmed.
+	CookStateWatcher->Arm();
+	TaskEvent->Wait(FTimespan::FromSeconds(UpdateFrequency));
+	CookStateWatcher->Disarm();
+
+	int32 CookState = HAPI_STATE_STARTING_COOK;
+	HAPI_Result Result = HAPI_RESULT_SUCCESS;
+	int32 WatcherPollCount = 0;
+	const bool bPolled = CookStateWatcher->GetLastCookState(CookState, Result, WatcherPollCount);
+	InOutPollCount += WatcherPollCount;
+
+	// If the watcher failed to poll, we'll poll the session ourselves
+	if (!bPolled || Result != HAPI_RESULT_SUCCESS)
+		return false;
+
+	OutCookState = CookState;
+	return true;
+}
+
+void
+FHoudiniEngineScheduler::StartCookStateWatcher()
+{
+	if (CookStateWatcher || !FPlatformProcess::SupportsMultithreading() || !TaskEvent)
+		return;
+
+	CookStateWatcher = new FHoudiniEngineCookStateWatcher(
+		SessionIndex,
+		[this](int32& OutCookState) { return QueryCookState(OutCookState); },
+		TaskEvent);
+
+	CookStateWatcherThread = FRunnableThread::Create(
+		CookStateWatcher, *FString::Printf(TEXT("HoudiniCookStateWatcher_%d"), SessionIndex), 0, TPri_Normal);
+
+	if (!CookStateWatcherThread)
+	{
+		delete CookStateWatcher;
+		CookStateWatcher = nullptr;
+	}
+}
+
+void
+FHoudiniEngineScheduler::StopCookStateWatcher()
+{
+	if (CookStateWatcherThread)
+	{
+		CookStateWatcherThread->Kill(true);
+		delete CookStateWatcherThread;
+		CookStateWatcherThread = nullptr;
+	}
+
+	if (CookStateWatcher)
+	{
+		delete CookStateWatcher;
+		CookStateWatcher = nullptr;
 	}
 }
 
@@ -393,7 +823,7 @@ FHoudiniEngineScheduler::AddResponseTaskInfo(
 	//TaskInfo.bLoadedComponent = Task.bLoadedComponent;
 
 	TaskDescription(TaskInfo, Task.ActorName, StatusString);
-	FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, TaskInfo);
+	SetTaskInfo(Task, TaskInfo);
 }
 
 void
@@ -406,7 +836,29 @@ FHoudiniEngineScheduler::AddResponseMessageTaskInfo(
 	//TaskInfo.bLoadedComponent = Task.bLoadedComponent;
 
 	TaskDescription(TaskInfo, Task.ActorName, ErrorMessage);
-	FHoudiniEngine::Get().AddTaskInfo(Task.HapiGUID, TaskInfo);
+	SetTaskInfo(Task, TaskInfo);
+}
+
+void
+FHoudiniEngineScheduler::SetTaskInfo(const FHoudiniEngineTask & Task, const FHoudiniEngineTaskInfo & TaskInfo)
+{
+	if (Task.Handle.IsValid())
+		Task.Handle->SetTaskInfo(TaskInfo);
+
+	// Tasks merged into this one share its result
+	for (const FHoudiniEngineTaskHandlePtr& CoalescedHandle : Task.CoalescedHandles)
+	{
+		if (CoalescedHandle.IsValid())
+			CoalescedHandle->SetTaskInfo(TaskInfo);
+	}
+}
+
+void
+FHoudiniEngineScheduler::AbortTask(const FHoudiniEngineTask & Task)
+{
+	AddResponseMessageTaskInfo(
+		HAPI_RESULT_FAILURE, Task.TaskType, EHoudiniEngineTaskState::Aborted,
+		Task.AssetId, Task, TEXT("Aborted, the scheduler has been stopped."));
 }
 
 void
@@ -416,21 +868,12 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 	{
 		while (true)
 		{
+			// Retrieve task.
 			FHoudiniEngineTask Task;
-
+			if (!GetNextTask(Task))
 			{
-				FScopeLock ScopeLock(&CriticalSection);
-
 				// We have no tasks left.
-				if (PositionWrite == PositionRead)
-					break;
-
-				// Retrieve task.
-				Task = Tasks[PositionRead];
-				PositionRead++;
-
-				// Wrap around if required.
-				PositionRead &= (TaskCount - 1);
+				break;
 			}
 
 			bool bTaskProcessed = true;
@@ -461,6 +904,12 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 					break;
 				}
 
+				case EHoudiniEngineTaskType::AssetLibraryLoad:
+				{
+					TaskLoadAssetLibrary(Task);
+					break;
+				}
+
 				default:
 				{
 					bTaskProcessed = false;
@@ -474,8 +923,11 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 
 		if (FPlatformProcess::SupportsMultithreading())
 		{
-			// We want to yield for a bit.
-			FPlatformProcess::Sleep(UpdateFrequency);
+			// Wait until a new task is added, or for a bit.
+			if (TaskEvent)
+				TaskEvent->Wait(FTimespan::FromSeconds(UpdateFrequency));
+			else
+				FPlatformProcess::Sleep(UpdateFrequency);
 		}
 		else
 		{
@@ -485,6 +937,299 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 	}
 }
 
+void
+FHoudiniEngineScheduler::MoveNewTasksToPending()
+{
+	// We are the only consumer, so this doesn't need to lock.
+	FHoudiniEngineTask NewTask;
+	while (NewTasks.Dequeue(NewTask))
+	{
+		NewTaskCount.Decrement();
+		AddPendingTask(MoveTemp(NewTask));
+	}
+}
+
+FHoudiniEngineTask*
+FHoudiniEngineScheduler::FindPendingCook(const HAPI_NodeId& AssetId)
+{
+	if (AssetId < 0)
+		return nullptr;
+
+	// Pending cooks are coalesced, so there is at most one per node
+	for (TArray<FHoudiniEngineTask>& PendingList : PendingTasks)
+	{
+		for (FHoudiniEngineTask& PendingTask : PendingList)
+		{
+			if (PendingTask.TaskType == EHoudiniEngineTaskType::AssetCooking && PendingTask.AssetId == AssetId)
+				return &PendingTask;
+		}
+	}
+
+	return nullptr;
+}
+
+bool
+FHoudiniEngineScheduler::IsCookOutdated(const FHoudiniEngineTask& Task)
+{
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	if (!HoudiniRuntimeSettings || !HoudiniRuntimeSettings->bInterruptOutdatedCooks)
+		return false;
+
+	// The manager requests the cancellation of a cook when the parameters or inputs
+	// of its HAC change while it is running, it never queues a second cook for the same node
+	return Task.Handle.IsValid() && Task.Handle->IsCancelRequested();
+}
+
+void
+FHoudiniEngineScheduler::CancelCook(const FHoudiniEngineTask& Task, const FString& Reason)
+{
+	{
+		FScopeLock StatsLock(&StatsCriticalSection);
+		Stats.CancelledCookCount++;
+	}
+
+	// The requesters of the outdated cook will receive the result of the newer one
+	FHoudiniEngineTask* NewerCook = FindPendingCook(Task.AssetId);
+	if (NewerCook)
+	{
+		NewerCook->CoalescedHandles.Add(Task.Handle);
+		NewerCook->CoalescedHandles.Append(Task.CoalescedHandles);
+
+		// Keep the priority of the cancelled cook, along with the node's other pending tasks
+		PromotePendingTasks(Task.AssetId, Task.Priority);
+		return;
+	}
+
+	AddResponseMessageTaskInfo(
+		HAPI_RESULT_USER_INTERRUPTED,
+		EHoudiniEngineTaskType::AssetCooking,
+		EHoudiniEngineTaskState::Cancelled,
+		Task.AssetId, Task, Reason);
+}
+
+bool
+FHoudiniEngineScheduler::GetNextTask(FHoudiniEngineTask& OutTask)
+{
+	// Move the newly added tasks to the pending lists.
+	MoveNewTasksToPending();
+
+	// Retrieve the oldest task with the highest priority
+	int32 QueueDepth = 0;
+	bool bFound = false;
+	for (TArray<FHoudiniEngineTask>& PendingList : PendingTasks)
+	{
+		if (!bFound && PendingList.Num() > 0)
+		{
+			OutTask = MoveTemp(PendingList[0]);
+			PendingList.RemoveAt(0);
+			bFound = true;
+		}
+
+		QueueDepth += PendingList.Num();
+	}
+
+	FScopeLock StatsLock(&StatsCriticalSection);
+	Stats.QueueDepth = QueueDepth;
+	if (bFound)
+	{
+		const double WaitTime = FPlatformTime::Seconds() - OutTask.EnqueueTime;
+		Stats.ProcessedTaskCount++;
+		Stats.LastTaskWaitTime = WaitTime;
+		Stats.MaxTaskWaitTime = FMath::Max(Stats.MaxTaskWaitTime, WaitTime);
+		Stats.TotalTaskWaitTime += WaitTime;
+	}
+
+	return bFound;
+}
+
+void
+FHoudiniEngineScheduler::AddPendingTask(FHoudiniEngineTask&& NewTask)
+{
+	// A node's tasks must be processed in the order they were added:
+	// pending tasks of the same node can't stay behind the new one.
+	PromotePendingTasks(NewTask.AssetId, NewTask.Priority);
+
+	// Only the latest cook of a given node needs to be executed:
+	// merge the new task into the pending cook of that node, keeping its place in the queue
+	if (NewTask.TaskType == EHoudiniEngineTaskType::AssetCooking)
+	{
+		FHoudiniEngineTask* PendingCook = FindPendingCook(NewTask.AssetId);
+		if (PendingCook)
+		{
+			NewTask.CoalescedHandles.Add(PendingCook->Handle);
+			NewTask.CoalescedHandles.Append(PendingCook->CoalescedHandles);
+
+			// Keep the highest priority and the oldest enqueue time
+			NewTask.Priority = PendingCook->Priority;
+			NewTask.EnqueueTime = FMath::Min(NewTask.EnqueueTime, PendingCook->EnqueueTime);
+
+			*PendingCook = MoveTemp(NewTask);
+
+			FScopeLock StatsLock(&StatsCriticalSection);
+			Stats.CoalescedTaskCount++;
+			return;
+		}
+	}
+
+	const int32 PriorityIndex = FMath::Clamp((int32)NewTask.Priority, 0, (int32)UE_ARRAY_COUNT(PendingTasks) - 1);
+	PendingTasks[PriorityIndex].Add(MoveTemp(NewTask));
+}
+
+void
+FHoudiniEngineScheduler::PromotePendingTasks(const HAPI_NodeId& AssetId, const EHoudiniEngineTaskPriority& Priority)
+{
+	if (AssetId < 0)
+		return;
+
+	const int32 PriorityIndex = FMath::Clamp((int32)Priority, 0, (int32)UE_ARRAY_COUNT(PendingTasks) - 1);
+
+	// The lists are visited from the highest to the lowest priority, which is
+	// also the order in which the node's tasks have been added since each new
+	// task promotes the older ones.
+	for (int32 ListIdx = PriorityIndex + 1; ListIdx < (int32)UE_ARRAY_COUNT(PendingTasks); ListIdx++)
+	{
+		TArray<FHoudiniEngineTask>& PendingList = PendingTasks[ListIdx];
+		for (int32 Idx = 0; Idx < PendingList.Num(); )
+		{
+			if (PendingList[Idx].AssetId != AssetId)
+			{
+				Idx++;
+				continue;
+			}
+
+			FHoudiniEngineTask& PromotedTask = PendingTasks[PriorityIndex].Add_GetRef(MoveTemp(PendingList[Idx]));
+			PromotedTask.Priority = Priority;
+			PendingList.RemoveAt(Idx);
+		}
+	}
+}
+
+void
+FHoudiniEngineScheduler::GetStats(FHoudiniEngineSchedulerStats& OutStats)
+{
+	FScopeLock StatsLock(&StatsCriticalSection);
+	OutStats = Stats;
+
+	// Add the tasks that haven't been moved to the pending lists yet
+	OutStats.QueueDepth += FMath::Max(NewTaskCount.GetValue(), 0);
+}
+
+void
+FHoudiniEngineScheduler::RunQueueBenchmark(const int32& InTaskCount, const int32& InProducerCount, const int32& InNodeCount)
+{
+	const int32 TaskCount = FMath::Max(InTaskCount, 1);
+	const int32 ProducerCount = FMath::Clamp(InProducerCount, 1, 64);
+	const int32 NodeCount = InNodeCount > 0 ? InNodeCount : TaskCount;
+	const int32 TasksPerProducer = FMath::DivideAndRoundUp(TaskCount, ProducerCount);
+
+	// Tasks go through AddTask and GetNextTask like the ones sent by the manager,
+	// only their processing is replaced by the completion of their handles.
+	FHoudiniEngineScheduler Scheduler;
+	FThreadSafeCounter ProducedCount(0);
+	FThreadSafeCounter CompletedHandleCount(0);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<TFuture<void>> Producers;
+	for (int32 ProducerIdx = 0; ProducerIdx < ProducerCount; ProducerIdx++)
+	{
+		const int32 FirstTask = ProducerIdx * TasksPerProducer;
+		const int32 LastTask = FMath::Min(FirstTask + TasksPerProducer, TaskCount);
+		Producers.Add(Async(EAsyncExecution::Thread, [&Scheduler, &ProducedCount, FirstTask, LastTask, NodeCount]()
+		{
+			for (int32 TaskIdx = FirstTask; TaskIdx < LastTask; TaskIdx++)
+			{
+				FHoudiniEngineTask Task(EHoudiniEngineTaskType::AssetCooking, FGuid::NewGuid());
+				Task.ActorName = TEXT("SchedulerQueueBenchmark");
+				Task.AssetId = TaskIdx % NodeCount;
+				Task.Handle = MakeShared<FHoudiniEngineTaskHandle, ESPMode::ThreadSafe>(Task.HapiGUID, Task.TaskType);
+				Scheduler.AddTask(MoveTemp(Task));
+			}
+			ProducedCount.Add(LastTask - FirstTask);
+		}));
+	}
+
+	// Process on this thread, like the scheduler thread does
+	int32 ProcessedCount = 0;
+	double MaxLatency = 0.0;
+	FHoudiniEngineTask Task;
+	while (true)
+	{
+		const bool bProducersDone = ProducedCount.GetValue() >= TaskCount;
+		if (!Scheduler.GetNextTask(Task))
+		{
+			if (bProducersDone)
+				break;
+
+			Scheduler.TaskEvent->Wait(FTimespan::FromMilliseconds(1.0));
+			continue;
+		}
+
+		MaxLatency = FMath::Max(MaxLatency, FPlatformTime::Seconds() - Task.EnqueueTime);
+		Scheduler.SetTaskInfo(Task, FHoudiniEngineTaskInfo(
+			HAPI_RESULT_SUCCESS, Task.AssetId, Task.TaskType, EHoudiniEngineTaskState::Success));
+		CompletedHandleCount.Add(1 + Task.CoalescedHandles.Num());
+		ProcessedCount++;
+	}
+
+	for (TFuture<void>& Producer : Producers)
+		Producer.Wait();
+
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+	HOUDINI_LOG_DISPLAY(
+		TEXT("Scheduler queue benchmark: %d tasks from %d producers on %d nodes in %.3f s (%.0f tasks/s) - %d processed, %d coalesced - max enqueue to processing latency %.3f ms"),
+		ProducedCount.GetValue(), ProducerCount, NodeCount, Duration,
+		Duration > 0.0 ? CompletedHandleCount.GetValue() / Duration : 0.0,
+		ProcessedCount, CompletedHandleCount.GetValue() - ProcessedCount, MaxLatency * 1000.0);
+}
+
+void
+FHoudiniEngineScheduler::RunCookLatencyBenchmark(const int32& InCookCount, const float& InCookTime)
+{
+	const int32 CookCount = FMath::Clamp(InCookCount, 1, 10000);
+	const double CookTime = FMath::Max(InCookTime, 0.0f);
+
+	// The stubbed session reports the simulated cook as over once its duration has elapsed
+	FThreadSafeCounter64 CookEndCycles(0);
+	FHoudiniEngineScheduler Scheduler;
+	Scheduler.CookStateStub = [&CookEndCycles](int32& OutCookState)
+	{
+		OutCookState = (int64)FPlatformTime::Cycles64() >= CookEndCycles.GetValue() ? HAPI_STATE_READY : HAPI_STATE_COOKING;
+		return HAPI_RESULT_SUCCESS;
+	};
+
+	Scheduler.StartCookStateWatcher();
+
+	const bool LegacyPollingModes[] = { true, false };
+	for (const bool& bLegacyPolling : LegacyPollingModes)
+	{
+		double TotalLatency = 0.0;
+		double MaxLatency = 0.0;
+		int32 TotalPollCount = 0;
+		for (int32 CookIdx = 0; CookIdx < CookCount; CookIdx++)
+		{
+			CookEndCycles.Set((int64)FPlatformTime::Cycles64() + (int64)(CookTime / FPlatformTime::GetSecondsPerCycle64()));
+
+			HAPI_Result Result = HAPI_RESULT_SUCCESS;
+			int32 PollCount = 0;
+			Scheduler.WaitForCookCompletion(bLegacyPolling, []() {}, Result, PollCount);
+
+			const double Latency = FMath::Max(
+				((int64)FPlatformTime::Cycles64() - CookEndCycles.GetValue()) * FPlatformTime::GetSecondsPerCycle64(), 0.0);
+			TotalLatency += Latency;
+			MaxLatency = FMath::Max(MaxLatency, Latency);
+			TotalPollCount += PollCount;
+		}
+
+		HOUDINI_LOG_DISPLAY(
+			TEXT("Scheduler cook latency benchmark (%s wait): %d cooks of %.3f ms - latency avg %.3f ms, max %.3f ms - %.1f polls per cook"),
+			bLegacyPolling ? TEXT("legacy") : TEXT("adaptive"), CookCount, CookTime * 1000.0,
+			TotalLatency / CookCount * 1000.0, MaxLatency * 1000.0, (double)TotalPollCount / CookCount);
+	}
+
+	Scheduler.StopCookStateWatcher();
+}
+
 void
 FHoudiniEngineScheduler::TaskProccessAsset(const FHoudiniEngineTask & Task)
 {
@@ -520,83 +1265,56 @@ FHoudiniEngineScheduler::TaskProccessAsset(const FHoudiniEngineTask & Task)
 		return;
 	}
 		
-	HOUDINI_LOG_MESSAGE(
-		TEXT("HAPI Asynchronous Processing started for %s., AssetId = %d"),
+	// The cook results are translated into outputs by the manager on the game thread (see UpdateProcess),
+	// as creating UObjects isn't possible here. Nothing is left to do on the scheduler thread,
+	// so complete the task to release whoever is waiting on its handle.
+	HOUDINI_LOG_HELPER(Verbose, TEXT("HAPI Asynchronous Processing for %s (AssetId = %d): outputs are processed by the manager."),
 		*Task.ActorName, AssetId);
 
-	// Add processing notification.
 	AddResponseMessageTaskInfo(
 		HAPI_RESULT_SUCCESS,
 		EHoudiniEngineTaskType::AssetProcess,
-		EHoudiniEngineTaskState::Working,
-		AssetId, Task, TEXT("Started Cooking"));
-
-	//
-
-
-	// TODO: Process results!
+		EHoudiniEngineTaskState::Success,
+		AssetId, Task, TEXT("Finished Processing"));
 }
 
 void
-FHoudiniEngineScheduler::AddTask(const FHoudiniEngineTask & Task)
+FHoudiniEngineScheduler::AddTask(FHoudiniEngineTask && Task)
 {
-	FScopeLock ScopeLock(&CriticalSection);
+	Task.EnqueueTime = FPlatformTime::Seconds();
 
-	// Check if we need to grow our circular buffer.
-	if (PositionWrite + 1 == PositionRead)
+	// Cancelling the task wakes us up, so an outdated cook is interrupted right away.
+	// The handle releases the callback when the task completes, which always happens before our event is released.
+	if (Task.Handle.IsValid() && TaskEvent)
 	{
-		// Calculate next size (next power of two).
-		uint32 NextTaskCount = FPlatformMath::RoundUpToPowerOfTwo(TaskCount + 1);
-
-		// Allocate new buffer.
-		FHoudiniEngineTask * Buffer = static_cast<FHoudiniEngineTask *>(
-			FMemory::Malloc(NextTaskCount * sizeof(FHoudiniEngineTask)));
-
-		if (!Buffer)
-			return;
-
-		// Zero memory.
-		FMemory::Memset(Buffer, 0x0, NextTaskCount * sizeof(FHoudiniEngineTask));
-
-		// Copy elements from old buffer to new one.
-		if (PositionRead < PositionWrite)
-		{
-			FMemory::Memcpy(Buffer, Tasks + PositionRead, sizeof(FHoudiniEngineTask) * (PositionWrite - PositionRead));
-
-			// Update index positions.
-			PositionRead = 0;
-			PositionWrite = PositionWrite - PositionRead;
-		}
-		else
-		{
-			FMemory::Memcpy(Buffer, Tasks + PositionRead, sizeof(FHoudiniEngineTask) * (TaskCount - PositionRead));
-			FMemory::Memcpy(Buffer + TaskCount - PositionRead, Tasks, sizeof(FHoudiniEngineTask) * PositionWrite);
-
-			// Update index positions.
-			PositionRead = 0;
-			PositionWrite = TaskCount - PositionRead + PositionWrite;
-		}
-
-		// Deallocate old buffer.
-		FMemory::Free(Tasks);
-
-		// Bookkeeping.
-		Tasks = Buffer;
-		TaskCount = NextTaskCount;
+		FEvent* WakeEvent = TaskEvent;
+		Task.Handle->SetWakeCallback([WakeEvent]() { WakeEvent->Trigger(); });
 	}
 
 	// Store task.
-	Tasks[PositionWrite] = Task;
-	PositionWrite++;
+	NewTaskCount.Increment();
+	NewTasks.Enqueue(MoveTemp(Task));
 
-	// Wrap around if required.
-	PositionWrite &= (TaskCount - 1);
+	// Wake up the scheduler thread.
+	if (TaskEvent)
+		TaskEvent->Trigger();
+}
+
+void
+FHoudiniEngineScheduler::AddTask(const FHoudiniEngineTask & Task)
+{
+	AddTask(FHoudiniEngineTask(Task));
 }
 
 uint32
 FHoudiniEngineScheduler::Run()
 {
+	// All the HAPI calls made by this thread go to our session
+	FHoudiniEngineScopedSession ScopedSession(SessionIndex);
+
+	StartCookStateWatcher();
 	ProcessQueuedTasks();
+	StopCookStateWatcher();
 	return 0;
 }
 
@@ -604,11 +1322,16 @@ void
 FHoudiniEngineScheduler::Stop()
 {
 	bStopping = true;
+
+	if (TaskEvent)
+		TaskEvent->Trigger();
 }
 
 void
 FHoudiniEngineScheduler::Tick()
 {
+	FHoudiniEngineScopedSession ScopedSession(SessionIndex);
+
 	ProcessQueuedTasks();
 }
 
@@ -30,13 +30,111 @@
 #include "HoudiniEngineTaskInfo.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/CriticalSection.h"
 #include "Misc/SingleThreadRunnable.h"
+#include "Containers/Queue.h"
+
+// Counters exposed by the scheduler
+struct HOUDINIENGINE_API FHoudiniEngineSchedulerStats
+{
+	FHoudiniEngineSchedulerStats();
+
+	// Number of tasks waiting to be processed.
+	int32 QueueDepth;
+
+	// Number of tasks that have been merged into a newer task for the same node.
+	int32 CoalescedTaskCount;
+
+	// Number of tasks that have been processed.
+	int32 ProcessedTaskCount;
+
+	// Number of cooks that ran to completion.
+	int32 CompletedCookCount;
+
+	// Number of cooks that were interrupted or skipped because their result was outdated.
+	int32 CancelledCookCount;
+
+	// Time spent in the queue by the last processed task (in seconds).
+	double LastTaskWaitTime;
+
+	// Longest time spent in the queue by a processed task (in seconds).
+	double MaxTaskWaitTime;
+
+	// Cumulated time spent in the queue by all processed tasks (in seconds).
+	double TotalTaskWaitTime;
+};
+
+// Polls the cook state of a session on its own thread while it is armed, and triggers an event as soon as the cook is over.
+// This lets the scheduler block on an event during long cooks instead of waking up to poll the session itself.
+// While armed, the watcher is the only one polling the session, backing off exponentially between its polls.
+class FHoudiniEngineCookStateWatcher : public FRunnable
+{
+public:
+
+	// InCookStateQuery returns the cook state of the session, InCookOverEvent is triggered when the cook is over
+	FHoudiniEngineCookStateWatcher(
+		const int32& InSessionIndex,
+		TFunction<HAPI_Result(int32&)> InCookStateQuery,
+		FEvent* InCookOverEvent);
+	virtual ~FHoudiniEngineCookStateWatcher();
+
+	// FRunnable methods.
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	// Starts polling the cook state, until the cook is over or Disarm is called.
+	// Disarm waits for the poll in progress, so the session can be queried safely once it returns.
+	void Arm();
+	void Disarm();
+
+	// Restarts the back-off from the shortest poll interval, called when a new cook is waited for
+	void ResetBackoff();
+
+	// Returns the last cook state polled since the watcher was armed, and the number of polls.
+	// Returns false if the watcher hasn't polled since it was armed.
+	bool GetLastCookState(int32& OutCookState, HAPI_Result& OutResult, int32& OutPollCount);
+
+	// Indicates if the cook state means that the cook is over
+	static bool IsCookOver(const int32& InCookState);
+
+private:
+
+	// Shortest and longest time (in seconds) between two cook state polls
+	static const float MinPollInterval;
+	static const float MaxPollInterval;
+
+	// Index of the session whose cook state is polled
+	int32 SessionIndex;
+
+	TFunction<HAPI_Result(int32&)> CookStateQuery;
+
+	// Triggered when the cook is over, owned by the caller
+	FEvent* CookOverEvent;
+
+	// Wakes up the watcher thread when armed or stopped
+	FEvent* WakeEvent;
+
+	FThreadSafeCounter bArmed;
+	FThreadSafeCounter bStopping;
+
+	// Held while polling the session, guards the members below
+	FCriticalSection QueryLock;
+
+	// Time to wait before the next poll, doubled after each poll
+	float PollInterval;
+
+	// Last polled cook state, and number of polls since armed
+	int32 LastCookState;
+	HAPI_Result LastResult;
+	int32 PollCount;
+};
 
 class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
 {
 public:
 
-	FHoudiniEngineScheduler();
+	FHoudiniEngineScheduler(const int32& InSessionIndex = 0);
 	virtual ~FHoudiniEngineScheduler();
 
 	// FRunnable methods.
@@ -48,6 +146,8 @@ public:
 	virtual void Tick() override;
 
 	// Adds a task.
+	// Can be called from any thread, the task is moved to the scheduler's queue without locking.
+	void AddTask(FHoudiniEngineTask && Task);
 	void AddTask(const FHoudiniEngineTask & Task);
 
 	// Adds instantiation response task info.
@@ -66,14 +166,61 @@ public:
 		const FHoudiniEngineTask & Task,
 		const FString & ErrorMessage);
 
+	// Returns a copy of the scheduler's counters.
+	void GetStats(FHoudiniEngineSchedulerStats& OutStats);
+
+	// Adds tasks to a scheduler from several producer threads while the calling thread retrieves
+	// and completes them, to measure the throughput of the scheduler's add/process path without HAPI.
+	static void RunQueueBenchmark(const int32& InTaskCount, const int32& InProducerCount, const int32& InNodeCount);
+
+	// Measures the latency between the end of simulated cooks and their detection by the legacy and adaptive waits,
+	// using a scheduler whose cook state queries are answered by a stub instead of HAPI.
+	static void RunCookLatencyBenchmark(const int32& InCookCount, const float& InCookTime);
+
 protected:
 
 	// Process queued tasks. 
 	void ProcessQueuedTasks();
 
+	// Moves the newly added tasks to the pending lists.
+	void MoveNewTasksToPending();
+
+	// Returns the pending cook task for the given node, if any.
+	FHoudiniEngineTask* FindPendingCook(const HAPI_NodeId& AssetId);
+
+	// Indicates if the result of the given cook task is outdated:
+	// its cancellation was requested because the HAC's parameters or inputs changed during the cook.
+	bool IsCookOutdated(const FHoudiniEngineTask& Task);
+
+	// Discards an outdated cook task: its handles are moved to the newer
+	// cook of the same node if there is one, or finish with a Cancelled state.
+	void CancelCook(const FHoudiniEngineTask& Task, const FString& Reason);
+
+	// Moves the newly added tasks to the pending lists, 
+	// then retrieves the pending task with the highest priority.
+	// Returns false if there are no tasks left.
+	bool GetNextTask(FHoudiniEngineTask& OutTask);
+
+	// Adds a task to the pending list matching its priority.
+	// A new cook task replaces the pending cook of the same node, if any, and inherits its handles.
+	void AddPendingTask(FHoudiniEngineTask&& Task);
+
+	// Moves the pending tasks of the given node that have a lower priority
+	// to the end of the given priority's list, so that the node's tasks keep their order.
+	void PromotePendingTasks(const HAPI_NodeId& AssetId, const EHoudiniEngineTaskPriority& Priority);
+
+	// Reports the task infos to the task's handle and to the handles of the tasks merged into it.
+	void SetTaskInfo(const FHoudiniEngineTask & Task, const FHoudiniEngineTaskInfo & TaskInfo);
+
+	// Completes a task that won't be processed with an Aborted state.
+	void AbortTask(const FHoudiniEngineTask & Task);
+
 	// Task : instantiate an asset. 
 	void TaskInstantiateAsset(const FHoudiniEngineTask & Task);
 
+	// Task : load an HDA library in the scheduler's session.
+	void TaskLoadAssetLibrary(const FHoudiniEngineTask & Task);
+
 	// Task : cook an asset. 
 	void TaskCookAsset(const FHoudiniEngineTask & Task);
 
@@ -89,28 +236,75 @@ protected:
 	// Process the result of a sucesfull cook
 	void TaskProccessAsset(const FHoudiniEngineTask & Task);
 
-private:
+	// Returns the cook state of the scheduler's session.
+	HAPI_Result QueryCookState(int32& OutCookState);
 
-	// Initial number of tasks in our circular queue. 
-	static const uint32 InitialTaskSize;
+	// Polls the cook state until the current cook is over, and returns its last state.
+	// InOnPoll is called after each poll that didn't end the cook,
+	// OutPollCount receives the number of polls, including those of the cook state watcher.
+	int32 WaitForCookCompletion(
+		const bool& bInLegacyPolling,
+		TFunctionRef<void()> InOnPoll,
+		HAPI_Result& OutResult,
+		int32& OutPollCount);
+
+	// Yields the scheduler thread between two cook state polls.
+	// Spins for the first polls, then backs off exponentially, and finally blocks on the task event,
+	// which the cook state watcher triggers as soon as the cook is over.
+	// Returns true if the watcher polled the cook state meanwhile, OutCookState then receives it
+	// and the watcher's polls are added to InOutPollCount.
+	bool WaitForCookStateUpdate(
+		const int32& WaitCount,
+		const bool& bInLegacyPolling,
+		int32& OutCookState,
+		int32& InOutPollCount);
+
+	// Starts and stops the cook state watcher's thread
+	void StartCookStateWatcher();
+	void StopCookStateWatcher();
+
+private:
 
 	// Frequency update (sleep time between each update)
 	static const float UpdateFrequency;
 
-	// Synchronization primitive. 
-	FCriticalSection CriticalSection;
+	// Number of cook state polls during which we only yield the thread
+	static const int32 CookStateSpinCount;
+
+	// First back-off wait time (in seconds) after the spin phase
+	static const float CookStateMinWait;
+
+	// Back-off wait time (in seconds) from which we block on the task event until the watcher sees the end of the cook
+	static const float CookStateBlockingWait;
+
+	// Event triggered when a task is added, when stopping, or when the watcher sees the end of a cook.
+	FEvent* TaskEvent;
+
+	// Watches the cook state while we block on the task event. Only used in multithreaded mode.
+	FHoudiniEngineCookStateWatcher* CookStateWatcher;
+	FRunnableThread* CookStateWatcherThread;
+
+	// Answers the cook state queries instead of HAPI, for benchmarks
+	TFunction<HAPI_Result(int32&)> CookStateStub;
+
+	// Newly added tasks. Lock-free, filled by any thread and only drained by the scheduler thread.
+	TQueue<FHoudiniEngineTask, EQueueMode::Mpsc> NewTasks;
+
+	// Number of tasks in NewTasks.
+	FThreadSafeCounter NewTaskCount;
 
-	// List of scheduled tasks. 
-	FHoudiniEngineTask* Tasks;
+	// Tasks waiting to be processed, one list per priority.
+	// Only accessed by the scheduler thread.
+	TArray<FHoudiniEngineTask> PendingTasks[(uint8)EHoudiniEngineTaskPriority::Low + 1];
 
-	// Head of the circular queue. 
-	uint32 PositionWrite;
+	// Synchronization primitive for the stats.
+	FCriticalSection StatsCriticalSection;
 
-	// Tail of the circular queue. 
-	uint32 PositionRead;
+	// Scheduler counters.
+	FHoudiniEngineSchedulerStats Stats;
 
-	// Size of the circular queue. 
-	uint32 TaskCount;
+	// Index of the session used by this scheduler's tasks.
+	int32 SessionIndex;
 
 	// Stopping flag. 
 	bool bStopping;
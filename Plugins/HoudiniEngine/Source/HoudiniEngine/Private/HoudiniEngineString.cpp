@@ -30,8 +30,13 @@
 #include "HoudiniEngine.h"
 #include "HoudiniEngineRuntimePrivatePCH.h"
 
+#include "Misc/ScopeLock.h"
+
 #include <vector>
 
+// GetStringBatch returns the strings of the previous GetStringBatchSize call, the pair can't be interleaved
+static FCriticalSection HoudiniEngineStringBatchCriticalSection;
+
 FHoudiniEngineString::FHoudiniEngineString()
 	: StringId(-1)
 {}
@@ -182,4 +187,116 @@ FHoudiniEngineString::ToFText(const int32& InStringId, FText& OutText)
 {
 	FHoudiniEngineString HAPIString(InStringId);
 	return HAPIString.ToFText(OutText);
-}
\ No newline at end of file
+}
+
+bool
+FHoudiniEngineString::SHArrayToFStringArray(const TArray<int32>& InStringIdArray, TArray<FString>& OutStringArray)
+{
+	FHoudiniStringTable StringTable;
+	if (!SHArrayToStringTable(InStringIdArray, StringTable))
+		return false;
+
+	StringTable.ToFStringArray(OutStringArray);
+	return true;
+}
+
+bool
+FHoudiniEngineString::SHArrayToStringTable(const TArray<int32>& InStringIdArray, FHoudiniStringTable& OutStringTable)
+{
+	OutStringTable.Indices.SetNumUninitialized(InStringIdArray.Num());
+	OutStringTable.Strings.Empty();
+
+	// Only query each valid id once
+	TArray<int32> UniqueIds;
+	TMap<int32, int32> IdToUniqueIndex;
+	for (int32 Idx = 0; Idx < InStringIdArray.Num(); Idx++)
+	{
+		const int32& StringId = InStringIdArray[Idx];
+		if (StringId <= 0)
+		{
+			OutStringTable.Indices[Idx] = INDEX_NONE;
+			continue;
+		}
+
+		const int32* UniqueIndex = IdToUniqueIndex.Find(StringId);
+		OutStringTable.Indices[Idx] = UniqueIndex ? *UniqueIndex : IdToUniqueIndex.Add(StringId, UniqueIds.Add(StringId));
+	}
+
+	if (UniqueIds.Num() <= 0)
+		return true;
+
+	TArray<FString>& UniqueStrings = OutStringTable.Strings;
+	UniqueStrings.SetNum(UniqueIds.Num());
+
+	bool bBatchSucceeded = false;
+	{
+		FScopeLock ScopeLock(&HoudiniEngineStringBatchCriticalSection);
+
+		int32 BufferSize = 0;
+		if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetStringBatchSize(
+			FHoudiniEngine::Get().GetSession(), UniqueIds.GetData(), UniqueIds.Num(), &BufferSize)
+			&& BufferSize > 0)
+		{
+			TArray<char> Buffer;
+			Buffer.SetNumZeroed(BufferSize);
+			if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetStringBatch(
+				FHoudiniEngine::Get().GetSession(), Buffer.GetData(), BufferSize))
+			{
+				// The buffer contains the null-separated strings, in the ids' order
+				int32 StringIdx = 0;
+				const char* Current = Buffer.GetData();
+				const char* End = Buffer.GetData() + BufferSize;
+				while (Current < End && StringIdx < UniqueStrings.Num())
+				{
+					UniqueStrings[StringIdx++] = UTF8_TO_TCHAR(Current);
+					Current += FCStringAnsi::Strlen(Current) + 1;
+				}
+
+				bBatchSucceeded = (StringIdx == UniqueStrings.Num());
+			}
+		}
+	}
+
+	if (!bBatchSucceeded)
+	{
+		// Fall back to one query per string
+		for (int32 Idx = 0; Idx < UniqueIds.Num(); Idx++)
+			FHoudiniEngineString::ToFString(UniqueIds[Idx], UniqueStrings[Idx]);
+	}
+
+	return true;
+}
+
+const FString&
+FHoudiniStringTable::GetString(const int32& InElementIdx) const
+{
+	static const FString EmptyString;
+	const int32 StringIdx = Indices.IsValidIndex(InElementIdx) ? Indices[InElementIdx] : INDEX_NONE;
+	return Strings.IsValidIndex(StringIdx) ? Strings[StringIdx] : EmptyString;
+}
+
+void
+FHoudiniStringTable::ToFStringArray(TArray<FString>& OutStringArray) const
+{
+	OutStringArray.SetNum(Indices.Num());
+	for (int32 Idx = 0; Idx < Indices.Num(); Idx++)
+		OutStringArray[Idx] = Strings.IsValidIndex(Indices[Idx]) ? Strings[Indices[Idx]] : FString();
+}
+
+void
+FHoudiniStringTable::ToFNameArray(TArray<FName>& OutNames) const
+{
+	OutNames.SetNum(Strings.Num());
+	for (int32 Idx = 0; Idx < Strings.Num(); Idx++)
+		OutNames[Idx] = FName(*Strings[Idx]);
+}
+
+int64
+FHoudiniStringTable::GetAllocatedSize() const
+{
+	int64 Size = Indices.GetAllocatedSize() + Strings.GetAllocatedSize();
+	for (const FString& Str : Strings)
+		Size += Str.GetAllocatedSize();
+
+	return Size;
+}
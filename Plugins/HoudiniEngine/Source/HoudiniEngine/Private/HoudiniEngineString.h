@@ -32,6 +32,32 @@ class FName;
 
 #include <string>
 
+// The values of a string attribute, stored as an index buffer into the table of their unique strings.
+// Attributes referencing assets or materials usually have many elements but only a few unique values,
+// this avoids copying a string per element and lets callers process each unique value once.
+struct HOUDINIENGINE_API FHoudiniStringTable
+{
+	// Index in Strings of each element's value, INDEX_NONE for invalid string handles
+	TArray<int32> Indices;
+
+	// Unique values, in the order of their first element
+	TArray<FString> Strings;
+
+	// Returns the value of an element, an empty string for invalid handles
+	const FString& GetString(const int32& InElementIdx) const;
+
+	// Expands the table to one string per element
+	void ToFStringArray(TArray<FString>& OutStringArray) const;
+
+	// Interns the unique values, OutNames matches Strings
+	void ToFNameArray(TArray<FName>& OutNames) const;
+
+	// Number of elements
+	int32 Num() const { return Indices.Num(); };
+
+	int64 GetAllocatedSize() const;
+};
+
 class HOUDINIENGINE_API FHoudiniEngineString
 {
 	public:
@@ -57,6 +83,13 @@ class HOUDINIENGINE_API FHoudiniEngineString
 		static bool ToFString(const int32& InStringId, FString & String);
 		static bool ToFText(const int32& InStringId, FText & Text);
 
+		// Converts an array of string ids with a single batched query (instead of two queries per string).
+		// Invalid ids are converted to empty strings.
+		static bool SHArrayToFStringArray(const TArray<int32>& InStringIdArray, TArray<FString>& OutStringArray);
+
+		// Converts an array of string ids to a table of their unique strings with a single batched query.
+		static bool SHArrayToStringTable(const TArray<int32>& InStringIdArray, FHoudiniStringTable& OutStringTable);
+
 		// Return id of this string.
 		int32 GetId() const;
 
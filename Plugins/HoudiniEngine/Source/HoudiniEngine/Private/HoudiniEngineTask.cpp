@@ -34,6 +34,10 @@ FHoudiniEngineTask::FHoudiniEngineTask()
 	, AssetId(-1)
 	, AssetLibraryId(-1)
 	, AssetHapiName(-1)
+	, AssetLibraryHash(0)
+	, Priority(EHoudiniEngineTaskPriority::Normal)
+	, EnqueueTime(0.0)
+	, SessionIndex(-1)
 {
 	HapiGUID.Invalidate();
 }
@@ -45,4 +49,8 @@ FHoudiniEngineTask::FHoudiniEngineTask(EHoudiniEngineTaskType InTaskType, FGuid
 	, AssetId(-1)
 	, AssetLibraryId(-1)
 	, AssetHapiName(-1)
+	, AssetLibraryHash(0)
+	, Priority(EHoudiniEngineTaskPriority::Normal)
+	, EnqueueTime(0.0)
+	, SessionIndex(-1)
 {}
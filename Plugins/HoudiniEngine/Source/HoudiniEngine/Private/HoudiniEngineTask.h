@@ -50,6 +50,9 @@ namespace EHoudiniEngineTaskType
 }
 */
 
+class FHoudiniEngineTaskHandle;
+typedef TSharedPtr<FHoudiniEngineTaskHandle, ESPMode::ThreadSafe> FHoudiniEngineTaskHandlePtr;
+
 UENUM()
 enum class EHoudiniEngineTaskType : uint8
 {
@@ -66,6 +69,22 @@ enum class EHoudiniEngineTaskType : uint8
 
 	// This type is used when processing the results of a sucessful cook
 	AssetProcess,
+
+	// This type is used to load an HDA library before it's needed for instantiation.
+	AssetLibraryLoad,
+};
+
+UENUM()
+enum class EHoudiniEngineTaskPriority : uint8
+{
+	// Tasks for selected or visible assets, processed first.
+	High,
+
+	// Default priority.
+	Normal,
+
+	// Background tasks (bulk recooks/rebuilds of assets that are not visible).
+	Low,
 };
 
 struct HOUDINIENGINE_API FHoudiniEngineTask
@@ -95,6 +114,29 @@ struct HOUDINIENGINE_API FHoudiniEngineTask
 	// HAPI name of the asset.
 	int32 AssetHapiName;
 
+	// Path of the HDA library to load.
+	FString AssetLibraryPath;
+
+	// Content hash of the HDA library to load, used as its key in the asset library cache.
+	uint64 AssetLibraryHash;
+
+	// Priority of this task.
+	EHoudiniEngineTaskPriority Priority;
+
+	// Time at which the task was added to the scheduler.
+	double EnqueueTime;
+
+	// Handle receiving this task's progress and result.
+	FHoudiniEngineTaskHandlePtr Handle;
+
+	// Handles of older tasks that have been merged into this one.
+	// They will receive the same task infos as this task.
+	TArray<FHoudiniEngineTaskHandlePtr> CoalescedHandles;
+
+	// Index of the session this task runs in.
+	// A negative value uses the session of the thread adding the task.
+	int32 SessionIndex;
+
 	// Is set to true if component has been loaded.
 	//bool bLoadedComponent;
 };
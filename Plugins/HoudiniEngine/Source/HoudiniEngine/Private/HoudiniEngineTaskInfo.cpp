@@ -27,6 +27,7 @@
 #include "HoudiniEngineTaskInfo.h"
 
 #include "HAPI/HAPI_Common.h"
+#include "Misc/ScopeLock.h"
 
 FHoudiniEngineTaskInfo::FHoudiniEngineTaskInfo()
 	: Result(HAPI_RESULT_SUCCESS)
@@ -44,4 +45,108 @@ FHoudiniEngineTaskInfo::FHoudiniEngineTaskInfo(
 	, AssetId(InAssetId)
 	, TaskType(InTaskType)
 	, TaskState(InTaskState)
-{}
\ No newline at end of file
+{}
+
+FHoudiniEngineTaskHandle::FHoudiniEngineTaskHandle(const FGuid& InHapiGUID, EHoudiniEngineTaskType InTaskType)
+	: HapiGUID(InHapiGUID)
+	, TaskType(InTaskType)
+	, bComplete(false)
+	, bCancelRequested(false)
+{
+	Future = Promise.GetFuture().Share();
+}
+
+bool
+FHoudiniEngineTaskHandle::IsComplete() const
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	return bComplete;
+}
+
+void
+FHoudiniEngineTaskHandle::Then(FTaskInfoCallback InContinuation)
+{
+	if (!InContinuation)
+		return;
+
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (!bComplete)
+		{
+			Continuations.Add(MoveTemp(InContinuation));
+			return;
+		}
+	}
+
+	// Already finished, call the continuation now
+	InContinuation(Future.Get());
+}
+
+void
+FHoudiniEngineTaskHandle::OnProgress(FTaskInfoCallback InCallback)
+{
+	if (!InCallback)
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	if (!bComplete)
+		ProgressCallbacks.Add(MoveTemp(InCallback));
+}
+
+void
+FHoudiniEngineTaskHandle::Cancel()
+{
+	bCancelRequested = true;
+
+	// Called under our lock, so the scheduler can't release its event after completing the task
+	FScopeLock ScopeLock(&CriticalSection);
+	if (!bComplete && WakeCallback)
+		WakeCallback();
+}
+
+void
+FHoudiniEngineTaskHandle::SetWakeCallback(TFunction<void()> InWakeCallback)
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	if (!bComplete)
+		WakeCallback = MoveTemp(InWakeCallback);
+}
+
+void
+FHoudiniEngineTaskHandle::SetTaskInfo(const FHoudiniEngineTaskInfo& InTaskInfo)
+{
+	if (InTaskInfo.TaskState == EHoudiniEngineTaskState::None || InTaskInfo.TaskState == EHoudiniEngineTaskState::Working)
+	{
+		// Progress update, copy the callbacks so they're not called under our lock
+		TArray<FTaskInfoCallback> Callbacks;
+		{
+			FScopeLock ScopeLock(&CriticalSection);
+			if (bComplete)
+				return;
+
+			Callbacks = ProgressCallbacks;
+		}
+
+		for (const FTaskInfoCallback& Callback : Callbacks)
+			Callback(InTaskInfo);
+
+		return;
+	}
+
+	TArray<FTaskInfoCallback> PendingContinuations;
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (bComplete)
+			return;
+
+		bComplete = true;
+		PendingContinuations = MoveTemp(Continuations);
+		ProgressCallbacks.Empty();
+		WakeCallback = nullptr;
+	}
+
+	Promise.SetValue(InTaskInfo);
+
+	for (const FTaskInfoCallback& Continuation : PendingContinuations)
+		Continuation(InTaskInfo);
+}
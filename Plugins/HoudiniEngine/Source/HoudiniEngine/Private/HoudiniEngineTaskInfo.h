@@ -28,6 +28,10 @@
 
 #include "HoudiniEngineTask.h"
 
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+
 UENUM()
 enum class EHoudiniEngineTaskState : uint8
 {
@@ -45,8 +49,11 @@ enum class EHoudiniEngineTaskState : uint8
 	// Indicates the task has finished with fatal errors and should be terminated
 	FinishedWithFatalError,
 
-	// Indicates the task has been aborted (unused)
-	Aborted
+	// Indicates the task has been aborted
+	Aborted,
+
+	// Indicates the task has been interrupted because its result was outdated
+	Cancelled
 };
 
 struct HOUDINIENGINE_API FHoudiniEngineTaskInfo
@@ -76,3 +83,80 @@ struct HOUDINIENGINE_API FHoudiniEngineTaskInfo
 	// Is set to true if corresponding task was issued for loaded component.
 	//bool bLoadedComponent;
 };
+
+// Completion handle of a scheduled task, shared by the scheduler and the task's requester.
+// The scheduler reports the task's progress to it, then completes it once with the task's final infos.
+class HOUDINIENGINE_API FHoudiniEngineTaskHandle
+{
+public:
+
+	// Callback receiving a task's infos.
+	typedef TFunction<void(const FHoudiniEngineTaskInfo&)> FTaskInfoCallback;
+
+	FHoudiniEngineTaskHandle(const FGuid& InHapiGUID, EHoudiniEngineTaskType InTaskType);
+
+	// GUID of the task.
+	const FGuid& GetHapiGUID() const { return HapiGUID; };
+
+	// Type of the task.
+	EHoudiniEngineTaskType GetTaskType() const { return TaskType; };
+
+	// Returns a future resolved with the task's final infos.
+	TSharedFuture<FHoudiniEngineTaskInfo> GetFuture() const { return Future; };
+
+	// Indicates if the task has finished.
+	bool IsComplete() const;
+
+	// Asks the scheduler to interrupt the task, its result is not needed anymore.
+	// The task will then finish with a Cancelled state, unless it had already finished.
+	// The scheduler is woken up, so it notices the cancellation without waiting for its next update.
+	void Cancel();
+
+	// Sets the callback waking up the scheduler processing the task, it is released once the task has finished.
+	void SetWakeCallback(TFunction<void()> InWakeCallback);
+
+	// Indicates if the task's cancellation has been requested.
+	bool IsCancelRequested() const { return bCancelRequested; };
+
+	// Adds a continuation called once with the task's final infos.
+	// Continuations run on the thread that completes the task (usually a scheduler thread),
+	// or immediately on the calling thread if the task has already finished.
+	void Then(FTaskInfoCallback InContinuation);
+
+	// Adds a callback called on each progress update of the task, on the scheduler thread.
+	void OnProgress(FTaskInfoCallback InCallback);
+
+	// Reports new infos for this task: a Working state updates the progress, 
+	// any other state completes the task. Only the first completion is kept.
+	void SetTaskInfo(const FHoudiniEngineTaskInfo& InTaskInfo);
+
+private:
+
+	// GUID of the task.
+	FGuid HapiGUID;
+
+	// Type of the task.
+	EHoudiniEngineTaskType TaskType;
+
+	// Promise fulfilled when the task finishes, and its future.
+	TPromise<FHoudiniEngineTaskInfo> Promise;
+	TSharedFuture<FHoudiniEngineTaskInfo> Future;
+
+	// Continuations waiting for the task to finish.
+	TArray<FTaskInfoCallback> Continuations;
+
+	// Callbacks for progress updates.
+	TArray<FTaskInfoCallback> ProgressCallbacks;
+
+	// Wakes up the scheduler processing the task.
+	TFunction<void()> WakeCallback;
+
+	// Synchronization primitive for the callbacks and the completion flag.
+	mutable FCriticalSection CriticalSection;
+
+	// Set once the task has finished.
+	bool bComplete;
+
+	// Set when the task should be interrupted.
+	FThreadSafeBool bCancelRequested;
+};
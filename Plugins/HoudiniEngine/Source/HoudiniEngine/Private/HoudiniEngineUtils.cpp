@@ -42,9 +42,13 @@
 #include "HoudiniRuntimeSettings.h"
 #include "HoudiniApi.h"
 #include "HoudiniEngine.h"
+#include "HoudiniEngineRuntime.h"
+#include "HoudiniEngineOutputStats.h"
 #include "HoudiniAsset.h"
 #include "HoudiniAssetActor.h"
 #include "HoudiniEngineString.h"
+#include "HoudiniAttributeCache.h"
+#include "HoudiniDataConversion.h"
 #include "HoudiniGeoPartObject.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniInput.h"
@@ -66,6 +70,7 @@
 #include "Modules/ModuleManager.h"
 #include "Engine/StaticMeshSocket.h"
 #include "Async/Async.h"
+#include "Hash/CityHash.h"
 #include "BlueprintEditor.h"
 #include "Toolkits/AssetEditorManager.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -259,7 +264,7 @@ FHoudiniEngineUtils::GetStatusString(HAPI_StatusType status_type, HAPI_StatusVer
 	{
 		// Let FHoudiniEngine know that the sesion is now invalid to "Stop" the invalid session
 		// and clean things up
-		FHoudiniEngine::Get().OnSessionLost();
+		FHoudiniEngine::Get().OnSessionLost(SessionPtr);
 	}
 
 	if (StatusBufferLength > 0)
@@ -1016,16 +1021,11 @@ FHoudiniEngineUtils::LocateLibHAPIInRegistry(
 }
 #endif
 
-bool
-FHoudiniEngineUtils::LoadHoudiniAsset(UHoudiniAsset * HoudiniAsset, HAPI_AssetLibraryId & OutAssetLibraryId)
+FString
+FHoudiniEngineUtils::GetHoudiniAssetLibraryPath(const UHoudiniAsset * HoudiniAsset)
 {
-	OutAssetLibraryId = -1;
-
 	if (!HoudiniAsset || HoudiniAsset->IsPendingKill())
-		return false;
-
-	if (!FHoudiniEngineUtils::IsInitialized())
-		return false;
+		return FString();
 
 	// Get the HDA's file path
 	// We need to convert relative file path to absolute
@@ -1041,6 +1041,34 @@ FHoudiniEngineUtils::LoadHoudiniAsset(UHoudiniAsset * HoudiniAsset, HAPI_AssetLi
 		AssetFileName = FPaths::GetPath(AssetFileName);
 	}
 
+	return AssetFileName;
+}
+
+bool
+FHoudiniEngineUtils::LoadHoudiniAsset(UHoudiniAsset * HoudiniAsset, HAPI_AssetLibraryId & OutAssetLibraryId)
+{
+	OutAssetLibraryId = -1;
+
+	if (!HoudiniAsset || HoudiniAsset->IsPendingKill())
+		return false;
+
+	if (!FHoudiniEngineUtils::IsInitialized())
+		return false;
+
+	FString AssetFileName = GetHoudiniAssetLibraryPath(HoudiniAsset);
+
+	// No need to load the library again if the same content has already been loaded in this session
+	// (by another instantiation, or by the preload task).
+	// The manager waits for the preload task before instantiating, if it started loading in the meantime,
+	// the library is loaded again without being registered, rather than blocking the game thread.
+	FHoudiniAssetLibraryCache& AssetLibraryCache = FHoudiniEngine::Get().GetAssetLibraryCache();
+	const uint64 AssetLibraryHash = FHoudiniAssetLibraryCache::GetAssetLibraryHash(HoudiniAsset, AssetFileName);
+	const EHoudiniAssetLibraryLoadState LoadState = AssetLibraryCache.BeginLoad(AssetLibraryHash, OutAssetLibraryId);
+	if (LoadState == EHoudiniAssetLibraryLoadState::Loaded)
+		return true;
+
+	const bool bRegisterLoad = LoadState == EHoudiniAssetLibraryLoadState::MustLoad;
+
 	// If the hda file exists, we can simply load it directly the file
 	HAPI_Result Result = HAPI_RESULT_FAILURE;
 	if ( !AssetFileName.IsEmpty() )
@@ -1063,6 +1091,8 @@ FHoudiniEngineUtils::LoadHoudiniAsset(UHoudiniAsset * HoudiniAsset, HAPI_AssetLi
 		if (HoudiniAsset->IsExpandedHDA() || HoudiniAsset->GetAssetBytesCount() <= 0)
 		{
 			HOUDINI_LOG_ERROR(TEXT("Error loading Asset %s: source asset file not found and no memory copy available."), *AssetFileName);
+			if (bRegisterLoad)
+				AssetLibraryCache.EndLoad(AssetLibraryHash, AssetFileName, -1, false);
 			return false;
 		}
 		else
@@ -1081,9 +1111,14 @@ FHoudiniEngineUtils::LoadHoudiniAsset(UHoudiniAsset * HoudiniAsset, HAPI_AssetLi
 	if (Result != HAPI_RESULT_SUCCESS)
 	{
 		HOUDINI_LOG_MESSAGE(TEXT("Error loading asset library for %s: %s"), *AssetFileName, *FHoudiniEngineUtils::GetErrorDescription());
+		if (bRegisterLoad)
+			AssetLibraryCache.EndLoad(AssetLibraryHash, AssetFileName, -1, false);
 		return false;
 	}
 
+	if (bRegisterLoad)
+		AssetLibraryCache.EndLoad(AssetLibraryHash, AssetFileName, OutAssetLibraryId, true);
+
 	return true;
 }
 
@@ -1444,37 +1479,7 @@ FHoudiniEngineUtils::HapiGetAssetTransform(const HAPI_NodeId& InNodeId, FTransfo
 void
 FHoudiniEngineUtils::TranslateHapiTransform(const HAPI_Transform & HapiTransform, FTransform & UnrealTransform)
 {
-	if ( HAPI_UNREAL_CONVERT_COORDINATE_SYSTEM )
-	{
-		// Swap Y/Z, invert W
-		FQuat ObjectRotation(
-			HapiTransform.rotationQuaternion[0], HapiTransform.rotationQuaternion[2],
-			HapiTransform.rotationQuaternion[1], -HapiTransform.rotationQuaternion[3]);
-
-		// Swap Y/Z and scale
-		FVector ObjectTranslation(HapiTransform.position[0], HapiTransform.position[2], HapiTransform.position[1]);
-		ObjectTranslation *= HAPI_UNREAL_SCALE_FACTOR_TRANSLATION;
-
-		// Swap Y/Z
-		FVector ObjectScale3D(HapiTransform.scale[0], HapiTransform.scale[2], HapiTransform.scale[1]);
-		Swap(ObjectScale3D.Y, ObjectScale3D.Z);
-
-		UnrealTransform.SetComponents(ObjectRotation, ObjectTranslation, ObjectScale3D);
-	}
-	else
-	{
-		FQuat ObjectRotation(
-			HapiTransform.rotationQuaternion[0], HapiTransform.rotationQuaternion[1],
-			HapiTransform.rotationQuaternion[2], HapiTransform.rotationQuaternion[3]);
-
-		FVector ObjectTranslation(
-			HapiTransform.position[0], HapiTransform.position[1], HapiTransform.position[2]);
-		ObjectTranslation *= HAPI_UNREAL_SCALE_FACTOR_TRANSLATION;
-
-		FVector ObjectScale3D(HapiTransform.scale[0], HapiTransform.scale[1], HapiTransform.scale[2]);
-
-		UnrealTransform.SetComponents(ObjectRotation, ObjectTranslation, ObjectScale3D);
-	}
+	FHoudiniDataConversion::HoudiniToUnrealTransforms(&HapiTransform, &UnrealTransform, 1);
 }
 
 void
@@ -2341,32 +2346,16 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
 	OutAttributeInfo.exists = false;
 
 	// Reset container size.
-	OutData.SetNumUninitialized(0);
+	OutData.Reset();
 
 	int32 OriginalTupleSize = InTupleSize;
 
+	// Look for the attribute via the attribute cache, which knows the names of the part's attributes
 	HAPI_AttributeInfo AttributeInfo;
 	FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
-	if (InOwner == HAPI_ATTROWNER_INVALID)
-	{
-		for (int32 AttrIdx = 0; AttrIdx < HAPI_ATTROWNER_MAX; ++AttrIdx)
-		{
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InGeoId, InPartId, InAttribName,
-				(HAPI_AttributeOwner)AttrIdx, &AttributeInfo), false);
-
-			if (AttributeInfo.exists)
-				break;
-		}
-	}
-	else
-	{
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-			FHoudiniEngine::Get().GetSession(), 
-			InGeoId, InPartId, InAttribName,
-			InOwner, &AttributeInfo), false);
-	}
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(
+		InGeoId, InPartId, InAttribName, InOwner, AttributeInfo))
+		return false;
 
 	if (!AttributeInfo.exists)
 		return false;
@@ -2379,36 +2368,20 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
 
 	if (AttributeInfo.storage == HAPI_STORAGETYPE_FLOAT)
 	{
-		// Allocate sufficient buffer for data.
-		OutData.SetNum(AttributeInfo.count * AttributeInfo.tupleSize);
-
-		// Fetch the values
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeFloatData(
-			FHoudiniEngine::Get().GetSession(),
-			InGeoId, InPartId, InAttribName,
-			&AttributeInfo, -1, &OutData[0], 0, AttributeInfo.count), false);
-
-		return true;
+		// Fetch the values, or reuse them if they have already been fetched since the last cook
+		return FHoudiniEngine::Get().GetAttributeCache().GetFloatData(
+			InGeoId, InPartId, InAttribName, AttributeInfo, OutData);
 	}
 	else if (AttributeInfo.storage == HAPI_STORAGETYPE_INT)
 	{
 		// Expected Float, found an int, try to convert the attribute
-
-		// Allocate sufficient buffer for data.
-		TArray<int32> IntData;
-		IntData.SetNum(AttributeInfo.count * AttributeInfo.tupleSize);
-
-		// Fetch the values
-		if(HAPI_RESULT_SUCCESS == FHoudiniApi::GetAttributeIntData(
-			FHoudiniEngine::Get().GetSession(),
-			InGeoId, InPartId, InAttribName,
-			&AttributeInfo, -1, &IntData[0], 0, AttributeInfo.count))
+		// The integers are borrowed from the cache and converted straight into the caller's buffer
+		FHoudiniIntAttributeView IntData;
+		if (FHoudiniEngine::Get().GetAttributeCache().GetIntData(
+			InGeoId, InPartId, InAttribName, AttributeInfo, IntData))
 		{
-			OutData.SetNum(IntData.Num());
-			for (int32 Idx = 0; Idx < IntData.Num(); Idx++)
-			{
-				OutData[Idx] = (float)IntData[Idx];
-			}
+			OutData.SetNumUninitialized(IntData.Num());
+			FHoudiniDataConversion::IntToFloat(IntData.GetData(), OutData.GetData(), IntData.Num());
 
 			HOUDINI_LOG_MESSAGE(TEXT("Attribute %s was expected to be a float attribute, its value had to be converted from integer."), *FString(InAttribName));
 			return true;
@@ -2443,6 +2416,51 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
 	return false;
 }
 
+bool
+FHoudiniEngineUtils::HapiGetAttributeDataAsFloat(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& OutAttributeInfo,
+	FHoudiniFloatAttributeView& OutView,
+	int32 InTupleSize,
+	HAPI_AttributeOwner InOwner)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniEngineUtils::HapiGetAttributeDataAsFloat"));
+
+	OutAttributeInfo.exists = false;
+	OutView.Empty();
+
+	HAPI_AttributeInfo AttributeInfo;
+	FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(
+		InGeoId, InPartId, InAttribName, InOwner, AttributeInfo))
+		return false;
+
+	if (!AttributeInfo.exists)
+		return false;
+
+	if (AttributeInfo.storage == HAPI_STORAGETYPE_FLOAT)
+	{
+		if (InTupleSize > 0)
+			AttributeInfo.tupleSize = InTupleSize;
+
+		OutAttributeInfo = AttributeInfo;
+
+		// Borrow the cached values
+		return FHoudiniEngine::Get().GetAttributeCache().GetFloatData(
+			InGeoId, InPartId, InAttribName, AttributeInfo, OutView);
+	}
+
+	// The attribute needs to be converted, do it in a buffer owned by the view
+	TSharedRef<TArray<float>, ESPMode::ThreadSafe> ConvertedData = MakeShared<TArray<float>, ESPMode::ThreadSafe>();
+	if (!HapiGetAttributeDataAsFloat(InGeoId, InPartId, InAttribName, OutAttributeInfo, ConvertedData.Get(), InTupleSize, InOwner))
+		return false;
+
+	OutView = FHoudiniFloatAttributeView(ConvertedData);
+	return true;
+}
+
 bool
 FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
 	const HAPI_NodeId& InGeoId,
@@ -2456,32 +2474,16 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
 	OutAttributeInfo.exists = false;
 
 	// Reset container size.
-	OutData.SetNumUninitialized(0);
+	OutData.Reset();
 
 	int32 OriginalTupleSize = InTupleSize;
 
+	// Look for the attribute via the attribute cache, which knows the names of the part's attributes
 	HAPI_AttributeInfo AttributeInfo;
 	FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
-	if (InOwner == HAPI_ATTROWNER_INVALID)
-	{
-		for (int32 AttrIdx = 0; AttrIdx < HAPI_ATTROWNER_MAX; ++AttrIdx)
-		{
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InGeoId, InPartId, InAttribName,
-				(HAPI_AttributeOwner)AttrIdx, &AttributeInfo), false);
-
-			if (AttributeInfo.exists)
-				break;
-		}
-	}
-	else
-	{
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-			FHoudiniEngine::Get().GetSession(),
-			InGeoId, InPartId, InAttribName,
-			InOwner, &AttributeInfo), false);
-	}
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(
+		InGeoId, InPartId, InAttribName, InOwner, AttributeInfo))
+		return false;
 
 	if (!AttributeInfo.exists)
 		return false;
@@ -2494,36 +2496,19 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsInteger(
 
 	if (AttributeInfo.storage == HAPI_STORAGETYPE_INT)
 	{
-		// Allocate sufficient buffer for data.
-		OutData.SetNum(AttributeInfo.count * AttributeInfo.tupleSize);
-
-		// Fetch the values
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeIntData(
-			FHoudiniEngine::Get().GetSession(),
-			InGeoId, InPartId, InAttribName,
-			&AttributeInfo, -1, &OutData[0], 0, AttributeInfo.count), false);
-
-		return true;
+		// Fetch the values, or reuse them if they have already been fetched since the last cook
+		return FHoudiniEngine::Get().GetAttributeCache().GetIntData(
+			InGeoId, InPartId, InAttribName, AttributeInfo, OutData);
 	}
 	else if (AttributeInfo.storage == HAPI_STORAGETYPE_FLOAT)
 	{
 		// Expected Int, found a float, try to convert the attribute
-
-		// Allocate sufficient buffer for data.
-		TArray<float> FloatData;
-		FloatData.SetNum(AttributeInfo.count * AttributeInfo.tupleSize);
-
-		// Fetch the float values
-		if(HAPI_RESULT_SUCCESS == FHoudiniApi::GetAttributeFloatData(
-			FHoudiniEngine::Get().GetSession(),
-			InGeoId, InPartId, InAttribName,
-			&AttributeInfo, -1, &FloatData[0], 0, AttributeInfo.count))
+		FHoudiniFloatAttributeView FloatData;
+		if (FHoudiniEngine::Get().GetAttributeCache().GetFloatData(
+			InGeoId, InPartId, InAttribName, AttributeInfo, FloatData))
 		{
-			OutData.SetNum(FloatData.Num());
-			for (int32 Idx = 0; Idx < FloatData.Num(); Idx++)
-			{
-				OutData[Idx] = (int32)FloatData[Idx];
-			}
+			OutData.SetNumUninitialized(FloatData.Num());
+			FHoudiniDataConversion::FloatToInt(FloatData.GetData(), OutData.GetData(), FloatData.Num());
 
 			HOUDINI_LOG_MESSAGE(TEXT("Attribute %s was expected to be an integer attribute, its value had to be converted from float."), *FString(InAttribName));
 
@@ -2572,32 +2557,16 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsString(
 	OutAttributeInfo.exists = false;
 
 	// Reset container size.
-	OutData.SetNumUninitialized(0);
+	OutData.Reset();
 
 	int32 OriginalTupleSize = InTupleSize;
 
+	// Look for the attribute via the attribute cache, which knows the names of the part's attributes
 	HAPI_AttributeInfo AttributeInfo;
 	FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
-	if (InOwner == HAPI_ATTROWNER_INVALID)
-	{
-		for (int32 AttrIdx = 0; AttrIdx < HAPI_ATTROWNER_MAX; ++AttrIdx)
-		{
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InGeoId, InPartId, InAttribName,
-				(HAPI_AttributeOwner)AttrIdx, &AttributeInfo), false);
-
-			if (AttributeInfo.exists)
-				break;
-		}
-	}
-	else
-	{
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-			FHoudiniEngine::Get().GetSession(),
-			InGeoId, InPartId, InAttribName,
-			InOwner, &AttributeInfo), false);
-	}
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(
+		InGeoId, InPartId, InAttribName, InOwner, AttributeInfo))
+		return false;
 
 	if (!AttributeInfo.exists)
 		return false;
@@ -2676,75 +2645,410 @@ FHoudiniEngineUtils::HapiGetAttributeDataAsStringFromInfo(
 	if (!InAttributeInfo.exists)
 		return false;
 
-	// Extract the StringHandles
-	TArray<HAPI_StringHandle> StringHandles;
-	StringHandles.Init(-1, InAttributeInfo.count * InAttributeInfo.tupleSize);
-	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeStringData(
-		FHoudiniEngine::Get().GetSession(),
-		InGeoId, InPartId, InAttribName, &InAttributeInfo,
-		&StringHandles[0], 0, InAttributeInfo.count), false);
+	// Extract the StringHandles and convert them to FString in a single batch,
+	// or reuse the strings if they have already been fetched since the last cook
+	return FHoudiniEngine::Get().GetAttributeCache().GetStringData(
+		InGeoId, InPartId, InAttribName, InAttributeInfo, OutData);
+}
 
-	// Set the output data size
-	OutData.SetNum(InAttributeInfo.count);
+bool
+FHoudiniEngineUtils::HapiGetAttributeDataAsStringTable(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& OutAttributeInfo,
+	FHoudiniStringTable& OutStringTable,
+	int32 InTupleSize,
+	HAPI_AttributeOwner InOwner)
+{
+	OutAttributeInfo.exists = false;
+	OutStringTable.Indices.Empty();
+	OutStringTable.Strings.Empty();
 
-	// Convert the StringHandles to FString.
-	// We'll use a map to minimize the number of HAPI calls
-	TMap<int32, FString> StringHandleToStringMap;
-	for (int32 Idx = 0; Idx < StringHandles.Num(); ++Idx)
+	HAPI_AttributeInfo AttributeInfo;
+	FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(
+		InGeoId, InPartId, InAttribName, InOwner, AttributeInfo))
+		return false;
+
+	if (!AttributeInfo.exists)
+		return false;
+
+	if (AttributeInfo.storage != HAPI_STORAGETYPE_STRING)
 	{
-		const HAPI_StringHandle& CurrentSH = StringHandles[Idx];
-		if (CurrentSH < 0)
+		// Numeric attributes are converted to strings first, then deduplicated
+		TArray<FString> StringData;
+		if (!FHoudiniEngineUtils::HapiGetAttributeDataAsString(
+			InGeoId, InPartId, InAttribName, OutAttributeInfo, StringData, InTupleSize, (HAPI_AttributeOwner)AttributeInfo.owner))
+			return false;
+
+		TMap<FString, int32> StringToIndex;
+		OutStringTable.Indices.SetNumUninitialized(StringData.Num());
+		for (int32 Idx = 0; Idx < StringData.Num(); Idx++)
 		{
-			OutData[Idx] = TEXT("");
-			continue;
+			const int32* FoundIndex = StringToIndex.Find(StringData[Idx]);
+			OutStringTable.Indices[Idx] = FoundIndex ? *FoundIndex
+				: StringToIndex.Add(StringData[Idx], OutStringTable.Strings.Add(StringData[Idx]));
 		}
 
-		FString* FoundString = StringHandleToStringMap.Find(CurrentSH);
-		if (FoundString)
+		return true;
+	}
+
+	// Store the retrieved attribute information.
+	OutAttributeInfo = AttributeInfo;
+
+	if (InTupleSize > 0)
+		AttributeInfo.tupleSize = InTupleSize;
+
+	return FHoudiniEngineUtils::HapiGetAttributeDataAsStringTableFromInfo(
+		InGeoId, InPartId, InAttribName, AttributeInfo, OutStringTable);
+}
+
+bool
+FHoudiniEngineUtils::HapiGetAttributeDataAsStringTableFromInfo(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	HAPI_AttributeInfo& InAttributeInfo,
+	FHoudiniStringTable& OutStringTable)
+{
+	if (!InAttributeInfo.exists)
+		return false;
+
+	// The string handles are converted with a single batched query,
+	// and the table is reused if it has already been fetched since the last cook
+	return FHoudiniEngine::Get().GetAttributeCache().GetStringTable(
+		InGeoId, InPartId, InAttribName, InAttributeInfo, OutStringTable);
+}
+
+bool
+FHoudiniEngineUtils::HapiGetAttributeDataAsFloatChunked(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartId& InPartId,
+	const char * InAttribName,
+	const HAPI_AttributeInfo& InAttributeInfo,
+	const int32& InChunkSize,
+	TFunctionRef<void(const TArrayView<const float>& InChunk, const int32& InFirstElement)> InChunkFunction)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniEngineUtils::HapiGetAttributeDataAsFloatChunked"));
+
+	if (!InAttributeInfo.exists || InAttributeInfo.tupleSize <= 0)
+		return false;
+
+	if (InAttributeInfo.storage != HAPI_STORAGETYPE_FLOAT && InAttributeInfo.storage != HAPI_STORAGETYPE_INT)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Found attribute %s, but it was expected to be a float attribute and is of an invalid type."), *FString(InAttribName));
+		return false;
+	}
+
+	const int32 ElementCount = InAttributeInfo.count;
+	const int32 TupleSize = InAttributeInfo.tupleSize;
+	const int32 ChunkSize = FMath::Max(InChunkSize, 1);
+
+	// HAPI expects a mutable info
+	HAPI_AttributeInfo AttributeInfo = InAttributeInfo;
+
+	// Double buffering: a chunk is fetched in one buffer while the previous one is processed from the other.
+	// Integer chunks are fetched in their own buffers and converted.
+	TArray<float> FloatBuffers[2];
+	TArray<int32> IntBuffers[2];
+	auto FetchChunk = [&](const int32& InFirstElement, const int32& InBufferIdx)
+	{
+		const int32 Length = FMath::Min(ChunkSize, ElementCount - InFirstElement);
+		TArray<float>& FloatBuffer = FloatBuffers[InBufferIdx];
+		FloatBuffer.SetNumUninitialized(Length * TupleSize, false);
+
+		if (AttributeInfo.storage == HAPI_STORAGETYPE_FLOAT)
 		{
-			OutData[Idx] = *FoundString;
+			return HAPI_RESULT_SUCCESS == FHoudiniApi::GetAttributeFloatData(
+				FHoudiniEngine::Get().GetSession(),
+				InGeoId, InPartId, InAttribName,
+				&AttributeInfo, -1, FloatBuffer.GetData(), InFirstElement, Length);
 		}
-		else
+
+		TArray<int32>& IntBuffer = IntBuffers[InBufferIdx];
+		IntBuffer.SetNumUninitialized(Length * TupleSize, false);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeIntData(
+			FHoudiniEngine::Get().GetSession(),
+			InGeoId, InPartId, InAttribName,
+			&AttributeInfo, -1, IntBuffer.GetData(), InFirstElement, Length))
+			return false;
+
+		FHoudiniDataConversion::IntToFloat(IntBuffer.GetData(), FloatBuffer.GetData(), IntBuffer.Num());
+		return true;
+	};
+
+	if (ElementCount <= 0)
+		return true;
+
+	const int32 ChunkCount = FMath::DivideAndRoundUp(ElementCount, ChunkSize);
+	if (ChunkCount == 1)
+	{
+		// Nothing to overlap
+		if (!FetchChunk(0, 0))
+			return false;
+
+		InChunkFunction(FloatBuffers[0], 0);
+		return true;
+	}
+
+	// The chunks are fetched one after the other by a single fetch thread, which has to use our session
+	// and record its transfers in our cook stats. A dedicated thread is used, as the caller might itself be a pool worker.
+	const int32 SessionIndex = FHoudiniEngineRuntime::GetCurrentSessionIndex();
+	const FHoudiniCookStatsContext CookStatsContext = FHoudiniCookStatsContext::Capture();
+
+	// A buffer is handed back and forth between the threads: BufferFetched is triggered once the fetch thread filled it,
+	// BufferFree once the caller processed it. ChunkFetched[i] tells if the i-th buffer's last fetch succeeded.
+	FEvent* BufferFetched[2] = { FPlatformProcess::GetSynchEventFromPool(false), FPlatformProcess::GetSynchEventFromPool(false) };
+	FEvent* BufferFree[2] = { FPlatformProcess::GetSynchEventFromPool(false), FPlatformProcess::GetSynchEventFromPool(false) };
+	bool ChunkFetched[2] = { false, false };
+
+	TFuture<void> FetchTask = Async(EAsyncExecution::Thread, [&]()
+	{
+		FHoudiniEngineScopedSession ScopedSession(SessionIndex);
+		FHoudiniCookStatsWorkerScope CookStatsScope(CookStatsContext);
+
+		for (int32 ChunkIdx = 0; ChunkIdx < ChunkCount; ChunkIdx++)
 		{
-			FString HapiString = TEXT("");
-			FHoudiniEngineString::ToFString(CurrentSH, HapiString);
+			const int32 BufferIdx = ChunkIdx % 2;
+
+			// The first two buffers are free, then wait for the caller to be done with the chunk that used this buffer
+			if (ChunkIdx >= 2)
+				BufferFree[BufferIdx]->Wait();
+
+			ChunkFetched[BufferIdx] = FetchChunk(ChunkIdx * ChunkSize, BufferIdx);
+			BufferFetched[BufferIdx]->Trigger();
+
+			// The caller stops at the first failed chunk
+			if (!ChunkFetched[BufferIdx])
+				break;
+		}
+	});
 
-			StringHandleToStringMap.Add(CurrentSH, HapiString);
-			OutData[Idx] = HapiString;
+	bool bSuccess = true;
+	for (int32 ChunkIdx = 0; ChunkIdx < ChunkCount; ChunkIdx++)
+	{
+		const int32 BufferIdx = ChunkIdx % 2;
+		BufferFetched[BufferIdx]->Wait();
+		if (!ChunkFetched[BufferIdx])
+		{
+			HOUDINI_LOG_WARNING(TEXT("Failed to stream attribute %s."), *FString(InAttribName));
+			bSuccess = false;
+			break;
 		}
+
+		// The next chunk is being fetched in the other buffer while we process this one
+		InChunkFunction(FloatBuffers[BufferIdx], ChunkIdx * ChunkSize);
+		BufferFree[BufferIdx]->Trigger();
 	}
 
-	return true;
+	FetchTask.Wait();
+
+	for (int32 BufferIdx = 0; BufferIdx < 2; BufferIdx++)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(BufferFetched[BufferIdx]);
+		FPlatformProcess::ReturnSynchEventToPool(BufferFree[BufferIdx]);
+	}
+
+	return bSuccess;
 }
 
 bool
-FHoudiniEngineUtils::HapiCheckAttributeExists(
-	const HAPI_NodeId& GeoId, const HAPI_PartId& PartId,
-	const char * AttribName, HAPI_AttributeOwner Owner)
+FHoudiniEngineUtils::HapiGetPartFingerprint(
+	const HAPI_NodeId& InGeoId,
+	const HAPI_PartInfo& InPartInfo,
+	uint64& OutFingerprint)
 {
-	if (Owner == HAPI_ATTROWNER_INVALID)
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniEngineUtils::HapiGetPartFingerprint"));
+
+	// Number of elements fetched at once, to bound the memory used for large parts
+	const int32 ChunkSize = 64 * 1024;
+
+	const HAPI_PartId& PartId = InPartInfo.id;
+
+	uint64 Fingerprint = 0;
+	auto HashData = [&Fingerprint](const void* InData, const int32& InNumBytes)
 	{
-		for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; OwnerIdx++)
+		Fingerprint = CityHash64WithSeed((const char*)InData, (uint32)InNumBytes, Fingerprint);
+	};
+	auto HashValue = [&HashData](const int32& InValue) { HashData(&InValue, sizeof(int32)); };
+	auto HashString = [&HashData](const FString& InValue)
+	{
+		HashData(*InValue, InValue.Len() * sizeof(TCHAR));
+		HashData(TEXT("\0"), sizeof(TCHAR));
+	};
+
+	// Calls InChunkFunction with the first element and length of each chunk of an array of InCount elements
+	auto ForEachChunk = [&](const int32& InCount, TFunctionRef<bool(const int32&, const int32&)> InChunkFunction)
+	{
+		for (int32 FirstElement = 0; FirstElement < InCount; FirstElement += ChunkSize)
 		{
-			if (HapiCheckAttributeExists(GeoId, PartId, AttribName, (HAPI_AttributeOwner)OwnerIdx))
-			{
-				return true;
-			}
+			if (!InChunkFunction(FirstElement, FMath::Min(ChunkSize, InCount - FirstElement)))
+				return false;
 		}
+
+		return true;
+	};
+
+	// Element counts
+	HashValue(InPartInfo.type);
+	HashValue(InPartInfo.faceCount);
+	HashValue(InPartInfo.vertexCount);
+	HashValue(InPartInfo.pointCount);
+	HashValue(InPartInfo.isInstanced ? 1 : 0);
+
+	// Topology, only meshes have faces
+	TArray<int32> IntChunk;
+	if (InPartInfo.type == HAPI_PARTTYPE_MESH)
+	{
+		const bool bFaceCountsHashed = ForEachChunk(InPartInfo.faceCount, [&](const int32& InFirstElement, const int32& InLength)
+		{
+			IntChunk.SetNumUninitialized(InLength, false);
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetFaceCounts(
+				FHoudiniEngine::Get().GetSession(), InGeoId, PartId, IntChunk.GetData(), InFirstElement, InLength))
+				return false;
+
+			HashData(IntChunk.GetData(), IntChunk.Num() * sizeof(int32));
+			return true;
+		});
+
+		if (!bFaceCountsHashed)
+			return false;
+
+		const bool bVertexListHashed = ForEachChunk(InPartInfo.vertexCount, [&](const int32& InFirstElement, const int32& InLength)
+		{
+			IntChunk.SetNumUninitialized(InLength, false);
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetVertexList(
+				FHoudiniEngine::Get().GetSession(), InGeoId, PartId, IntChunk.GetData(), InFirstElement, InLength))
+				return false;
+
+			HashData(IntChunk.GetData(), IntChunk.Num() * sizeof(int32));
+			return true;
+		});
+
+		if (!bVertexListHashed)
+			return false;
 	}
-	else
+
+	// Attribute names, per owner, and their values
+	TArray<float> FloatChunk;
+	TArray<FString> StringChunk;
+	for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; ++OwnerIdx)
 	{
-		HAPI_AttributeInfo AttribInfo;
-		FHoudiniApi::AttributeInfo_Init(&AttribInfo);
+		const HAPI_AttributeOwner Owner = (HAPI_AttributeOwner)OwnerIdx;
+		const int32 AttributeCount = InPartInfo.attributeCounts[OwnerIdx];
+		HashValue(AttributeCount);
+		if (AttributeCount <= 0)
+			continue;
 
-		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
-			FHoudiniEngine::Get().GetSession(),
-			GeoId, PartId, AttribName, Owner, &AttribInfo), false);
+		TArray<HAPI_StringHandle> NameHandles;
+		NameHandles.SetNumZeroed(AttributeCount);
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeNames(
+			FHoudiniEngine::Get().GetSession(), InGeoId, PartId, Owner,
+			NameHandles.GetData(), AttributeCount), false);
+
+		TArray<FString> Names;
+		FHoudiniEngineString::SHArrayToFStringArray(NameHandles, Names);
+		for (const FString& Name : Names)
+		{
+			HashString(Name);
+
+			HAPI_AttributeInfo AttributeInfo;
+			FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
+			const std::string AttributeName = TCHAR_TO_UTF8(*Name);
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAttributeInfo(
+				FHoudiniEngine::Get().GetSession(), InGeoId, PartId,
+				AttributeName.c_str(), Owner, &AttributeInfo), false);
+
+			HashValue(AttributeInfo.storage);
+			HashValue(AttributeInfo.tupleSize);
+			if (!AttributeInfo.exists || AttributeInfo.tupleSize <= 0)
+				continue;
 
-		return AttribInfo.exists;
+			// Array and 64 bits attributes are only identified by their name and storage
+			bool bValuesHashed = true;
+			switch (AttributeInfo.storage)
+			{
+				case HAPI_STORAGETYPE_FLOAT:
+				{
+					bValuesHashed = ForEachChunk(AttributeInfo.count, [&](const int32& InFirstElement, const int32& InLength)
+					{
+						FloatChunk.SetNumUninitialized(InLength * AttributeInfo.tupleSize, false);
+						if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeFloatData(
+							FHoudiniEngine::Get().GetSession(), InGeoId, PartId, AttributeName.c_str(),
+							&AttributeInfo, -1, FloatChunk.GetData(), InFirstElement, InLength))
+							return false;
+
+						HashData(FloatChunk.GetData(), FloatChunk.Num() * sizeof(float));
+						return true;
+					});
+				}
+				break;
+
+				case HAPI_STORAGETYPE_INT:
+				{
+					bValuesHashed = ForEachChunk(AttributeInfo.count, [&](const int32& InFirstElement, const int32& InLength)
+					{
+						IntChunk.SetNumUninitialized(InLength * AttributeInfo.tupleSize, false);
+						if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeIntData(
+							FHoudiniEngine::Get().GetSession(), InGeoId, PartId, AttributeName.c_str(),
+							&AttributeInfo, -1, IntChunk.GetData(), InFirstElement, InLength))
+							return false;
+
+						HashData(IntChunk.GetData(), IntChunk.Num() * sizeof(int32));
+						return true;
+					});
+				}
+				break;
+
+				case HAPI_STORAGETYPE_STRING:
+				{
+					// String handles aren't stable across cooks, their values are hashed
+					bValuesHashed = ForEachChunk(AttributeInfo.count, [&](const int32& InFirstElement, const int32& InLength)
+					{
+						IntChunk.SetNumUninitialized(InLength * AttributeInfo.tupleSize, false);
+						if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeStringData(
+							FHoudiniEngine::Get().GetSession(), InGeoId, PartId, AttributeName.c_str(),
+							&AttributeInfo, IntChunk.GetData(), InFirstElement, InLength))
+							return false;
+
+						if (!FHoudiniEngineString::SHArrayToFStringArray(IntChunk, StringChunk))
+							return false;
+
+						for (const FString& Value : StringChunk)
+							HashString(Value);
+
+						return true;
+					});
+				}
+				break;
+
+				default:
+					break;
+			}
+
+			if (!bValuesHashed)
+				return false;
+		}
 	}
 
-	return false;
+	// 0 is kept for parts without a fingerprint
+	OutFingerprint = Fingerprint != 0 ? Fingerprint : 1;
+	return true;
+}
+
+bool
+FHoudiniEngineUtils::HapiCheckAttributeExists(
+	const HAPI_NodeId& GeoId, const HAPI_PartId& PartId,
+	const char * AttribName, HAPI_AttributeOwner Owner)
+{
+	// The attribute cache resolves this with the part's attribute names, without probing each owner
+	HAPI_AttributeInfo AttribInfo;
+	FHoudiniApi::AttributeInfo_Init(&AttribInfo);
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(GeoId, PartId, AttribName, Owner, AttribInfo))
+		return false;
+
+	return AttribInfo.exists;
 }
 
 bool
@@ -4354,6 +4658,9 @@ FHoudiniEngineUtils::HapiCookNode(const HAPI_NodeId& InNodeId, HAPI_CookOptions*
 			FHoudiniEngine::Get().GetSession(), InNodeId, InCookOptions), false);
 	}
 
+	// The cached attributes need to be checked against their geo's new cook count
+	FHoudiniEngine::Get().GetAttributeCache().NotifyCooked();
+
 	// If we don't need to wait for completion, return now
 	if (!bWaitForCompletion)
 		return true;
@@ -33,6 +33,7 @@
 
 #include "HoudiniOutput.h"
 #include "HoudiniPackageParams.h"
+#include "HoudiniAttributeCache.h"
 #include "Containers/UnrealString.h"
 
 
@@ -46,6 +47,7 @@ struct FHoudiniPartInfo;
 struct FHoudiniMeshSocket;
 struct FHoudiniGeoPartObject;
 struct FHoudiniGenericAttribute;
+struct FHoudiniStringTable;
 
 struct FRawMesh;
 
@@ -178,6 +180,17 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 			int32 InTupleSize = 0,
 			HAPI_AttributeOwner InOwner = HAPI_ATTROWNER_INVALID);
 
+		// HAPI : Get attribute data as float, without copying it.
+		// Float attributes share the attribute cache's buffer, other storages are converted into a new buffer.
+		static bool HapiGetAttributeDataAsFloat(
+			const HAPI_NodeId& InGeoId,
+			const HAPI_PartId& InPartId,
+			const char * InAttribName,
+			HAPI_AttributeInfo& OutAttributeInfo,
+			FHoudiniFloatAttributeView& OutView,
+			int32 InTupleSize = 0,
+			HAPI_AttributeOwner InOwner = HAPI_ATTROWNER_INVALID);
+
 		// HAPI : Get attribute data as Integer.
 		static bool HapiGetAttributeDataAsInteger(
 			const HAPI_NodeId& InGeoId,
@@ -206,6 +219,44 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 			HAPI_AttributeInfo& InAttributeInfo,
 			TArray<FString>& OutData);
 
+		// HAPI : Get attribute data as a table of unique strings and an index per element.
+		// Prefer this to HapiGetAttributeDataAsString for attributes with many elements but few values (assets, materials...)
+		static bool HapiGetAttributeDataAsStringTable(
+			const HAPI_NodeId& InGeoId,
+			const HAPI_PartId& InPartId,
+			const char * InAttribName,
+			HAPI_AttributeInfo& OutAttributeInfo,
+			FHoudiniStringTable& OutStringTable,
+			int32 InTupleSize = 0,
+			HAPI_AttributeOwner InOwner = HAPI_ATTROWNER_INVALID);
+
+		// HAPI : Get attribute data as a table of unique strings and an index per element.
+		static bool HapiGetAttributeDataAsStringTableFromInfo(
+			const HAPI_NodeId& InGeoId,
+			const HAPI_PartId& InPartId,
+			const char * InAttribName,
+			HAPI_AttributeInfo& InAttributeInfo,
+			FHoudiniStringTable& OutStringTable);
+
+		// HAPI : Streams a float or integer attribute in chunks of InChunkSize elements, converted to floats.
+		// InChunkFunction is called with each chunk and the index of its first element, in order.
+		// The next chunk is fetched while the current one is processed, so at most two chunks are allocated at once.
+		static bool HapiGetAttributeDataAsFloatChunked(
+			const HAPI_NodeId& InGeoId,
+			const HAPI_PartId& InPartId,
+			const char * InAttribName,
+			const HAPI_AttributeInfo& InAttributeInfo,
+			const int32& InChunkSize,
+			TFunctionRef<void(const TArrayView<const float>& InChunk, const int32& InFirstElement)> InChunkFunction);
+
+		// HAPI : Computes a fingerprint of a part's content, used to detect the parts left untouched by a cook of their geo.
+		// It's a 64 bit hash of the part's element counts, face counts, vertex list, and the names and values of all its
+		// attributes, fetched in chunks. Returns false if HAPI failed.
+		static bool HapiGetPartFingerprint(
+			const HAPI_NodeId& InGeoId,
+			const HAPI_PartInfo& InPartInfo,
+			uint64& OutFingerprint);
+
 		// HAPI : Check if given attribute exists.
 		static bool HapiCheckAttributeExists(
 			const HAPI_NodeId& GeoId,
@@ -243,6 +294,9 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 		// Destroy asset, returns the status.
 		static bool DestroyHoudiniAsset(const HAPI_NodeId& AssetId);
 
+		// Returns the absolute path of the library file (or expanded HDA directory) to load for a Houdini Asset
+		static FString GetHoudiniAssetLibraryPath(const UHoudiniAsset * HoudiniAsset);
+
 		// Loads an HDA file and returns its AssetLibraryId
 		static bool LoadHoudiniAsset(
 			UHoudiniAsset * HoudiniAsset,
@@ -28,6 +28,7 @@
 #include "HoudiniHandleTranslator.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineString.h"
@@ -43,6 +44,9 @@
 bool
 FHoudiniHandleTranslator::UpdateHandles(UHoudiniAssetComponent* HAC) 
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniHandleTranslator::UpdateHandles"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniHandleTranslator::UpdateHandles"));
+
 	if (!HAC || HAC->IsPendingKill())
 		return false;
 
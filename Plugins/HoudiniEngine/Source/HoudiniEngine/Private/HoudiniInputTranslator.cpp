@@ -28,6 +28,7 @@
 
 #include "HoudiniInput.h"
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineString.h"
@@ -93,6 +94,9 @@ struct FHoudiniMoveTracker
 bool
 FHoudiniInputTranslator::UpdateInputs(UHoudiniAssetComponent* HAC)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniInputTranslator::UpdateInputs"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniInputTranslator::UpdateInputs"));
+
 	if (!HAC || HAC->IsPendingKill())
 		return false;
 
@@ -589,6 +593,9 @@ FHoudiniInputTranslator::SetDefaultAssetFromHDA(UHoudiniInput* Input)
 bool
 FHoudiniInputTranslator::UploadChangedInputs(UHoudiniAssetComponent * HAC)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniInputTranslator::UploadChangedInputs"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniInputTranslator::UploadChangedInputs"));
+
 	if (!HAC || HAC->IsPendingKill())
 		return false;
 
@@ -27,7 +27,11 @@
 #include "HoudiniInstanceTranslator.h"
 
 #include "HoudiniEngine.h"
+#include "HoudiniApiTrace.h"
+#include "HoudiniEngineOutputStats.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniDataConversion.h"
+#include "HoudiniEngineString.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniInstancedActorComponent.h"
@@ -67,6 +71,10 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(
 	const TArray<UHoudiniOutput*>& InAllOutputs,
 	UObject* InOuterComponent)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput"));
+	FHoudiniCookPhaseScope PhaseScope(EHoudiniCookPhase::CreateComponents);
+
 	if (!InOutput || InOutput->IsPendingKill())
 		return false;
 
@@ -927,11 +935,8 @@ FHoudiniInstanceTranslator::GetPackedPrimitiveInstancerHGPOsAndTransforms(
 	// Convert the transform to Unreal's coordinate system
 	TArray<FTransform> InstancerUnrealTransforms;
 	InstancerUnrealTransforms.SetNumUninitialized(InstancerPartTransforms.Num());
-	for (int32 InstanceIdx = 0; InstanceIdx < InstancerPartTransforms.Num(); InstanceIdx++)
-	{
-		const auto& InstanceTransform = InstancerPartTransforms[InstanceIdx];
-		FHoudiniEngineUtils::TranslateHapiTransform(InstanceTransform, InstancerUnrealTransforms[InstanceIdx]);
-	}
+	FHoudiniDataConversion::HoudiniToUnrealTransforms(
+		InstancerPartTransforms.GetData(), InstancerUnrealTransforms.GetData(), InstancerPartTransforms.Num());
 
 	// Get the part ids for parts being instanced
 	TArray<HAPI_PartId> InstancedPartIds;
@@ -1148,9 +1153,10 @@ FHoudiniInstanceTranslator::GetAttributeInstancerObjectsAndTransforms(
 	}
 	else
 	{
-		// Attribute is on points, so we may have different values for each of them
-		TArray<FString> PointInstanceValues;
-		if (!FHoudiniEngineUtils::HapiGetAttributeDataAsStringFromInfo(
+		// Attribute is on points, so we may have different values for each of them.
+		// Get them as a table of the unique values, which are the unique objects we want to instance
+		FHoudiniStringTable PointInstanceValues;
+		if (!FHoudiniEngineUtils::HapiGetAttributeDataAsStringTableFromInfo(
 			InHGPO.GeoId,
 			InHGPO.PartId,
 			is_override_attr ? HAPI_UNREAL_ATTRIB_INSTANCE_OVERRIDE : HAPI_UNREAL_ATTRIB_INSTANCE,
@@ -1168,51 +1174,52 @@ FHoudiniInstanceTranslator::GetAttributeInstancerObjectsAndTransforms(
 			return false;
 		}
 
-		// If instance attribute exists on points, we need to get all the unique values.
-		// This will give us all the unique object we want to instance
-		TMap<FString, UObject *> ObjectsToInstance;
-		for (const auto& Iter : PointInstanceValues)
+		// Gather the points of each unique value in a single pass,
+		// points with an invalid string go in an extra last bucket with an empty path
+		const int32 InvalidValueIdx = PointInstanceValues.Strings.Num();
+		TArray<TArray<int32>> PointsPerValue;
+		PointsPerValue.SetNum(InvalidValueIdx + 1);
+		for (int32 Idx = 0; Idx < PointInstanceValues.Num(); ++Idx)
 		{
-			if (!ObjectsToInstance.Contains(Iter))
-			{
-				// To avoid trying to load an object that fails multiple times,
-				// still add it to the array if null so we can still skip further attempts
-				UObject * AttributeObject = StaticLoadObject(
-					UObject::StaticClass(), nullptr, *Iter, nullptr, LOAD_None, nullptr);
-
-				if (!AttributeObject)
-				{
-					// See if the ref is a class that we can instantiate
-					UClass * FoundClass = FindObject<UClass>(ANY_PACKAGE, *Iter);
-					if (FoundClass != nullptr)
-					{
-						// TODO: ensure we'll be able to create an actor from this class!
-						AttributeObject = FoundClass;
-					}
-				}
-
-				ObjectsToInstance.Add(Iter, AttributeObject);
-			}
+			const int32& ValueIdx = PointInstanceValues.Indices[Idx];
+			PointsPerValue[ValueIdx == INDEX_NONE ? InvalidValueIdx : ValueIdx].Add(Idx);
 		}
 
 		// Iterates through all the unique objects and get their corresponding transforms
 		bool Success = false;
-		for (auto Iter : ObjectsToInstance)
+		for (int32 ValueIdx = 0; ValueIdx < PointsPerValue.Num(); ++ValueIdx)
 		{
-			bool bHiddenInGame = false;
+			const TArray<int32>& ValuePoints = PointsPerValue[ValueIdx];
+			if (ValuePoints.Num() <= 0)
+				continue;
+
+			// Only try to load each object once
+			const FString InstancePath = ValueIdx < InvalidValueIdx ? PointInstanceValues.Strings[ValueIdx] : FString();
+			UObject * AttributeObject = StaticLoadObject(
+				UObject::StaticClass(), nullptr, *InstancePath, nullptr, LOAD_None, nullptr);
+
+			if (!AttributeObject)
+			{
+				// See if the ref is a class that we can instantiate
+				UClass * FoundClass = FindObject<UClass>(ANY_PACKAGE, *InstancePath);
+				if (FoundClass != nullptr)
+				{
+					// TODO: ensure we'll be able to create an actor from this class!
+					AttributeObject = FoundClass;
+				}
+			}
+
 			// Check that we managed to load this object
-			UObject * AttributeObject = Iter.Value;
 			if (!AttributeObject && bDefaultObjectEnabled) 
 			{
 				HOUDINI_LOG_WARNING(
-					TEXT("Failed to load instanced object '%s', use default mesh (hidden in game)."), *(Iter.Key));
+					TEXT("Failed to load instanced object '%s', use default mesh (hidden in game)."), *InstancePath);
 
 				// If failed to load this object, add default reference mesh
 				UStaticMesh * DefaultReferenceSM = FHoudiniEngine::Get().GetHoudiniDefaultReferenceMesh().Get();
 				if (DefaultReferenceSM && !DefaultReferenceSM->IsPendingKill())
 				{
 					AttributeObject = DefaultReferenceSM;
-					bHiddenInGame = true;
 				}
 				else// Failed to load default reference mesh object
 				{
@@ -1224,43 +1231,26 @@ FHoudiniInstanceTranslator::GetAttributeInstancerObjectsAndTransforms(
 			if (!AttributeObject)
 				continue;
 
-			if (!bHasSplitAttribute)
-			{
-				// No Split attribute:
-				// Extract the transform values that correspond to this object, and add them to the output arrays
-				const FString & InstancePath = Iter.Key;
-				TArray<FTransform> ObjectTransforms;
-				for (int32 Idx = 0; Idx < PointInstanceValues.Num(); ++Idx)
-				{
-					if (InstancePath.Equals(PointInstanceValues[Idx]))
-						ObjectTransforms.Add(InstancerUnrealTransforms[Idx]);
-				}
+			// Extract the transform values that correspond to this object, and add them to the output arrays
+			TArray<FTransform> ObjectTransforms;
+			ObjectTransforms.Reserve(ValuePoints.Num());
+			for (const int32& PointIdx : ValuePoints)
+				ObjectTransforms.Add(InstancerUnrealTransforms[PointIdx]);
 
-				OutInstancedObjects.Add(AttributeObject);
-				OutInstancedTransforms.Add(ObjectTransforms);
-				Success = true;
-			}
-			else
+			OutInstancedObjects.Add(AttributeObject);
+			OutInstancedTransforms.Add(ObjectTransforms);
+			Success = true;
+
+			if (bHasSplitAttribute)
 			{
 				// We have a split attribute:
-				// Extract the transform values and split attribute values for this object,
-				// add them to the output arrays, and we will process the splits after
-				const FString & InstancePath = Iter.Key;
-				TArray<FTransform> ObjectTransforms;
+				// Also extract the split attribute values for this object, we will process the splits after
 				TArray<FString> ObjectSplitValues;
-				for (int32 Idx = 0; Idx < PointInstanceValues.Num(); ++Idx)
-				{
-					if (InstancePath.Equals(PointInstanceValues[Idx]))
-					{
-						ObjectTransforms.Add(InstancerUnrealTransforms[Idx]);
-						ObjectSplitValues.Add(AllSplitAttributeValues[Idx]);
-					}
-				}
+				ObjectSplitValues.Reserve(ValuePoints.Num());
+				for (const int32& PointIdx : ValuePoints)
+					ObjectSplitValues.Add(AllSplitAttributeValues[PointIdx]);
 
-				OutInstancedObjects.Add(AttributeObject);
-				OutInstancedTransforms.Add(ObjectTransforms);
 				SplitAttributeValuesPerObject.Add(ObjectSplitValues);
-				Success = true;
 			}
 		}
 
@@ -2262,12 +2252,9 @@ FHoudiniInstanceTranslator::HapiGetInstanceTransforms(
 	}
 
 	// Convert the transform to Unreal's coordinate system
-	OutInstancerUnrealTransforms.SetNumZeroed(InstanceTransforms.Num());
-	for (int32 InstanceIdx = 0; InstanceIdx < InstanceTransforms.Num(); InstanceIdx++)
-	{
-		const auto& InstanceTransform = InstanceTransforms[InstanceIdx];
-		FHoudiniEngineUtils::TranslateHapiTransform(InstanceTransform, OutInstancerUnrealTransforms[InstanceIdx]);
-	}
+	OutInstancerUnrealTransforms.SetNumUninitialized(InstanceTransforms.Num());
+	FHoudiniDataConversion::HoudiniToUnrealTransforms(
+		InstanceTransforms.GetData(), OutInstancerUnrealTransforms.GetData(), InstanceTransforms.Num());
 
 	return true;
 }
@@ -2357,12 +2344,12 @@ FHoudiniInstanceTranslator::RemoveAndDestroyComponent(UObject* InComponent)
 
 bool
 FHoudiniInstanceTranslator::GetMaterialOverridesFromAttributes(
-	const int32& InGeoNodeId, const int32& InPartId, TArray<FString>& OutMaterialAttributes)
+	const int32& InGeoNodeId, const int32& InPartId, FHoudiniStringTable& OutMaterialAttributes)
 {
 	HAPI_AttributeInfo MaterialAttributeInfo;
 	FHoudiniApi::AttributeInfo_Init(&MaterialAttributeInfo);
 
-	FHoudiniEngineUtils::HapiGetAttributeDataAsString(
+	FHoudiniEngineUtils::HapiGetAttributeDataAsStringTable(
 		InGeoNodeId, InPartId, HAPI_UNREAL_ATTRIB_MATERIAL, MaterialAttributeInfo, OutMaterialAttributes);
 
 	/*
@@ -2382,7 +2369,8 @@ FHoudiniInstanceTranslator::GetMaterialOverridesFromAttributes(
 		&& MaterialAttributeInfo.owner != HAPI_ATTROWNER_DETAIL*/)
 	{
 		//HOUDINI_LOG_WARNING(TEXT("Instancer: the unreal_material attribute must be a primitive or detail attribute, ignoring the attribute."));
-		OutMaterialAttributes.Empty();
+		OutMaterialAttributes.Indices.Empty();
+		OutMaterialAttributes.Strings.Empty();
 		return false;
 	}
 
@@ -2393,45 +2381,38 @@ bool
 FHoudiniInstanceTranslator::GetInstancerMaterials(
 	const int32& InGeoNodeId, const int32& InPartId, TArray<UMaterialInterface*>& OutInstancerMaterials)
 {
-	TArray<FString> MaterialAttributes;
-	if (!GetMaterialOverridesFromAttributes(InGeoNodeId, InPartId, MaterialAttributes))
-		MaterialAttributes.Empty();
-
-	// Use a map to avoid attempting to load the object for each instance
-	TMap<FString, UMaterialInterface*> MaterialMap;
+	FHoudiniStringTable MaterialAttributes;
+	GetMaterialOverridesFromAttributes(InGeoNodeId, InPartId, MaterialAttributes);
 
+	// Only attempt to load each unique material once
 	bool bHasValidMaterial = false;
-	for (auto& CurrentMatString : MaterialAttributes)
+	TArray<UMaterialInterface*> UniqueMaterials;
+	UniqueMaterials.SetNumZeroed(MaterialAttributes.Strings.Num());
+	for (int32 Idx = 0; Idx < MaterialAttributes.Strings.Num(); Idx++)
 	{
-		UMaterialInterface* CurrentMaterialInterface = nullptr;
-		UMaterialInterface** FoundMaterial = MaterialMap.Find(CurrentMatString);
-		if (!FoundMaterial)
-		{
-			// See if we can find a material interface that matches the attribute
-			CurrentMaterialInterface = Cast<UMaterialInterface>(
-				StaticLoadObject(UMaterialInterface::StaticClass(), nullptr, *CurrentMatString, nullptr, LOAD_NoWarn, nullptr));
+		// See if we can find a material interface that matches the attribute
+		UMaterialInterface* CurrentMaterialInterface = Cast<UMaterialInterface>(
+			StaticLoadObject(UMaterialInterface::StaticClass(), nullptr, *MaterialAttributes.Strings[Idx], nullptr, LOAD_NoWarn, nullptr));
 
-			// Check validity
-			if (!CurrentMaterialInterface || CurrentMaterialInterface->IsPendingKill())
-				CurrentMaterialInterface = nullptr;
-			else
-				bHasValidMaterial = true;
-
-			// Add what we found to the material map to avoid unnecessary loads
-			MaterialMap.Add(CurrentMatString, CurrentMaterialInterface);
-		}
+		// Check validity
+		if (!CurrentMaterialInterface || CurrentMaterialInterface->IsPendingKill())
+			CurrentMaterialInterface = nullptr;
 		else
-		{
-			// Reuse what we previously found
-			CurrentMaterialInterface = *FoundMaterial;
-		}
-		
-		OutInstancerMaterials.Add(CurrentMaterialInterface);
+			bHasValidMaterial = true;
+
+		UniqueMaterials[Idx] = CurrentMaterialInterface;
 	}
 
 	// IF we couldn't find at least one valid material interface, empty the array
 	if (!bHasValidMaterial)
+	{
 		OutInstancerMaterials.Empty();
+		return true;
+	}
+
+	OutInstancerMaterials.Reserve(OutInstancerMaterials.Num() + MaterialAttributes.Num());
+	for (const int32& MaterialIdx : MaterialAttributes.Indices)
+		OutInstancerMaterials.Add(UniqueMaterials.IsValidIndex(MaterialIdx) ? UniqueMaterials[MaterialIdx] : nullptr);
 
 	return true;
 }
@@ -34,6 +34,7 @@
 
 class UStaticMesh;
 struct FHoudiniGenericAttribute;
+struct FHoudiniStringTable;
 class UHoudiniStaticMesh;
 class UHoudiniInstancedActorComponent;
 
@@ -213,7 +214,7 @@ struct HOUDINIENGINE_API FHoudiniInstanceTranslator
 		static bool GetMaterialOverridesFromAttributes(
 			const int32& InGeoNodeId,
 			const int32& InPartId, 
-			TArray<FString>& OutMaterialAttributes);
+			FHoudiniStringTable& OutMaterialAttributes);
 
 		static bool GetInstancerMaterials(
 			const int32& InGeoNodeId,
@@ -29,6 +29,7 @@
 #include "HoudiniGeoPartObject.h"
 #include "HoudiniEngineString.h"
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineRuntime.h"
@@ -105,6 +106,9 @@ FHoudiniLandscapeTranslator::CreateLandscape(
 	TArray<UPackage*>& OutCreatedPackages
 )
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniLandscapeTranslator::CreateLandscape"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniLandscapeTranslator::CreateLandscape"));
+
 	check(LayerMinimums.Contains(TEXT("height")));
 	check(LayerMaximums.Contains(TEXT("height")));
 
@@ -28,6 +28,7 @@
 #include "HoudiniMaterialTranslator.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineString.h"
@@ -76,6 +77,7 @@ bool FHoudiniMaterialTranslator::CreateHoudiniMaterials(
 	bool bInTreatExistingMaterialsAsUpToDate)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMaterialTranslator::CreateHoudiniMaterials"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniMaterialTranslator::CreateHoudiniMaterials"));
 
 	if (InUniqueMaterialIds.Num() <= 0)
 		return false;
@@ -28,15 +28,19 @@
 #include "HoudiniMeshTranslator.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
+#include "HoudiniEngineOutputStats.h"
 #include "HoudiniEngine.h"
 #include "HoudiniOutput.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniGeoPartObject.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniDataConversion.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniMaterialTranslator.h"
 #include "HoudiniAssetActor.h"
+#include "HoudiniRuntimeSettings.h"
 
 #include "HoudiniStaticMesh.h"
 #include "HoudiniStaticMeshComponent.h"
@@ -62,6 +66,8 @@
 #include "ObjectTools.h"
 
 // #include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "Algo/BinarySearch.h"
 
 #include "ProfilingDebugging/CpuProfilerTrace.h"
 
@@ -76,6 +82,17 @@
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE
 
+// Copies a split's assembled values into a mesh description's attribute array,
+// whose elements were created in the same order.
+template<typename ValueType, typename RawArrayType>
+static void
+CopySplitDataToRawArray(const TArray<ValueType>& InValues, RawArrayType& OutRawArray)
+{
+	const int32 Count = FMath::Min(InValues.Num(), OutRawArray.Num());
+	if (Count > 0)
+		FMemory::Memcpy(OutRawArray.GetData(), InValues.GetData(), Count * sizeof(ValueType));
+}
+
 // 
 bool
 FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
@@ -84,8 +101,13 @@ FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 	EHoudiniStaticMeshMethod InStaticMeshMethod,
 	UObject* InOuterComponent,
 	bool bInTreatExistingMaterialsAsUpToDate,
-	bool bInDestroyProxies)
+	bool bInDestroyProxies,
+	FHoudiniMeshPrefetch* InPrefetch)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput"));
+	FHoudiniCookPhaseScope PhaseScope(EHoudiniCookPhase::TranslateMeshes);
+
 	if (!InOutput || InOutput->IsPendingKill())
 		return false;
 
@@ -123,7 +145,8 @@ FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 			ReplacementMaterials,
 			InForceRebuild,
 			InStaticMeshMethod,
-			bInTreatExistingMaterialsAsUpToDate);
+			bInTreatExistingMaterialsAsUpToDate,
+			InPrefetch);
 	}
 
 	// Remove Static Meshes and their components from the old map 
@@ -239,6 +262,7 @@ FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 	*/
 
 	// Now create/update the new static mesh components
+	FHoudiniCookPhaseScope CreateComponentsPhaseScope(EHoudiniCookPhase::CreateComponents);
 	for (auto& NewPair : NewOutputObjects)
 	{
 		// Get the old Identifier / StaticMesh
@@ -470,8 +494,12 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 	TMap<FString, UMaterialInterface*>& ReplacementMaterialMap,
 	const bool& InForceRebuild,
 	EHoudiniStaticMeshMethod InStaticMeshMethod,
-	bool bInTreatExistingMaterialsAsUpToDate)
+	bool bInTreatExistingMaterialsAsUpToDate,
+	FHoudiniMeshPrefetch* InPrefetch)
 {
+	// Get the part's data if it has been fetched ahead of time
+	TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe> PrefetchedTranslator = InPrefetch ? InPrefetch->Take(InHGPO) : nullptr;
+
 	// If we're not forcing the rebuild
 	// No need to recreate something that hasn't changed
 	if (!InForceRebuild && (!InHGPO.bHasGeoChanged || !InHGPO.bHasPartChanged) && InOutputObjects.Num() > 0)
@@ -481,7 +509,8 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 		return true;
 	}
 	
-	FHoudiniMeshTranslator CurrentTranslator;
+	FHoudiniMeshTranslator LocalTranslator;
+	FHoudiniMeshTranslator& CurrentTranslator = PrefetchedTranslator.IsValid() ? *PrefetchedTranslator : LocalTranslator;
 	CurrentTranslator.ForceRebuild = InForceRebuild;
 	CurrentTranslator.SetHoudiniGeoPartObject(InHGPO);
 	CurrentTranslator.SetInputObjects(InOutputObjects);
@@ -518,6 +547,448 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 	return true;
 }
 
+FHoudiniMeshTranslator::FHoudiniMeshTranslator()
+	: OuterComponent(nullptr)
+	, ForceRebuild(false)
+	, bOnlyOneFaceMaterial(false)
+	, bMaterialOverrideNeedsCreateInstance(false)
+	, DefaultMeshSmoothing(1)
+	, bTreatExistingMaterialsAsUpToDate(false)
+	, bPartHasTextureUVSets(false)
+	, bPartDataPrefetched(false)
+	, bPrefetchedVertexList(false)
+	, bPrefetchedSplits(false)
+	, bPartPositionsStreamed(false)
+{
+}
+
+bool
+FHoudiniMeshTranslator::PrefetchPartData(const bool& bInAssembleSplits)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::PrefetchPartData"));
+
+	bPrefetchedVertexList = UpdatePartVertexList();
+	bPrefetchedSplits = false;
+	if (bPrefetchedVertexList)
+	{
+		SortSplitGroups();
+		bPrefetchedSplits = UpdateSplitsFacesAndIndices();
+	}
+
+	ResetPartCache();
+	bPartDataPrefetched = true;
+
+	if (!bPrefetchedSplits)
+		return false;
+
+	// Everything the mesh creation reads from the part, the unused UV sets are removed later if needed.
+	// Huge positions are streamed by the mesh creation instead of being fetched whole.
+	if (!StreamPartPositionsIfNeeded())
+		UpdatePartPositionIfNeeded();
+	UpdatePartNormalsIfNeeded();
+	UpdatePartTangentsIfNeeded();
+	UpdatePartColorsIfNeeded();
+	UpdatePartAlphasIfNeeded();
+	UpdatePartFaceSmoothingIfNeeded();
+	UpdatePartUVSetsIfNeeded(false);
+	UpdatePartLightmapResolutionsIfNeeded();
+	UpdatePartLODScreensizeIfNeeded();
+	UpdatePartFaceMaterialIDsIfNeeded();
+	UpdatePartFaceMaterialOverridesIfNeeded();
+
+	if (!bInAssembleSplits)
+		return true;
+
+	// Assemble the geometry of the splits that will be turned into meshes,
+	// so that the game thread only has to copy it into their mesh descriptions.
+	for (const FString& SplitGroupName : AllSplitGroups)
+	{
+		EHoudiniSplitType SplitType = GetSplitTypeFromSplitName(SplitGroupName);
+		if (SplitType == EHoudiniSplitType::Invalid
+			|| SplitType == EHoudiniSplitType::InvisibleUCXCollider
+			|| SplitType == EHoudiniSplitType::InvisibleSimpleCollider)
+			continue;
+
+		FHoudiniMeshSplitData SplitData;
+		if (AssembleSplitMeshData(SplitGroupName, SplitData))
+			AllAssembledSplits.Add(SplitGroupName, MoveTemp(SplitData));
+	}
+
+	return true;
+}
+
+bool
+FHoudiniMeshTranslator::UpdatePartVertexListAndSplits(bool& bOutHasSplits)
+{
+	if (bPartDataPrefetched)
+	{
+		bOutHasSplits = bPrefetchedSplits;
+		return bPrefetchedVertexList;
+	}
+
+	bOutHasSplits = false;
+	if (!UpdatePartVertexList())
+		return false;
+
+	SortSplitGroups();
+
+	// Handles the split groups found in the part
+	// and builds the corresponding faces and indices arrays
+	if (!UpdateSplitsFacesAndIndices())
+		return true;
+
+	// Resets the containers used for the raw data extraction.
+	ResetPartCache();
+
+	bOutHasSplits = true;
+	return true;
+}
+
+bool
+FHoudiniMeshTranslator::AssembleSplitMeshData(const FString& InSplitGroupName, FHoudiniMeshSplitData& OutSplitData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::AssembleSplitMeshData"));
+
+	const TArray<int32>* FoundSplitVertexList = AllSplitVertexLists.Find(InSplitGroupName);
+	const int32* FoundSplitVertexCount = AllSplitVertexCounts.Find(InSplitGroupName);
+	if (!FoundSplitVertexList || !FoundSplitVertexCount)
+		return false;
+
+	const TArray<int32>& SplitVertexList = *FoundSplitVertexList;
+	const int32& SplitVertexCount = *FoundSplitVertexCount;
+	if (SplitVertexCount % 3 != 0 || SplitVertexList.Num() % 3 != 0)
+		return false;
+
+	//--------------------------------------------------------------------------------------------------------------------- 
+	//  INDICES
+	//--------------------------------------------------------------------------------------------------------------------- 
+
+	//
+	// Because of the splits, we don't need to declare all the vertices in the Part, 
+	// but only the one that are currently used by the split's faces.
+	// The indicesMapper array is used to map those indices from Part Vertices to Split Vertices.
+	// We also keep track of the needed vertices index to declare them easily afterwards.
+	//
+
+	// SplitNeededVertices
+	// Array containing the (unique) part indices for the vertices that are needed for this split
+	// SplitNeededVertices[splitIndex] = PartIndex
+	TArray<int32> SplitNeededVertices;
+
+	// IndicesMapper:
+	// Maps index values for all vertices in the Part:
+	// - Vertices unused by the split will be set to -1
+	// - Used vertices will have their value set to the "NewIndex" so that IndicesMapper[ partIndex ] => splitIndex
+	TArray<int32> PartToSplitIndicesMapper;
+	PartToSplitIndicesMapper.Init(-1, SplitVertexList.Num());
+
+	// SplitIndices
+	// Array of SplitIndices used to describe this split's polygons
+	TArray<uint32> SplitIndices;
+	SplitIndices.SetNumZeroed(SplitVertexCount);
+
+	int32 CurrentSplitIndex = 0;
+	int32 ValidVertexId = 0;
+	for (int32 VertexIdx = 0; VertexIdx < SplitVertexList.Num(); VertexIdx += 3)
+	{
+		int32 WedgeCheck = SplitVertexList[VertexIdx + 0];
+		if (WedgeCheck == -1)
+			continue;
+
+		int32 WedgeIndices[3] =
+		{
+			SplitVertexList[VertexIdx + 0],
+			SplitVertexList[VertexIdx + 1],
+			SplitVertexList[VertexIdx + 2]
+		};
+
+		// Ensure the indices are valid
+		if (!PartToSplitIndicesMapper.IsValidIndex(WedgeIndices[0])
+			|| !PartToSplitIndicesMapper.IsValidIndex(WedgeIndices[1])
+			|| !PartToSplitIndicesMapper.IsValidIndex(WedgeIndices[2]))
+		{
+			// Invalid face index.
+			HOUDINI_LOG_MESSAGE(
+				TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s], Split [%s] has some invalid face indices"),
+				HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName, *InSplitGroupName);
+			continue;
+		}
+
+		// Converting Old (Part) Indices to New (Split) Indices:
+		for (int32 i = 0; i < 3; i++)
+		{
+			if (PartToSplitIndicesMapper[WedgeIndices[i]] < 0)
+			{
+				// This part index has not yet been "converted" to a new split index
+				SplitNeededVertices.Add(WedgeIndices[i]);
+				PartToSplitIndicesMapper[WedgeIndices[i]] = CurrentSplitIndex;
+				CurrentSplitIndex++;
+			}
+
+			// Replace the old part index with the new split index
+			WedgeIndices[i] = PartToSplitIndicesMapper[WedgeIndices[i]];
+		}
+
+		if (!SplitIndices.IsValidIndex(ValidVertexId + 2))
+			break;
+
+		// Flip wedge indices to fix the winding order.
+		SplitIndices[ValidVertexId + 0] = WedgeIndices[0];
+		SplitIndices[ValidVertexId + 1] = WedgeIndices[2];
+		SplitIndices[ValidVertexId + 2] = WedgeIndices[1];
+
+		ValidVertexId += 3;
+	}
+
+	//--------------------------------------------------------------------------------------------------------------------- 
+	// POSITIONS
+	//--------------------------------------------------------------------------------------------------------------------- 
+
+	// Only the vertices needed by the split are declared, their IDs will match their split index
+	OutSplitData.Positions.SetNumZeroed(SplitNeededVertices.Num());
+
+	// Huge positions are streamed and converted directly into the split's positions
+	bool bPositionsStreamed = StreamPartPositionsIfNeeded() && TakeStreamedSplitPositions(InSplitGroupName, PartToSplitIndicesMapper,
+		[&OutSplitData](const int32& InSplitIndex, const FVector& InPosition)
+	{
+		OutSplitData.Positions[InSplitIndex] = InPosition;
+	});
+
+	if (!bPositionsStreamed)
+	{
+		// Extract position for this part
+		UpdatePartPositionIfNeeded();
+
+		// We need to swap Z and Y coordinate here, and convert from m to cm. 
+		if (FHoudiniDataConversion::HoudiniToUnrealPositions(PartPositions, 3, SplitNeededVertices, OutSplitData.Positions.GetData()) > 0)
+		{
+			// Error when retrieving positions.
+			HOUDINI_LOG_WARNING(
+				TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s], Split [%s] invalid position/index data."),
+				HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName, *InSplitGroupName);
+		}
+	}
+
+	//
+	// VERTEX INSTANCE ATTRIBUTES
+	// NORMALS, TANGENTS, COLORS, UVS, Alpha
+	//
+
+	// Extract the normals
+	UpdatePartNormalsIfNeeded();
+	// Get the normals for this split
+	TArray<float> SplitNormals;
+	FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
+		SplitVertexList, AttribInfoNormals, PartNormals, SplitNormals);
+
+	// Extract this part's Tangents if needed
+	UpdatePartTangentsIfNeeded();
+
+	// Get the Tangents for this split
+	TArray<float> SplitTangentU;
+	FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
+		SplitVertexList, AttribInfoTangentU, PartTangentU, SplitTangentU);
+
+	// Get the binormals for this split
+	TArray<float> SplitTangentV;
+	FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
+		SplitVertexList, AttribInfoTangentV, PartTangentV, SplitTangentV);
+
+	// We need to manually generate tangents if:
+	// - we have normals but dont have tangentu or tangentv attributes
+	// - we have not specified that we wanted unreal to generate them
+	int32 NormalCount = SplitNormals.Num();
+	bool bGenerateTangents = (NormalCount > 0) && (SplitTangentU.Num() <= 0 || SplitTangentV.Num() <= 0);
+	// Check that the number of tangents read matches the number of normals
+	if (SplitTangentU.Num() != NormalCount || SplitTangentV.Num() != NormalCount)
+		bGenerateTangents = true;
+
+	// Generate the tangents if needed
+	if (bGenerateTangents)
+	{
+		SplitTangentU.SetNumZeroed(NormalCount);
+		SplitTangentV.SetNumZeroed(NormalCount);
+		for (int32 Idx = 0; Idx + 2 < NormalCount; Idx += 3)
+		{
+			FVector TangentZ;
+			TangentZ.X = SplitNormals[Idx + 0];
+			TangentZ.Y = SplitNormals[Idx + 2];
+			TangentZ.Z = SplitNormals[Idx + 1];
+
+			FVector TangentX, TangentY;
+			TangentZ.FindBestAxisVectors(TangentX, TangentY);
+
+			SplitTangentU[Idx + 0] = TangentX.X;
+			SplitTangentU[Idx + 2] = TangentX.Y;
+			SplitTangentU[Idx + 1] = TangentX.Z;
+
+			SplitTangentV[Idx + 0] = TangentY.X;
+			SplitTangentV[Idx + 2] = TangentY.Y;
+			SplitTangentV[Idx + 1] = TangentY.Z;
+		}
+	}
+
+	// Extract the color values
+	UpdatePartColorsIfNeeded();
+	// Get the colors values for this split
+	TArray<float> SplitColors;
+	FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
+		SplitVertexList, AttribInfoColors, PartColors, SplitColors);
+
+	// Extract the alpha values
+	UpdatePartAlphasIfNeeded();
+	// Get the colors values for this split
+	TArray<float> SplitAlphas;
+	FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
+		SplitVertexList, AttribInfoAlpha, PartAlphas, SplitAlphas);
+
+	// Extract UVs
+	UpdatePartUVSetsIfNeeded(true);
+	// See if we need to transfer uv point attributes to vertex attributes.
+	int32 UVSetCount = PartUVSets.Num();
+	TArray<TArray<FVector2D>> SplitUVSets;
+	SplitUVSets.SetNum(UVSetCount);
+	for (int32 TexCoordIdx = 0; TexCoordIdx < UVSetCount; TexCoordIdx++)
+	{
+		TArray<float> SplitUVs;
+		FHoudiniMeshTranslator::TransferPartAttributesToSplit<float>(
+			SplitVertexList, AttribInfoUVSets[TexCoordIdx], PartUVSets[TexCoordIdx], SplitUVs);
+
+		// We need to flip V coordinate when it's coming from HAPI.
+		SplitUVSets[TexCoordIdx].SetNumUninitialized(SplitUVs.Num() / 2);
+		FHoudiniDataConversion::HoudiniToUnrealUVs(SplitUVs, SplitUVSets[TexCoordIdx].GetData());
+	}
+
+	bool bHasNormal = SplitNormals.Num() > 0;
+	bool bHasTangents = SplitTangentU.Num() > 0 && SplitTangentV.Num() > 0;
+	bool bHasRGB = SplitColors.Num() > 0;
+	bool bHasRGBA = bHasRGB && AttribInfoColors.tupleSize == 4;
+	bool bHasAlpha = SplitAlphas.Num() > 0;
+
+	//--------------------------------------------------------------------------------------------------------------------- 
+	// TRIANGLES
+	//--------------------------------------------------------------------------------------------------------------------- 
+
+	const int32 FaceCount = SplitIndices.Num() / 3;
+	const int32 MaxVertexInstanceCount = FaceCount * 3;
+	OutSplitData.TriangleVertices.Reset(MaxVertexInstanceCount);
+	OutSplitData.TriangleFaces.Reset(FaceCount);
+	if (bHasNormal)
+		OutSplitData.Normals.Reset(MaxVertexInstanceCount);
+	if (bHasTangents)
+	{
+		OutSplitData.Tangents.Reset(MaxVertexInstanceCount);
+		OutSplitData.BinormalSigns.Reset(MaxVertexInstanceCount);
+	}
+	OutSplitData.Colors.Reset(MaxVertexInstanceCount);
+	OutSplitData.UVSets.SetNum(UVSetCount);
+	for (TArray<FVector2D>& UVSet : OutSplitData.UVSets)
+		UVSet.Reset(MaxVertexInstanceCount);
+
+	for (int32 FaceIndex = 0; FaceIndex < FaceCount; FaceIndex++)
+	{
+		// Ignore degenerate triangles
+		const uint32* FaceVertices = &SplitIndices[FaceIndex * 3];
+		if (FaceVertices[0] == FaceVertices[1] || FaceVertices[0] == FaceVertices[2] || FaceVertices[1] == FaceVertices[2])
+			continue;
+
+		OutSplitData.TriangleFaces.Add(FaceIndex);
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			OutSplitData.TriangleVertices.Add(FaceVertices[Corner]);
+
+			// Fix the winding order by updating the SplitIndex (invert corner 1 and 2)
+			// instead of going 0 1 2 go 0 2 1
+			const int32 SplitIndex = FaceIndex * 3 + (Corner == 1 ? 2 : Corner == 2 ? 1 : 0);
+
+			const int32 SplitVertexIndex_X = SplitIndex * 3 + 0;
+			const int32 SplitVertexIndex_Y = SplitIndex * 3 + 2;
+			const int32 SplitVertexIndex_Z = SplitIndex * 3 + 1;
+
+			// Normals
+			// We need to swap Z and Y coordinate here
+			FVector Normal = FVector::ZeroVector;
+			if (bHasNormal)
+			{
+				Normal = FVector(SplitNormals[SplitVertexIndex_X], SplitNormals[SplitVertexIndex_Y], SplitNormals[SplitVertexIndex_Z]);
+				OutSplitData.Normals.Add(Normal);
+			}
+
+			// Tangents and binormals
+			if (bHasTangents)
+			{
+				const FVector TangentX(SplitTangentU[SplitVertexIndex_X], SplitTangentU[SplitVertexIndex_Y], SplitTangentU[SplitVertexIndex_Z]);
+				const FVector TangentY(SplitTangentV[SplitVertexIndex_X], SplitTangentV[SplitVertexIndex_Y], SplitTangentV[SplitVertexIndex_Z]);
+
+				OutSplitData.Tangents.Add(TangentX);
+				OutSplitData.BinormalSigns.Add(GetBasisDeterminantSign(
+					TangentX.GetSafeNormal(), TangentY.GetSafeNormal(), Normal.GetSafeNormal()));
+			}
+
+			// Color
+			FLinearColor Color = FLinearColor::White;
+			if (bHasRGB)
+			{
+				Color.R = FMath::Clamp(SplitColors[SplitIndex * AttribInfoColors.tupleSize + 0], 0.0f, 1.0f);
+				Color.G = FMath::Clamp(SplitColors[SplitIndex * AttribInfoColors.tupleSize + 1], 0.0f, 1.0f);
+				Color.B = FMath::Clamp(SplitColors[SplitIndex * AttribInfoColors.tupleSize + 2], 0.0f, 1.0f);
+			}
+			// Alpha
+			if (bHasAlpha)
+			{
+				Color.A = FMath::Clamp(SplitAlphas[SplitIndex], 0.0f, 1.0f);
+			}
+			else if (bHasRGBA)
+			{
+				Color.A = FMath::Clamp(SplitColors[SplitIndex * AttribInfoColors.tupleSize + 3], 0.0f, 1.0f);
+			}
+			OutSplitData.Colors.Add(FVector4(Color));
+
+			// UVs
+			for (int32 UVIndex = 0; UVIndex < UVSetCount; UVIndex++)
+			{
+				const TArray<FVector2D>& SplitUVs = SplitUVSets[UVIndex];
+				OutSplitData.UVSets[UVIndex].Add(SplitUVs.IsValidIndex(SplitIndex) ? SplitUVs[SplitIndex] : FVector2D::ZeroVector);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------------------------- 
+	//  FACE SMOOTHING
+	//---------------------------------------------------------------------------------------------------------------------
+
+	// Extract this part's FaceSmoothing values if needed
+	UpdatePartFaceSmoothingIfNeeded();
+
+	// Get the FaceSmoothing values for this split
+	TArray<int32> SplitFaceSmoothingMasks;
+	FHoudiniMeshTranslator::TransferPartAttributesToSplit<int32>(
+		SplitVertexList, AttribInfoFaceSmoothingMasks, PartFaceSmoothingMasks, SplitFaceSmoothingMasks);
+
+	// FaceSmoothing masks must be initialized even if we don't have a value from Houdini!
+	// TODO: Expose the default FaceSmoothing value
+	// 0 will make hard face
+	OutSplitData.FaceSmoothingMasks.Init(DefaultMeshSmoothing, SplitVertexCount / 3);
+
+	// Check that the number of face smoothing values we retrieved is correct
+	int32 WedgeFaceSmoothCount = SplitFaceSmoothingMasks.Num() / 3;
+	if (SplitFaceSmoothingMasks.Num() != 0 && !SplitFaceSmoothingMasks.IsValidIndex((WedgeFaceSmoothCount - 1) * 3 + 2))
+	{
+		// Ignore our face smoothing values
+		WedgeFaceSmoothCount = 0;
+		HOUDINI_LOG_WARNING(TEXT("Invalid face smoothing mask count detected - Skipping them."));
+	}
+
+	// Transfer the face smoothing masks if we have any
+	for (int32 WedgeFaceSmoothIdx = 0; WedgeFaceSmoothIdx < WedgeFaceSmoothCount; WedgeFaceSmoothIdx += 3)
+	{
+		OutSplitData.FaceSmoothingMasks[WedgeFaceSmoothIdx] = SplitFaceSmoothingMasks[WedgeFaceSmoothIdx * 3];
+	}
+
+	return true;
+}
+
 bool
 FHoudiniMeshTranslator::UpdatePartVertexList()
 {
@@ -616,6 +1087,7 @@ FHoudiniMeshTranslator::UpdateSplitsFacesAndIndices()
 	AllSplitFaceIndices.Empty();
 	AllSplitFirstValidVertexIndex.Empty();
 	AllSplitFirstValidPrimIndex.Empty();
+	AllAssembledSplits.Empty();
 
 	bool bHasSplit = AllSplitGroups.Num() > 0;
 	if (bHasSplit)
@@ -759,6 +1231,8 @@ FHoudiniMeshTranslator::ResetPartCache()
 	// Vertex Positions
 	PartPositions.Empty();
 	FHoudiniApi::AttributeInfo_Init(&AttribInfoPositions);
+	AllSplitStreamedPositions.Empty();
+	bPartPositionsStreamed = false;
 
 	// Vertex Normals
 	PartNormals.Empty();
@@ -787,6 +1261,7 @@ FHoudiniMeshTranslator::ResetPartCache()
 	// UVs
 	PartUVSets.Empty();
 	AttribInfoUVSets.Empty();
+	bPartHasTextureUVSets = false;
 
 	// UVs
 	PartLightMapResolutions.Empty();
@@ -835,6 +1310,154 @@ FHoudiniMeshTranslator::UpdatePartPositionIfNeeded()
 	return true;
 }
 
+bool
+FHoudiniMeshTranslator::ShouldStreamPartPositions(HAPI_AttributeInfo& OutAttribInfo)
+{
+	FHoudiniApi::AttributeInfo_Init(&OutAttribInfo);
+
+	// Reuse the positions if they have already been fetched
+	if (PartPositions.Num() > 0)
+		return false;
+
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	const int64 ThresholdBytes = HoudiniRuntimeSettings ? (int64)HoudiniRuntimeSettings->AttributeStreamingThresholdMb * 1024 * 1024 : 0;
+	if (ThresholdBytes <= 0)
+		return false;
+
+	if (!FHoudiniEngine::Get().GetAttributeCache().GetAttributeInfo(
+		HGPO.GeoInfo.NodeId, HGPO.PartInfo.PartId, HAPI_UNREAL_ATTRIB_POSITION, HAPI_ATTROWNER_POINT, OutAttribInfo))
+		return false;
+
+	if (!OutAttribInfo.exists || OutAttribInfo.tupleSize < 3)
+		return false;
+
+	return (int64)OutAttribInfo.count * OutAttribInfo.tupleSize * sizeof(float) > ThresholdBytes;
+}
+
+bool
+FHoudiniMeshTranslator::StreamPartPositionsIfNeeded()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::StreamPartPositionsIfNeeded"));
+
+	if (bPartPositionsStreamed)
+		return true;
+
+	// Number of points fetched per chunk
+	static const int32 PositionChunkSize = 1 << 20;
+
+	HAPI_AttributeInfo AttribInfo;
+	if (!ShouldStreamPartPositions(AttribInfo))
+		return false;
+
+	// Flag the points used by each split, and allocate their positions
+	const int32 PointCount = AttribInfo.count;
+	AllSplitStreamedPositions.Empty();
+	for (const FString& SplitGroupName : AllSplitGroups)
+	{
+		const TArray<int32>* SplitVertexList = AllSplitVertexLists.Find(SplitGroupName);
+		if (!SplitVertexList)
+			continue;
+
+		FHoudiniStreamedSplitPositions& SplitPositions = AllSplitStreamedPositions.Add(SplitGroupName);
+		SplitPositions.UsedPoints.Init(false, PointCount);
+
+		int32 UsedPointCount = 0;
+		for (const int32& PointIdx : *SplitVertexList)
+		{
+			if (PointIdx < 0 || PointIdx >= PointCount || SplitPositions.UsedPoints[PointIdx])
+				continue;
+
+			SplitPositions.UsedPoints[PointIdx] = true;
+			UsedPointCount++;
+		}
+
+		SplitPositions.Positions.SetNumZeroed(UsedPointCount);
+	}
+
+	TArray<FHoudiniStreamedSplitPositions*> StreamedSplits;
+	for (auto& Pair : AllSplitStreamedPositions)
+		StreamedSplits.Add(&Pair.Value);
+
+	// Index of the next position to write in each split's buffer
+	TArray<int32> NextPositionIndices;
+	NextPositionIndices.SetNumZeroed(StreamedSplits.Num());
+
+	const int32 TupleSize = AttribInfo.tupleSize;
+	TArray<FVector> ChunkPositions;
+	bool bSuccess = FHoudiniEngineUtils::HapiGetAttributeDataAsFloatChunked(
+		HGPO.GeoInfo.NodeId, HGPO.PartInfo.PartId, HAPI_UNREAL_ATTRIB_POSITION, AttribInfo, PositionChunkSize,
+		[&](const TArrayView<const float>& InChunk, const int32& InFirstPoint)
+	{
+		// Convert the whole chunk to Unreal's coordinate system, then scatter it into the splits
+		const int32 ChunkPointCount = InChunk.Num() / TupleSize;
+		ChunkPositions.SetNumUninitialized(ChunkPointCount, false);
+		FHoudiniDataConversion::HoudiniToUnrealPositions(InChunk, TupleSize, ChunkPositions.GetData());
+
+		const int32 EndPoint = FMath::Min(InFirstPoint + ChunkPointCount, PointCount);
+		for (int32 SplitIdx = 0; SplitIdx < StreamedSplits.Num(); SplitIdx++)
+		{
+			FHoudiniStreamedSplitPositions& SplitPositions = *StreamedSplits[SplitIdx];
+			int32& NextPositionIdx = NextPositionIndices[SplitIdx];
+			for (TConstSetBitIterator<> It(SplitPositions.UsedPoints, InFirstPoint); It && It.GetIndex() < EndPoint; ++It)
+				SplitPositions.Positions[NextPositionIdx++] = ChunkPositions[It.GetIndex() - InFirstPoint];
+		}
+	});
+
+	if (!bSuccess)
+	{
+		// The positions will be fetched whole instead
+		AllSplitStreamedPositions.Empty();
+		HOUDINI_LOG_WARNING(
+			TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s], unable to stream position data"),
+			HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName);
+		return false;
+	}
+
+	AttribInfoPositions = AttribInfo;
+	bPartPositionsStreamed = true;
+	return true;
+}
+
+bool
+FHoudiniMeshTranslator::TakeStreamedSplitPositions(
+	const FString& InSplitGroupName,
+	const TArray<int32>& InPartToSplitIndices,
+	TFunctionRef<void(const int32& InSplitIndex, const FVector& InPosition)> InSetPosition)
+{
+	FHoudiniStreamedSplitPositions* SplitPositions = AllSplitStreamedPositions.Find(InSplitGroupName);
+	if (!SplitPositions)
+		return false;
+
+	int32 PositionIdx = 0;
+	for (TConstSetBitIterator<> It(SplitPositions->UsedPoints); It; ++It, ++PositionIdx)
+	{
+		const int32 PointIdx = It.GetIndex();
+		if (InPartToSplitIndices.IsValidIndex(PointIdx) && InPartToSplitIndices[PointIdx] >= 0)
+			InSetPosition(InPartToSplitIndices[PointIdx], SplitPositions->Positions[PositionIdx]);
+	}
+
+	// A split is only translated once, if it were to be translated again its positions would be fetched whole
+	AllSplitStreamedPositions.Remove(InSplitGroupName);
+	return true;
+}
+
+bool
+FHoudiniMeshTranslator::TakeStreamedSplitPositions(
+	const FString& InSplitGroupName, TArray<int32>& OutPartPoints, TArray<FVector>& OutPositions)
+{
+	FHoudiniStreamedSplitPositions* SplitPositions = AllSplitStreamedPositions.Find(InSplitGroupName);
+	if (!SplitPositions)
+		return false;
+
+	OutPartPoints.Reset(SplitPositions->Positions.Num());
+	for (TConstSetBitIterator<> It(SplitPositions->UsedPoints); It; ++It)
+		OutPartPoints.Add(It.GetIndex());
+
+	OutPositions = MoveTemp(SplitPositions->Positions);
+	AllSplitStreamedPositions.Remove(InSplitGroupName);
+	return true;
+}
+
 bool
 FHoudiniMeshTranslator::UpdatePartNormalsIfNeeded()
 {
@@ -996,7 +1619,13 @@ FHoudiniMeshTranslator::UpdatePartUVSetsIfNeeded(const bool& bRemoveUnused)
 
 	// Only Retrieve uvs if necessary
 	if (PartUVSets.Num() > 0)
+	{
+		// The sets may have been fetched without removing the unused ones (see PrefetchPartData)
+		if (bRemoveUnused && bPartHasTextureUVSets)
+			RemoveUnusedPartUVSets();
+
 		return true;
+	}
 
 	PartUVSets.SetNum(MAX_STATIC_TEXCOORDS);
 	AttribInfoUVSets.SetNum(MAX_STATIC_TEXCOORDS);
@@ -1034,6 +1663,7 @@ FHoudiniMeshTranslator::UpdatePartUVSetsIfNeeded(const bool& bRemoveUnused)
 		return true;
 
 	// We found some additionnal uv attributes
+	bPartHasTextureUVSets = true;
 	int32 AvailableIdx = 0;
 	for (int32 attrIdx = 0; attrIdx < FoundAttributeInfos.Num(); attrIdx++)
 	{
@@ -1091,17 +1721,21 @@ FHoudiniMeshTranslator::UpdatePartUVSetsIfNeeded(const bool& bRemoveUnused)
 
 	// Remove unused UV sets
 	if (bRemoveUnused)
+		RemoveUnusedPartUVSets();
+
+	return true;
+}
+
+void
+FHoudiniMeshTranslator::RemoveUnusedPartUVSets()
+{
+	for (int32 Idx = PartUVSets.Num() - 1; Idx >= 0; Idx--)
 	{
-		for (int32 Idx = PartUVSets.Num() - 1; Idx >= 0; Idx--)
-		{
-			if (PartUVSets[Idx].Num() > 0)
-				continue;
+		if (PartUVSets[Idx].Num() > 0)
+			continue;
 
-			PartUVSets.RemoveAt(Idx);
-		}
+		PartUVSets.RemoveAt(Idx);
 	}
-
-	return true;
 }
 
 bool
@@ -1343,21 +1977,15 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 {
 	double time_start = FPlatformTime::Seconds();
 
-	// Start by updating the vertex list
-	if (!UpdatePartVertexList())
+	// Start by updating the vertex list and the split groups' faces and indices
+	// (unless they were prefetched with the rest of the part's data)
+	bool bHasSplits = false;
+	if (!UpdatePartVertexListAndSplits(bHasSplits))
 		return false;
 
-	// Sort the split groups
-	SortSplitGroups();
-
-	// Handles the split groups found in the part
-	// and builds the corresponding faces and indices arrays
-	if (!UpdateSplitsFacesAndIndices())
+	if (!bHasSplits)
 		return true;
 
-	// Resets the containers used for the raw data extraction.
-	ResetPartCache();
-
 	// Prepare the object that will store UCX and simple colliders
 	AllAggregateCollisions.Empty();
 
@@ -1456,8 +2084,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 		// Handle UCX / Convex Hull colliders
 		if (SplitType == EHoudiniSplitType::InvisibleUCXCollider || SplitType == EHoudiniSplitType::RenderedUCXCollider)
 		{
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
+			// Get the part position if needed, huge positions are streamed instead
+			if (!StreamPartPositionsIfNeeded())
+				UpdatePartPositionIfNeeded();
 
 			// Create the convex hull colliders and add them to the Aggregate
 			if (!AddConvexCollisionToAggregate(SplitGroupName, AggregateCollisions))
@@ -1474,8 +2103,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 		}
 		else if (SplitType == EHoudiniSplitType::InvisibleSimpleCollider || SplitType == EHoudiniSplitType::RenderedSimpleCollider)
 		{
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
+			// Get the part position if needed, huge positions are streamed instead
+			if (!StreamPartPositionsIfNeeded())
+				UpdatePartPositionIfNeeded();
 
 			// Create the simple colliders and add them to the aggregate
 			if (!AddSimpleCollisionToAggregate(SplitGroupName, AggregateCollisions))
@@ -1634,14 +2264,10 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 			}
 
 			// Transfer the normals to the raw mesh 
-			RawMesh.WedgeTangentZ.SetNumZeroed(WedgeNormalCount);
-			for (int32 WedgeTangentZIdx = 0; WedgeTangentZIdx < WedgeNormalCount; ++WedgeTangentZIdx)
-			{
-				// Swap Y/Z for Coordinates conversion
-				RawMesh.WedgeTangentZ[WedgeTangentZIdx].X = SplitNormals[WedgeTangentZIdx * 3 + 0];
-				RawMesh.WedgeTangentZ[WedgeTangentZIdx].Y = SplitNormals[WedgeTangentZIdx * 3 + 2];
-				RawMesh.WedgeTangentZ[WedgeTangentZIdx].Z = SplitNormals[WedgeTangentZIdx * 3 + 1];
-			}
+			// Swap Y/Z for Coordinates conversion
+			RawMesh.WedgeTangentZ.SetNumUninitialized(WedgeNormalCount);
+			FHoudiniDataConversion::HoudiniToUnrealVectors(
+				TArrayView<const float>(SplitNormals.GetData(), WedgeNormalCount * 3), 3, RawMesh.WedgeTangentZ.GetData());
 
 
 			//--------------------------------------------------------------------------------------------------------------------- 
@@ -1704,23 +2330,14 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 				else
 				{
 					// Transfer the tangents we have read them and they're valid
-					RawMesh.WedgeTangentX.SetNumZeroed(WedgeTangentUCount);
-					for (int32 WedgeTangentUIdx = 0; WedgeTangentUIdx < WedgeTangentUCount; ++WedgeTangentUIdx)
-					{
-						// We need to flip Z and Y
-						RawMesh.WedgeTangentX[WedgeTangentUIdx].X = SplitTangentU[WedgeTangentUIdx * 3 + 0];
-						RawMesh.WedgeTangentX[WedgeTangentUIdx].Y = SplitTangentU[WedgeTangentUIdx * 3 + 2];
-						RawMesh.WedgeTangentX[WedgeTangentUIdx].Z = SplitTangentU[WedgeTangentUIdx * 3 + 1];
-					}
-
-					RawMesh.WedgeTangentY.SetNumZeroed(WedgeTangentVCount);
-					for (int32 WedgeTangentVIdx = 0; WedgeTangentVIdx < WedgeTangentVCount; ++WedgeTangentVIdx)
-					{
-						// We need to flip Z and Y
-						RawMesh.WedgeTangentY[WedgeTangentVIdx].X = SplitTangentV[WedgeTangentVIdx * 3 + 0];
-						RawMesh.WedgeTangentY[WedgeTangentVIdx].Y = SplitTangentV[WedgeTangentVIdx * 3 + 2];
-						RawMesh.WedgeTangentY[WedgeTangentVIdx].Z = SplitTangentV[WedgeTangentVIdx * 3 + 1];
-					}
+					// We need to flip Z and Y
+					RawMesh.WedgeTangentX.SetNumUninitialized(WedgeTangentUCount);
+					FHoudiniDataConversion::HoudiniToUnrealVectors(
+						TArrayView<const float>(SplitTangentU.GetData(), WedgeTangentUCount * 3), 3, RawMesh.WedgeTangentX.GetData());
+
+					RawMesh.WedgeTangentY.SetNumUninitialized(WedgeTangentVCount);
+					FHoudiniDataConversion::HoudiniToUnrealVectors(
+						TArrayView<const float>(SplitTangentV.GetData(), WedgeTangentVCount * 3), 3, RawMesh.WedgeTangentY.GetData());
 				}
 			}
 
@@ -1847,13 +2464,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 				int32 WedgeUVCount = SplitUVs.Num() / 2;
 				if (SplitUVs.Num() > 0 && SplitUVs.IsValidIndex((WedgeUVCount - 1) * 2 + 1))
 				{
-					RawMesh.WedgeTexCoords[TexCoordIdx].SetNumZeroed(WedgeUVCount);
-					for (int32 WedgeUVIdx = 0; WedgeUVIdx < WedgeUVCount; ++WedgeUVIdx)
-					{
-						// We need to flip V coordinate when it's coming from HAPI.
-						RawMesh.WedgeTexCoords[TexCoordIdx][WedgeUVIdx].X = SplitUVs[WedgeUVIdx * 2 + 0];
-						RawMesh.WedgeTexCoords[TexCoordIdx][WedgeUVIdx].Y = 1.0f - SplitUVs[WedgeUVIdx * 2 + 1];
-					}
+					// We need to flip V coordinate when it's coming from HAPI.
+					RawMesh.WedgeTexCoords[TexCoordIdx].SetNumUninitialized(WedgeUVCount);
+					FHoudiniDataConversion::HoudiniToUnrealUVs(SplitUVs, RawMesh.WedgeTexCoords[TexCoordIdx].GetData());
 
 					UVChannelCount++;
 					if (UVChannelCount <= 2)
@@ -1989,8 +2602,6 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 			//--------------------------------------------------------------------------------------------------------------------- 
 			// POSITIONS
 			//--------------------------------------------------------------------------------------------------------------------- 
-			UpdatePartPositionIfNeeded();
-
 			//
 			// Transfer vertex positions:
 			//
@@ -2001,24 +2612,26 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 			int32 VertexPositionsCount = NeededVertices.Num();
 			RawMesh.VertexPositions.SetNumZeroed(VertexPositionsCount);
 
-			for (int32 VertexPositionIdx = 0; VertexPositionIdx < VertexPositionsCount; ++VertexPositionIdx)
+			// Huge positions are streamed and converted directly into the mesh
+			bool bPositionsStreamed = StreamPartPositionsIfNeeded() && TakeStreamedSplitPositions(SplitGroupName, IndicesMapper,
+				[&RawMesh](const int32& InSplitIndex, const FVector& InPosition)
+			{
+				RawMesh.VertexPositions[InSplitIndex] = InPosition;
+			});
+
+			if (!bPositionsStreamed)
 			{
-				int32 NeededVertexIndex = NeededVertices[VertexPositionIdx];
-				if (!PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
+				UpdatePartPositionIfNeeded();
+
+				// We need to swap Z and Y coordinate here, and convert from m to cm. 
+				if (FHoudiniDataConversion::HoudiniToUnrealPositions(PartPositions, 3, NeededVertices, RawMesh.VertexPositions.GetData()) > 0)
 				{
 					// Error retrieving positions.
 					HOUDINI_LOG_WARNING(
 						TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s], Split [%d %s] invalid position/index data ")
 						TEXT("- skipping."),
 						HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName, SplitId, *SplitGroupName);
-
-					continue;
 				}
-
-				// We need to swap Z and Y coordinate here, and convert from m to cm. 
-				RawMesh.VertexPositions[VertexPositionIdx].X = PartPositions[NeededVertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-				RawMesh.VertexPositions[VertexPositionIdx].Y = PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-				RawMesh.VertexPositions[VertexPositionIdx].Z = PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
 			}
 
 			/*
@@ -2453,7 +3066,10 @@ FHoudiniMeshTranslator::CreateStaticMesh_RawMesh()
 		// bSilent doesnt add the Build Errors...
 		double build_start = FPlatformTime::Seconds();
 		TArray<FText> SMBuildErrors;
-		SM->Build(true, &SMBuildErrors);
+		{
+			FHoudiniCookPhaseScope BuildPhaseScope(EHoudiniCookPhase::BuildStaticMeshes);
+			SM->Build(true, &SMBuildErrors);
+		}
 		double build_end = FPlatformTime::Seconds();
 		HOUDINI_LOG_MESSAGE(TEXT("StaticMesh->Build() executed in %f seconds."), build_end - build_start);
 
@@ -2520,22 +3136,15 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 {
 	double time_start = FPlatformTime::Seconds();
 
-	// Start by updating the vertex list
-	if (!UpdatePartVertexList())
+	// Start by updating the vertex list and the split groups' faces and indices
+	// (unless they were prefetched with the rest of the part's data)
+	bool bHasSplits = false;
+	if (!UpdatePartVertexListAndSplits(bHasSplits))
 		return false;
 
-	// Sort the split groups
-	// Simple colliders first, lods and finally, invisible colliders (that are separate Static Mesh)
-	SortSplitGroups();
-
-	// Handles the split groups found in the part
-	// and builds the corresponding faces and indices arrays
-	if (!UpdateSplitsFacesAndIndices())
+	if (!bHasSplits)
 		return true;
 
-	// Resets the containers used for the raw data extraction.
-	ResetPartCache();
-
 	// Prepare the object that will store UCX and simple colliders
 	AllAggregateCollisions.Empty();
 
@@ -2639,8 +3248,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 		// Handle UCX / Convex Hull colliders
 		if (SplitType == EHoudiniSplitType::InvisibleUCXCollider || SplitType == EHoudiniSplitType::RenderedUCXCollider)
 		{
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
+			// Get the part position if needed, huge positions are streamed instead
+			if (!StreamPartPositionsIfNeeded())
+				UpdatePartPositionIfNeeded();
 
 			// Create the convex hull colliders and add them to the Aggregate
 			if (!AddConvexCollisionToAggregate(SplitGroupName, AggregateCollisions))
@@ -2657,8 +3267,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 		}
 		else if (SplitType == EHoudiniSplitType::InvisibleSimpleCollider || SplitType == EHoudiniSplitType::RenderedSimpleCollider)
 		{
-			// Get the part position if needed
-			UpdatePartPositionIfNeeded();
+			// Get the part position if needed, huge positions are streamed instead
+			if (!StreamPartPositionsIfNeeded())
+				UpdatePartPositionIfNeeded();
 
 			// Create the simple colliders and add them to the aggregate
 			if (!AddSimpleCollisionToAggregate(SplitGroupName, AggregateCollisions))
@@ -2806,136 +3417,32 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 			MeshDescription = FoundStaticMesh->CreateMeshDescription(LODIndex);
 			FStaticMeshAttributes(*MeshDescription).Register();
 
-			// Mesh description uses material to create its PolygonGroups,
-			// so we first need to know how many different materials we have for this split
-			// and what vertices/indices belong to each material for remapping
-
-			//--------------------------------------------------------------------------------------------------------------------- 
-			//  INDICES
-			//--------------------------------------------------------------------------------------------------------------------- 
-
-			//
-			// Because of the splits, we don't need to declare all the vertices in the Part, 
-			// but only the one that are currently used by the split's faces.
-			// The indicesMapper array is used to map those indices from Part Vertices to Split Vertices.
-			// We also keep track of the needed vertices index to declare them easily afterwards.
-			//
-
-			// SplitNeededVertices
-			// Array containing the (unique) part indices for the vertices that are needed for this split
-			// SplitNeededVertices[splitIndex] = PartIndex
-			TArray<int32> SplitNeededVertices;
-			//SplitNeededVertices.SetNumZeroed(SplitVertexCount);
-
-			// IndicesMapper:
-			// Maps index values for all vertices in the Part:
-			// - Vertices unused by the split will be set to -1
-			// - Used vertices will have their value set to the "NewIndex" so that IndicesMapper[ partIndex ] => splitIndex
-			TArray<int32> PartToSplitIndicesMapper;
-			PartToSplitIndicesMapper.Init(-1, SplitVertexList.Num());
-			//TMap<int32, int32> SplitToPartIndicesMapper;
-
-			// SplitIndices
-			// Array of SplitIndices used to describe this split's polygons
-			TArray<uint32> SplitIndices;
-			SplitIndices.SetNumZeroed(SplitVertexCount);
-
-			int32 CurrentSplitIndex = 0;
-			int32 ValidVertexId = 0;
-			for (int32 VertexIdx = 0; VertexIdx < SplitVertexList.Num(); VertexIdx += 3)
+			// Get the geometry assembled for this split by the prefetch worker,
+			// or assemble it now if the part's data wasn't prefetched
+			FHoudiniMeshSplitData LocalSplitData;
+			const FHoudiniMeshSplitData* SplitData = AllAssembledSplits.Find(SplitGroupName);
+			if (!SplitData)
 			{
-				int32 WedgeCheck = SplitVertexList[VertexIdx + 0];
-				if (WedgeCheck == -1)
-					continue;
-
-				int32 WedgeIndices[3] =
-				{
-					SplitVertexList[VertexIdx + 0],
-					SplitVertexList[VertexIdx + 1],
-					SplitVertexList[VertexIdx + 2]
-				};
-
-				// Ensure the indices are valid
-				if (!PartToSplitIndicesMapper.IsValidIndex(WedgeIndices[0])
-					|| !PartToSplitIndicesMapper.IsValidIndex(WedgeIndices[1])
-					|| !PartToSplitIndicesMapper.IsValidIndex(WedgeIndices[2]))
-				{
-					// Invalid face index.
-					HOUDINI_LOG_MESSAGE(
-						TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s], Split [%d %s] has some invalid face indices"),
-						HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName, SplitId, *SplitGroupName);
-					continue;
-				}
-
-				// Converting Old (Part) Indices to New (Split) Indices:
-				for (int32 i = 0; i < 3; i++)
-				{
-					if (PartToSplitIndicesMapper[WedgeIndices[i]] < 0)
-					{
-						// This part index has not yet been "converted" to a new split index
-						SplitNeededVertices.Add(WedgeIndices[i]);
-						PartToSplitIndicesMapper[WedgeIndices[i]] = CurrentSplitIndex;
-						//SplitToPartIndicesMapper.Add(CurrentSplitIndex, WedgeIndices[i]);
-						CurrentSplitIndex++;
-					}
-
-					// Replace the old part index with the new split index
-					WedgeIndices[i] = PartToSplitIndicesMapper[WedgeIndices[i]];
-				}
-
-				if (!SplitIndices.IsValidIndex(ValidVertexId + 2))
-					break;
-
-				// Flip wedge indices to fix the winding order.
-				SplitIndices[ValidVertexId + 0] = WedgeIndices[0];
-				SplitIndices[ValidVertexId + 1] = WedgeIndices[2];
-				SplitIndices[ValidVertexId + 2] = WedgeIndices[1];
-
-				ValidVertexId += 3;
+				AssembleSplitMeshData(SplitGroupName, LocalSplitData);
+				SplitData = &LocalSplitData;
 			}
-			
-			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - Indices in %f seconds."), FPlatformTime::Seconds() - tick);
+
+			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - Split geometry assembled in %f seconds."), FPlatformTime::Seconds() - tick);
 			tick = FPlatformTime::Seconds();
 
 			//--------------------------------------------------------------------------------------------------------------------- 
 			// POSITIONS
-			//--------------------------------------------------------------------------------------------------------------------- 			
-			
-			// Extract position for this part
-			UpdatePartPositionIfNeeded();
-
-			// Transfer vertex positions:
-			//
-			// Because of the split, we're only interested in the needed vertices.
-			// Instead of declaring all the Positions, we'll only declare the vertices
-			// needed by the current split.
-			//
+			//--------------------------------------------------------------------------------------------------------------------- 			
+			
+			// Only the vertices needed by the split are declared, their IDs match their split index
 			TVertexAttributesRef<FVector> VertexPositions =
 				MeshDescription->VertexAttributes().GetAttributesRef<FVector>(MeshAttribute::Vertex::Position);
 				
-			MeshDescription->ReserveNewVertices(SplitNeededVertices.Num());
-			for ( const int32& NeededVertexIndex : SplitNeededVertices)
-			{
-				// Create a new Vertex
-				FVertexID VertexID = MeshDescription->CreateVertex();
-				if (PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
-				{
-					// We need to swap Z and Y coordinate here, and convert from m to cm. 
-					VertexPositions[VertexID].X = PartPositions[NeededVertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-					VertexPositions[VertexID].Y = PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-					VertexPositions[VertexID].Z = PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-				}
-				else
-				{
-					// Error when retrieving positions.
-					HOUDINI_LOG_WARNING(
-						TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s], Split [%d %s] invalid position/index data ")
-						TEXT("- skipping."),
-						HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName, SplitId, *SplitGroupName);
+			MeshDescription->ReserveNewVertices(SplitData->Positions.Num());
+			for (int32 SplitIdx = 0; SplitIdx < SplitData->Positions.Num(); SplitIdx++)
+				MeshDescription->CreateVertex();
 
-					continue;
-				}
-			}
+			CopySplitDataToRawArray(SplitData->Positions, VertexPositions.GetRawArray());
 
 			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - Positions in %f seconds."), FPlatformTime::Seconds() - tick);
 			tick = FPlatformTime::Seconds();
@@ -3181,233 +3688,45 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 			// NORMALS, TANGENTS, COLORS, UVS, Alpha
 			//
 
-			// Extract the normals
-			UpdatePartNormalsIfNeeded();
-			// Get the normals for this split
-			TArray<float> SplitNormals;
-			FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
-				SplitVertexList, AttribInfoNormals, PartNormals, SplitNormals);
-
-			TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Normal);
-
-			// Extract the tangents
-			// No need to read the tangents if we want unreal to recompute them after
-			TArray<float> SplitTangentU;
-			TArray<float> SplitTangentV;
-			bool bReadTangents = true;
-			// TODO: Add runtime setting check!
-			//bool bReadTangents = HoudiniRuntimeSettings->RecomputeTangentsFlag != EHoudiniRuntimeSettingsRecomputeFlag::HRSRF_Always;			
-			if (bReadTangents)
-			{
-				// Extract this part's Tangents if needed
-				UpdatePartTangentsIfNeeded();
-
-				// Get the Tangents for this split				
-				FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
-					SplitVertexList, AttribInfoTangentU, PartTangentU, SplitTangentU);
-
-				// Get the binormals for this split				
-				FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
-					SplitVertexList, AttribInfoTangentV, PartTangentV, SplitTangentV);
-
-				// We need to manually generate tangents if:
-				// - we have normals but dont have tangentu or tangentv attributes
-				// - we have not specified that we wanted unreal to generate them
-				int32 NormalCount = SplitNormals.Num();
-				bool bGenerateTangents = (NormalCount > 0) && (SplitTangentU.Num() <= 0 || SplitTangentV.Num() <= 0);
-				// Check that the number of tangents read matches the number of normals
-				if (SplitTangentU.Num() != NormalCount || SplitTangentV.Num() != NormalCount)
-					bGenerateTangents = true;
-
-				/*
-				// TODO: Add settings check!
-				if (bGenerateTangents && (HoudiniRuntimeSettings->RecomputeTangentsFlag == EHoudiniRuntimeSettingsRecomputeFlag::HRSRF_Always))
-				{
-					// No need to generate tangents if we want unreal to recompute them after
-					bGenerateTangents = false;
-				}
-				*/
-
-				// Generate the tangents if needed
-				if (bGenerateTangents)
-				{
-					SplitTangentU.SetNumZeroed(NormalCount);
-					SplitTangentV.SetNumZeroed(NormalCount);
-					for (int32 Idx = 0; Idx + 2 < NormalCount; Idx += 3)
-					{
-						FVector TangentZ;
-						TangentZ.X = SplitNormals[Idx + 0];
-						TangentZ.Y = SplitNormals[Idx + 2];
-						TangentZ.Z = SplitNormals[Idx + 1];
-
-						FVector TangentX, TangentY;
-						TangentZ.FindBestAxisVectors(TangentX, TangentY);
+			// The vertex instances are created in the order of the assembled triangles' corners,
+			// so their attributes can be copied straight into the raw attribute arrays.
+			const int32 VertexInstanceCount = SplitData->TriangleVertices.Num();
+			MeshDescription->ReserveNewVertexInstances(VertexInstanceCount);
+			MeshDescription->ReserveNewPolygons(VertexInstanceCount / 3);
+			//Approximately 2.5 edges per polygons
+			MeshDescription->ReserveNewEdges(VertexInstanceCount * 2.5f / 3);
 
-						SplitTangentU[Idx + 0] = TangentX.X;
-						SplitTangentU[Idx + 2] = TangentX.Y;
-						SplitTangentU[Idx + 1] = TangentX.Z;
+			for (int32 VertexInstanceIdx = 0; VertexInstanceIdx < VertexInstanceCount; VertexInstanceIdx++)
+				MeshDescription->CreateVertexInstance(FVertexID(SplitData->TriangleVertices[VertexInstanceIdx]));
 
-						SplitTangentV[Idx + 0] = TangentY.X;
-						SplitTangentV[Idx + 2] = TangentY.Y;
-						SplitTangentV[Idx + 1] = TangentY.Z;
-					}
-				}
-			}
+			TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Normal);
 			TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Tangent);
 			TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = MeshDescription->VertexInstanceAttributes().GetAttributesRef<float>(MeshAttribute::VertexInstance::BinormalSign);
-
-			// Extract the color values
-			UpdatePartColorsIfNeeded();
-			// Get the colors values for this split
-			TArray<float> SplitColors;
-			FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
-				SplitVertexList, AttribInfoColors, PartColors, SplitColors);
-
-			// Extract the alpha values
-			UpdatePartAlphasIfNeeded();
-			// Get the colors values for this split
-			TArray<float> SplitAlphas;
-			FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
-				SplitVertexList, AttribInfoAlpha, PartAlphas, SplitAlphas);
 			TVertexInstanceAttributesRef<FVector4> VertexInstanceColors = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector4>(MeshAttribute::VertexInstance::Color);
-
-			// Extract UVs
-			UpdatePartUVSetsIfNeeded(true);
-			// See if we need to transfer uv point attributes to vertex attributes.
-			int32 UVSetCount = PartUVSets.Num();
-			TArray<TArray<float>> SplitUVSets;
-			SplitUVSets.SetNum(UVSetCount);
-			for (int32 TexCoordIdx = 0; TexCoordIdx < UVSetCount; TexCoordIdx++)
-			{
-				FHoudiniMeshTranslator::TransferPartAttributesToSplit<float>(
-					SplitVertexList, AttribInfoUVSets[TexCoordIdx], PartUVSets[TexCoordIdx], SplitUVSets[TexCoordIdx]);
-			}
-			TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector2D>(MeshAttribute::VertexInstance::TextureCoordinate);					
-			VertexInstanceUVs.SetNumIndices(UVSetCount);
-
-			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - VertexAttr extracted in %f seconds."), FPlatformTime::Seconds() - tick);
-			tick = FPlatformTime::Seconds();
-
-			// Allocate space for the vertex instances and polygons
-			MeshDescription->ReserveNewVertexInstances(SplitIndices.Num());
-			MeshDescription->ReserveNewPolygons(SplitIndices.Num() / 3);
-			//Approximately 2.5 edges per polygons
-			MeshDescription->ReserveNewEdges(SplitIndices.Num() * 2.5f / 3);
-
-			bool bHasNormal = SplitNormals.Num() > 0;
-			bool bHasTangents = SplitTangentU.Num() > 0 && SplitTangentV.Num() > 0;
-			bool bHasRGB = SplitColors.Num() > 0;
-			bool bHasRGBA = bHasRGB && AttribInfoColors.tupleSize == 4;
-			bool bHasAlpha = SplitAlphas.Num() > 0;
-
-			bRecomputeNormal = !bHasNormal;
-			bRecomputeTangent = !bHasTangents;
-
-			TArray<bool> HasUVSets;
-			HasUVSets.SetNumZeroed(PartUVSets.Num());
-			for (int32 Idx = 0; Idx < PartUVSets.Num(); Idx++)
-				HasUVSets[Idx] = PartUVSets.Num() > 0;
-
-			uint32 FaceCount = SplitIndices.Num() / 3;
-			for (uint32 FaceIndex = 0; FaceIndex < FaceCount; FaceIndex++)
+			TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector2D>(MeshAttribute::VertexInstance::TextureCoordinate);
+			VertexInstanceUVs.SetNumIndices(SplitData->UVSets.Num());
+
+			CopySplitDataToRawArray(SplitData->Normals, VertexInstanceNormals.GetRawArray());
+			CopySplitDataToRawArray(SplitData->Tangents, VertexInstanceTangents.GetRawArray());
+			CopySplitDataToRawArray(SplitData->BinormalSigns, VertexInstanceBinormalSigns.GetRawArray());
+			CopySplitDataToRawArray(SplitData->Colors, VertexInstanceColors.GetRawArray());
+			for (int32 UVIndex = 0; UVIndex < SplitData->UVSets.Num(); UVIndex++)
+				CopySplitDataToRawArray(SplitData->UVSets[UVIndex], VertexInstanceUVs.GetRawArray(UVIndex));
+
+			bRecomputeNormal = SplitData->Normals.Num() <= 0;
+			bRecomputeTangent = SplitData->Tangents.Num() <= 0;
+
+			// Insert the triangles into the mesh
+			TArray<FVertexInstanceID> FaceVertexInstanceIDs;
+			FaceVertexInstanceIDs.SetNum(3);
+			for (int32 TriangleIdx = 0; TriangleIdx < SplitData->TriangleFaces.Num(); TriangleIdx++)
 			{
-				TArray<FVertexInstanceID> FaceVertexInstanceIDs;
-				FaceVertexInstanceIDs.SetNum(3);
-
-				// Ignore degenerate triangles
-				FVertexID VertexIDs[3];
-				for (int32 Corner = 0; Corner < 3; ++Corner)
-				{
-					VertexIDs[Corner] = FVertexID(SplitIndices[(FaceIndex * 3) + Corner]);
-				}
-				if (VertexIDs[0] == VertexIDs[1] || VertexIDs[0] == VertexIDs[2] || VertexIDs[1] == VertexIDs[2])
-					continue;
-
-				//FVertexID FaceVertexIDs[3];
 				for (int32 Corner = 0; Corner < 3; Corner++)
-				{
-					uint32 SplitIndex = (FaceIndex * 3) + Corner;
-					uint32 SplitVertexIndex = SplitIndices[SplitIndex];
-					const FVertexInstanceID& VertexInstanceID = MeshDescription->CreateVertexInstance(FVertexID(SplitVertexIndex));
-
-					// Fix the winding order by updating the SplitIndex (invert corner 1 and 2)
-					// instead of going 0 1 2 go 0 2 1
-					// TODO; this slows down StaticMesh->Build() considerably!
-					Corner == 1 ? SplitIndex++ : Corner == 2 ? SplitIndex-- : SplitIndex;
-
-					const uint32 SplitVertexIndex_X = SplitIndex * 3 + 0;
-					const uint32 SplitVertexIndex_Y = SplitIndex * 3 + 2;
-					const uint32 SplitVertexIndex_Z = SplitIndex * 3 + 1;
-					// Normals
-					if (bHasNormal)
-					{
-						// We need to swap Z and Y coordinate here, and convert from m to cm. 
-						VertexInstanceNormals[VertexInstanceID].X = SplitNormals[SplitVertexIndex_X];
-						VertexInstanceNormals[VertexInstanceID].Y = SplitNormals[SplitVertexIndex_Y];
-						VertexInstanceNormals[VertexInstanceID].Z = SplitNormals[SplitVertexIndex_Z];
-					}
-
-					// Tangents and binormals
-					if (bHasTangents)
-					{
-						// We need to swap Z and Y coordinate here, and convert from m to cm.
-						VertexInstanceTangents[VertexInstanceID].X = SplitTangentU[SplitVertexIndex_X];
-						VertexInstanceTangents[VertexInstanceID].Y = SplitTangentU[SplitVertexIndex_Y];
-						VertexInstanceTangents[VertexInstanceID].Z = SplitTangentU[SplitVertexIndex_Z];
-
-						FVector TangentY;
-						TangentY.X = SplitTangentV[SplitVertexIndex_X];
-						TangentY.Y = SplitTangentV[SplitVertexIndex_Y];
-						TangentY.Z = SplitTangentV[SplitVertexIndex_Z];
-
-						VertexInstanceBinormalSigns[VertexInstanceID] = GetBasisDeterminantSign(
-							VertexInstanceTangents[VertexInstanceID].GetSafeNormal(),
-							TangentY.GetSafeNormal(),
-							VertexInstanceNormals[VertexInstanceID].GetSafeNormal());
-					}
-
-					// Color
-					FLinearColor Color = FLinearColor::White;
-					if (bHasRGB)
-					{
-						Color.R = FMath::Clamp(
-							SplitColors[SplitIndex * AttribInfoColors.tupleSize + 0], 0.0f, 1.0f);
-						Color.G = FMath::Clamp(
-							SplitColors[SplitIndex * AttribInfoColors.tupleSize + 1], 0.0f, 1.0f);
-						Color.B = FMath::Clamp(
-							SplitColors[SplitIndex * AttribInfoColors.tupleSize + 2], 0.0f, 1.0f);
-					}
-					// Alpha
-					if (bHasAlpha)
-					{
-						Color.A = FMath::Clamp(SplitAlphas[SplitIndex], 0.0f, 1.0f);
-					}
-					else if (bHasRGBA)
-					{
-						Color.A = FMath::Clamp(SplitColors[SplitIndex * AttribInfoColors.tupleSize + 3], 0.0f, 1.0f);
-					}
-					VertexInstanceColors[VertexInstanceID] = FVector4(Color);
-
-					// UVs
-					for (int32 UVIndex = 0; UVIndex < SplitUVSets.Num(); UVIndex++)
-					{
-						if (HasUVSets[UVIndex])
-						{
-							// We need to flip V coordinate when it's coming from HAPI.
-							FVector2D CurrentUV;
-							CurrentUV.X = SplitUVSets[UVIndex][SplitIndex * 2 + 0];
-							CurrentUV.Y = 1.0f - SplitUVSets[UVIndex][SplitIndex * 2 + 1];
-
-							VertexInstanceUVs.Set(VertexInstanceID, UVIndex, CurrentUV);
-						}
-					}
-
-					FaceVertexInstanceIDs[Corner] = VertexInstanceID;
-				}
+					FaceVertexInstanceIDs[Corner] = FVertexInstanceID(TriangleIdx * 3 + Corner);
 
-				const FPolygonGroupID PolygonGroupID(SplitFaceMaterialIndices[FaceIndex]);
+				const int32& FaceIndex = SplitData->TriangleFaces[TriangleIdx];
+				const FPolygonGroupID PolygonGroupID(SplitFaceMaterialIndices.IsValidIndex(FaceIndex) ? SplitFaceMaterialIndices[FaceIndex] : 0);
 
-				// Insert a triangle into the mesh
 				MeshDescription->CreateTriangle(PolygonGroupID, FaceVertexInstanceIDs);
 			}
 
@@ -3418,38 +3737,9 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 			//  FACE SMOOTHING
 			//---------------------------------------------------------------------------------------------------------------------
 
-			// Extract this part's FaceSmoothing values if needed
-			UpdatePartFaceSmoothingIfNeeded();
-
-			// Get the FaceSmoothing values for this split
-			TArray<int32> SplitFaceSmoothingMasks;
-			FHoudiniMeshTranslator::TransferPartAttributesToSplit<int32>(
-				SplitVertexList, AttribInfoFaceSmoothingMasks, PartFaceSmoothingMasks, SplitFaceSmoothingMasks);
-
-			// FaceSmoothing masks must be initialized even if we don't have a value from Houdini!
-			// TODO: Expose the default FaceSmoothing value
-			// 0 will make hard face
-			TArray<uint32> FaceSmoothingMasks;
-			FaceSmoothingMasks.Init(DefaultMeshSmoothing, SplitVertexCount / 3);
-
-			// Check that the number of face smoothing values we retrieved is correct
-			int32 WedgeFaceSmoothCount = SplitFaceSmoothingMasks.Num() / 3;
-			if (SplitFaceSmoothingMasks.Num() != 0 && !SplitFaceSmoothingMasks.IsValidIndex((WedgeFaceSmoothCount - 1) * 3 + 2))
-			{
-				// Ignore our face smoothing values
-				WedgeFaceSmoothCount = 0;
-				HOUDINI_LOG_WARNING(TEXT("Invalid face smoothing mask count detected - Skipping them."));
-			}
-
-			// Transfer the face smoothing masks to the raw mesh if we have any
-			for (int32 WedgeFaceSmoothIdx = 0; WedgeFaceSmoothIdx < WedgeFaceSmoothCount; WedgeFaceSmoothIdx += 3)
-			{
-				FaceSmoothingMasks[WedgeFaceSmoothIdx] = SplitFaceSmoothingMasks[WedgeFaceSmoothIdx * 3];
-			}
-
 			// TODO
 			// Check
-			FStaticMeshOperations::ConvertSmoothGroupToHardEdges(FaceSmoothingMasks, *MeshDescription);
+			FStaticMeshOperations::ConvertSmoothGroupToHardEdges(SplitData->FaceSmoothingMasks, *MeshDescription);
 
 			HOUDINI_LOG_MESSAGE(TEXT("CreateStaticMesh_MeshDescription() - FaceSoothing filled in %f seconds."), FPlatformTime::Seconds() - tick);
 			tick = FPlatformTime::Seconds();
@@ -3676,7 +3966,10 @@ FHoudiniMeshTranslator::CreateStaticMesh_MeshDescription()
 		// bSilent doesnt add the Build Errors...
 		double build_start = FPlatformTime::Seconds();
 		TArray<FText> SMBuildErrors;
-		SM->Build(true, &SMBuildErrors);
+		{
+			FHoudiniCookPhaseScope BuildPhaseScope(EHoudiniCookPhase::BuildStaticMeshes);
+			SM->Build(true, &SMBuildErrors);
+		}
 		double build_end = FPlatformTime::Seconds();
 		HOUDINI_LOG_MESSAGE(TEXT("StaticMesh->Build() executed in %f seconds."), build_end - build_start);
 
@@ -3777,21 +4070,15 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 
 	const double time_start = FPlatformTime::Seconds();
 
-	// Start by updating the vertex list
-	if (!UpdatePartVertexList())
+	// Start by updating the vertex list and the split groups' faces and indices
+	// (unless they were prefetched with the rest of the part's data)
+	bool bHasSplits = false;
+	if (!UpdatePartVertexListAndSplits(bHasSplits))
 		return false;
 
-	// Sort the split groups
-	SortSplitGroups();
-
-	// Handles the split groups found in the part
-	// and builds the corresponding faces and indices arrays
-	if (!UpdateSplitsFacesAndIndices())
+	if (!bHasSplits)
 		return true;
 
-	// Resets the containers used for the raw data extraction.
-	ResetPartCache();
-
 	// Determine if there is "main" geo, if not we'll use the first LOD
 	// as main geo
 	bool bHasMainGeo = false;
@@ -4180,8 +4467,6 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 			//--------------------------------------------------------------------------------------------------------------------- 
 			// POSITIONS
 			//--------------------------------------------------------------------------------------------------------------------- 
-			UpdatePartPositionIfNeeded();
-
 			//
 			// Transfer vertex positions:
 			//
@@ -4192,11 +4477,21 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Vertex Positions"));
 
-				for (int32 VertexPositionIdx = 0; VertexPositionIdx < NumVertexPositions; ++VertexPositionIdx)
-				//ParallelFor(NumVertexPositions, [&](uint32 VertexPositionIdx)
+				// Huge positions are streamed and converted directly into the mesh
+				bool bPositionsStreamed = StreamPartPositionsIfNeeded() && TakeStreamedSplitPositions(SplitGroupName, IndicesMapper,
+					[FoundStaticMesh](const int32& InSplitIndex, const FVector& InPosition)
 				{
-					int32 NeededVertexIndex = NeededVertices[VertexPositionIdx];
-					if (!PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
+					FoundStaticMesh->SetVertexPosition(InSplitIndex, InPosition);
+				});
+
+				if (!bPositionsStreamed)
+				{
+					UpdatePartPositionIfNeeded();
+
+					// We need to swap Z and Y coordinate here, and convert from m to cm. 
+					TArrayView<FVector> MeshPositions = FoundStaticMesh->GetVertexPositionsForWrite();
+					check(MeshPositions.Num() == NumVertexPositions);
+					if (FHoudiniDataConversion::HoudiniToUnrealPositions(PartPositions, 3, NeededVertices, MeshPositions.GetData()) > 0)
 					{
 						// Error retrieving positions.
 						HOUDINI_LOG_WARNING(
@@ -4204,14 +4499,7 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 							TEXT("- skipping."),
 							HGPO.ObjectId, *HGPO.ObjectName, HGPO.GeoId, HGPO.PartId, *HGPO.PartName, SplitId, *SplitGroupName);
 					}
-
-					// We need to swap Z and Y coordinate here, and convert from m to cm. 
-					FoundStaticMesh->SetVertexPosition(VertexPositionIdx, FVector(
-						PartPositions[NeededVertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
-						PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
-						PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION
-					));
-				}//);
+				}
 			}
 
 			//--------------------------------------------------------------------------------------------------------------------- 
@@ -4535,7 +4823,10 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 		//		FoundStaticMesh, PropertyAttributes);
 		//}
 
-		FoundStaticMesh->Optimize();
+		{
+			FHoudiniCookPhaseScope BuildPhaseScope(EHoudiniCookPhase::BuildStaticMeshes);
+			FoundStaticMesh->Optimize();
+		}
 
 		//// Try to find the outer package so we can dirty it up
 		//if (FoundStaticMesh->GetOuter())
@@ -4777,28 +5068,24 @@ FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupN
 	TArray<int32>& SplitGroupVertexList = AllSplitVertexLists[SplitGroupName];
 
 	// We're only interested in unique vertices
+	// If the positions were streamed, the split's unique points are sorted
 	TArray<int32> UniqueVertexIndexes;
-	for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
-	{
-		int32 Index = SplitGroupVertexList[VertexIdx];
-		if (!PartPositions.IsValidIndex(Index))
-			continue;
-
-		UniqueVertexIndexes.AddUnique(Index);
-	}
-
-	// Extract the collision geo's vertices
 	TArray< FVector > VertexArray;
-	VertexArray.SetNum(UniqueVertexIndexes.Num());
-	for (int32 Idx = 0; Idx < UniqueVertexIndexes.Num(); Idx++)
+	const bool bPositionsStreamed = TakeStreamedSplitPositions(SplitGroupName, UniqueVertexIndexes, VertexArray);
+	if (!bPositionsStreamed)
 	{
-		int32 VertexIndex = UniqueVertexIndexes[Idx];
-		if (!PartPositions.IsValidIndex(VertexIndex * 3 + 2))
-			continue;
+		for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+		{
+			int32 Index = SplitGroupVertexList[VertexIdx];
+			if (!PartPositions.IsValidIndex(Index))
+				continue;
+
+			UniqueVertexIndexes.AddUnique(Index);
+		}
 
-		VertexArray[Idx].X = PartPositions[VertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Y = PartPositions[VertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Z = PartPositions[VertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+		// Extract the collision geo's vertices
+		VertexArray.SetNum(UniqueVertexIndexes.Num());
+		FHoudiniDataConversion::HoudiniToUnrealPositions(PartPositions, 3, UniqueVertexIndexes, VertexArray.GetData());
 	}
 
 #if WITH_EDITOR
@@ -4822,24 +5109,35 @@ FHoudiniMeshTranslator::AddConvexCollisionToAggregate(const FString& SplitGroupN
 
 		// We're only interested in the valid indices!
 		TArray<uint32> Indices;
-		for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+		TArray< FVector > Vertices;
+		if (bPositionsStreamed)
 		{
-			int32 Index = SplitGroupVertexList[VertexIdx];
-			if (!PartPositions.IsValidIndex(Index))
-				continue;
+			// Only the split's points were streamed, so index them in the split's positions
+			for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+			{
+				int32 Index = Algo::BinarySearch(UniqueVertexIndexes, SplitGroupVertexList[VertexIdx]);
+				if (Index == INDEX_NONE)
+					continue;
+
+				Indices.Add(Index);
+			}
 
-			Indices.Add(Index);
+			Vertices = VertexArray;
 		}
+		else
+		{
+			for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+			{
+				int32 Index = SplitGroupVertexList[VertexIdx];
+				if (!PartPositions.IsValidIndex(Index))
+					continue;
 
-		// But we need all the positions as vertex
-		TArray< FVector > Vertices;
-		Vertices.SetNum(PartPositions.Num() / 3);
+				Indices.Add(Index);
+			}
 
-		for (int32 Idx = 0; Idx < Vertices.Num(); Idx++)
-		{
-			Vertices[Idx].X = PartPositions[Idx * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			Vertices[Idx].Y = PartPositions[Idx * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			Vertices[Idx].Z = PartPositions[Idx * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+			// But we need all the positions as vertex
+			Vertices.SetNum(PartPositions.Num() / 3);
+			FHoudiniDataConversion::HoudiniToUnrealPositions(PartPositions, 3, Vertices.GetData());
 		}
 
 		// We are using Unreal's DecomposeMeshToHulls() 
@@ -4880,27 +5178,21 @@ FHoudiniMeshTranslator::AddSimpleCollisionToAggregate(const FString& SplitGroupN
 
 	// We're only interested in unique vertices
 	TArray<int32> UniqueVertexIndexes;
-	for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
-	{
-		int32 Index = SplitGroupVertexList[VertexIdx];
-		if (!PartPositions.IsValidIndex(Index))
-			continue;
-
-		UniqueVertexIndexes.AddUnique(Index);
-	}
-
-	// Extract the collision geo's vertices
 	TArray< FVector > VertexArray;
-	VertexArray.SetNum(UniqueVertexIndexes.Num());
-	for (int32 Idx = 0; Idx < UniqueVertexIndexes.Num(); Idx++)
+	if (!TakeStreamedSplitPositions(SplitGroupName, UniqueVertexIndexes, VertexArray))
 	{
-		int32 VertexIndex = UniqueVertexIndexes[Idx];
-		if (!PartPositions.IsValidIndex(VertexIndex * 3 + 2))
-			continue;
+		for (int32 VertexIdx = 0; VertexIdx < SplitGroupVertexList.Num(); VertexIdx++)
+		{
+			int32 Index = SplitGroupVertexList[VertexIdx];
+			if (!PartPositions.IsValidIndex(Index))
+				continue;
+
+			UniqueVertexIndexes.AddUnique(Index);
+		}
 
-		VertexArray[Idx].X = PartPositions[VertexIndex * 3 + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Y = PartPositions[VertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		VertexArray[Idx].Z = PartPositions[VertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+		// Extract the collision geo's vertices
+		VertexArray.SetNum(UniqueVertexIndexes.Num());
+		FHoudiniDataConversion::HoudiniToUnrealPositions(PartPositions, 3, UniqueVertexIndexes, VertexArray.GetData());
 	}
 
 	int32 NewColliders = 0;
@@ -4961,7 +5253,7 @@ int32
 FHoudiniMeshTranslator::TransferRegularPointAttributesToVertices(
 	const TArray<int32>& InVertexList,
 	const HAPI_AttributeInfo& InAttribInfo,
-	const TArray<float>& InData,
+	TArrayView<const float> InData,
 	TArray<float>& OutVertexData)
 {
 	return FHoudiniMeshTranslator::TransferPartAttributesToSplit<float>(
@@ -5098,7 +5390,7 @@ template <typename TYPE>
 int32 FHoudiniMeshTranslator::TransferPartAttributesToSplit(
 	const TArray<int32>& InVertexList,
 	const HAPI_AttributeInfo& InAttribInfo,
-	const TArray<TYPE>& InData,
+	TArrayView<const TYPE> InData,
 	TArray<TYPE>& OutVertexData)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshTranslator::TransferPartAttributesToSplit"));
@@ -6213,4 +6505,116 @@ FHoudiniMeshTranslator::AddActorsToMeshSocket(UStaticMeshSocket * Socket, UStati
 	return bSuccess;
 }
 
+// Serializes the prefetch workers of a session
+static TSharedRef<FCriticalSection, ESPMode::ThreadSafe>
+GetHoudiniMeshPrefetchSessionLock(const int32& InSessionIndex)
+{
+	static FCriticalSection SessionLocksCriticalSection;
+	static TMap<int32, TSharedRef<FCriticalSection, ESPMode::ThreadSafe>> SessionLocks;
+
+	FScopeLock ScopeLock(&SessionLocksCriticalSection);
+	if (TSharedRef<FCriticalSection, ESPMode::ThreadSafe>* FoundLock = SessionLocks.Find(InSessionIndex))
+		return *FoundLock;
+
+	return SessionLocks.Add(InSessionIndex, MakeShared<FCriticalSection, ESPMode::ThreadSafe>());
+}
+
+FHoudiniMeshPrefetch::FHoudiniMeshPrefetch()
+	: CookStats(MakeShared<FHoudiniCookStats, ESPMode::ThreadSafe>())
+{
+}
+
+TSharedPtr<FHoudiniMeshPrefetch>
+FHoudiniMeshPrefetch::Start(const TArray<UHoudiniOutput*>& InOutputs, const int32& InSessionIndex, const bool& bInAssembleSplits)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniMeshPrefetch::Start"));
+
+	TSharedPtr<FHoudiniMeshPrefetch> Prefetch = MakeShared<FHoudiniMeshPrefetch>();
+
+	// Only fetch the parts that CreateStaticMeshFromHoudiniGeoPartObject will rebuild
+	TArray<TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe>> PartTranslators;
+	for (UHoudiniOutput* CurOutput : InOutputs)
+	{
+		if (!CurOutput || CurOutput->IsPendingKill() || CurOutput->GetType() != EHoudiniOutputType::Mesh)
+			continue;
+
+		const bool bHasOutputObjects = CurOutput->GetOutputObjects().Num() > 0;
+		for (const FHoudiniGeoPartObject& CurHGPO : CurOutput->GetHoudiniGeoPartObjects())
+		{
+			if (CurHGPO.Type != EHoudiniPartType::Mesh)
+				continue;
+
+			if (bHasOutputObjects && (!CurHGPO.bHasGeoChanged || !CurHGPO.bHasPartChanged))
+				continue;
+
+			FHoudiniOutputObjectIdentifier Identifier(CurHGPO.ObjectId, CurHGPO.GeoId, CurHGPO.PartId, FString());
+			if (Prefetch->Translators.Contains(Identifier))
+				continue;
+
+			TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe> Translator = MakeShared<FHoudiniMeshTranslator, ESPMode::ThreadSafe>();
+			Translator->SetHoudiniGeoPartObject(CurHGPO);
+			Prefetch->Translators.Add(Identifier, Translator);
+			PartTranslators.Add(Translator);
+		}
+	}
+
+	if (PartTranslators.Num() <= 0)
+		return Prefetch;
+
+	// HAPI serializes the calls made on a session, and concurrent workers would only contend on it:
+	// a single worker fetches and assembles the parts, and the workers of a session's HACs run one at a time.
+	TSharedRef<FCriticalSection, ESPMode::ThreadSafe> SessionLock = GetHoudiniMeshPrefetchSessionLock(InSessionIndex);
+
+	// The worker's time and transfers are accounted as fetching geometry
+	TSharedRef<FHoudiniCookStats, ESPMode::ThreadSafe> CookStats = Prefetch->CookStats;
+	const bool bRecordCookStats = FHoudiniApiTrace::IsRecordingCookStats();
+
+	Prefetch->Tasks.Add(Async(EAsyncExecution::ThreadPool, [PartTranslators, SessionLock, InSessionIndex, bInAssembleSplits, CookStats, bRecordCookStats]()
+	{
+		FScopeLock ScopeLock(&SessionLock.Get());
+
+		// The parts live in the session of the HAC
+		FHoudiniEngineScopedSession ScopedSession(InSessionIndex);
+		FHoudiniCookStatsWorkerScope CookStatsScope(bRecordCookStats
+			? FHoudiniCookStatsContext(&CookStats.Get(), EHoudiniCookPhase::FetchGeometry)
+			: FHoudiniCookStatsContext());
+
+		for (const TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe>& PartTranslator : PartTranslators)
+			PartTranslator->PrefetchPartData(bInAssembleSplits);
+	}));
+
+	return Prefetch;
+}
+
+bool
+FHoudiniMeshPrefetch::IsComplete() const
+{
+	for (const TFuture<void>& Task : Tasks)
+	{
+		if (!Task.IsReady())
+			return false;
+	}
+
+	return true;
+}
+
+void
+FHoudiniMeshPrefetch::Wait()
+{
+	for (const TFuture<void>& Task : Tasks)
+		Task.Wait();
+}
+
+TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe>
+FHoudiniMeshPrefetch::Take(const FHoudiniGeoPartObject& InHGPO)
+{
+	TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe> Translator;
+	if (!Translators.RemoveAndCopyValue(FHoudiniOutputObjectIdentifier(InHGPO.ObjectId, InHGPO.GeoId, InHGPO.PartId, FString()), Translator))
+		return nullptr;
+
+	// The translator is only handed over once its task is done with it
+	Wait();
+	return Translator;
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
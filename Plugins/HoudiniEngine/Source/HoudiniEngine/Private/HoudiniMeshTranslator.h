@@ -31,10 +31,12 @@
 #include "HoudiniOutput.h"
 #include "HoudiniPackageParams.h"
 #include "HoudiniAssetComponent.h"
+#include "HoudiniAttributeCache.h"
 
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "PhysicsEngine/AggregateGeom.h"
+#include "Async/Future.h"
 
 //#include "HoudiniMeshTranslator.generated.h"
 
@@ -48,6 +50,7 @@ class UHoudiniStaticMeshComponent;
 
 struct FKAggregateGeom;
 struct FHoudiniGenericAttribute;
+struct FHoudiniMeshPrefetch;
 
 
 UENUM()
@@ -69,10 +72,46 @@ enum class EHoudiniSplitType : uint8
 	InvisibleSimpleCollider
 };
 
+// Geometry of a split, ready to be copied into a mesh description.
+// It only depends on the part's data, so it can be assembled on a worker thread (see FHoudiniMeshPrefetch).
+struct FHoudiniMeshSplitData
+{
+	// Positions of the split's vertices
+	TArray<FVector> Positions;
+
+	// Split vertex of each vertex instance, three per non-degenerate triangle
+	TArray<int32> TriangleVertices;
+
+	// Index of each triangle's face in the split, used to look up its material
+	TArray<int32> TriangleFaces;
+
+	// Vertex instance attributes, left empty if the part doesn't have them
+	TArray<FVector> Normals;
+	TArray<FVector> Tangents;
+	TArray<float> BinormalSigns;
+	TArray<FVector4> Colors;
+	TArray<TArray<FVector2D>> UVSets;
+
+	// Smoothing mask of each face
+	TArray<uint32> FaceSmoothingMasks;
+};
+
+// Positions of a split's points, streamed with those of the other splits of its part.
+struct FHoudiniStreamedSplitPositions
+{
+	// Flags the part's points used by the split
+	TBitArray<> UsedPoints;
+
+	// Positions of the used points, in ascending point order
+	TArray<FVector> Positions;
+};
+
 struct HOUDINIENGINE_API FHoudiniMeshTranslator
 {
 	public:
 
+		FHoudiniMeshTranslator();
+
 		//-----------------------------------------------------------------------------------------------------------------------------
 		// HOUDINI TO UNREAL
 		//-----------------------------------------------------------------------------------------------------------------------------
@@ -84,7 +123,8 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 			EHoudiniStaticMeshMethod InStaticMeshMethod,
 			UObject* InOuterComponent,
 			bool bInTreatExistingMaterialsAsUpToDate=false,
-			bool bInDestroyProxies=false);
+			bool bInDestroyProxies=false,
+			FHoudiniMeshPrefetch* InPrefetch=nullptr);
 	
 		static bool CreateStaticMeshFromHoudiniGeoPartObject(
 			const FHoudiniGeoPartObject& InHGPO,
@@ -95,7 +135,8 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 			TMap<FString, UMaterialInterface*>& InReplacementMaterialMap,
 			const bool& InForceRebuild,
 			EHoudiniStaticMeshMethod InStaticMeshMethod,
-			bool bInTreatExistingMaterialsAsUpToDate = false);
+			bool bInTreatExistingMaterialsAsUpToDate = false,
+			FHoudiniMeshPrefetch* InPrefetch = nullptr);
 
 		//-----------------------------------------------------------------------------------------------------------------------------
 		// HELPERS
@@ -109,14 +150,14 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 		static int32 TransferRegularPointAttributesToVertices(
 			const TArray<int32>& InVertexList,
 			const HAPI_AttributeInfo& InAttribInfo,
-			const TArray<float>& InData,
+			TArrayView<const float> InData,
 			TArray<float>& OutVertexData);
 
 		template <typename TYPE>
 		static int32 TransferPartAttributesToSplit(
 			const TArray<int32>& InVertexList,
 			const HAPI_AttributeInfo& InAttribInfo,
-			const TArray<TYPE>& InData,
+			TArrayView<const TYPE> InData,
 			TArray<TYPE>& OutSplitData);
 
 
@@ -142,6 +183,11 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 
 		void SetTreatExistingMaterialsAsUpToDate(bool bInTreatExistingMaterialsAsUpToDate) { bTreatExistingMaterialsAsUpToDate = bInTreatExistingMaterialsAsUpToDate; }
 
+		// Fetches the vertex list, splits and attributes of the part, without touching any UObject
+		// so it can be called from a worker thread. The mesh creation then uses this data instead of fetching it.
+		// If bInAssembleSplits is true, the splits' geometry is also assembled for CreateStaticMesh_MeshDescription.
+		bool PrefetchPartData(const bool& bInAssembleSplits);
+
 	protected:
 
 		// Create a StaticMesh using the MeshDescription format
@@ -157,13 +203,40 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 
 		bool UpdatePartVertexList();
 
+		// Updates the vertex list and the splits' faces and indices, unless they were prefetched.
+		// Returns false if the vertex list couldn't be retrieved, bOutHasSplits is false if there is nothing to build.
+		bool UpdatePartVertexListAndSplits(bool& bOutHasSplits);
+
 		void SortSplitGroups();
+
+		// Converts a split's indices, positions and vertex attributes to the layout of a mesh description
+		bool AssembleSplitMeshData(const FString& InSplitGroupName, FHoudiniMeshSplitData& OutSplitData);
 				
 		bool UpdateSplitsFacesAndIndices();
 
 		// Update this part's position cache if we haven't already
 		bool UpdatePartPositionIfNeeded();
 
+		// Returns true if this part's positions haven't been fetched yet and are over the streaming threshold
+		bool ShouldStreamPartPositions(HAPI_AttributeInfo& OutAttribInfo);
+
+		// Streams this part's positions in chunks if they are too large to be fetched whole (see AttributeStreamingThresholdMb).
+		// The positions are streamed once per part: each chunk is converted and scattered into the buffers of all the splits.
+		// Returns false if the positions haven't been streamed and must be read from PartPositions instead.
+		bool StreamPartPositionsIfNeeded();
+
+		// Hands the streamed positions of a split to InSetPosition, with the index of each point in the split.
+		// InPartToSplitIndices maps the part's point indices to their split index, -1 for unused points.
+		// The split's buffer is released, returns false if the split's positions haven't been streamed.
+		bool TakeStreamedSplitPositions(
+			const FString& InSplitGroupName,
+			const TArray<int32>& InPartToSplitIndices,
+			TFunctionRef<void(const int32& InSplitIndex, const FVector& InPosition)> InSetPosition);
+
+		// Same, but returns the part's points used by the split, in ascending order, and their positions.
+		bool TakeStreamedSplitPositions(
+			const FString& InSplitGroupName, TArray<int32>& OutPartPoints, TArray<FVector>& OutPositions);
+
 		// Update this part's normal cache if we haven't already
 		bool UpdatePartNormalsIfNeeded();
 
@@ -182,6 +255,9 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 		// Update this part's UV sets if we haven't already
 		bool UpdatePartUVSetsIfNeeded(const bool& bRemoveUnused = false);
 
+		// Removes the empty sets from the UV sets cache
+		void RemoveUnusedPartUVSets();
+
 		// Update this part;s lightmap resolution cache if we haven't already
 		bool UpdatePartLightmapResolutionsIfNeeded();
 
@@ -322,31 +398,38 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 		// Per-split first valid prim index
 		TMap<FString, int32> AllSplitFirstValidPrimIndex;
 
+		// Per-split geometry assembled by PrefetchPartData
+		TMap<FString, FHoudiniMeshSplitData> AllAssembledSplits;
+
 		// Vertex Indices for the part
 		TArray<int32> PartVertexList;
 
 		// Positions
-		TArray<float> PartPositions;
+		FHoudiniFloatAttributeView PartPositions;
 		HAPI_AttributeInfo AttribInfoPositions;
 
+		// Per-split positions, if the part's positions were streamed
+		TMap<FString, FHoudiniStreamedSplitPositions> AllSplitStreamedPositions;
+		bool bPartPositionsStreamed;
+
 		// Vertex Normals
-		TArray<float> PartNormals;
+		FHoudiniFloatAttributeView PartNormals;
 		HAPI_AttributeInfo AttribInfoNormals;
 
 		// Vertex TangentU
-		TArray<float> PartTangentU;
+		FHoudiniFloatAttributeView PartTangentU;
 		HAPI_AttributeInfo AttribInfoTangentU;
 
 		// Vertex TangentV
-		TArray<float> PartTangentV;
+		FHoudiniFloatAttributeView PartTangentV;
 		HAPI_AttributeInfo AttribInfoTangentV;
 
 		// Vertex Colors
-		TArray<float> PartColors;
+		FHoudiniFloatAttributeView PartColors;
 		HAPI_AttributeInfo AttribInfoColors;
 
 		// Vertex Alpha values
-		TArray<float> PartAlphas;
+		FHoudiniFloatAttributeView PartAlphas;
 		HAPI_AttributeInfo AttribInfoAlpha;
 
 		// Face Smoothing masks
@@ -388,4 +471,52 @@ struct HOUDINIENGINE_API FHoudiniMeshTranslator
 		// When building a mesh, if an associated material already exists, treat
 		// it as up to date, regardless of the MaterialInfo.bHasChanged flag
 		bool bTreatExistingMaterialsAsUpToDate;
+
+		// Indicates that UV sets were found among the texture attributes
+		bool bPartHasTextureUVSets;
+
+		// Indicates the part's data was fetched by PrefetchPartData, and the results of its vertex list and splits updates
+		bool bPartDataPrefetched;
+		bool bPrefetchedVertexList;
+		bool bPrefetchedSplits;
+};
+
+// Fetches the data of the mesh parts of some outputs, and assembles their geometry, on a worker thread,
+// so only the creation of the meshes and their components is left to the game thread.
+// HAPI serializes the calls made on a session, so there is only one worker per session at a time.
+struct HOUDINIENGINE_API FHoudiniMeshPrefetch
+{
+	public:
+
+		FHoudiniMeshPrefetch();
+
+		// Starts fetching the mesh parts of the outputs that will need to be rebuilt.
+		// bInAssembleSplits should be true if the meshes will be created with a mesh description.
+		static TSharedPtr<FHoudiniMeshPrefetch> Start(
+			const TArray<UHoudiniOutput*>& InOutputs, const int32& InSessionIndex, const bool& bInAssembleSplits);
+
+		// Whether all the parts have been fetched
+		bool IsComplete() const;
+
+		// Blocks until all the parts have been fetched
+		void Wait();
+
+		// Returns the translator holding the part's data, null if the part wasn't prefetched
+		TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe> Take(const FHoudiniGeoPartObject& InHGPO);
+
+		int32 GetPartCount() const { return Translators.Num(); };
+
+		// Stats recorded by the workers, to be added to the HAC's once they're done
+		const FHoudiniCookStats& GetCookStats() const { return CookStats.Get(); };
+
+	protected:
+
+		// Translators of the parts being fetched
+		TMap<FHoudiniOutputObjectIdentifier, TSharedPtr<FHoudiniMeshTranslator, ESPMode::ThreadSafe>> Translators;
+
+		// Worker tasks, each fetching a share of the parts
+		TArray<TFuture<void>> Tasks;
+
+		// Shared with the workers, which may outlive the prefetch if its HAC is destroyed
+		TSharedRef<FHoudiniCookStats, ESPMode::ThreadSafe> CookStats;
 };
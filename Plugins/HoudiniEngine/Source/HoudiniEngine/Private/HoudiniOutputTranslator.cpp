@@ -28,6 +28,8 @@
 
 #include "HoudiniOutput.h"
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
+#include "HoudiniEngineOutputStats.h"
 #include "HoudiniEngine.h"
 
 #include "HoudiniEngineUtils.h"
@@ -38,6 +40,7 @@
 #include "HoudiniAssetComponent.h"
 #include "HoudiniSplineComponent.h"
 #include "HoudiniEngineRuntime.h"
+#include "HoudiniRuntimeSettings.h"
 #include "HoudiniInput.h"
 #include "HoudiniStaticMesh.h"
 
@@ -47,6 +50,7 @@
 #include "HoudiniInstanceTranslator.h"
 
 #include "Editor.h"
+#include "EditorViewportClient.h"
 #include "EditorSupportDelegates.h"
 #include "FileHelpers.h"
 #include "LandscapeInfo.h"
@@ -62,6 +66,20 @@
 bool
 FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool& bInForceUpdate, bool& bOutHasHoudiniStaticMeshOutput)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputTranslator::UpdateOutputs"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniOutputTranslator::UpdateOutputs"));
+
+	if (!BuildOutputs(HAC))
+		return false;
+
+	return CreateOutputs(HAC, bOutHasHoudiniStaticMeshOutput);
+}
+
+bool
+FHoudiniOutputTranslator::BuildOutputs(UHoudiniAssetComponent* HAC)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputTranslator::BuildOutputs"));
+
 	if (!HAC || HAC->IsPendingKill())
 		return false;
 
@@ -101,23 +119,69 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 		HAC->Outputs.Empty();
 	}
 
-	UWorldComposition* WorldComposition = HAC->GetWorld() ? HAC->GetWorld()->WorldComposition : nullptr;
-	if (IsValid(WorldComposition))
+	return true;
+}
+
+bool
+FHoudiniOutputTranslator::CreateOutputs(UHoudiniAssetComponent* HAC, bool& bOutHasHoudiniStaticMeshOutput, const TSharedPtr<FHoudiniMeshPrefetch>& InMeshPrefetch)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputTranslator::CreateOutputs"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniOutputTranslator::CreateOutputs"));
+
+	bOutHasHoudiniStaticMeshOutput = false;
+
+	FHoudiniOutputBuilder Builder(HAC, InMeshPrefetch);
+	if (!Builder.Begin())
+		return false;
+
+	// Create all the outputs at once
+	Builder.Step(0.0);
+	Builder.Finish();
+
+	bOutHasHoudiniStaticMeshOutput = Builder.HasHoudiniStaticMeshOutput();
+
+	return true;
+}
+
+FHoudiniOutputBuilder::FHoudiniOutputBuilder(UHoudiniAssetComponent* InHAC, const TSharedPtr<FHoudiniMeshPrefetch>& InMeshPrefetch)
+	: HAC(InHAC)
+	, MeshPrefetch(InMeshPrefetch)
+	, NextPendingIndex(0)
+	, NumInstances(0)
+	, bHasObjectInstancer(false)
+	, NumOutputs(0)
+	, NumCreatedOutputs(0)
+	, NumVisibleOutputs(0)
+	, bHasLandscape(false)
+	, bCreatedNewMaps(false)
+	, bHasHoudiniStaticMeshOutput(false)
+	, bFinished(false)
+{
+
+}
+
+FHoudiniOutputBuilder::~FHoudiniOutputBuilder()
+{
+	// Don't leave the origin tracking disabled if we haven't been finished (HAC destroyed...)
+	if (!bFinished && WorldComposition.IsValid())
+		WorldComposition->bTemporallyDisableOriginTracking = false;
+}
+
+bool
+FHoudiniOutputBuilder::Begin()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputBuilder::Begin"));
+
+	if (!HAC.IsValid() || HAC->IsPendingKill())
+		return false;
+
+	WorldComposition = HAC->GetWorld() ? HAC->GetWorld()->WorldComposition : nullptr;
+	if (WorldComposition.IsValid())
 	{
 		// We don't want the origin to shift as we're potentially updating levels.
 		WorldComposition->bTemporallyDisableOriginTracking = true;
 	}
 
-	// "Process" the mesh.
-	// TODO: Move this to the actual processing stage,
-	// And see if some of this could be threaded
-	UObject* OuterComponent = HAC;
-	
-	FString HoudiniAssetPath = FPaths::GetPath(HAC->GetPathName());
-	FString ComponentGUIDString = HAC->GetComponentGUID().ToString().Left(FHoudiniEngineUtils::PackageGUIDComponentNameLength);
-	FString HoudiniAssetNameString = HAC->GetDisplayName();
-
-	FHoudiniPackageParams PackageParams;
 	PackageParams.PackageMode = FHoudiniPackageParams::GetDefaultStaticMeshesCookMode();
 	PackageParams.ReplaceMode = FHoudiniPackageParams::GetDefaultReplaceMode();
 
@@ -129,27 +193,18 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 	PackageParams.HoudiniAssetActorName = HAC->GetOwner()->GetName();
 	PackageParams.ComponentGUID = HAC->GetComponentGUID();
 	PackageParams.ObjectName = FString();
-	
-	TArray<UPackage*> CreatedWorldCompositionPackages;
-	bool bCreatedNewMaps = false;
-	//...  for heightfield outputs  ...//
 
-	// Collect all the landscape layers' global min/max values.
-	TMap<FString, float> LandscapeLayerGlobalMinimums;
-	TMap<FString, float> LandscapeLayerGlobalMaximums;
-	
-	// Store the instancer outputs separately so we can process them later, after all mesh output are processed.
 	// Determine the total number of instances, if we have more than 1 then mesh parts with instanced geo we will not create proxy meshes
 	// Also if we have object instancer (or oldschool attribute instancers), we won't be creating any proxy at all
-	TArray<UHoudiniOutput*> InstancerOutputs;
-	int32 NumInstances = 0;
-	bool bHasObjectInstancer = false;
-	
 	for (auto& CurOutput : HAC->Outputs)
 	{
+		if (!CurOutput || CurOutput->IsPendingKill())
+			continue;
+
+		PendingOutputs.Add(CurOutput);
+
 		if (CurOutput->GetType() == EHoudiniOutputType::Instancer)
 		{
-			// InstancerOutputs.Add(CurOutput);
 			for (const FHoudiniGeoPartObject &HGPO : CurOutput->GetHoudiniGeoPartObjects())
 			{
 				if (HGPO.Type == EHoudiniPartType::Instancer)
@@ -173,147 +228,257 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 		}
 		else if (CurOutput->GetType() == EHoudiniOutputType::Landscape)
 		{
+			// Collect all the landscape layers' global min/max values.
 			FHoudiniLandscapeTranslator::CalcHeightfieldsArrayGlobalZMinZMax(CurOutput->GetHoudiniGeoPartObjects(), LandscapeLayerGlobalMinimums, LandscapeLayerGlobalMaximums, false);
 		}
 	}
 
-	bOutHasHoudiniStaticMeshOutput = false;
-	int32 NumVisibleOutputs = 0;
-	int32 NumOutputs = HAC->Outputs.Num();
-	bool bHasLandscape = false;
-
-	// Before processing all the outputs, 
-	// See if we have any landscape input that have "Update Input Landscape" enabled
-	// And make an array of all our input landscapes
-	TArray<ALandscapeProxy *> AllInputLandscapes;
-	TArray<ALandscapeProxy *> InputLandscapesToUpdate;
-	
-	for (auto CurrentInput : HAC->Inputs)
+	NumOutputs = PendingOutputs.Num();
+
+	SortPendingOutputs();
+
+	return true;
+}
+
+void
+FHoudiniOutputBuilder::SortPendingOutputs()
+{
+	// Get the editor viewport's camera
+	bool bHasView = false;
+	FVector ViewLocation = FVector::ZeroVector;
+	FVector ViewDirection = FVector::ForwardVector;
+#if WITH_EDITOR
+	if (GEditor && GEditor->GetActiveViewport())
+	{
+		FEditorViewportClient* ViewportClient = (FEditorViewportClient*)GEditor->GetActiveViewport()->GetClient();
+		if (ViewportClient)
+		{
+			ViewLocation = ViewportClient->GetViewLocation();
+			ViewDirection = ViewportClient->GetViewRotation().Vector();
+			bHasView = true;
+		}
+	}
+#endif
+
+	// Outputs that haven't been created yet use the HAC's bounds
+	const FBoxSphereBounds DefaultBounds = HAC->Bounds;
+
+	// Work list priority: group, then in front/behind the camera, then distance
+	struct FPendingOutputKey
+	{
+		int32 Group = 0;
+		bool bBehindView = false;
+		float Distance = 0.0f;
+	};
+
+	TMap<UHoudiniOutput*, FPendingOutputKey> Keys;
+	for (auto& CurOutput : PendingOutputs)
 	{
-		if (CurrentInput->GetInputType() != EHoudiniInputType::Landscape)
+		FPendingOutputKey& Key = Keys.Add(CurOutput.Get());
+
+		const EHoudiniOutputType OutputType = CurOutput->GetType();
+		if (OutputType == EHoudiniOutputType::Mesh)
+			Key.Group = 1;
+		else if (OutputType == EHoudiniOutputType::Instancer)
+			Key.Group = 2;
+		else
 			continue;
 
-		// Get the landscape input's landscape
-		ALandscapeProxy* InputLandscape = Cast<ALandscapeProxy>(CurrentInput->GetInputObjectAt(0));
-		if (!InputLandscape)
+		if (!bHasView)
 			continue;
 
-		AllInputLandscapes.Add(InputLandscape);
+		// Use the bounds of the components created by the previous cook if any
+		FBox Box(ForceInit);
+		for (auto& Pair : CurOutput->GetOutputObjects())
+		{
+			USceneComponent* Component = Cast<USceneComponent>(Pair.Value.OutputComponent);
+			if (!IsValid(Component))
+				Component = Cast<USceneComponent>(Pair.Value.ProxyComponent);
+
+			if (IsValid(Component))
+				Box += Component->Bounds.GetBox();
+		}
 
-		if (CurrentInput->GetUpdateInputLandscape())
-			InputLandscapesToUpdate.Add(InputLandscape);
+		const FBoxSphereBounds Bounds = Box.IsValid ? FBoxSphereBounds(Box) : DefaultBounds;
+		const FVector ToBounds = Bounds.Origin - ViewLocation;
+		Key.Distance = FMath::Max(ToBounds.Size() - Bounds.SphereRadius, 0.0f);
+		Key.bBehindView = FVector::DotProduct(ToBounds, ViewDirection) < -Bounds.SphereRadius;
 	}
 
-	// ----------------------------------------------------
-	// Process outputs
-	// ----------------------------------------------------
-	TArray<UPackage*> CreatedPackages;
-	for (int32 OutputIdx = 0; OutputIdx < NumOutputs; OutputIdx++)
+	// Stable: landscapes and curves keep their order
+	PendingOutputs.StableSort([&Keys](const TWeakObjectPtr<UHoudiniOutput>& A, const TWeakObjectPtr<UHoudiniOutput>& B)
+	{
+		const FPendingOutputKey& KeyA = Keys.FindChecked(A.Get());
+		const FPendingOutputKey& KeyB = Keys.FindChecked(B.Get());
+		if (KeyA.Group != KeyB.Group)
+			return KeyA.Group < KeyB.Group;
+		if (KeyA.bBehindView != KeyB.bBehindView)
+			return !KeyA.bBehindView;
+		return KeyA.Distance < KeyB.Distance;
+	});
+}
+
+bool
+FHoudiniOutputBuilder::Step(const double& InBudgetSeconds)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputBuilder::Step"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniOutputBuilder::Step"));
+
+	if (!HAC.IsValid() || HAC->IsPendingKill())
+		return true;
+
+	const double StepStartTime = FPlatformTime::Seconds();
+	int32 NumCreatedThisStep = 0;
+	while (NextPendingIndex < PendingOutputs.Num())
 	{
-		UHoudiniOutput* CurOutput = HAC->GetOutputAt(OutputIdx);
+		// Stop when we run out of time, but always create at least one output
+		if (InBudgetSeconds > 0.0 && NumCreatedThisStep > 0 && (FPlatformTime::Seconds() - StepStartTime) >= InBudgetSeconds)
+			break;
+
+		UHoudiniOutput* CurOutput = PendingOutputs[NextPendingIndex++].Get();
+		NumCreatedOutputs++;
 		if (!CurOutput || CurOutput->IsPendingKill())
 			continue;
 
-		FString Notification = FString::Format(TEXT("Processing output {0} / {1}..."), {FString::FromInt(OutputIdx + 1), FString::FromInt(NumOutputs)});
+		FString Notification = FString::Format(TEXT("Processing output {0} / {1}..."), {FString::FromInt(NumCreatedOutputs), FString::FromInt(NumOutputs)});
 		FHoudiniEngine::Get().UpdateTaskSlateNotification(FText::FromString(Notification));
 
-		switch (CurOutput->GetType())
+		CreateOutput(CurOutput);
+		NumCreatedThisStep++;
+	}
+
+	return NextPendingIndex >= PendingOutputs.Num();
+}
+
+void
+FHoudiniOutputBuilder::CreateOutput(UHoudiniOutput* CurOutput)
+{
+	UObject* OuterComponent = HAC.Get();
+
+	switch (CurOutput->GetType())
+	{
+		case EHoudiniOutputType::Mesh:
 		{
-			case EHoudiniOutputType::Mesh:
+			bool bIsProxyStaticMeshEnabled = HAC->IsProxyStaticMeshEnabled() && !HAC->HasNoProxyMeshNextCookBeenRequested();
+			if (bIsProxyStaticMeshEnabled && NumInstances > 1)
 			{
-				bool bIsProxyStaticMeshEnabled = HAC->IsProxyStaticMeshEnabled() && !HAC->HasNoProxyMeshNextCookBeenRequested();
-				if (bIsProxyStaticMeshEnabled && NumInstances > 1)
+				if (bHasObjectInstancer)
 				{
-					if (bHasObjectInstancer)
-					{
-						// Completely disable proxies if we have object instancers/old school attribute instancers
-						// as they rely on having a static mesh created (and the instanced mesh HGPO is not marked as instanced...)
-						bIsProxyStaticMeshEnabled = false;
-					}
-					else
+					// Completely disable proxies if we have object instancers/old school attribute instancers
+					// as they rely on having a static mesh created (and the instanced mesh HGPO is not marked as instanced...)
+					bIsProxyStaticMeshEnabled = false;
+				}
+				else
+				{
+					// If we dont have proxy instancer, enable proxy only for non-instanced mesh
+					for (const FHoudiniGeoPartObject &HGPO : CurOutput->GetHoudiniGeoPartObjects())
 					{
-						// If we dont have proxy instancer, enable proxy only for non-instanced mesh
-						for (const FHoudiniGeoPartObject &HGPO : CurOutput->GetHoudiniGeoPartObjects())
+						if (HGPO.bIsInstanced && HGPO.Type == EHoudiniPartType::Mesh)
 						{
-							if (HGPO.bIsInstanced && HGPO.Type == EHoudiniPartType::Mesh)
-							{
-								bIsProxyStaticMeshEnabled = false;
-								break;
-							}
+							bIsProxyStaticMeshEnabled = false;
+							break;
 						}
 					}
 				}
+			}
 
-				FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
-					CurOutput, 
-					PackageParams, 
-					bIsProxyStaticMeshEnabled ? EHoudiniStaticMeshMethod::UHoudiniStaticMesh : HAC->StaticMeshMethod,
-					OuterComponent);
-
-				NumVisibleOutputs++;
+			FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
+				CurOutput, 
+				PackageParams, 
+				bIsProxyStaticMeshEnabled ? EHoudiniStaticMeshMethod::UHoudiniStaticMesh : HAC->StaticMeshMethod,
+				OuterComponent,
+				false,
+				false,
+				MeshPrefetch.Get());
 
-				// Look for UHoudiniStaticMesh in the output, and set bOutHasHoudiniStaticMeshOutput accordingly
-				if (bIsProxyStaticMeshEnabled && !bOutHasHoudiniStaticMeshOutput)
-				{
-					bOutHasHoudiniStaticMeshOutput = CurOutput->HasAnyCurrentProxy();
-				}
+			NumVisibleOutputs++;
 
-				break;
+			// Look for UHoudiniStaticMesh in the output, and set bHasHoudiniStaticMeshOutput accordingly
+			if (bIsProxyStaticMeshEnabled && !bHasHoudiniStaticMeshOutput)
+			{
+				bHasHoudiniStaticMeshOutput = CurOutput->HasAnyCurrentProxy();
 			}
 
-			case EHoudiniOutputType::Curve:
+			break;
+		}
+
+		case EHoudiniOutputType::Curve:
+		{
+			if (CurOutput->IsEditableNode())
 			{
-				if (CurOutput->IsEditableNode())
+				if (!CurOutput->HasEditableNodeBuilt())
 				{
-					if (!CurOutput->HasEditableNodeBuilt())
-					{
-						const TArray<FHoudiniGeoPartObject> &GeoPartObjects = CurOutput->GetHoudiniGeoPartObjects();
+					const TArray<FHoudiniGeoPartObject> &GeoPartObjects = CurOutput->GetHoudiniGeoPartObjects();
 
-						if (GeoPartObjects.Num() <= 0)
-							continue;
+					if (GeoPartObjects.Num() <= 0)
+						break;
 
-						const FHoudiniGeoPartObject & CurHGPO = GeoPartObjects[0];
+					const FHoudiniGeoPartObject & CurHGPO = GeoPartObjects[0];
 
-						// Editable curve, only need to be built once. 
-						UHoudiniSplineComponent* HoudiniSplineComponent = FHoudiniSplineTranslator::CreateHoudiniSplineComponentFromHoudiniEditableNode(
-							CurHGPO.GeoId, 
-							CurHGPO.PartName,
-							HAC);
+					// Editable curve, only need to be built once. 
+					UHoudiniSplineComponent* HoudiniSplineComponent = FHoudiniSplineTranslator::CreateHoudiniSplineComponentFromHoudiniEditableNode(
+						CurHGPO.GeoId, 
+						CurHGPO.PartName,
+						HAC.Get());
 
-						HoudiniSplineComponent->SetIsEditableOutputCurve(true);
+					HoudiniSplineComponent->SetIsEditableOutputCurve(true);
 
-						FHoudiniOutputObjectIdentifier EditableSplineComponentIdentifier;
-						EditableSplineComponentIdentifier.ObjectId = CurHGPO.ObjectId;
-						EditableSplineComponentIdentifier.GeoId = CurHGPO.GeoId;
-						EditableSplineComponentIdentifier.PartId = CurHGPO.PartId;
-						EditableSplineComponentIdentifier.PartName = CurHGPO.PartName;
-						
-						TMap<FHoudiniOutputObjectIdentifier, FHoudiniOutputObject>& OutputObjects = CurOutput->GetOutputObjects();
-						FHoudiniOutputObject& FoundOutputObject = OutputObjects.FindOrAdd(EditableSplineComponentIdentifier);
-						FoundOutputObject.OutputComponent = HoudiniSplineComponent;
+					FHoudiniOutputObjectIdentifier EditableSplineComponentIdentifier;
+					EditableSplineComponentIdentifier.ObjectId = CurHGPO.ObjectId;
+					EditableSplineComponentIdentifier.GeoId = CurHGPO.GeoId;
+					EditableSplineComponentIdentifier.PartId = CurHGPO.PartId;
+					EditableSplineComponentIdentifier.PartName = CurHGPO.PartName;
+					
+					TMap<FHoudiniOutputObjectIdentifier, FHoudiniOutputObject>& OutputObjects = CurOutput->GetOutputObjects();
+					FHoudiniOutputObject& FoundOutputObject = OutputObjects.FindOrAdd(EditableSplineComponentIdentifier);
+					FoundOutputObject.OutputComponent = HoudiniSplineComponent;
 
-						CurOutput->SetHasEditableNodeBuilt(true);
-					}
-				}
-				else
-				{	
-					// Output curve (deactivated for now)
-					// TODO: Add a setting/attribute to handle curve outputs?
-					//FHoudiniSplineTranslator::CreateAllSplinesFromHoudiniOutput(CurOutput, OuterComponent);
-					//NumVisibleOutputs++;
-					break;
+					CurOutput->SetHasEditableNodeBuilt(true);
 				}
 			}
-			break;
+			else
+			{	
+				// Output curve (deactivated for now)
+				// TODO: Add a setting/attribute to handle curve outputs?
+				//FHoudiniSplineTranslator::CreateAllSplinesFromHoudiniOutput(CurOutput, OuterComponent);
+				//NumVisibleOutputs++;
+				break;
+			}
+		}
+		break;
 
 		case EHoudiniOutputType::Instancer:
-			InstancerOutputs.Add(CurOutput);
+		{
+			// The work list is sorted so that all meshes have been created at this point
+			FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(CurOutput, HAC->Outputs, OuterComponent);
+			NumVisibleOutputs++;
 			break;
+		}
 
 		case EHoudiniOutputType::Landscape:
 		{
 			NumVisibleOutputs++;
 
+			// See if we have any landscape input that have "Update Input Landscape" enabled
+			// And make an array of all our input landscapes
+			TArray<ALandscapeProxy *> AllInputLandscapes;
+			TArray<ALandscapeProxy *> InputLandscapesToUpdate;
+			for (auto CurrentInput : HAC->Inputs)
+			{
+				if (CurrentInput->GetInputType() != EHoudiniInputType::Landscape)
+					continue;
+
+				// Get the landscape input's landscape
+				ALandscapeProxy* InputLandscape = Cast<ALandscapeProxy>(CurrentInput->GetInputObjectAt(0));
+				if (!InputLandscape)
+					continue;
+
+				AllInputLandscapes.Add(InputLandscape);
+
+				if (CurrentInput->GetUpdateInputLandscape())
+					InputLandscapesToUpdate.Add(InputLandscape);
+			}
+
 			// This gets called for each heightfield primitive from Houdini, i.e., each "tile".
 			UWorld* PersistentWorld = HAC->GetWorld();
 			bool bNewMapCreated = false;
@@ -322,19 +487,23 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 			// and remove them. That aforementioned behaviour should really be updated to 
 			// make use of untracked actors on the HAC (similar to PDG Asset Link).
 			TArray<TWeakObjectPtr<AActor>> UntrackedActors;
+			TArray<UPackage*> OutputCreatedPackages;
 
 			FHoudiniLandscapeTranslator::CreateLandscape(
 				CurOutput,
 				UntrackedActors,
 				InputLandscapesToUpdate,
 				AllInputLandscapes,
-				HAC,
+				HAC.Get(),
 				TEXT("{hda_actor_name}_"),
 				PersistentWorld,
 				LandscapeLayerGlobalMinimums,
 				LandscapeLayerGlobalMaximums,
 				PackageParams,
-				CreatedPackages);
+				OutputCreatedPackages);
+
+			for (UPackage* CreatedPackage : OutputCreatedPackages)
+				CreatedPackages.Add(CreatedPackage);
 
 			bHasLandscape = true;
 
@@ -352,7 +521,7 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 				// Attach the created landscapes to HAC
 				// Output Transforms are always relative to the HDA
 				HAC->SetMobility(EComponentMobility::Static);
-				OutputLandscape->AttachToComponent(HAC, FAttachmentTransformRules::KeepRelativeTransform);
+				OutputLandscape->AttachToComponent(HAC.Get(), FAttachmentTransformRules::KeepRelativeTransform);
 				// Note that the above attach will cause the collision components to crap out. This manifests
 				// itself via the Landscape editor tools not being able to trace Landscape collision components.
 				// By recreating collision components here, it appears to put things back into working order. 
@@ -366,25 +535,35 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 		default:
 			// Do Nothing for now
 			break;
-		}
 	}
+}
+
+void
+FHoudiniOutputBuilder::Finish()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputBuilder::Finish"));
+
+	if (bFinished)
+		return;
+
+	bFinished = true;
 
-	// Now that all meshes have been created, process the instancers
-	for (auto& CurOutput : InstancerOutputs)
+	if (!HAC.IsValid() || HAC->IsPendingKill())
 	{
-		FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutput(CurOutput, HAC->Outputs, OuterComponent);
-		NumVisibleOutputs++;
+		if (WorldComposition.IsValid())
+			WorldComposition->bTemporallyDisableOriginTracking = false;
+		return;
 	}
 
 	if (NumVisibleOutputs > 0)
 	{
 		// If we have valid outputs, we don't need to display the houdini logo anymore...
-		FHoudiniEngineUtils::RemoveHoudiniLogoFromComponent(HAC);
+		FHoudiniEngineUtils::RemoveHoudiniLogoFromComponent(HAC.Get());
 	}
 	else
 	{
 		// ... if we don't have any valid outputs however, we should
-		FHoudiniEngineUtils::AddHoudiniLogoToComponent(HAC);
+		FHoudiniEngineUtils::AddHoudiniLogoToComponent(HAC.Get());
 	}
 
 	if (bHasLandscape)
@@ -447,7 +626,7 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 		ULandscapeInfo::RecreateLandscapeInfo(HAC->GetWorld(), true);
 	}
 
-	if (IsValid(WorldComposition))
+	if (WorldComposition.IsValid())
 	{
 		// Disable the flag that we set before starting the import process.
 		WorldComposition->bTemporallyDisableOriginTracking = false;
@@ -473,7 +652,7 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 		ULandscapeInfo::RecreateLandscapeInfo(CurrentWorld, true);
 
 		FHoudiniEngineUtils::LogWorldInfo(CurrentWorld);
-		if (WorldComposition)
+		if (WorldComposition.IsValid())
 		{
 			UWorldComposition::WorldCompositionChangedEvent.Broadcast(CurrentWorld);
 		}
@@ -482,16 +661,22 @@ FHoudiniOutputTranslator::UpdateOutputs(UHoudiniAssetComponent* HAC, const bool&
 		FEditorDelegates::RefreshAllBrowsers.Broadcast();
 	}
 
-	if (CreatedPackages.Num() > 0)
+	TArray<UPackage*> PackagesToSave;
+	for (auto& CreatedPackage : CreatedPackages)
+	{
+		if (CreatedPackage.IsValid())
+			PackagesToSave.Add(CreatedPackage.Get());
+	}
+
+	if (PackagesToSave.Num() > 0)
 	{
 		// Save created packages. For example, we don't want landscape layers deleted 
 		// along with the HDA.
-		FEditorFileUtils::PromptForCheckoutAndSave(CreatedPackages, true, false);
+		FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, true, false);
 	}
-
-	return true;
 }
 
+
 bool
 FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(UHoudiniAssetComponent* HAC, bool bInDestroyProxies)
 {
@@ -792,40 +977,19 @@ FHoudiniOutputTranslator::BuildAllOutputs(
 	TArray<UHoudiniOutput*>& OutNewOutputs,
 	const bool& InOutputTemplatedGeos)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputTranslator::BuildAllOutputs"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniOutputTranslator::BuildAllOutputs"));
+	FHoudiniCookPhaseScope PhaseScope(EHoudiniCookPhase::FetchGeometry);
+
 	// Ensure the asset has a valid node ID
 	if (AssetId < 0)
 	{
 		return false;
 	}
 
-	// Get the AssetInfo
-	HAPI_AssetInfo AssetInfo;
-	FHoudiniApi::AssetInfo_Init(&AssetInfo);
-	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAssetInfo(
-		FHoudiniEngine::Get().GetSession(), AssetId, &AssetInfo), false);
-
-	FString CurrentAssetName;
-	{
-		FHoudiniEngineString hapiSTR(AssetInfo.nameSH);
-		hapiSTR.ToFString(CurrentAssetName);
-	}
-
-	// Retrieve the asset's transform.
-	// TODO: Unused?!
-	//FTransform AssetUnrealTransform;
-	//if (!FHoudiniEngineUtils::HapiGetAssetTransform(AssetId, AssetUnrealTransform))
-	//	return false;
-
-	// Retrieve information about each object contained within our asset.
-	TArray<HAPI_ObjectInfo> ObjectInfos;
-	if (!FHoudiniEngineUtils::HapiGetObjectInfos(AssetId, ObjectInfos))
-		return false;
-
-	//const int32 ObjectCount = ObjectInfos.Num();
-
-	// Retrieve transforms for each object in this asset.
-	TArray<HAPI_Transform> ObjectTransforms;
-	if (!FHoudiniEngineUtils::HapiGetObjectTransforms(AssetId, ObjectTransforms))
+	// Enumerate the objects, geos and parts of the asset and build their HGPOs
+	TArray<FHoudiniGeoPartObject> AllHGPOs;
+	if (!DiscoverAllGeoPartObjects(AssetId, InOutputTemplatedGeos, AllHGPOs))
 		return false;
 
 	// Mark all the previous HGPOs on the outputs as stale
@@ -841,103 +1005,261 @@ FHoudiniOutputTranslator::BuildAllOutputs(
 	// match them with theit corresponding height volume after
 	TArray<FHoudiniGeoPartObject> UnassignedVolumeParts;
 
-	TArray<FHoudiniMeshSocket> AllSockets;
-
-	// Iterate through all objects.
-	int32 OutputIdx = 1;
-	for (int32 ObjectId = 0; ObjectId < ObjectInfos.Num(); ++ObjectId)
+	// Assign each HGPO to an output
+	for (FHoudiniGeoPartObject& currentHGPO : AllHGPOs)
 	{
-		// Retrieve the object info
-		const HAPI_ObjectInfo& CurrentHapiObjectInfo = ObjectInfos[ObjectId];
-
-		// Cache/convert them
-		FHoudiniObjectInfo CurrentObjectInfo;
-		CacheObjectInfo(CurrentHapiObjectInfo, CurrentObjectInfo);
-
-		// Retrieve object name.
-		FString CurrentObjectName = CurrentObjectInfo.Name;
-
-		// Get transformation for this object.
-		const HAPI_Transform & ObjectTransform = ObjectTransforms[ObjectId];
-		FTransform TransformMatrix;
-		FHoudiniEngineUtils::TranslateHapiTransform(ObjectTransform, TransformMatrix);
-
-		// TODO: Check transforms??
+		// See if we have an existing output that matches this HGPO or if we need to create a new one
+		bool IsFoundOutputValid = false;
+		UHoudiniOutput ** FoundHoudiniOutput = nullptr;	
+		// We handle volumes differently than other outputs types, as a single HF output has multiple HGPOs
+		if (currentHGPO.Type != EHoudiniPartType::Volume)
+		{
+			// Look in the previous output if we have a match
+			FoundHoudiniOutput = InOldOutputs.FindByPredicate(
+				[currentHGPO](UHoudiniOutput* Output) { return Output ? Output->HasHoudiniGeoPartObject(currentHGPO) : false; });
 
-		// Build an array of the geos we'll need to process
-		// In most case, it will only be the display geo, 
-		// but we may also want to process editable geos as well
-		TArray<HAPI_GeoInfo> GeoInfos;
+			if (FoundHoudiniOutput && *FoundHoudiniOutput && !(*FoundHoudiniOutput)->IsPendingKill())
+				IsFoundOutputValid = true;
 
-		// Get the Display Geo's info
-		HAPI_GeoInfo DisplayHapiGeoInfo;
-		FHoudiniApi::GeoInfo_Init(&DisplayHapiGeoInfo);
-		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetDisplayGeoInfo(
-			FHoudiniEngine::Get().GetSession(), CurrentHapiObjectInfo.nodeId, &DisplayHapiGeoInfo))
-		{
-			HOUDINI_LOG_MESSAGE(
-				TEXT("Creating Static Meshes: Object [%d %s] unable to retrieve GeoInfo, - skipping."),
-				CurrentHapiObjectInfo.nodeId, *CurrentObjectName);		
 		}
 		else
 		{
-			// Add the display geo info to the array
-			GeoInfos.Add(DisplayHapiGeoInfo);
-		}
+			// Look in the previous outputs if we have a match
+			FoundHoudiniOutput = InOldOutputs.FindByPredicate(
+				[currentHGPO](UHoudiniOutput* Output) { return Output ? Output->HeightfieldMatch(currentHGPO, true) : false; });
+			
+			if (FoundHoudiniOutput && *FoundHoudiniOutput && !(*FoundHoudiniOutput)->IsPendingKill())
+				IsFoundOutputValid = true;
+
+			// If we dont have a match in the old maps, also look in the newly created outputs
+			if (!IsFoundOutputValid)
+			{
+				FoundHoudiniOutput = OutNewOutputs.FindByPredicate(
+					[currentHGPO](UHoudiniOutput* Output) { return Output ? Output->HeightfieldMatch(currentHGPO, false) : false; });
 
-		// Handle the editable nodes for this geo
-		// Start by getting the number of editable nodes
-		int32 EditableNodeCount = 0;
-		HOUDINI_CHECK_ERROR(FHoudiniApi::ComposeChildNodeList(
-			FHoudiniEngine::Get().GetSession(),
-			CurrentHapiObjectInfo.nodeId, HAPI_NODETYPE_SOP, HAPI_NODEFLAGS_EDITABLE,
-			true, &EditableNodeCount));
+				if (FoundHoudiniOutput && *FoundHoudiniOutput && !(*FoundHoudiniOutput)->IsPendingKill())
+					IsFoundOutputValid = true;
+			}
+		}
 
-		if (EditableNodeCount > 0)
+		UHoudiniOutput * HoudiniOutput = nullptr;
+		if (IsFoundOutputValid)
 		{
-			TArray< HAPI_NodeId > EditableNodeIds;
-			EditableNodeIds.SetNumUninitialized(EditableNodeCount);
-			HOUDINI_CHECK_ERROR(FHoudiniApi::GetComposedChildNodeList(
-				FHoudiniEngine::Get().GetSession(), 
-				AssetId, EditableNodeIds.GetData(), EditableNodeCount));
+			// We can reuse the existing output
+			HoudiniOutput = *FoundHoudiniOutput;
+			HoudiniOutput->SetIsUpdating(true);
+			// Compare the part with its previous cook, its meshes are reused if it hasn't changed
+			UpdateUnchangedPartFlags(currentHGPO, HoudiniOutput->GetHoudiniGeoPartObjects());
+			// Transfer this output from the old array to the new one
+			InOldOutputs.Remove(HoudiniOutput);
+		}
+		else
+		{
+			// We couldn't find a valid output object, so create a new one
 
-			for (int32 nEditable = 0; nEditable < EditableNodeCount; nEditable++)
+			// If the current part is a volume, only create a new output object
+			// if the volume's name is "height", if not store the HGPO aside
+			if (currentHGPO.Type == EHoudiniPartType::Volume
+				&& !currentHGPO.VolumeName.Equals(HAPI_UNREAL_LANDSCAPE_HEIGHT_VOLUME_NAME, ESearchCase::IgnoreCase))
 			{
-				HAPI_GeoInfo CurrentEditableGeoInfo;
-				FHoudiniApi::GeoInfo_Init(&CurrentEditableGeoInfo);
-				HOUDINI_CHECK_ERROR(FHoudiniApi::GetGeoInfo(
-					FHoudiniEngine::Get().GetSession(), 
-					EditableNodeIds[nEditable], &CurrentEditableGeoInfo));
-
-				// Do not process the main display geo twice!
-				if (CurrentEditableGeoInfo.isDisplayGeo)
-					continue;
+				UnassignedVolumeParts.Add(currentHGPO);
+				continue;
+			}
 
-				// We only handle editable curves for now
-				if (CurrentEditableGeoInfo.type != HAPI_GEOTYPE_CURVE)
-					continue;
+			// Create a new output object
+			//FString OutputName = TEXT("Output") + FString::FromInt(OutputIdx++);
+			HoudiniOutput = NewObject<UHoudiniOutput>(
+				InOuterObject,
+				UHoudiniOutput::StaticClass(),
+				NAME_None,//FName(*OutputName),
+				RF_NoFlags);
 
-				// Add this geo to the geo info array
-				GeoInfos.Add(CurrentEditableGeoInfo);
+			// Make sure the created object is valid 
+			if (!HoudiniOutput || HoudiniOutput->IsPendingKill())
+			{
+				//HOUDINI_LOG_WARNING("Failed to create asset output");
+				continue;
 			}
+
+			// Mark if the HoudiniOutput is editable
+			HoudiniOutput->SetIsEditableNode(currentHGPO.bIsEditable);
 		}
 
-		// Handle the templated nodes if desired
-		if (InOutputTemplatedGeos)
-		{
-			// Start by getting the number of templated nodes
-			int32 TemplatedNodeCount = 0;
-			HOUDINI_CHECK_ERROR(FHoudiniApi::ComposeChildNodeList(
-				FHoudiniEngine::Get().GetSession(),
-				CurrentHapiObjectInfo.nodeId,
-				HAPI_NODETYPE_SOP, HAPI_NODEFLAGS_TEMPLATED,
-				true, &TemplatedNodeCount));
+		// Add the HGPO to the output
+		HoudiniOutput->AddNewHGPO(currentHGPO);
+		// Add this output object to the new ouput array
+		OutNewOutputs.AddUnique(HoudiniOutput);
+	}
 
-			if (TemplatedNodeCount > 0)
-			{
-				TArray<HAPI_NodeId> TemplatedNodeIds;
-				TemplatedNodeIds.SetNumUninitialized(TemplatedNodeCount);
-				HOUDINI_CHECK_ERROR(FHoudiniApi::GetComposedChildNodeList(
+	// Update the output/HGPO associations from the map
+	// Clear the old HGPO since we don't need them anymore
+	for (auto& CurrentOuput : OutNewOutputs)
+	{
+		if (!CurrentOuput || CurrentOuput->IsPendingKill())
+			continue;
+
+		CurrentOuput->DeleteAllStaleHGPOs();
+	}
+
+	// If we have unassigned volumes,
+	// try to find their corresponding output
+	if (UnassignedVolumeParts.Num() > 0)
+	{
+		for (auto& currentVolumeHGPO : UnassignedVolumeParts)
+		{
+			UHoudiniOutput ** FoundHoudiniOutput = OutNewOutputs.FindByPredicate(
+				[currentVolumeHGPO](UHoudiniOutput* Output) 
+				{
+					return Output ? Output->HeightfieldMatch(currentVolumeHGPO, false) : false;
+				});
+
+			if (!FoundHoudiniOutput || !(*FoundHoudiniOutput) || (*FoundHoudiniOutput)->IsPendingKill())
+			{
+				// Skip - consider this volume as invalid
+				continue;
+			}
+
+			// Add this HGPO to the output
+			(*FoundHoudiniOutput)->AddNewHGPO(currentVolumeHGPO);
+		} 
+	}
+
+	// All our output objects now have their HGPO assigned
+	// We can now parse them to update the output type
+	for (auto& Output : OutNewOutputs)
+	{
+		Output->UpdateOutputType();
+	}
+
+	return true;
+}
+
+bool
+FHoudiniOutputTranslator::DiscoverAllGeoPartObjects(
+	const HAPI_NodeId& AssetId,
+	const bool& InOutputTemplatedGeos,
+	TArray<FHoudiniGeoPartObject>& OutHGPOs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniOutputTranslator::DiscoverAllGeoPartObjects"));
+	FHoudiniCookPhaseScope PhaseScope(EHoudiniCookPhase::DiscoverOutputs);
+
+	const double DiscoveryStartTime = FPlatformTime::Seconds();
+
+	// Get the AssetInfo
+	HAPI_AssetInfo AssetInfo;
+	FHoudiniApi::AssetInfo_Init(&AssetInfo);
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetAssetInfo(
+		FHoudiniEngine::Get().GetSession(), AssetId, &AssetInfo), false);
+
+	FString CurrentAssetName;
+	{
+		FHoudiniEngineString hapiSTR(AssetInfo.nameSH);
+		hapiSTR.ToFString(CurrentAssetName);
+	}
+
+	// Retrieve information about each object contained within our asset.
+	TArray<HAPI_ObjectInfo> ObjectInfos;
+	if (!FHoudiniEngineUtils::HapiGetObjectInfos(AssetId, ObjectInfos))
+		return false;
+
+	// Retrieve transforms for each object in this asset.
+	TArray<HAPI_Transform> ObjectTransforms;
+	if (!FHoudiniEngineUtils::HapiGetObjectTransforms(AssetId, ObjectTransforms))
+		return false;
+
+	// HAPI serializes the calls made on a session, so the discovery is done on the calling thread
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	const bool bReuseUnchangedParts = HoudiniRuntimeSettings && HoudiniRuntimeSettings->bReuseUnchangedParts;
+
+	// ----------------------------------------------------
+	// Objects: build the list of geos to process
+	// ----------------------------------------------------
+	// In most case, it will only be the display geo, 
+	// but we may also want to process editable geos as well
+	TArray<FHoudiniObjectInfo> CachedObjectInfos;
+	TArray<FTransform> ObjectTransformMatrices;
+	TArray<TArray<HAPI_GeoInfo>> ObjectGeoInfos;
+	CachedObjectInfos.SetNum(ObjectInfos.Num());
+	ObjectTransformMatrices.SetNum(ObjectInfos.Num());
+	ObjectGeoInfos.SetNum(ObjectInfos.Num());
+
+	for (int32 ObjectIdx = 0; ObjectIdx < ObjectInfos.Num(); ObjectIdx++)
+	{
+		const HAPI_ObjectInfo& CurrentHapiObjectInfo = ObjectInfos[ObjectIdx];
+		CacheObjectInfo(CurrentHapiObjectInfo, CachedObjectInfos[ObjectIdx]);
+		FHoudiniEngineUtils::TranslateHapiTransform(ObjectTransforms[ObjectIdx], ObjectTransformMatrices[ObjectIdx]);
+
+		TArray<HAPI_GeoInfo>& GeoInfos = ObjectGeoInfos[ObjectIdx];
+
+		// Get the Display Geo's info
+		HAPI_GeoInfo DisplayHapiGeoInfo;
+		FHoudiniApi::GeoInfo_Init(&DisplayHapiGeoInfo);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetDisplayGeoInfo(
+			FHoudiniEngine::Get().GetSession(), CurrentHapiObjectInfo.nodeId, &DisplayHapiGeoInfo))
+		{
+			HOUDINI_LOG_MESSAGE(
+				TEXT("Creating Static Meshes: Object [%d %s] unable to retrieve GeoInfo, - skipping."),
+				CurrentHapiObjectInfo.nodeId, *CachedObjectInfos[ObjectIdx].Name);
+		}
+		else
+		{
+			// Add the display geo info to the array
+			GeoInfos.Add(DisplayHapiGeoInfo);
+		}
+
+		// Handle the editable nodes for this geo
+		// Start by getting the number of editable nodes
+		int32 EditableNodeCount = 0;
+		HOUDINI_CHECK_ERROR(FHoudiniApi::ComposeChildNodeList(
+			FHoudiniEngine::Get().GetSession(),
+			CurrentHapiObjectInfo.nodeId, HAPI_NODETYPE_SOP, HAPI_NODEFLAGS_EDITABLE,
+			true, &EditableNodeCount));
+
+		if (EditableNodeCount > 0)
+		{
+			TArray< HAPI_NodeId > EditableNodeIds;
+			EditableNodeIds.SetNumUninitialized(EditableNodeCount);
+			HOUDINI_CHECK_ERROR(FHoudiniApi::GetComposedChildNodeList(
+				FHoudiniEngine::Get().GetSession(), 
+				AssetId, EditableNodeIds.GetData(), EditableNodeCount));
+
+			for (int32 nEditable = 0; nEditable < EditableNodeCount; nEditable++)
+			{
+				HAPI_GeoInfo CurrentEditableGeoInfo;
+				FHoudiniApi::GeoInfo_Init(&CurrentEditableGeoInfo);
+				HOUDINI_CHECK_ERROR(FHoudiniApi::GetGeoInfo(
+					FHoudiniEngine::Get().GetSession(), 
+					EditableNodeIds[nEditable], &CurrentEditableGeoInfo));
+
+				// Do not process the main display geo twice!
+				if (CurrentEditableGeoInfo.isDisplayGeo)
+					continue;
+
+				// We only handle editable curves for now
+				if (CurrentEditableGeoInfo.type != HAPI_GEOTYPE_CURVE)
+					continue;
+
+				// Add this geo to the geo info array
+				GeoInfos.Add(CurrentEditableGeoInfo);
+			}
+		}
+
+		// Handle the templated nodes if desired
+		if (InOutputTemplatedGeos)
+		{
+			// Start by getting the number of templated nodes
+			int32 TemplatedNodeCount = 0;
+			HOUDINI_CHECK_ERROR(FHoudiniApi::ComposeChildNodeList(
+				FHoudiniEngine::Get().GetSession(),
+				CurrentHapiObjectInfo.nodeId,
+				HAPI_NODETYPE_SOP, HAPI_NODEFLAGS_TEMPLATED,
+				true, &TemplatedNodeCount));
+
+			if (TemplatedNodeCount > 0)
+			{
+				TArray<HAPI_NodeId> TemplatedNodeIds;
+				TemplatedNodeIds.SetNumUninitialized(TemplatedNodeCount);
+				HOUDINI_CHECK_ERROR(FHoudiniApi::GetComposedChildNodeList(
 					FHoudiniEngine::Get().GetSession(),
 					CurrentHapiObjectInfo.nodeId, TemplatedNodeIds.GetData(), TemplatedNodeCount));
 
@@ -970,530 +1292,490 @@ FHoudiniOutputTranslator::BuildAllOutputs(
 			}
 		}
 
-		// Iterates through the geos we want to process
-		for (int32 GeoIdx = 0; GeoIdx < GeoInfos.Num(); GeoIdx++)
+		// Cook editable/templated nodes to get their parts.
+		for (HAPI_GeoInfo& CurrentHapiGeoInfo : GeoInfos)
 		{
-			// Cook editable/templated nodes to get their parts.
-			const HAPI_GeoInfo& CurrentHapiGeoInfo = GeoInfos[GeoIdx];
-			if ((CurrentHapiGeoInfo.isEditable && CurrentHapiGeoInfo.partCount <= 0)
-				|| (CurrentHapiGeoInfo.isTemplated && CurrentHapiGeoInfo.partCount <= 0))
+			const bool bNeedsCook = (CurrentHapiGeoInfo.isEditable || CurrentHapiGeoInfo.isTemplated) && CurrentHapiGeoInfo.partCount <= 0;
+
+			// Templated geos are cooked manually before getting their parts
+			if (bNeedsCook || (CurrentHapiGeoInfo.isTemplated && InOutputTemplatedGeos))
 			{
-				//HAPI_CookOptions CookOptions = FHoudiniEngine::GetDefaultCookOptions();
-				//FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, &CookOptions);
 				FHoudiniEngineUtils::HapiCookNode(CurrentHapiGeoInfo.nodeId, nullptr, true);
 
 				HOUDINI_CHECK_ERROR(FHoudiniApi::GetGeoInfo(
 					FHoudiniEngine::Get().GetSession(),
 					CurrentHapiGeoInfo.nodeId,
-					&GeoInfos[GeoIdx]));
+					&CurrentHapiGeoInfo));
 			}
+		}
+	}
 
-			// Cache/convert the display geo's info
-			FHoudiniGeoInfo CurrentGeoInfo;
-			CacheGeoInfo(CurrentHapiGeoInfo, CurrentGeoInfo);
+	// ----------------------------------------------------
+	// Geos: flatten them and get their node path
+	// ----------------------------------------------------
+	struct FDiscoveredGeo
+	{
+		int32 ObjectIdx = -1;
+		HAPI_GeoInfo HapiGeoInfo;
+		FHoudiniGeoInfo GeoInfo;
+		// Node path of the geo relative to the asset, the HGPO's node paths are suffixed with their part id
+		FString NodePath;
+		// Split groups shared by the geo's non-instanced mesh parts
+		TArray<FString> SplitGroups;
+		bool bNeedsSplitGroups = false;
+	};
+
+	TArray<FDiscoveredGeo> Geos;
+	for (int32 ObjectIdx = 0; ObjectIdx < ObjectGeoInfos.Num(); ObjectIdx++)
+	{
+		for (const HAPI_GeoInfo& CurrentHapiGeoInfo : ObjectGeoInfos[ObjectIdx])
+		{
+			FDiscoveredGeo& Geo = Geos.AddDefaulted_GetRef();
+			Geo.ObjectIdx = ObjectIdx;
+			Geo.HapiGeoInfo = CurrentHapiGeoInfo;
+			CacheGeoInfo(CurrentHapiGeoInfo, Geo.GeoInfo);
+		}
+	}
 
-			// Simply create an empty array for this geo's group names
-			// We might need it later for splitting
-			TArray<FString> GeoGroupNames;
-			bool HasSocketGroups = false;
+	for (int32 GeoIdx = 0; GeoIdx < Geos.Num(); GeoIdx++)
+	{
+		FDiscoveredGeo& Geo = Geos[GeoIdx];
+		if (Geo.GeoInfo.PartCount <= 0)
+			continue;
 
-			// Iterate on this geo's parts
-			for (int32 PartId = 0; PartId < CurrentGeoInfo.PartCount; ++PartId)
+		if (Geo.HapiGeoInfo.nodeId == AssetId)
+		{
+			// This is a SOP asset, just use the asset name in this case
+			HAPI_NodeInfo AssetNodeInfo;
+			FHoudiniApi::NodeInfo_Init(&AssetNodeInfo);
+			if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetNodeInfo(
+				FHoudiniEngine::Get().GetSession(), AssetInfo.nodeId, &AssetNodeInfo))
 			{
-				// Get part information.
-				HAPI_PartInfo CurrentHapiPartInfo;
-				FHoudiniApi::PartInfo_Init(&CurrentHapiPartInfo);
-
-				// If the geo is templated, cook it manually
-				if (CurrentHapiGeoInfo.isTemplated && InOutputTemplatedGeos)
-				{
-					//HAPI_CookOptions CookOptions = FHoudiniEngine::GetDefaultCookOptions();
-					//FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, &CookOptions);
-					FHoudiniEngineUtils::HapiCookNode(CurrentHapiGeoInfo.nodeId, nullptr, true);
-				}
-
-				bool bPartInfoFailed = false;
-				if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetPartInfo(
-					FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, PartId, &CurrentHapiPartInfo))
-				{
-					bPartInfoFailed = true;
+				FHoudiniEngineString::ToFString(AssetNodeInfo.nameSH, Geo.NodePath);
+			}
+		}
+		else
+		{
+			// This is an OBJ asset, use the path to this geo relative to the asset
+			FHoudiniEngineUtils::HapiGetNodePath(Geo.HapiGeoInfo.nodeId, AssetId, Geo.NodePath);
+		}
+	}
 
-					// If the geo is templated, attempt to cook it manually
-					if(CurrentHapiGeoInfo.isTemplated && InOutputTemplatedGeos)
-					{
-						//HAPI_CookOptions CookOptions = FHoudiniEngine::GetDefaultCookOptions();
-						//FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, nullptr);
-						FHoudiniEngineUtils::HapiCookNode(CurrentHapiGeoInfo.nodeId, nullptr, true);
+	// ----------------------------------------------------
+	// Parts: get their infos and types
+	// ----------------------------------------------------
+	struct FDiscoveredPart
+	{
+		int32 GeoIdx = -1;
+		int32 PartId = -1;
+		HAPI_PartInfo HapiPartInfo;
+		bool bValid = false;
+		FHoudiniGeoPartObject HGPO;
+	};
+
+	TArray<FDiscoveredPart> Parts;
+	for (int32 GeoIdx = 0; GeoIdx < Geos.Num(); GeoIdx++)
+	{
+		for (int32 PartId = 0; PartId < Geos[GeoIdx].GeoInfo.PartCount; ++PartId)
+		{
+			FDiscoveredPart& Part = Parts.AddDefaulted_GetRef();
+			Part.GeoIdx = GeoIdx;
+			Part.PartId = PartId;
+		}
+	}
 
-						HOUDINI_CHECK_ERROR(FHoudiniApi::GetGeoInfo(
-							FHoudiniEngine::Get().GetSession(),
-							CurrentHapiGeoInfo.nodeId,
-							&GeoInfos[GeoIdx]));
+	for (int32 PartIdx = 0; PartIdx < Parts.Num(); PartIdx++)
+	{
+		FDiscoveredPart& Part = Parts[PartIdx];
+		const FDiscoveredGeo& Geo = Geos[Part.GeoIdx];
+		const HAPI_ObjectInfo& CurrentHapiObjectInfo = ObjectInfos[Geo.ObjectIdx];
+		const HAPI_GeoInfo& CurrentHapiGeoInfo = Geo.HapiGeoInfo;
+		const FString& CurrentObjectName = CachedObjectInfos[Geo.ObjectIdx].Name;
+		const int32 PartId = Part.PartId;
+
+		// Get part information.
+		HAPI_PartInfo& CurrentHapiPartInfo = Part.HapiPartInfo;
+		FHoudiniApi::PartInfo_Init(&CurrentHapiPartInfo);
+
+		bool bPartInfoFailed = false;
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetPartInfo(
+			FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, PartId, &CurrentHapiPartInfo))
+		{
+			bPartInfoFailed = true;
 
-						if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetPartInfo(
-							FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, PartId, &CurrentHapiPartInfo))
-						{
-							// We managed to get the templated part infos after cooking
-							bPartInfoFailed = false;
-						}
-					}
-				}
+			// If the geo is templated, attempt to cook it manually
+			if(CurrentHapiGeoInfo.isTemplated && InOutputTemplatedGeos)
+			{
+				FHoudiniEngineUtils::HapiCookNode(CurrentHapiGeoInfo.nodeId, nullptr, true);
 
-				if (bPartInfoFailed)
+				if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetPartInfo(
+					FHoudiniEngine::Get().GetSession(), CurrentHapiGeoInfo.nodeId, PartId, &CurrentHapiPartInfo))
 				{
-					// Error retrieving part info.
-					HOUDINI_LOG_MESSAGE(
-						TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d] unable to retrieve PartInfo - skipping."),
-						CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId);
-					continue;
+					// We managed to get the templated part infos after cooking
+					bPartInfoFailed = false;
 				}
+			}
+		}
+
+		if (bPartInfoFailed)
+		{
+			// Error retrieving part info.
+			HOUDINI_LOG_MESSAGE(
+				TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d] unable to retrieve PartInfo - skipping."),
+				CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId);
+			continue;
+		}
 
-				// Convert/cache the part info
-				FHoudiniPartInfo CurrentPartInfo;
-				CachePartInfo(CurrentHapiPartInfo, CurrentPartInfo);
+		// Convert/cache the part info
+		FHoudiniPartInfo CurrentPartInfo;
+		CachePartInfo(CurrentHapiPartInfo, CurrentPartInfo);
 
-				// Retrieve part name.
-				FString CurrentPartName = CurrentPartInfo.Name;
+		// Retrieve part name.
+		FString CurrentPartName = CurrentPartInfo.Name;
 
-				// Unsupported/Invalid part
-				if (CurrentPartInfo.Type == EHoudiniPartType::Invalid)
-					continue;
+		// Unsupported/Invalid part
+		if (CurrentPartInfo.Type == EHoudiniPartType::Invalid)
+			continue;
 
-				// Update part/instancer type from the part infos
-				EHoudiniPartType CurrentPartType = EHoudiniPartType::Invalid;
-				EHoudiniInstancerType CurrentInstancerType = EHoudiniInstancerType::Invalid;
-				switch (CurrentHapiPartInfo.type)
+		// Update part/instancer type from the part infos
+		EHoudiniPartType CurrentPartType = EHoudiniPartType::Invalid;
+		EHoudiniInstancerType CurrentInstancerType = EHoudiniInstancerType::Invalid;
+		switch (CurrentHapiPartInfo.type)
+		{
+			case HAPI_PARTTYPE_BOX:
+			case HAPI_PARTTYPE_SPHERE:
+			case HAPI_PARTTYPE_MESH:
+			{
+				if (CurrentHapiGeoInfo.type == HAPI_GEOTYPE_CURVE)
 				{
-					case HAPI_PARTTYPE_BOX:
-					case HAPI_PARTTYPE_SPHERE:
-					case HAPI_PARTTYPE_MESH:
+					// Closed curve will be seen as mesh
+					CurrentPartType = EHoudiniPartType::Curve;
+				}
+				else
+				{
+					CurrentPartType = EHoudiniPartType::Mesh;
+					
+					if (CurrentHapiObjectInfo.isInstancer)
 					{
-						if (CurrentHapiGeoInfo.type == HAPI_GEOTYPE_CURVE)
+						if (FHoudiniEngineUtils::IsAttributeInstancer(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentInstancerType))
 						{
-							// Closed curve will be seen as mesh
-							CurrentPartType = EHoudiniPartType::Curve;
+							// That part is actually an attribute instancer
+							CurrentPartType = EHoudiniPartType::Instancer;
+							// Instancer type is set by IsAttributeInstancer
 						}
 						else
 						{
-							CurrentPartType = EHoudiniPartType::Mesh;
-							
-							if (CurrentHapiObjectInfo.isInstancer)
-							{
-								if (FHoudiniEngineUtils::IsAttributeInstancer(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentInstancerType))
-								{
-									// That part is actually an attribute instancer
-									CurrentPartType = EHoudiniPartType::Instancer;
-									// Instancer type is set by IsAttributeInstancer
-								}
-								else
-								{
-									// That part is actually an instancer
-									CurrentPartType = EHoudiniPartType::Instancer;
-									CurrentInstancerType = EHoudiniInstancerType::ObjectInstancer;
-								}
-								
-							}
-							else if (CurrentHapiPartInfo.vertexCount <= 0 && CurrentHapiPartInfo.pointCount <= 0)
-							{
-								// No points, no vertices, we're likely invalid
-								CurrentPartType = EHoudiniPartType::Invalid;
-								HOUDINI_LOG_MESSAGE(
-									TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] is a mesh with no points or vertices - skipping."),
-									CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
-							}
-							else if (CurrentHapiPartInfo.vertexCount <= 0)
-							{
-								// This is not an instancer, we do not have vertices, but we have points
-								// Maybe this is a point cloud with attribute override instancing
-								if(FHoudiniEngineUtils::IsAttributeInstancer(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentInstancerType))
-								{
-									// Mark it as an instancer
-									CurrentPartType = EHoudiniPartType::Instancer;
-									// Instancer type is set by IsAttributeInstancer
-									//CurrentInstancerType = EHoudiniInstancerType::OldSchoolAttributeInstancer;
-								}
-								else
-								{
-									// No vertices, not an instancer, just a point cloud, consider ourself as invalid
-									CurrentPartType = EHoudiniPartType::Invalid;
-									HOUDINI_LOG_MESSAGE(
-										TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] is a point cloud mesh - skipping."),
-										CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
-								}
-							}
+							// That part is actually an instancer
+							CurrentPartType = EHoudiniPartType::Instancer;
+							CurrentInstancerType = EHoudiniInstancerType::ObjectInstancer;
 						}
+						
 					}
-					break;
-
-					case HAPI_PARTTYPE_CURVE:
+					else if (CurrentHapiPartInfo.vertexCount <= 0 && CurrentHapiPartInfo.pointCount <= 0)
 					{
-						// Make sure that this curve is not an an attribute instancer!
-						if (FHoudiniEngineUtils::IsAttributeInstancer(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentInstancerType))
+						// No points, no vertices, we're likely invalid
+						CurrentPartType = EHoudiniPartType::Invalid;
+						HOUDINI_LOG_MESSAGE(
+							TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] is a mesh with no points or vertices - skipping."),
+							CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
+					}
+					else if (CurrentHapiPartInfo.vertexCount <= 0)
+					{
+						// This is not an instancer, we do not have vertices, but we have points
+						// Maybe this is a point cloud with attribute override instancing
+						if(FHoudiniEngineUtils::IsAttributeInstancer(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentInstancerType))
 						{
-							// Mark the part as an instancer it as an instancer
+							// Mark it as an instancer
 							CurrentPartType = EHoudiniPartType::Instancer;
 							// Instancer type is set by IsAttributeInstancer
-							//CurrentInstancerType = EHoudiniInstancerType::OldSchoolAttributeInstancer;
 						}
 						else
 						{
-							// The curve is a curve!
-							CurrentPartType = EHoudiniPartType::Curve;
+							// No vertices, not an instancer, just a point cloud, consider ourself as invalid
+							CurrentPartType = EHoudiniPartType::Invalid;
+							HOUDINI_LOG_MESSAGE(
+								TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] is a point cloud mesh - skipping."),
+								CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
 						}
 					}
-						break;
-
-					case HAPI_PARTTYPE_INSTANCER:
-						// This is a packed primitive instancer
-						CurrentPartType = EHoudiniPartType::Instancer;
-						CurrentInstancerType = EHoudiniInstancerType::PackedPrimitive;
-						break;
-
-					case HAPI_PARTTYPE_VOLUME:
-						// Volume data, likely a Heightfield height / mask	
-						CurrentPartType = EHoudiniPartType::Volume;
-						break;
-
-					default:
-						// Unsupported Part Type
-						break;
 				}
+			}
+			break;
 
-				// There are no vertices AND no points and this part is not a packed prim instancer
-				if ((CurrentPartInfo.VertexCount <= 0 && CurrentPartInfo.PointCount <= 0)
-					&& (CurrentPartType != EHoudiniPartType::Instancer || CurrentInstancerType != EHoudiniInstancerType::PackedPrimitive))
+			case HAPI_PARTTYPE_CURVE:
+			{
+				// Make sure that this curve is not an an attribute instancer!
+				if (FHoudiniEngineUtils::IsAttributeInstancer(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CurrentInstancerType))
 				{
-					HOUDINI_LOG_MESSAGE(
-						TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] no points or vertices found - skipping."),
-						CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
-					continue;
+					// Mark the part as an instancer it as an instancer
+					CurrentPartType = EHoudiniPartType::Instancer;
+					// Instancer type is set by IsAttributeInstancer
 				}
-
-				// This is an instancer with no points.
-				if (CurrentHapiObjectInfo.isInstancer && CurrentHapiPartInfo.pointCount <= 0)
+				else
 				{
-					HOUDINI_LOG_MESSAGE(
-						TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] is instancer but has 0 points - skipping."),
-						CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
-					continue;
+					// The curve is a curve!
+					CurrentPartType = EHoudiniPartType::Curve;
 				}
+			}
+				break;
 
-				// Ignore invalid parts
-				if (CurrentPartType == EHoudiniPartType::Invalid)
-					continue;
-
-				// Build the HGPO corresponding to this part
-				FHoudiniGeoPartObject currentHGPO;
-				currentHGPO.AssetId = AssetId;
-				currentHGPO.AssetName = CurrentAssetName;
+			case HAPI_PARTTYPE_INSTANCER:
+				// This is a packed primitive instancer
+				CurrentPartType = EHoudiniPartType::Instancer;
+				CurrentInstancerType = EHoudiniInstancerType::PackedPrimitive;
+				break;
 
-				currentHGPO.ObjectId = CurrentHapiObjectInfo.nodeId;
-				currentHGPO.ObjectName = CurrentObjectName;
+			case HAPI_PARTTYPE_VOLUME:
+				// Volume data, likely a Heightfield height / mask	
+				CurrentPartType = EHoudiniPartType::Volume;
+				break;
 
-				currentHGPO.GeoId = CurrentHapiGeoInfo.nodeId;
+			default:
+				// Unsupported Part Type
+				break;
+		}
 
-				currentHGPO.PartId = CurrentHapiPartInfo.id;
+		// There are no vertices AND no points and this part is not a packed prim instancer
+		if ((CurrentPartInfo.VertexCount <= 0 && CurrentPartInfo.PointCount <= 0)
+			&& (CurrentPartType != EHoudiniPartType::Instancer || CurrentInstancerType != EHoudiniInstancerType::PackedPrimitive))
+		{
+			HOUDINI_LOG_MESSAGE(
+				TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] no points or vertices found - skipping."),
+				CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
+			continue;
+		}
 
-				currentHGPO.Type = CurrentPartType;
-				currentHGPO.InstancerType = CurrentInstancerType;
+		// This is an instancer with no points.
+		if (CurrentHapiObjectInfo.isInstancer && CurrentHapiPartInfo.pointCount <= 0)
+		{
+			HOUDINI_LOG_MESSAGE(
+				TEXT("Creating Static Meshes: Object [%d %s], Geo [%d], Part [%d %s] is instancer but has 0 points - skipping."),
+				CurrentHapiObjectInfo.nodeId, *CurrentObjectName, CurrentHapiGeoInfo.nodeId, PartId, *CurrentPartName);
+			continue;
+		}
 
-				currentHGPO.TransformMatrix = TransformMatrix;
+		// Ignore invalid parts
+		if (CurrentPartType == EHoudiniPartType::Invalid)
+			continue;
 
-				currentHGPO.NodePath = TEXT("");
+		// Build the HGPO corresponding to this part
+		FHoudiniGeoPartObject& currentHGPO = Part.HGPO;
+		currentHGPO.AssetId = AssetId;
+		currentHGPO.AssetName = CurrentAssetName;
 
-				currentHGPO.bIsVisible = CurrentHapiObjectInfo.isVisible && !CurrentHapiPartInfo.isInstanced;
-				currentHGPO.bIsEditable = CurrentHapiGeoInfo.isEditable;
-				currentHGPO.bIsInstanced = CurrentHapiPartInfo.isInstanced;
-				// Never consider a display geo as templated!
-				currentHGPO.bIsTemplated = CurrentHapiGeoInfo.isDisplayGeo ? false : CurrentHapiGeoInfo.isTemplated;
+		currentHGPO.ObjectId = CurrentHapiObjectInfo.nodeId;
+		currentHGPO.ObjectName = CurrentObjectName;
 
-				currentHGPO.bHasGeoChanged = CurrentHapiGeoInfo.hasGeoChanged;
-				currentHGPO.bHasPartChanged = CurrentHapiPartInfo.hasChanged;
-				currentHGPO.bHasMaterialsChanged = CurrentHapiGeoInfo.hasMaterialChanged;
-				currentHGPO.bHasTransformChanged = CurrentHapiObjectInfo.hasTransformChanged;
-				
-				// Copy the HAPI info caches 
-				currentHGPO.ObjectInfo = CurrentObjectInfo;
-				currentHGPO.GeoInfo = CurrentGeoInfo;
-				currentHGPO.PartInfo = CurrentPartInfo;
+		currentHGPO.GeoId = CurrentHapiGeoInfo.nodeId;
 
-				// We only support meshes for templated geos
-				if (currentHGPO.bIsTemplated && (CurrentPartType != EHoudiniPartType::Mesh))
-					continue;
+		currentHGPO.PartId = CurrentHapiPartInfo.id;
+		currentHGPO.PartName = CurrentPartName;
 
-				// Update the HGPO's node path
-				FHoudiniEngineUtils::HapiGetNodePath(currentHGPO, currentHGPO.NodePath);
+		currentHGPO.Type = CurrentPartType;
+		currentHGPO.InstancerType = CurrentInstancerType;
 
-				// Try to get the custom part name from attribute
-				FString CustomPartName;
-				if (FHoudiniOutputTranslator::GetCustomPartNameFromAttribute(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, CustomPartName))
-					currentHGPO.SetCustomPartName(CustomPartName);
-				else
-					currentHGPO.PartName = CurrentPartName;
+		currentHGPO.TransformMatrix = ObjectTransformMatrices[Geo.ObjectIdx];
 
-				//
-				// Mesh Only - Extract split groups
-				// 
-				// Extract the group names used by this part to see if it will require splitting
-				// Only meshes can be split, via their primitive groups
-				TArray< FString > SplitGroupNames;
-				if (CurrentPartType == EHoudiniPartType::Mesh)
-				{
-					if (!CurrentHapiPartInfo.isInstanced && GeoGroupNames.Num() > 0)
-					{
-						// We are not instanced and already have extracted the geo's group names
-						// We can simply reuse the Geo group names / socket groups
-						currentHGPO.SplitGroups = GeoGroupNames;
-					}
-					else
-					{
-						// We need to get the primitive group names from HAPI
-						int32 GroupCount = 0;
-						TArray<FString> GroupNames;
-						if (!FHoudiniEngineUtils::HapiGetGroupNames(
-							CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id,
-							HAPI_GROUPTYPE_PRIM, CurrentHapiPartInfo.isInstanced,
-							GroupNames))
-						{
-							GroupCount = 0;
-							GroupNames.Empty();
-						}
+		currentHGPO.NodePath = TEXT("");
 
-						// Convert the string handles to FStrings
-						for (const FString& GroupName : GroupNames)
-						{
-							FString LodGroup = HAPI_UNREAL_GROUP_LOD_PREFIX;
-							FString CollisionGroup = HAPI_UNREAL_GROUP_INVISIBLE_COLLISION_PREFIX;
-							FString RenderedCollisionGroup = HAPI_UNREAL_GROUP_RENDERED_COLLISION_PREFIX;
-							if (GroupName.StartsWith(LodGroup, ESearchCase::IgnoreCase)
-								|| GroupName.StartsWith(CollisionGroup, ESearchCase::IgnoreCase)
-								|| GroupName.StartsWith(RenderedCollisionGroup, ESearchCase::IgnoreCase))
-								//|| GroupName.StartsWith(HAPI_UNREAL_GROUP_USER_SPLIT_PREFIX, ESearchCase::IgnoreCase))
-							{
-								// Split by collisions / lods
-								currentHGPO.SplitGroups.Add(GroupName);
-							}
-						}
+		currentHGPO.bIsVisible = CurrentHapiObjectInfo.isVisible && !CurrentHapiPartInfo.isInstanced;
+		currentHGPO.bIsEditable = CurrentHapiGeoInfo.isEditable;
+		currentHGPO.bIsInstanced = CurrentHapiPartInfo.isInstanced;
+		// Never consider a display geo as templated!
+		currentHGPO.bIsTemplated = CurrentHapiGeoInfo.isDisplayGeo ? false : CurrentHapiGeoInfo.isTemplated;
 
-						// Sort the Group name array by name, 
-						// this will order the LODs and other incremental group names
-						currentHGPO.SplitGroups.Sort();
+		currentHGPO.bHasGeoChanged = CurrentHapiGeoInfo.hasGeoChanged;
+		currentHGPO.bHasPartChanged = CurrentHapiPartInfo.hasChanged;
+		currentHGPO.bHasMaterialsChanged = CurrentHapiGeoInfo.hasMaterialChanged;
+		currentHGPO.bHasTransformChanged = CurrentHapiObjectInfo.hasTransformChanged;
+		
+		// Copy the HAPI info caches 
+		currentHGPO.ObjectInfo = CachedObjectInfos[Geo.ObjectIdx];
+		currentHGPO.GeoInfo = Geo.GeoInfo;
+		currentHGPO.PartInfo = CurrentPartInfo;
 
-						// If this part is not instanced, we can copy the geo
-						// group names so we can reuse them for another part
-						if (!CurrentHapiPartInfo.isInstanced)
-						{
-							GeoGroupNames = currentHGPO.SplitGroups;
-						}
-					}
-				}
+		// We only support meshes for templated geos
+		if (currentHGPO.bIsTemplated && (CurrentPartType != EHoudiniPartType::Mesh))
+			continue;
 
-				//
-				// Volume Only - Extract volume name/tile index
-				// 
-				// Extract the volume's name, and see if a tile attribute is present
-				FHoudiniVolumeInfo CurrentVolumeInfo;
-				if (CurrentPartType == EHoudiniPartType::Volume)
-				{
-					// Get this volume's info
-					HAPI_VolumeInfo CurrentHapiVolumeInfo;
-					FHoudiniApi::VolumeInfo_Init(&CurrentHapiVolumeInfo);
+		// Fingerprint the meshes and curves of the cooked geos, to find the parts the cook left untouched
+		if (bReuseUnchangedParts && currentHGPO.bHasGeoChanged
+			&& (CurrentPartType == EHoudiniPartType::Mesh || CurrentPartType == EHoudiniPartType::Curve))
+		{
+			if (!FHoudiniEngineUtils::HapiGetPartFingerprint(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo, currentHGPO.PartFingerprint))
+				currentHGPO.PartFingerprint = 0;
+		}
 
-					bool bVolumeValid = true;
-					if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetVolumeInfo(
-						FHoudiniEngine::Get().GetSession(),
-						CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id,
-						&CurrentHapiVolumeInfo))
-					{
-						bVolumeValid = false;
-					}
-					else if (CurrentHapiVolumeInfo.tupleSize != 1)
-					{
-						bVolumeValid = false;
-					}
-					else if (CurrentHapiVolumeInfo.zLength != 1)
-					{
-						bVolumeValid = false;
-					}
-					else if (CurrentHapiVolumeInfo.storage != HAPI_STORAGETYPE_FLOAT)
-					{
-						bVolumeValid = false;
-					}
+		Part.bValid = true;
+	}
 
-					// Only cache valid volumes
-					if (bVolumeValid)
-					{
-						// Convert/Cache the volume info
-						CacheVolumeInfo(CurrentHapiVolumeInfo, CurrentVolumeInfo);
+	// ----------------------------------------------------
+	// Split groups: only meshes can be split, via their primitive groups
+	// ----------------------------------------------------
+	// Non-instanced parts share their geo's group names, instanced parts have their own
+	auto GetSplitGroups = [](const HAPI_NodeId& GeoId, const HAPI_PartId& PartId, const bool& bIsInstanced, TArray<FString>& OutSplitGroups)
+	{
+		// We need to get the primitive group names from HAPI
+		TArray<FString> GroupNames;
+		if (!FHoudiniEngineUtils::HapiGetGroupNames(
+			GeoId, PartId, HAPI_GROUPTYPE_PRIM, bIsInstanced, GroupNames))
+		{
+			GroupNames.Empty();
+		}
 
-						// Get the volume's name
-						currentHGPO.VolumeName = CurrentVolumeInfo.Name;
+		for (const FString& GroupName : GroupNames)
+		{
+			FString LodGroup = HAPI_UNREAL_GROUP_LOD_PREFIX;
+			FString CollisionGroup = HAPI_UNREAL_GROUP_INVISIBLE_COLLISION_PREFIX;
+			FString RenderedCollisionGroup = HAPI_UNREAL_GROUP_RENDERED_COLLISION_PREFIX;
+			if (GroupName.StartsWith(LodGroup, ESearchCase::IgnoreCase)
+				|| GroupName.StartsWith(CollisionGroup, ESearchCase::IgnoreCase)
+				|| GroupName.StartsWith(RenderedCollisionGroup, ESearchCase::IgnoreCase))
+				//|| GroupName.StartsWith(HAPI_UNREAL_GROUP_USER_SPLIT_PREFIX, ESearchCase::IgnoreCase))
+			{
+				// Split by collisions / lods
+				OutSplitGroups.Add(GroupName);
+			}
+		}
 
-						// Now see if this volume has a tile attribute
-						TArray<int32> TileValues;
-						if (FHoudiniEngineUtils::GetTileAttribute(CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id, TileValues, HAPI_ATTROWNER_PRIM))
-						{
-							if (TileValues.Num() > 0 && TileValues[0] >= 0)
-								currentHGPO.VolumeTileIndex = TileValues[0];
-							else
-								currentHGPO.VolumeTileIndex = -1;
-						}
-					}
-				}
-				currentHGPO.VolumeInfo = CurrentVolumeInfo;
+		// Sort the Group name array by name, 
+		// this will order the LODs and other incremental group names
+		OutSplitGroups.Sort();
+	};
 
-				// Cache the curve info as well
-				FHoudiniCurveInfo CurrentCurveInfo;
-				if (CurrentPartType == EHoudiniPartType::Curve)
-				{
-					HAPI_CurveInfo CurrentHapiCurveInfo;
-					FHoudiniApi::CurveInfo_Init(&CurrentHapiCurveInfo);
-					if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetCurveInfo(
-						FHoudiniEngine::Get().GetSession(),
-						CurrentHapiGeoInfo.nodeId, CurrentHapiPartInfo.id,
-						&CurrentHapiCurveInfo))
-					{
-						// Cache/Convert this part's curve info
-						CacheCurveInfo(CurrentHapiCurveInfo, CurrentCurveInfo);
-					}
-				}
-				currentHGPO.CurveInfo = CurrentCurveInfo;
+	for (const FDiscoveredPart& Part : Parts)
+	{
+		if (Part.bValid && Part.HGPO.Type == EHoudiniPartType::Mesh && !Part.HapiPartInfo.isInstanced)
+			Geos[Part.GeoIdx].bNeedsSplitGroups = true;
+	}
 
+	for (int32 GeoIdx = 0; GeoIdx < Geos.Num(); GeoIdx++)
+	{
+		FDiscoveredGeo& Geo = Geos[GeoIdx];
+		if (!Geo.bNeedsSplitGroups)
+			continue;
 
-				// TODO:
-				// DONE? bake folders are handled out of this loop?
-				// See if a custom bake folder override for the mesh was assigned via the "unreal_bake_folder" attribute
-				//TArray<FString> BakeFolderOverrides;
+		GetSplitGroups(Geo.HapiGeoInfo.nodeId, 0, false, Geo.SplitGroups);
+	}
 
-				// Extract socket points
-				FHoudiniEngineUtils::AddMeshSocketsToArray_DetailAttribute(
-					currentHGPO.GeoId, currentHGPO.PartId, AllSockets, CurrentHapiPartInfo.isInstanced);
-				FHoudiniEngineUtils::AddMeshSocketsToArray_Group(
-					currentHGPO.GeoId, currentHGPO.PartId, AllSockets, CurrentHapiPartInfo.isInstanced);
+	// ----------------------------------------------------
+	// Parts: get their names, groups, volume and curve infos
+	// ----------------------------------------------------
+	for (int32 PartIdx = 0; PartIdx < Parts.Num(); PartIdx++)
+	{
+		FDiscoveredPart& Part = Parts[PartIdx];
+		if (!Part.bValid)
+			continue;
 
-				// See if we have an existing output that matches this HGPO or if we need to create a new one
-				bool IsFoundOutputValid = false;
-				UHoudiniOutput ** FoundHoudiniOutput = nullptr;	
-				// We handle volumes differently than other outputs types, as a single HF output has multiple HGPOs
-				if (currentHGPO.Type != EHoudiniPartType::Volume)
-				{
-					// Look in the previous output if we have a match
-					FoundHoudiniOutput = InOldOutputs.FindByPredicate(
-						[currentHGPO](UHoudiniOutput* Output) { return Output ? Output->HasHoudiniGeoPartObject(currentHGPO) : false; });
 
-					if (FoundHoudiniOutput && *FoundHoudiniOutput && !(*FoundHoudiniOutput)->IsPendingKill())
-						IsFoundOutputValid = true;
+		const FDiscoveredGeo& Geo = Geos[Part.GeoIdx];
+		const HAPI_PartInfo& CurrentHapiPartInfo = Part.HapiPartInfo;
+		FHoudiniGeoPartObject& currentHGPO = Part.HGPO;
 
-				}
-				else
-				{
-					// Look in the previous outputs if we have a match
-					FoundHoudiniOutput = InOldOutputs.FindByPredicate(
-						[currentHGPO](UHoudiniOutput* Output) { return Output ? Output->HeightfieldMatch(currentHGPO, true) : false; });
-					
-					if (FoundHoudiniOutput && *FoundHoudiniOutput && !(*FoundHoudiniOutput)->IsPendingKill())
-						IsFoundOutputValid = true;
+		// Update the HGPO's node path
+		if (!Geo.NodePath.IsEmpty())
+			currentHGPO.NodePath = FString::Printf(TEXT("%s_%d"), *Geo.NodePath, currentHGPO.PartId);
 
-					// If we dont have a match in the old maps, also look in the newly created outputs
-					if (!IsFoundOutputValid)
-					{
-						FoundHoudiniOutput = OutNewOutputs.FindByPredicate(
-							[currentHGPO](UHoudiniOutput* Output) { return Output ? Output->HeightfieldMatch(currentHGPO, false) : false; });
+		// Try to get the custom part name from attribute
+		FString CustomPartName;
+		if (FHoudiniOutputTranslator::GetCustomPartNameFromAttribute(currentHGPO.GeoId, currentHGPO.PartId, CustomPartName))
+			currentHGPO.SetCustomPartName(CustomPartName);
 
-						if (FoundHoudiniOutput && *FoundHoudiniOutput && !(*FoundHoudiniOutput)->IsPendingKill())
-							IsFoundOutputValid = true;
-					}
-				}
+		//
+		// Mesh Only - Extract split groups
+		// 
+		// Extract the group names used by this part to see if it will require splitting
+		if (currentHGPO.Type == EHoudiniPartType::Mesh)
+		{
+			if (!CurrentHapiPartInfo.isInstanced)
+				currentHGPO.SplitGroups = Geo.SplitGroups;
+			else
+				GetSplitGroups(currentHGPO.GeoId, currentHGPO.PartId, true, currentHGPO.SplitGroups);
+		}
 
-				UHoudiniOutput * HoudiniOutput = nullptr;
-				if (IsFoundOutputValid)
-				{
-					// We can reuse the existing output
-					HoudiniOutput = *FoundHoudiniOutput;
-					HoudiniOutput->SetIsUpdating(true);
-					// Transfer this output from the old array to the new one
-					InOldOutputs.Remove(HoudiniOutput);
-				}
-				else
-				{
-					// We couldn't find a valid output object, so create a new one
+		//
+		// Volume Only - Extract volume name/tile index
+		// 
+		// Extract the volume's name, and see if a tile attribute is present
+		FHoudiniVolumeInfo CurrentVolumeInfo;
+		if (currentHGPO.Type == EHoudiniPartType::Volume)
+		{
+			// Get this volume's info
+			HAPI_VolumeInfo CurrentHapiVolumeInfo;
+			FHoudiniApi::VolumeInfo_Init(&CurrentHapiVolumeInfo);
 
-					// If the current part is a volume, only create a new output object
-					// if the volume's name is "height", if not store the HGPO aside
-					if (currentHGPO.Type == EHoudiniPartType::Volume
-						&& !currentHGPO.VolumeName.Equals(HAPI_UNREAL_LANDSCAPE_HEIGHT_VOLUME_NAME, ESearchCase::IgnoreCase))
-					{
-						UnassignedVolumeParts.Add(currentHGPO);
-						continue;
-					}
+			bool bVolumeValid = true;
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetVolumeInfo(
+				FHoudiniEngine::Get().GetSession(),
+				currentHGPO.GeoId, currentHGPO.PartId,
+				&CurrentHapiVolumeInfo))
+			{
+				bVolumeValid = false;
+			}
+			else if (CurrentHapiVolumeInfo.tupleSize != 1)
+			{
+				bVolumeValid = false;
+			}
+			else if (CurrentHapiVolumeInfo.zLength != 1)
+			{
+				bVolumeValid = false;
+			}
+			else if (CurrentHapiVolumeInfo.storage != HAPI_STORAGETYPE_FLOAT)
+			{
+				bVolumeValid = false;
+			}
 
-					// Create a new output object
-					//FString OutputName = TEXT("Output") + FString::FromInt(OutputIdx++);
-					HoudiniOutput = NewObject<UHoudiniOutput>(
-						InOuterObject,
-						UHoudiniOutput::StaticClass(),
-						NAME_None,//FName(*OutputName),
-						RF_NoFlags);
+			// Only cache valid volumes
+			if (bVolumeValid)
+			{
+				// Convert/Cache the volume info
+				CacheVolumeInfo(CurrentHapiVolumeInfo, CurrentVolumeInfo);
 
-					// Make sure the created object is valid 
-					if (!HoudiniOutput || HoudiniOutput->IsPendingKill())
-					{
-						//HOUDINI_LOG_WARNING("Failed to create asset output");
-						continue;
-					}
+				// Get the volume's name
+				currentHGPO.VolumeName = CurrentVolumeInfo.Name;
 
-					// Mark if the HoudiniOutput is editable
-					HoudiniOutput->SetIsEditableNode(currentHGPO.bIsEditable);
+				// Now see if this volume has a tile attribute
+				TArray<int32> TileValues;
+				if (FHoudiniEngineUtils::GetTileAttribute(currentHGPO.GeoId, currentHGPO.PartId, TileValues, HAPI_ATTROWNER_PRIM))
+				{
+					if (TileValues.Num() > 0 && TileValues[0] >= 0)
+						currentHGPO.VolumeTileIndex = TileValues[0];
+					else
+						currentHGPO.VolumeTileIndex = -1;
 				}
-
-				// Add the HGPO to the output
-				HoudiniOutput->AddNewHGPO(currentHGPO);
-				// Add this output object to the new ouput array
-				OutNewOutputs.AddUnique(HoudiniOutput);
 			}
 		}
-	}
-
-	// Update the output/HGPO associations from the map
-	// Clear the old HGPO since we don't need them anymore
-	for (auto& CurrentOuput : OutNewOutputs)
-	{
-		if (!CurrentOuput || CurrentOuput->IsPendingKill())
-			continue;
+		currentHGPO.VolumeInfo = CurrentVolumeInfo;
 
-		CurrentOuput->DeleteAllStaleHGPOs();
-	}
-
-	// If we have unassigned volumes,
-	// try to find their corresponding output
-	if (UnassignedVolumeParts.Num() > 0)
-	{
-		for (auto& currentVolumeHGPO : UnassignedVolumeParts)
+		// Cache the curve info as well
+		FHoudiniCurveInfo CurrentCurveInfo;
+		if (currentHGPO.Type == EHoudiniPartType::Curve)
 		{
-			UHoudiniOutput ** FoundHoudiniOutput = OutNewOutputs.FindByPredicate(
-				[currentVolumeHGPO](UHoudiniOutput* Output) 
-				{
-					return Output ? Output->HeightfieldMatch(currentVolumeHGPO, false) : false;
-				});
-
-			if (!FoundHoudiniOutput || !(*FoundHoudiniOutput) || (*FoundHoudiniOutput)->IsPendingKill())
+			HAPI_CurveInfo CurrentHapiCurveInfo;
+			FHoudiniApi::CurveInfo_Init(&CurrentHapiCurveInfo);
+			if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetCurveInfo(
+				FHoudiniEngine::Get().GetSession(),
+				currentHGPO.GeoId, currentHGPO.PartId,
+				&CurrentHapiCurveInfo))
 			{
-				// Skip - consider this volume as invalid
-				continue;
+				// Cache/Convert this part's curve info
+				CacheCurveInfo(CurrentHapiCurveInfo, CurrentCurveInfo);
 			}
-
-			// Add this HGPO to the output
-			(*FoundHoudiniOutput)->AddNewHGPO(currentVolumeHGPO);
-		} 
+		}
+		currentHGPO.CurveInfo = CurrentCurveInfo;
 	}
 
-	// All our output objects now have their HGPO assigned
-	// We can now parse them to update the output type
-	for (auto& Output : OutNewOutputs)
+	// Return the HGPOs in object/geo/part order
+	for (FDiscoveredPart& Part : Parts)
 	{
-		Output->UpdateOutputType();
+		if (Part.bValid)
+			OutHGPOs.Add(MoveTemp(Part.HGPO));
 	}
 
+	HOUDINI_LOG_HELPER(Verbose,
+		TEXT("Discovered %d parts in %d objects / %d geos in %.3f ms."),
+		OutHGPOs.Num(), ObjectInfos.Num(), Geos.Num(), (FPlatformTime::Seconds() - DiscoveryStartTime) * 1000.0);
+
 	return true;
 }
 
@@ -1618,6 +1900,44 @@ FHoudiniOutputTranslator::ConvertHapiGeoType(const HAPI_GeoType& InType)
 	return OutType;
 }
 
+void
+FHoudiniOutputTranslator::UpdateUnchangedPartFlags(FHoudiniGeoPartObject& InOutHGPO, const TArray<FHoudiniGeoPartObject>& InPreviousHGPOs)
+{
+	if (InOutHGPO.Type != EHoudiniPartType::Mesh && InOutHGPO.Type != EHoudiniPartType::Curve)
+		return;
+
+	// The part's node ids must match, unlike the HGPOs' equality which also matches them by name
+	const FHoudiniGeoPartObject* PreviousHGPO = InPreviousHGPOs.FindByPredicate([&InOutHGPO](const FHoudiniGeoPartObject& HGPO)
+	{
+		return HGPO.ObjectId == InOutHGPO.ObjectId && HGPO.GeoId == InOutHGPO.GeoId
+			&& HGPO.PartId == InOutHGPO.PartId && HGPO.Type == InOutHGPO.Type;
+	});
+
+	if (!PreviousHGPO || PreviousHGPO->PartFingerprint == 0)
+		return;
+
+	// The geo hasn't been cooked, keep the part's fingerprint for its next cook
+	if (!InOutHGPO.bHasGeoChanged)
+	{
+		if (InOutHGPO.PartFingerprint == 0)
+			InOutHGPO.PartFingerprint = PreviousHGPO->PartFingerprint;
+		return;
+	}
+
+	if (InOutHGPO.PartFingerprint == 0 || InOutHGPO.PartFingerprint != PreviousHGPO->PartFingerprint)
+		return;
+
+	// The fingerprint doesn't cover the material nodes and the split groups' membership, rebuild the part if they changed
+	if (InOutHGPO.bHasMaterialsChanged || InOutHGPO.SplitGroups != PreviousHGPO->SplitGroups)
+		return;
+
+	// The cook didn't touch this part: the translators will reuse its existing meshes/curves
+	InOutHGPO.bHasGeoChanged = false;
+	InOutHGPO.bHasPartChanged = false;
+	InOutHGPO.GeoInfo.bHasGeoChanged = false;
+	InOutHGPO.PartInfo.bHasChanged = false;
+}
+
 void
 FHoudiniOutputTranslator::CacheGeoInfo(const HAPI_GeoInfo& InGeoInfo, FHoudiniGeoInfo& OutGeoInfoCache)
 {
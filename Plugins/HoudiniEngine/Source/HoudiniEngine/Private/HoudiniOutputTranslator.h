@@ -27,21 +27,28 @@
 #pragma once
 
 #include "HAPI/HAPI_Common.h"
+#include "HoudiniPackageParams.h"
 
 class UHoudiniOutput;
 class UHoudiniAssetComponent;
+class UWorldComposition;
+class UPackage;
+class ALandscapeProxy;
 
 struct FHoudiniObjectInfo;
 struct FHoudiniGeoInfo;
 struct FHoudiniPartInfo;
 struct FHoudiniVolumeInfo;
 struct FHoudiniCurveInfo;
+struct FHoudiniGeoPartObject;
 
 enum class EHoudiniOutputType : uint8;
 enum class EHoudiniGeoType : uint8;
 enum class EHoudiniPartType : uint8;
 enum class EHoudiniCurveType : int8;
 
+struct FHoudiniMeshPrefetch;
+
 struct HOUDINIENGINE_API FHoudiniOutputTranslator
 {
 	// 
@@ -50,6 +57,17 @@ struct HOUDINIENGINE_API FHoudiniOutputTranslator
 		const bool& bInForceUpdate,
 		bool& bOutHasHoudiniStaticMeshOutput);
 
+	// First half of UpdateOutputs: updates the HAC's outputs and their HGPOs from the cooked asset
+	static bool BuildOutputs(UHoudiniAssetComponent* HAC);
+
+	// Second half of UpdateOutputs: creates the meshes, instancers, landscapes... of the HAC's outputs.
+	// The mesh parts found in InMeshPrefetch are used instead of being fetched.
+	// Use FHoudiniOutputBuilder to spread the creation of the outputs over multiple ticks.
+	static bool CreateOutputs(
+		UHoudiniAssetComponent* HAC,
+		bool& bOutHasHoudiniStaticMeshOutput,
+		const TSharedPtr<FHoudiniMeshPrefetch>& InMeshPrefetch = nullptr);
+
 	//
 	static bool BuildStaticMeshesOnHoudiniProxyMeshOutputs(UHoudiniAssetComponent* HAC, bool bInDestroyProxies=false);
 
@@ -68,6 +86,17 @@ struct HOUDINIENGINE_API FHoudiniOutputTranslator
 		TArray<UHoudiniOutput*>& OutNewOutputs,
 		const bool& InOutputTemplatedGeos);
 
+	// Enumerates the objects, geos and parts of a cooked asset, and builds the HGPOs of its valid parts.
+	// The objects, geos and parts are queried in parallel batches, the HGPOs are returned in object/geo/part order.
+	static bool DiscoverAllGeoPartObjects(
+		const HAPI_NodeId& AssetId,
+		const bool& InOutputTemplatedGeos,
+		TArray<FHoudiniGeoPartObject>& OutHGPOs);
+
+	// Clears the change flags of a mesh/curve HGPO whose geo was cooked, if its part's fingerprint
+	// matches the one of its previous cook, so the translators reuse the part's existing outputs.
+	static void UpdateUnchangedPartFlags(FHoudiniGeoPartObject& InOutHGPO, const TArray<FHoudiniGeoPartObject>& InPreviousHGPOs);
+
 	static bool UpdateChangedOutputs(
 		UHoudiniAssetComponent* HAC);
 
@@ -88,4 +117,77 @@ struct HOUDINIENGINE_API FHoudiniOutputTranslator
 	static bool GetCustomPartNameFromAttribute(const HAPI_NodeId & NodeId, const HAPI_PartId & PartId, FString & OutCustomPartName);
 	static void GetBakeFolderFromAttribute(UHoudiniAssetComponent * HAC);
 	static void GetTempFolderFromAttribute(UHoudiniAssetComponent * HAC);
-};
\ No newline at end of file
+};
+
+// Creates the meshes, instancers, landscapes... of a HAC's outputs incrementally.
+// The pending outputs are kept in a work list sorted by distance to the editor viewport,
+// so the visible/nearby outputs are realized first. Instancers are created once all the meshes are.
+struct HOUDINIENGINE_API FHoudiniOutputBuilder
+{
+	public:
+
+		FHoudiniOutputBuilder(UHoudiniAssetComponent* InHAC, const TSharedPtr<FHoudiniMeshPrefetch>& InMeshPrefetch);
+		~FHoudiniOutputBuilder();
+
+		// Prepares the creation of the HAC's outputs and fills the work list
+		// Returns false if the HAC is not valid anymore
+		bool Begin();
+
+		// Creates the pending outputs until InBudgetSeconds have been spent, at least one output is always created.
+		// A budget of 0 creates all the pending outputs.
+		// Returns true once all the outputs have been created
+		bool Step(const double& InBudgetSeconds);
+
+		// Cleans up once all the outputs have been created (logo, landscapes, world composition, packages...)
+		void Finish();
+
+		int32 GetNumOutputs() const { return NumOutputs; };
+		int32 GetNumPendingOutputs() const { return PendingOutputs.Num() - NextPendingIndex; };
+
+		// Whether HoudiniStaticMesh proxies were created for the mesh outputs
+		bool HasHoudiniStaticMeshOutput() const { return bHasHoudiniStaticMeshOutput; };
+
+	protected:
+
+		// Sorts the work list: landscapes and curves first, then meshes, then instancers,
+		// meshes and instancers being sorted by their distance to the editor viewport
+		void SortPendingOutputs();
+
+		// Creates the objects and components of a single output
+		void CreateOutput(UHoudiniOutput* CurOutput);
+
+	protected:
+
+		TWeakObjectPtr<UHoudiniAssetComponent> HAC;
+
+		// Prefetched mesh parts, kept alive until all the mesh outputs have been created
+		TSharedPtr<FHoudiniMeshPrefetch> MeshPrefetch;
+
+		// Outputs left to create, in order, and the index of the next one
+		TArray<TWeakObjectPtr<UHoudiniOutput>> PendingOutputs;
+		int32 NextPendingIndex;
+
+		FHoudiniPackageParams PackageParams;
+
+		TWeakObjectPtr<UWorldComposition> WorldComposition;
+
+		// Landscape layers' global min/max values
+		TMap<FString, float> LandscapeLayerGlobalMinimums;
+		TMap<FString, float> LandscapeLayerGlobalMaximums;
+
+		// Packages created by the landscape outputs, saved when done
+		TArray<TWeakObjectPtr<UPackage>> CreatedPackages;
+
+		// Total number of instances, and whether we have object (or oldschool attribute) instancers:
+		// both prevent proxy meshes from being created
+		int32 NumInstances;
+		bool bHasObjectInstancer;
+
+		int32 NumOutputs;
+		int32 NumCreatedOutputs;
+		int32 NumVisibleOutputs;
+		bool bHasLandscape;
+		bool bCreatedNewMaps;
+		bool bHasHoudiniStaticMeshOutput;
+		bool bFinished;
+};
@@ -27,6 +27,7 @@
 #include "HoudiniParameterTranslator.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEnginePrivatePCH.h"
 
 #include "HoudiniParameter.h"
@@ -80,6 +81,9 @@
 bool 
 FHoudiniParameterTranslator::UpdateParameters(UHoudiniAssetComponent* HAC)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniParameterTranslator::UpdateParameters"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniParameterTranslator::UpdateParameters"));
+
 	if (!HAC || HAC->IsPendingKill())
 		return false;
 
@@ -2067,6 +2071,9 @@ FHoudiniParameterTranslator::HapiGetParameterHasTag(const HAPI_NodeId& NodeId, c
 bool
 FHoudiniParameterTranslator::UploadChangedParameters( UHoudiniAssetComponent * HAC )
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniParameterTranslator::UploadChangedParameters"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniParameterTranslator::UploadChangedParameters"));
+
 	if (!HAC || HAC->IsPendingKill())
 		return false;
 
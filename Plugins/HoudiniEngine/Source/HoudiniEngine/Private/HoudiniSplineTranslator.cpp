@@ -27,12 +27,14 @@
 #include "HoudiniSplineTranslator.h"
 
 #include "HoudiniApi.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngine.h"
 #include "HoudiniInput.h"
 #include "HoudiniOutput.h"
 #include "HoudiniAssetComponent.h"
 #include "HoudiniSplineComponent.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniDataConversion.h"
 #include "HoudiniEngineString.h"
 
 #include "HoudiniGeoPartObject.h"
@@ -67,15 +69,8 @@ FHoudiniSplineTranslator::ExtractStringPositions(const FString& Positions, TArra
 void
 FHoudiniSplineTranslator::ConvertToVectorData(const TArray<float> & InRawData, TArray<FVector>& OutVectorData)
 {
-	OutVectorData.SetNum(InRawData.Num() / 3);
-
-	for (int32 OutIndex = 0; OutIndex < OutVectorData.Num(); OutIndex++)
-	{
-		const int32& InIndex = OutIndex * 3;
-		OutVectorData[OutIndex].X = InRawData[InIndex + 0] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		OutVectorData[OutIndex].Y = InRawData[InIndex + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-		OutVectorData[OutIndex].Z = InRawData[InIndex + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-	}
+	OutVectorData.SetNumUninitialized(InRawData.Num() / 3);
+	FHoudiniDataConversion::HoudiniToUnrealPositions(InRawData, 3, OutVectorData.GetData());
 }
 
 void 
@@ -96,20 +91,23 @@ FHoudiniSplineTranslator::ConvertToVectorData(const TArray<float> & InRawData, T
 
 	for (int32 n = 0; n < CurveCounts.Num(); ++n)
 	{
-		TArray<FVector> & NextVectorDataArray = OutVectorData[n];
-		NextVectorDataArray.SetNumZeroed(CurveCounts[n]);
-
-		for (int32 PtIdx = 0; PtIdx < CurveCounts[n]; ++PtIdx)
+		// Clamp the curve to the points left in the raw data, so the view never reads past it
+		const int32 NumPoints = FMath::Clamp(CurveCounts[n], 0, (InRawData.Num() - Itr) / 3);
+		if (NumPoints != CurveCounts[n])
 		{
-			if (Itr + 2 >= InRawData.Num())
-				return;
+			HOUDINI_LOG_WARNING(TEXT("Curve %d expects %d points, but only %d could be converted."), n, CurveCounts[n], NumPoints);
+		}
 
-			NextVectorDataArray[PtIdx].X = InRawData[Itr]     * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			NextVectorDataArray[PtIdx].Y = InRawData[Itr + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
-			NextVectorDataArray[PtIdx].Z = InRawData[Itr + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION;
+		TArray<FVector> & NextVectorDataArray = OutVectorData[n];
+		NextVectorDataArray.SetNumUninitialized(NumPoints);
+		if (NumPoints <= 0)
+			continue;
 
-			Itr += 3;
-		}
+		// Convert this curve's points
+		TArrayView<const float> CurveRawData(InRawData.GetData() + Itr, NumPoints * 3);
+		FHoudiniDataConversion::HoudiniToUnrealPositions(CurveRawData, 3, NextVectorDataArray.GetData());
+
+		Itr += NumPoints * 3;
 	}
 }
 void
@@ -1492,6 +1490,9 @@ FHoudiniSplineTranslator::CreateOutputSplinesFromHoudiniGeoPartObject(
 bool 
 FHoudiniSplineTranslator::CreateAllSplinesFromHoudiniOutput(UHoudiniOutput* InOutput, UObject* InOuterComponent)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FHoudiniSplineTranslator::CreateAllSplinesFromHoudiniOutput"));
+	FHoudiniApiTraceScope ApiTraceScope(TEXT("FHoudiniSplineTranslator::CreateAllSplinesFromHoudiniOutput"));
+
 	if (!InOutput || InOutput->IsPendingKill())
 		return false;
 
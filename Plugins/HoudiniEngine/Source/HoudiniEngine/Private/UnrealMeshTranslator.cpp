@@ -28,6 +28,7 @@
 
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniDataConversion.h"
 #include "HoudiniEnginePrivatePCH.h"
 
 #include "RawMesh.h"
@@ -744,16 +745,11 @@ FUnrealMeshTranslator::CreateInputNodeForRawMesh(
 	//--------------------------------------------------------------------------------------------------------------------- 
 	if (RawMesh.VertexPositions.Num() > 3)
 	{
+		// Convert Unreal to Houdini
 		TArray<float> StaticMeshVertices;
-		StaticMeshVertices.SetNumZeroed(RawMesh.VertexPositions.Num() * 3);
-		for (int32 VertexIdx = 0; VertexIdx < RawMesh.VertexPositions.Num(); ++VertexIdx)
-		{
-			// Convert Unreal to Houdini
-			const FVector & PositionVector = RawMesh.VertexPositions[VertexIdx];
-			StaticMeshVertices[VertexIdx * 3 + 0] = PositionVector.X / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.X;
-			StaticMeshVertices[VertexIdx * 3 + 1] = PositionVector.Z / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Z;
-			StaticMeshVertices[VertexIdx * 3 + 2] = PositionVector.Y / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Y;
-		}
+		StaticMeshVertices.SetNumUninitialized(RawMesh.VertexPositions.Num() * 3);
+		FHoudiniDataConversion::UnrealToHoudiniPositions(
+			RawMesh.VertexPositions.GetData(), RawMesh.VertexPositions.Num(), StaticMeshVertices.GetData(), BuildScaleVector);
 
 		// Now that we have raw positions, we can upload them for our attribute.
 		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetAttributeFloatData(
@@ -772,11 +768,10 @@ FUnrealMeshTranslator::CreateInputNodeForRawMesh(
 		{
 			const TArray<FVector2D> & RawMeshUVs = RawMesh.WedgeTexCoords[MeshTexCoordIdx];
 			TArray<FVector> StaticMeshUVs;
-			StaticMeshUVs.Reserve(StaticMeshUVCount);
+			StaticMeshUVs.SetNumUninitialized(StaticMeshUVCount);
 
-			// Transfer UV data.
-			for (int32 UVIdx = 0; UVIdx < StaticMeshUVCount; UVIdx++)
-				StaticMeshUVs.Emplace(RawMeshUVs[UVIdx].X, 1.0 - RawMeshUVs[UVIdx].Y, 0);
+			// Transfer UV data, each UV is written as 3 floats.
+			FHoudiniDataConversion::UnrealToHoudiniUVs(RawMeshUVs.GetData(), StaticMeshUVCount, &StaticMeshUVs[0].X);
 
 			// Convert Unreal to Houdini
 			// We need to re-index UVs for wedges we swapped (due to winding differences).
@@ -2358,25 +2353,28 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 	TArray<int32> VertexIDToHIndex;
 	if (bIsVertexPositionsValid && VertexPositions.GetNumElements() >= 3)
 	{
-		TArray<float> StaticMeshVertices;
-		StaticMeshVertices.SetNumUninitialized(NumVertices * 3);
+		// Gather the positions of the valid vertices first, so they can be converted in one pass
+		TArray<FVector> UnrealPositions;
+		UnrealPositions.SetNumUninitialized(NumVertices);
 
 		int32 VertexIdx = 0;
 		VertexIDToHIndex.Init(INDEX_NONE, MDVertices.GetArraySize());
 
 		for (const FVertexID& VertexID : MDVertices.GetElementIDs())
 		{
-			// Convert Unreal to Houdini
-			const FVector &PositionVector = VertexPositions.Get(VertexID);
-			StaticMeshVertices[VertexIdx * 3 + 0] = PositionVector.X / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.X;
-			StaticMeshVertices[VertexIdx * 3 + 1] = PositionVector.Z / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Z;
-			StaticMeshVertices[VertexIdx * 3 + 2] = PositionVector.Y / HAPI_UNREAL_SCALE_FACTOR_POSITION * BuildScaleVector.Y;
+			UnrealPositions[VertexIdx] = VertexPositions.Get(VertexID);
 
 			// Record the UE Vertex ID to Houdini Point Index lookup
 			VertexIDToHIndex[VertexID.GetValue()] = VertexIdx;
 			VertexIdx++;
 		}
 
+		// Convert Unreal to Houdini
+		TArray<float> StaticMeshVertices;
+		StaticMeshVertices.SetNumUninitialized(NumVertices * 3);
+		FHoudiniDataConversion::UnrealToHoudiniPositions(
+			UnrealPositions.GetData(), UnrealPositions.Num(), StaticMeshVertices.GetData(), BuildScaleVector);
+
 		// Now that we have raw positions, we can upload them for our attribute.
 		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetAttributeFloatData(
 			FHoudiniEngine::Get().GetSession(),
@@ -2541,13 +2539,18 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 		// Alphas: 1 float per vertex instance
 		TArray<float> Alphas;
 
+		// Unreal UVs, per layer and per vertex instance, converted once they've all been gathered
+		TArray<TArray<FVector2D>> UnrealUVs;
+
 		// Initialize the arrays for the attributes that are valid
 		if (bIsVertexInstanceUVsValid)
 		{
 			UVs.SetNum(NumUVLayers);
+			UnrealUVs.SetNum(NumUVLayers);
 			for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; ++UVLayerIndex)
 			{
 				UVs[UVLayerIndex].SetNumUninitialized(NumVertexInstances * 3);
+				UnrealUVs[UVLayerIndex].SetNumUninitialized(NumVertexInstances);
 			}
 		}
 
@@ -2608,10 +2611,7 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 					{
 						for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; ++UVLayerIndex)
 						{
-							const FVector2D &UV = VertexInstanceUVs.Get(VertexInstanceID, UVLayerIndex);
-							UVs[UVLayerIndex][Float3Index + 0] = UV.X;
-							UVs[UVLayerIndex][Float3Index + 1] = 1.0f - UV.Y;
-							UVs[UVLayerIndex][Float3Index + 2] = 0;
+							UnrealUVs[UVLayerIndex][VertexInstanceIdx] = VertexInstanceUVs.Get(VertexInstanceID, UVLayerIndex);
 						}
 					}
 
@@ -2714,6 +2714,10 @@ FUnrealMeshTranslator::CreateInputNodeForMeshDescription(
 		{
 			for (int32 UVLayerIndex = 0; UVLayerIndex < NumUVLayers; UVLayerIndex++)
 			{
+				// Convert Unreal to Houdini
+				FHoudiniDataConversion::UnrealToHoudiniUVs(
+					UnrealUVs[UVLayerIndex].GetData(), UnrealUVs[UVLayerIndex].Num(), UVs[UVLayerIndex].GetData());
+
 				// Construct the attribute name for this UV index.
 				FString UVAttributeName = HAPI_UNREAL_ATTRIB_UV;
 				if (UVLayerIndex > 0)
@@ -30,6 +30,7 @@
 #include "HoudiniAsset.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniParameter.h"
 #include "HoudiniHandleComponent.h"
 #include "HoudiniParameterDetails.h"
@@ -158,6 +159,10 @@ FHoudiniAssetComponentDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuil
 		}
 	}
 
+	// The last cook's stats are only recorded while HoudiniEngine.CookStats is enabled
+	if (!FHoudiniApiTrace::IsRecordingCookStats())
+		DetailBuilder.HideProperty(GET_MEMBER_NAME_CHECKED(UHoudiniAssetComponent, CookStats), UHoudiniAssetComponent::StaticClass());
+
 	// Check if we'll need to add indie license labels
 	bool bIsIndieLicense = FHoudiniEngine::Get().IsLicenseIndie();
 
@@ -28,6 +28,8 @@
 
 #include "HoudiniEngineEditorPrivatePCH.h"
 #include "HoudiniAsset.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineUtils.h"
 
 #include "EditorFramework/AssetImportData.h"
 #include "Misc/FileHelper.h"
@@ -193,6 +195,10 @@ UHoudiniAssetFactory::Reimport(UObject * Obj)
 		{
 			HOUDINI_LOG_MESSAGE(TEXT("Houdini Asset reimported successfully."));
 
+			// The libraries loaded from the previous version of the asset must not be reused
+			if (FHoudiniEngine::IsInitialized())
+				FHoudiniEngine::Get().GetAssetLibraryCache().Invalidate(FHoudiniEngineUtils::GetHoudiniAssetLibraryPath(HoudiniAsset));
+
 			if (HoudiniAsset->GetOuter())
 				HoudiniAsset->GetOuter()->MarkPackageDirty();
 			else
@@ -131,12 +131,44 @@ FHoudiniEngineCommands::SaveHIPFile()
 		// ... and a log message
 		HOUDINI_LOG_MESSAGE(TEXT("Saved Houdini scene to %s"), *SaveFilenames[0]);
 
-		// Get first path.
-		std::string HIPPathConverted(TCHAR_TO_UTF8(*SaveFilenames[0]));
+		// Save the HIP files of all the sessions through Engine.
+		SaveSessionHIPFiles(SaveFilenames[0]);
+	}
+}
+
+TArray<FString>
+FHoudiniEngineCommands::SaveSessionHIPFiles(const FString& InHIPPath)
+{
+	TArray<FString> SavedPaths;
+
+	// Assets can be instantiated in any of the pooled sessions,
+	// so each session's scene has to be saved to get all of them
+	const int32 SessionCount = FHoudiniEngine::Get().GetSessionCount();
+	for (int32 SessionIndex = 0; SessionIndex < SessionCount; SessionIndex++)
+	{
+		const HAPI_Session* SessionPtr = FHoudiniEngine::Get().GetSessionAt(SessionIndex);
+		if (!SessionPtr || HAPI_RESULT_SUCCESS != FHoudiniApi::IsSessionValid(SessionPtr))
+			continue;
+
+		FString HIPPath = InHIPPath;
+		if (SessionIndex > 0)
+		{
+			HIPPath = FPaths::Combine(
+				FPaths::GetPath(InHIPPath),
+				FString::Printf(TEXT("%s_session%d.%s"), *FPaths::GetBaseFilename(InHIPPath), SessionIndex, *FPaths::GetExtension(InHIPPath)));
+		}
+
+		std::string HIPPathConverted(TCHAR_TO_UTF8(*HIPPath));
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::SaveHIPFile(SessionPtr, HIPPathConverted.c_str(), false))
+		{
+			HOUDINI_LOG_WARNING(TEXT("Failed to save the scene of Houdini Engine session %d to %s"), SessionIndex, *HIPPath);
+			continue;
+		}
 
-		// Save HIP file through Engine.
-		FHoudiniApi::SaveHIPFile(FHoudiniEngine::Get().GetSession(), HIPPathConverted.c_str(), false);
+		SavedPaths.Add(HIPPath);
 	}
+
+	return SavedPaths;
 }
 
 void
@@ -151,13 +183,9 @@ FHoudiniEngineCommands::OpenInHoudini()
 		FPlatformProcess::UserTempDir(),
 		TEXT("HoudiniEngine"), TEXT(".hip"));
 
-	// Save HIP file through Engine.
-	std::string TempPathConverted(TCHAR_TO_UTF8(*UserTempPath));
-	FHoudiniApi::SaveHIPFile(
-		FHoudiniEngine::Get().GetSession(),
-		TempPathConverted.c_str(), false);
-
-	if (!FPaths::FileExists(UserTempPath))
+	// Save the HIP files of all the sessions through Engine.
+	TArray<FString> SavedPaths = SaveSessionHIPFiles(UserTempPath);
+	if (SavedPaths.Num() <= 0)
 		return;
 
 	// Add a slate notification
@@ -167,18 +195,24 @@ FHoudiniEngineCommands::OpenInHoudini()
 	// ... and a log message
 	HOUDINI_LOG_MESSAGE(TEXT("Opened scene in Houdini."));
 
-	// Add quotes to the path to avoid issues with spaces
-	UserTempPath = TEXT("\"") + UserTempPath + TEXT("\"");
-	// Then open the hip file in Houdini
+	// Then open the hip files in Houdini, one instance per session
 	FString LibHAPILocation = FHoudiniEngine::Get().GetLibHAPILocation();
 	FString HoudiniLocation = LibHAPILocation + TEXT("//houdini");
-	FPlatformProcess::CreateProc(
-		*HoudiniLocation,
-		*UserTempPath,
-		true, false, false,
-		nullptr, 0,
-		FPlatformProcess::UserTempDir(),
-		nullptr, nullptr);
+	for (FString& SavedPath : SavedPaths)
+	{
+		if (!FPaths::FileExists(SavedPath))
+			continue;
+
+		// Add quotes to the path to avoid issues with spaces
+		SavedPath = TEXT("\"") + SavedPath + TEXT("\"");
+		FPlatformProcess::CreateProc(
+			*HoudiniLocation,
+			*SavedPath,
+			true, false, false,
+			nullptr, 0,
+			FPlatformProcess::UserTempDir(),
+			nullptr, nullptr);
+	}
 
 	// Unfortunately, LaunchFileInDefaultExternalApplication doesn't seem to be working properly
 	//FPlatformProcess::LaunchFileInDefaultExternalApplication( UserTempPath.GetCharArray().GetData(), nullptr, ELaunchVerb::Open );
@@ -218,5 +218,10 @@ protected:
 	// Needs to be call after starting/restarting/connecting/session syncing a HE session..
 	static void MarkAllHACsAsNeedInstantiation();
 
+	// Saves the scene of each Houdini Engine session to a HIP file.
+	// The main session's scene is saved to InHIPPath, the pooled sessions' ones next to it with a _sessionN suffix.
+	// Returns the paths of the saved files.
+	static TArray<FString> SaveSessionHIPFiles(const FString& InHIPPath);
+
 };
 
@@ -31,6 +31,7 @@
 #include "HoudiniParameter.h"
 
 #include "HoudiniEngineUtils.h"
+#include "HoudiniApiTrace.h"
 #include "HoudiniEngineRuntime.h"
 #include "HoudiniEngineBakeUtils.h"
 #include "HoudiniPackageParams.h"
@@ -1662,6 +1663,34 @@ FHoudiniEngineDetails::CreateHelpAndDebugWidgets(
 	];
 
 	ButtonRow.WholeRowWidget.Widget = ButtonRowHorizontalBox;
+
+	// Last cook stats row
+	TWeakObjectPtr<UHoudiniAssetComponent> WeakMainHAC(MainHAC);
+	auto GetCookStatsTextLambda = [WeakMainHAC]()
+	{
+		UHoudiniAssetComponent* HAC = WeakMainHAC.Get();
+		if (!HAC || HAC->IsPendingKill())
+			return FText::GetEmpty();
+
+		return FText::FromString(HAC->CookStats.ToString());
+	};
+
+	// Only shown while the cook stats are recorded (HoudiniEngine.CookStats)
+	FDetailWidgetRow & CookStatsRow = HoudiniEngineCategoryBuilder.AddCustomRow(FText::GetEmpty());
+	CookStatsRow.Visibility(TAttribute<EVisibility>::Create(TAttribute<EVisibility>::FGetter::CreateLambda([]()
+	{
+		return FHoudiniApiTrace::IsRecordingCookStats() ? EVisibility::Visible : EVisibility::Collapsed;
+	})));
+	CookStatsRow.WholeRowWidget.Widget =
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.Padding(15.0f, 4.0f, 0.0f, 4.0f)
+		[
+			SNew(STextBlock)
+			.Font(FEditorStyle::GetFontStyle(TEXT("MonoFont")))
+			.ToolTipText(LOCTEXT("HoudiniEngineCookStatsTooltip", "Time and HAPI payload of each phase of the last cook, and the data transferred to/from the Houdini Engine session."))
+			.Text_Lambda(GetCookStatsTextLambda)
+		];
 }
 
 FMenuBuilder 
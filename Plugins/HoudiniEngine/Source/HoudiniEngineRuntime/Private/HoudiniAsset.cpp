@@ -29,11 +29,14 @@
 
 #include "Misc/Paths.h"
 #include "HAL/UnrealMemory.h"
+#include "Hash/CityHash.h"
 
 UHoudiniAsset::UHoudiniAsset(const FObjectInitializer & ObjectInitializer)
 	: Super(ObjectInitializer)
 	, AssetFileName(TEXT(""))
 	, AssetBytesCount(0)	
+	, AssetBytesHash(0)
+	, bAssetBytesHashValid(false)
 	, bAssetLimitedCommercial(false)
 	, bAssetNonCommercial(false)
 	, bAssetExpanded(false)
@@ -55,6 +58,9 @@ UHoudiniAsset::CreateAsset(const uint8 * BufferStart, const uint8 * BufferEnd, c
 		FMemory::Memcpy(AssetBytes.GetData(), BufferStart, AssetBytesCount);
 	}
 
+	// The data has changed (reimport), the hash needs to be computed again
+	bAssetBytesHashValid = false;
+
 	FString FileExtension = FPaths::GetExtension(InFileName);
 
 	// Expanded HDAs are imported via a "houdini.hdalibrary" file inside the .hda directory
@@ -108,6 +114,21 @@ UHoudiniAsset::GetAssetBytesCount() const
 	return AssetBytesCount;
 }
 
+uint64
+UHoudiniAsset::GetAssetBytesHash() const
+{
+	if (!bAssetBytesHashValid)
+	{
+		const uint32 ByteCount = FMath::Min<uint32>(AssetBytesCount, AssetBytes.Num());
+		AssetBytesHash = ByteCount > 0
+			? CityHash64WithSeed(reinterpret_cast<const char *>(AssetBytes.GetData()), ByteCount, ByteCount)
+			: 0;
+		bAssetBytesHashValid = true;
+	}
+
+	return AssetBytesHash;
+}
+
 void
 UHoudiniAsset::Serialize(FArchive & Ar)
 {
@@ -115,6 +136,9 @@ UHoudiniAsset::Serialize(FArchive & Ar)
 	Super::Serialize(Ar);
 	Ar.UsingCustomVersion(FHoudiniCustomSerializationVersion::GUID);
 
+	if (Ar.IsLoading())
+		bAssetBytesHashValid = false;
+
 	// Get the version
 	uint32 HoudiniAssetVersion = Ar.CustomVer(FHoudiniCustomSerializationVersion::GUID);
 
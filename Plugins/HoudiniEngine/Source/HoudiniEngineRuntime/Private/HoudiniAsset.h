@@ -55,6 +55,9 @@ class HOUDINIENGINERUNTIME_API UHoudiniAsset : public UObject
 		// Return the size in bytes of raw Houdini OTL data.
 		uint32 GetAssetBytesCount() const;
 
+		// Return a hash of the raw Houdini OTL data, computed on first use.
+		uint64 GetAssetBytesHash() const;
+
 		// Return true if this asset is a limited commercial asset.
 		bool IsAssetLimitedCommercial() const;
 
@@ -90,6 +93,12 @@ class HOUDINIENGINERUNTIME_API UHoudiniAsset : public UObject
 		UPROPERTY()
 		uint32 AssetBytesCount;
 
+		// Hash of the raw HDA data, reset when the data changes.
+		mutable uint64 AssetBytesHash;
+
+		// Indicates if AssetBytesHash has been computed.
+		mutable bool bAssetBytesHashValid;
+
 		// Indicates if this is a limited commercial asset.
 		UPROPERTY()
 		bool bAssetLimitedCommercial;
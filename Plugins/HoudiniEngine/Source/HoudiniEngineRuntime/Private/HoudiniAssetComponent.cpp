@@ -61,6 +61,7 @@ UHoudiniAssetComponent::UHoudiniAssetComponent(const FObjectInitializer & Object
 	bCookOnAssetInputCook = true;
 
 	AssetId = -1;
+	SessionIndex = 0;
 
 	// Make an invalid GUID, since we do not have any cooking requests.
 	HapiGUID.Invalidate();
@@ -160,7 +161,7 @@ UHoudiniAssetComponent::UHoudiniAssetComponent(const FObjectInitializer & Object
 UHoudiniAssetComponent::~UHoudiniAssetComponent()
 {
 	// Unregister ourself so our houdini node can be delete.
-	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(AssetId, true);
+	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(AssetId, true, SessionIndex);
 	FHoudiniEngineRuntime::Get().UnRegisterHoudiniComponent(this);
 }
 
@@ -511,11 +512,38 @@ UHoudiniAssetComponent::NeedsToWaitForInputHoudiniAssets()
 	return bNeedToWait;
 }
 
+void
+UHoudiniAssetComponent::GetInputHoudiniAssets(TArray<UHoudiniAssetComponent*>& OutInputHoudiniAssets)
+{
+	OutInputHoudiniAssets.Empty();
+	for (auto& CurrentInput : Inputs)
+	{
+		if (!CurrentInput || CurrentInput->IsPendingKill() || CurrentInput->GetInputType() != EHoudiniInputType::Asset)
+			continue;
+
+		TArray<UHoudiniInputObject*>* ObjectArray = CurrentInput->GetHoudiniInputObjectArray(EHoudiniInputType::Asset);
+		if (!ObjectArray)
+			continue;
+
+		for (auto& CurrentInputObject : (*ObjectArray))
+		{
+			UHoudiniAssetComponent* InputHAC = CurrentInputObject
+				? Cast<UHoudiniAssetComponent>(CurrentInputObject->GetObject())
+				: nullptr;
+
+			if (!InputHAC || InputHAC->IsPendingKill())
+				continue;
+
+			OutInputHoudiniAssets.AddUnique(InputHAC);
+		}
+	}
+}
+
 void
 UHoudiniAssetComponent::BeginDestroy()
 {
 	// Unregister ourself so our houdini node can be deleted
-	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(AssetId, true);
+	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(AssetId, true, SessionIndex);
 	FHoudiniEngineRuntime::Get().UnRegisterHoudiniComponent(this);
 
 	Super::BeginDestroy();
@@ -890,7 +918,7 @@ UHoudiniAssetComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 	Outputs.Empty();
 
 	// Unregister ourself so our houdini node can be delete.
-	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(AssetId, true);
+	FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(AssetId, true, SessionIndex);
 	FHoudiniEngineRuntime::Get().UnRegisterHoudiniComponent(this);
 
 	// Clear the static mesh bake timer
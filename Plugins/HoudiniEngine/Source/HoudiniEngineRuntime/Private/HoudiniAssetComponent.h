@@ -30,6 +30,7 @@
 #include "UObject/ObjectMacros.h"
 
 #include "HoudiniRuntimeSettings.h"
+#include "HoudiniCookStats.h"
 
 #include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
@@ -189,6 +190,7 @@ public:
 	//------------------------------------------------------------------------------------------------
 	UHoudiniAsset * GetHoudiniAsset() const;
 	int32 GetAssetId() const { return AssetId; };
+	int32 GetSessionIndex() const { return SessionIndex; };
 	EHoudiniAssetState GetAssetState() const { return AssetState; };
 	EHoudiniAssetStateResult GetAssetStateResult() const { return AssetStateResult; };
 	FGuid GetHapiGUID() const { return HapiGUID; };
@@ -288,6 +290,8 @@ public:
 	bool NotifyCookedToDownstreamAssets();
 	//
 	bool NeedsToWaitForInputHoudiniAssets();
+	// Returns the HACs connected to our asset inputs
+	void GetInputHoudiniAssets(TArray<UHoudiniAssetComponent*>& OutInputHoudiniAssets);
 
 	// Clear/disable the RefineMeshesTimer.
 	void ClearRefineMeshesTimer();
@@ -506,6 +510,10 @@ public:
 	UPROPERTY(Category = "HoudiniAsset | Development", EditAnywhere, meta = (DisplayPriority = 0))
 	EHoudiniStaticMeshMethod StaticMeshMethod;
 
+	// Timings and HAPI payload sizes of the last cook, per phase. Only recorded when HoudiniEngine.CookStats is enabled.
+	UPROPERTY(Category = "HoudiniAsset | Development", VisibleInstanceOnly, BlueprintReadOnly, Transient, DuplicateTransient)
+	FHoudiniCookStats CookStats;
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY()
 	bool bGenerateMenuExpanded;
@@ -532,6 +540,10 @@ protected:
 	UPROPERTY(DuplicateTransient)
 	int32 AssetId;
 
+	// Index of the Houdini Engine session our node lives in (0 is the main session)
+	UPROPERTY(Transient, DuplicateTransient)
+	int32 SessionIndex;
+
 	// List of dependent downstream HACs that have us as an asset input
 	UPROPERTY(DuplicateTransient)
 	TSet<UHoudiniAssetComponent*> DownstreamHoudiniAssets;
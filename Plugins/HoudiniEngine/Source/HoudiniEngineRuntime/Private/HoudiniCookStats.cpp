@@ -0,0 +1,131 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniCookStats.h"
+
+FHoudiniCookPhaseStats::FHoudiniCookPhaseStats()
+	: Seconds(0.0f)
+	, PayloadBytes(0)
+{
+}
+
+FHoudiniCookStats::FHoudiniCookStats()
+	: BytesSent(0)
+	, BytesReceived(0)
+	, TotalSeconds(0.0f)
+{
+}
+
+FHoudiniCookPhaseStats&
+FHoudiniCookStats::GetPhase(const EHoudiniCookPhase& InPhase)
+{
+	switch (InPhase)
+	{
+		case EHoudiniCookPhase::UploadInputs:
+			return UploadInputs;
+		case EHoudiniCookPhase::UploadParameters:
+			return UploadParameters;
+		case EHoudiniCookPhase::Cook:
+			return Cook;
+		case EHoudiniCookPhase::DiscoverOutputs:
+			return DiscoverOutputs;
+		case EHoudiniCookPhase::FetchGeometry:
+			return FetchGeometry;
+		case EHoudiniCookPhase::TranslateMeshes:
+			return TranslateMeshes;
+		case EHoudiniCookPhase::BuildStaticMeshes:
+			return BuildStaticMeshes;
+		case EHoudiniCookPhase::CreateComponents:
+		default:
+			return CreateComponents;
+	}
+}
+
+const FHoudiniCookPhaseStats&
+FHoudiniCookStats::GetPhase(const EHoudiniCookPhase& InPhase) const
+{
+	return const_cast<FHoudiniCookStats*>(this)->GetPhase(InPhase);
+}
+
+FString
+FHoudiniCookStats::GetPhaseName(const EHoudiniCookPhase& InPhase)
+{
+	switch (InPhase)
+	{
+		case EHoudiniCookPhase::UploadInputs:
+			return TEXT("Upload Inputs");
+		case EHoudiniCookPhase::UploadParameters:
+			return TEXT("Upload Parameters");
+		case EHoudiniCookPhase::Cook:
+			return TEXT("Cook");
+		case EHoudiniCookPhase::DiscoverOutputs:
+			return TEXT("Discover Outputs");
+		case EHoudiniCookPhase::FetchGeometry:
+			return TEXT("Fetch Geometry");
+		case EHoudiniCookPhase::TranslateMeshes:
+			return TEXT("Translate Meshes");
+		case EHoudiniCookPhase::BuildStaticMeshes:
+			return TEXT("Build Static Meshes");
+		case EHoudiniCookPhase::CreateComponents:
+			return TEXT("Create Components");
+		default:
+			return FString();
+	}
+}
+
+FString
+FHoudiniCookStats::ToString() const
+{
+	FString Result;
+	for (int32 PhaseIdx = 0; PhaseIdx < (int32)EHoudiniCookPhase::Count; PhaseIdx++)
+	{
+		const EHoudiniCookPhase Phase = (EHoudiniCookPhase)PhaseIdx;
+		const FHoudiniCookPhaseStats& Stats = GetPhase(Phase);
+		Result += FString::Printf(TEXT("%-20s %9.3f s  %9.2f MB\n"),
+			*GetPhaseName(Phase), Stats.Seconds, (double)Stats.PayloadBytes / (1024.0 * 1024.0));
+	}
+
+	Result += FString::Printf(TEXT("%-20s %9.3f s\n"), TEXT("Total"), TotalSeconds);
+	Result += FString::Printf(TEXT("Sent %.2f MB, received %.2f MB"),
+		(double)BytesSent / (1024.0 * 1024.0), (double)BytesReceived / (1024.0 * 1024.0));
+
+	return Result;
+}
+
+void
+FHoudiniCookStats::Accumulate(const FHoudiniCookStats& InStats)
+{
+	for (int32 PhaseIdx = 0; PhaseIdx < (int32)EHoudiniCookPhase::Count; PhaseIdx++)
+	{
+		const EHoudiniCookPhase Phase = (EHoudiniCookPhase)PhaseIdx;
+		GetPhase(Phase).Seconds += InStats.GetPhase(Phase).Seconds;
+		GetPhase(Phase).PayloadBytes += InStats.GetPhase(Phase).PayloadBytes;
+	}
+
+	BytesSent += InStats.BytesSent;
+	BytesReceived += InStats.BytesReceived;
+	TotalSeconds += InStats.TotalSeconds;
+}
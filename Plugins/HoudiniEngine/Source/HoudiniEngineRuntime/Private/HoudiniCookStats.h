@@ -0,0 +1,123 @@
+/*
+* Copyright (c) <2018> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+
+#include "HoudiniCookStats.generated.h"
+
+UENUM(BlueprintType)
+enum class EHoudiniCookPhase : uint8
+{
+	UploadInputs,
+	UploadParameters,
+	Cook,
+	DiscoverOutputs,
+	FetchGeometry,
+	TranslateMeshes,
+	BuildStaticMeshes,
+	CreateComponents,
+
+	Count UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct HOUDINIENGINERUNTIME_API FHoudiniCookPhaseStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHoudiniCookPhaseStats();
+
+	// Time spent in this phase, excluding nested phases.
+	// The time of the worker threads working on the phase is added to it.
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	float Seconds;
+
+	// Payload bytes transferred to/from the session during this phase, on every thread working on it.
+	// This is the size of the HAC's data going through HAPI, not the phase's peak memory.
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	int64 PayloadBytes;
+};
+
+USTRUCT(BlueprintType)
+struct HOUDINIENGINERUNTIME_API FHoudiniCookStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	FHoudiniCookStats();
+
+	// Returns the stats of a given phase
+	FHoudiniCookPhaseStats& GetPhase(const EHoudiniCookPhase& InPhase);
+	const FHoudiniCookPhaseStats& GetPhase(const EHoudiniCookPhase& InPhase) const;
+
+	// Display name of a phase, for logs and the details panel
+	static FString GetPhaseName(const EHoudiniCookPhase& InPhase);
+
+	// One line per phase, followed by the transfer totals
+	FString ToString() const;
+
+	// Adds the given stats to these ones
+	void Accumulate(const FHoudiniCookStats& InStats);
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats UploadInputs;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats UploadParameters;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats Cook;
+
+	// Enumeration of the cooked objects, geos and parts
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats DiscoverOutputs;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats FetchGeometry;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats TranslateMeshes;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats BuildStaticMeshes;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	FHoudiniCookPhaseStats CreateComponents;
+
+	// Payload bytes sent to the Houdini Engine session
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	int64 BytesSent;
+
+	// Payload bytes received from the Houdini Engine session
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	int64 BytesReceived;
+
+	// Sum of all the phases' time
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Houdini Cook Stats")
+	float TotalSeconds;
+};
@@ -40,6 +40,9 @@ DEFINE_LOG_CATEGORY(LogHoudiniEngineRuntime);
 FHoudiniEngineRuntime *
 FHoudiniEngineRuntime::HoudiniEngineRuntimeInstance = nullptr;
 
+// Index of the session used by the HAPI calls made on this thread.
+static thread_local int32 HoudiniCurrentSessionIndex = 0;
+
 
 FHoudiniEngineRuntime &
 FHoudiniEngineRuntime::Get()
@@ -55,7 +58,39 @@ FHoudiniEngineRuntime::IsInitialized()
 }
 
 
+int32
+FHoudiniEngineRuntime::GetCurrentSessionIndex()
+{
+	return HoudiniCurrentSessionIndex;
+}
+
+
+void
+FHoudiniEngineRuntime::SetCurrentSessionIndex(const int32& InSessionIndex)
+{
+	HoudiniCurrentSessionIndex = FMath::Max(InSessionIndex, 0);
+}
+
+
+int32
+FHoudiniEngineRuntime::GetSessionIndexForObject(const UObject* InObject)
+{
+	if (!InObject)
+		return GetCurrentSessionIndex();
+
+	const UHoudiniAssetComponent* HAC = Cast<UHoudiniAssetComponent>(InObject);
+	if (!HAC)
+		HAC = InObject->GetTypedOuter<UHoudiniAssetComponent>();
+
+	if (!HAC)
+		return GetCurrentSessionIndex();
+
+	return HAC->GetSessionIndex();
+}
+
+
 FHoudiniEngineRuntime::FHoudiniEngineRuntime()
+	: RegistryRevision(0)
 {
 }
 
@@ -170,18 +205,36 @@ FHoudiniEngineRuntime::RegisterHoudiniComponent(UHoudiniAssetComponent* HAC)
 	{
 		FScopeLock ScopeLock(&CriticalSection);
 		RegisteredHoudiniComponents.Add(HAC);
+		RegistryRevision++;
 	}
 }
 
 
 void 
-FHoudiniEngineRuntime::MarkNodeIdAsPendingDelete(const int32& InNodeId, bool bDeleteParent)
+FHoudiniEngineRuntime::MarkNodeIdAsPendingDelete(const int32& InNodeId, bool bDeleteParent, const int32& InSessionIndex)
 {
 	if (InNodeId >= 0) {	
-		NodeIdsPendingDelete.AddUnique(InNodeId);
+		const int32 SessionIndex = InSessionIndex >= 0 ? InSessionIndex : GetCurrentSessionIndex();
+
+		// Node ids are only unique within a session
+		bool bAlreadyPending = false;
+		for (int32 Idx = 0; Idx < NodeIdsPendingDelete.Num(); Idx++)
+		{
+			if (NodeIdsPendingDelete[Idx] == InNodeId && NodeIdsPendingDeleteSessionIndex[Idx] == SessionIndex)
+			{
+				bAlreadyPending = true;
+				break;
+			}
+		}
+
+		if (!bAlreadyPending)
+		{
+			NodeIdsPendingDelete.Add(InNodeId);
+			NodeIdsPendingDeleteSessionIndex.Add(SessionIndex);
+		}
 
 		if (bDeleteParent)
-			NodeIdsParentPendingDelete.AddUnique(InNodeId);
+			NodeIdsParentPendingDelete.AddUnique(TPair<int32, int32>(InNodeId, SessionIndex));
 	}
 }
 
@@ -216,12 +269,13 @@ FHoudiniEngineRuntime::UnRegisterHoudiniComponent(const int32& ValidIndex)
 		UHoudiniAssetComponent* HAC = Ptr.Get();
 		if (HAC)
 		{
-			MarkNodeIdAsPendingDelete(HAC->GetAssetId(), true);
+			MarkNodeIdAsPendingDelete(HAC->GetAssetId(), true, HAC->GetSessionIndex());
 		}
 			
 	}
 	
 	RegisteredHoudiniComponents.RemoveAt(ValidIndex);
+	RegistryRevision++;
 }
 
 
@@ -252,6 +306,21 @@ FHoudiniEngineRuntime::GetNodeIdsPendingDeleteAt(const int32& Index)
 }
 
 
+int32
+FHoudiniEngineRuntime::GetNodeIdsPendingDeleteSessionIndexAt(const int32& Index)
+{
+	if (!IsInitialized())
+		return 0;
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	if (!NodeIdsPendingDeleteSessionIndex.IsValidIndex(Index))
+		return 0;
+
+	return NodeIdsPendingDeleteSessionIndex[Index];
+}
+
+
 void
 FHoudiniEngineRuntime::RemoveNodeIdPendingDeleteAt(const int32& Index)
 {
@@ -263,21 +332,21 @@ FHoudiniEngineRuntime::RemoveNodeIdPendingDeleteAt(const int32& Index)
 		return;
 
 	NodeIdsPendingDelete.RemoveAt(Index);
+	NodeIdsPendingDeleteSessionIndex.RemoveAt(Index);
 }
 
 
 bool 
-FHoudiniEngineRuntime::IsParentNodePendingDelete(const int32& NodeId) 
+FHoudiniEngineRuntime::IsParentNodePendingDelete(const int32& NodeId, const int32& SessionIndex) 
 {
-	return NodeIdsParentPendingDelete.Contains(NodeId);
+	return NodeIdsParentPendingDelete.Contains(TPair<int32, int32>(NodeId, SessionIndex));
 }
 
 
 void 
-FHoudiniEngineRuntime::RemoveParentNodePendingDelete(const int32& NodeId) 
+FHoudiniEngineRuntime::RemoveParentNodePendingDelete(const int32& NodeId, const int32& SessionIndex) 
 {
-	if (NodeIdsParentPendingDelete.Contains(NodeId))
-		NodeIdsParentPendingDelete.Remove(NodeId);
+	NodeIdsParentPendingDelete.Remove(TPair<int32, int32>(NodeId, SessionIndex));
 }
 
 
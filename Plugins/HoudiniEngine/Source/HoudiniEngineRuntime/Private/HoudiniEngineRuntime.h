@@ -50,6 +50,17 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngineRuntime : public IModuleInterface
 		// Return true if singleton instance has been created.
 		static bool IsInitialized();
 
+		//
+		// Session pool
+		//
+		// Index of the Houdini Engine session used by the HAPI calls made on the calling thread
+		static int32 GetCurrentSessionIndex();
+		// Sets the index of the session used by the HAPI calls made on the calling thread
+		static void SetCurrentSessionIndex(const int32& InSessionIndex);
+		// Returns the session index used by the Houdini Asset Component owning this object,
+		// or the calling thread's session index if the object isn't owned by a HAC
+		static int32 GetSessionIndexForObject(const UObject* InObject);
+
 		//
 		// Houdini Asset Component registry
 		//
@@ -66,19 +77,25 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngineRuntime : public IModuleInterface
 		UHoudiniAssetComponent* GetRegisteredHoudiniComponentAt(const int32& Index);
 
 		virtual TArray<TWeakObjectPtr<UHoudiniAssetComponent>>* GetRegisteredHoudiniComponents() { return &RegisteredHoudiniComponents; };
+
+		// Incremented each time a component is registered or unregistered
+		int32 GetRegistryRevision() const { return RegistryRevision; };
 		
 		//
 		// Node deletion
 		//
-		void MarkNodeIdAsPendingDelete(const int32& InNodeId, bool bDeleteParent = false);
+		// A negative session index will use the calling thread's session
+		void MarkNodeIdAsPendingDelete(const int32& InNodeId, bool bDeleteParent = false, const int32& InSessionIndex = -1);
 
 		int32 GetNodeIdsPendingDeleteCount();
 		int32 GetNodeIdsPendingDeleteAt(const int32& Index);
+		int32 GetNodeIdsPendingDeleteSessionIndexAt(const int32& Index);
 		void RemoveNodeIdPendingDeleteAt(const int32& Index);
 
-		bool IsParentNodePendingDelete(const int32& NodeId);
+		// Node ids are only unique within a session, so the parent deletion is tracked per session
+		bool IsParentNodePendingDelete(const int32& NodeId, const int32& SessionIndex);
 
-		void RemoveParentNodePendingDelete(const int32& NodeId);
+		void RemoveParentNodePendingDelete(const int32& NodeId, const int32& SessionIndex);
 
 		//
 		//
@@ -101,7 +118,14 @@ class HOUDINIENGINERUNTIME_API FHoudiniEngineRuntime : public IModuleInterface
 		// 
 		TArray<TWeakObjectPtr<UHoudiniAssetComponent>> RegisteredHoudiniComponents;
 
+		// Revision of the registered components
+		int32 RegistryRevision;
+
 		TArray<int32> NodeIdsPendingDelete;
 
-		TArray<int32> NodeIdsParentPendingDelete;
+		// Index of the session owning each of the NodeIdsPendingDelete
+		TArray<int32> NodeIdsPendingDeleteSessionIndex;
+
+		// Node id and session index of the nodes whose parent should be deleted as well
+		TArray<TPair<int32, int32>> NodeIdsParentPendingDelete;
 };
\ No newline at end of file
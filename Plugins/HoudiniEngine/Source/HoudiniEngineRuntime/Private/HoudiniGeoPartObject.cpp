@@ -51,6 +51,7 @@ FHoudiniGeoPartObject::FHoudiniGeoPartObject()
 	, bHasTransformChanged(true)
 	, bHasMaterialsChanged(true)
 	, bLoaded(false)
+	, PartFingerprint(0)
 {
 
 }
@@ -400,6 +400,10 @@ public:
 	// Indicates this object has been loaded
 	bool bLoaded;
 
+	// Fingerprint of the part's content (topology, attribute names and values), 0 if it wasn't computed.
+	// Isn't saved: a part is only considered unchanged against the fingerprint of a previous cook in the same session.
+	uint64 PartFingerprint;
+
 	// We also keep a cache of the various info objects
 	// That we've extracted from HAPI
 	
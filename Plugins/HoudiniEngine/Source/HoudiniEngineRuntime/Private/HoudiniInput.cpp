@@ -98,7 +98,7 @@ UHoudiniInput::BeginDestroy()
 		// is set to the input HDA's node ID!
 		if (Type != EHoudiniInputType::Asset)
 		{
-			FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, true);
+			FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, true, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 		}
 		
 		InputNodeId = -1;
@@ -168,12 +168,12 @@ void UHoudiniInput::PostEditUndo()
 			 {
 				 for (auto & NextNodeId : CreatedDataNodeIds)
 				 {
-					 FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(NextNodeId, true);
+					 FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(NextNodeId, true, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 				 }
 
 				 CreatedDataNodeIds.Empty();
 
-				 FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, true);
+				 FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, true, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 				 InputNodeId = -1;
 			 }
 		 }
@@ -1128,7 +1128,7 @@ UHoudiniInput::DeleteInputObjectAt(const EHoudiniInputType& InType, const int32&
 	// Delete the merge node when all the input objects are deleted.
 	if (InputObjectsPtr->Num() == 0 && InputNodeId >= 0)
 	{
-		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId);
+		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, false, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 		InputNodeId = -1;
 	}
 }
@@ -1314,7 +1314,7 @@ UHoudiniInput::SetInputObjectsNumber(const EHoudiniInputType& InType, const int3
 	// Also delete the input's merge node when all the input objects are deleted.
 	if (InNewCount == 0 && InputNodeId >= 0)
 	{
-		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, true);
+		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, true, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 		InputNodeId = -1;
 	}
 }
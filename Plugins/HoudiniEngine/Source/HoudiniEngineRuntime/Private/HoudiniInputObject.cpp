@@ -645,14 +645,14 @@ UHoudiniInputObject::MarkInputNodesForDeletion()
 
 	if (InputNodeId >= 0)
 	{
-		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId);
+		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputNodeId, false, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 		InputNodeId = -1;
 	}
 
 	// ... and the parent OBJ as well to clean up
 	if (InputObjectNodeId >= 0)
 	{
-		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputObjectNodeId);
+		FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(InputObjectNodeId, false, FHoudiniEngineRuntime::GetSessionIndexForObject(this));
 		InputObjectNodeId = -1;
 	}
 }
@@ -44,6 +44,7 @@ UHoudiniRuntimeSettings::UHoudiniRuntimeSettings( const FObjectInitializer & Obj
 	ServerPipeName = HAPI_UNREAL_SESSION_SERVER_PIPENAME;
 	bStartAutomaticServer = HAPI_UNREAL_SESSION_SERVER_AUTOSTART;
 	AutomaticServerTimeout = HAPI_UNREAL_SESSION_SERVER_TIMEOUT;
+	SessionPoolSize = 1;
 
 	bSyncWithHoudiniCook = true;
 	bCookUsingHoudiniTime = true;
@@ -53,10 +54,19 @@ UHoudiniRuntimeSettings::UHoudiniRuntimeSettings( const FObjectInitializer & Obj
 
 	// Instantiating options.
 	bShowMultiAssetDialog = true;
+	bPreloadAssetLibraries = true;
 
 	// Cooking options.
 	bPauseCookingOnStart = false;
 	bDisplaySlateCookingNotifications = true;
+	ProcessingTickBudgetMs = 10.0f;
+	bInterruptOutdatedCooks = true;
+	bEnableCookCache = true;
+	bFetchOutputsAsync = true;
+	OutputCreationTickBudgetMs = 8.0f;
+	AttributeCacheSizeMb = 256;
+	AttributeStreamingThresholdMb = 64;
+	bReuseUnchangedParts = true;
 	DefaultTemporaryCookFolder = HAPI_UNREAL_DEFAULT_TEMP_COOK_FOLDER;
 	DefaultBakeFolder = HAPI_UNREAL_DEFAULT_BAKE_FOLDER;
 
@@ -305,6 +315,7 @@ UHoudiniRuntimeSettings::UpdateSessionUI()
 	SetPropertyReadOnly(TEXT("ServerPipeName"), true);
 	SetPropertyReadOnly(TEXT("bStartAutomaticServer"), true);
 	SetPropertyReadOnly(TEXT("AutomaticServerTimeout"), true);
+	SetPropertyReadOnly(TEXT("SessionPoolSize"), true);
 
 	bool bServerType = false;
 
@@ -333,6 +344,7 @@ UHoudiniRuntimeSettings::UpdateSessionUI()
 	{
 		SetPropertyReadOnly(TEXT("bStartAutomaticServer"), false);
 		SetPropertyReadOnly(TEXT("AutomaticServerTimeout"), false);
+		SetPropertyReadOnly(TEXT("SessionPoolSize"), false);
 	}
 }
 
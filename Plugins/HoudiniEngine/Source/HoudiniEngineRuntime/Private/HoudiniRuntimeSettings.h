@@ -104,6 +104,13 @@ protected:
 		UPROPERTY(GlobalConfig, EditAnywhere, Category = Session)
 		float AutomaticServerTimeout;
 
+		// Number of automatically started HARS sessions used to cook independent assets in parallel.
+		// Additional sessions use the next ports (socket) or a suffixed pipe name (named pipe).
+		// Assets connected through asset inputs always share the same session.
+		// Not used with Session Sync.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Session, meta = (ClampMin = "1", ClampMax = "16", UIMin = "1", UIMax = "8"))
+		int32 SessionPoolSize;
+
 		// If enabled, changes made in Houdini, when connected to Houdini running in Session Sync mode will be automatically be pushed to Unreal.
 		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Session)
 		bool bSyncWithHoudiniCook;
@@ -133,6 +140,11 @@ protected:
 		UPROPERTY(GlobalConfig, EditAnywhere, Category = Instantiating)
 		bool bShowMultiAssetDialog;
 
+		// If enabled, the HDA libraries used by the Houdini Asset Components of a map are loaded in the background
+		// when the map is opened or the session starts, in the session each component will use, instead of on their first instantiation.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Instantiating)
+		bool bPreloadAssetLibraries;
+
 		//-------------------------------------------------------------------------------------------------------------
 		// Cooking options.		
 		//-------------------------------------------------------------------------------------------------------------
@@ -145,6 +157,51 @@ protected:
 		UPROPERTY(GlobalConfig, EditAnywhere, Category = Cooking)
 		bool bDisplaySlateCookingNotifications;
 
+		// Time budget (in milliseconds) the Houdini Engine manager can spend processing Houdini Asset Components on each tick.
+		// When set to 0, a single component is processed per tick.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking, meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "50.0"))
+		float ProcessingTickBudgetMs;
+
+		// If enabled, a cook whose result became outdated (parameters or inputs changed while it was running)
+		// is interrupted so the new cook can start right away, and its result is discarded.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking)
+		bool bInterruptOutdatedCooks;
+
+		// If enabled, the fingerprint of each cook (HDA, parameter values and inputs) is recorded with its outputs.
+		// A recook of an instantiated asset whose fingerprint matches the one that produced the component's current outputs
+		// (ie, a parameter changed then reverted) keeps those outputs instead of cooking and translating the asset again.
+		// Nothing is restored from disk: loaded, duplicated and rebuilt assets are always cooked.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking)
+		bool bEnableCookCache;
+
+		// If enabled, the geometry of a cooked asset's mesh outputs is fetched from the session and assembled
+		// on a worker thread. Only the creation of the meshes and components is left to the game thread.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking)
+		bool bFetchOutputsAsync;
+
+		// Time budget (in milliseconds) spent creating a component's output meshes, instancers and landscapes on each tick.
+		// Outputs closest to the editor viewport are created first. When set to 0, all the outputs are created in a single tick.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking, meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "50.0"))
+		float OutputCreationTickBudgetMs;
+
+		// Memory budget (in MB) of the cache keeping the attributes fetched for each cooked part,
+		// so the translators only query each attribute of a part once per cook. Set to 0 to disable the cache.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking, meta = (ClampMin = "0", UIMin = "0", UIMax = "2048"))
+		int32 AttributeCacheSizeMb;
+
+		// Size (in MB) above which the positions of a mesh part are streamed from HAPI in chunks
+		// and converted as they arrive, instead of being fetched whole. Set to 0 to never stream them.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking, meta = (ClampMin = "0", UIMin = "0", UIMax = "1024"))
+		int32 AttributeStreamingThresholdMb;
+
+		// If enabled, the content of each mesh and curve part is fingerprinted when its geo is cooked, and the parts whose
+		// fingerprint didn't change reuse their existing meshes and curves instead of being translated again.
+		// The fingerprint is a 64 bit hash of the part's whole topology and of all its attribute values.
+		// Fingerprinting fetches the part's data once more, with HAPI queries that bypass the attribute cache,
+		// which is usually cheaper than translating the part again.
+		UPROPERTY(GlobalConfig, EditAnywhere, AdvancedDisplay, Category = Cooking)
+		bool bReuseUnchangedParts;
+
 		// Default content folder storing all the temporary cook data (Static meshes, materials, textures, landscape layer infos...)
 		UPROPERTY(GlobalConfig, EditAnywhere, Category = Cooking)
 		FString DefaultTemporaryCookFolder;
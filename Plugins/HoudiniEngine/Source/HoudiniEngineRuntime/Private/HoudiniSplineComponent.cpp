@@ -343,7 +343,7 @@ UHoudiniSplineComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 		InputObject->MarkPendingKill();
 
 		if(NodeId > -1)
-			FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(NodeId);
+			FHoudiniEngineRuntime::Get().MarkNodeIdAsPendingDelete(NodeId, false, FHoudiniEngineRuntime::GetSessionIndexForObject(InputObject));
 
 		SetNodeId(-1); // Set nodeId to invalid for reconstruct on re-do
 	}
@@ -135,6 +135,9 @@ public:
 	UFUNCTION()
 	const TArray<FVector>& GetVertexPositions() const { return VertexPositions; }
 
+	// Gives write access to all the vertex positions, to set them in bulk after Initialize()
+	TArrayView<FVector> GetVertexPositionsForWrite() { return VertexPositions; }
+
 	UFUNCTION()
 	const TArray<FIntVector>& GetTriangleIndices() const { return TriangleIndices; }
 